@@ -68,6 +68,31 @@ SMALL_GEOMETRY_NAMES = [
     "k2x2_j2x2",
 ]
 
+# Geometries kernel_bench runs on by default: the small meshes plus a 64-lane one.
+BENCH_GEOMETRY_NAMES = SMALL_GEOMETRY_NAMES + ["k2x2_j4x4"]
+
+# Extra copts for benchmark kernels. Output is deferred to a ring that is flushed when
+# full or at exit, so printing inside a timed region issues no HTIF round trips
+# (PRINT_RING_BYTES in kernel_tests/common/syscalls.c).
+BENCH_COPTS = ["-DPRINT_RING_BYTES=4096"]
+
+def geometry_header(name, geometry):
+    """Generate {name}.h with compile-time constants for one zamlet.geometries entry.
+
+    See kernel_tests/gen_geometry_header.py for the macros it defines.
+
+    Args:
+        name: Name for the output (will produce {name}.h)
+        geometry: Geometry name, e.g. "k2x1_j1x1"
+    """
+    native.genrule(
+        name = name,
+        tools = ["//python/zamlet/kernel_tests:gen_geometry_header"],
+        outs = [name + ".h"],
+        cmd = "$(location //python/zamlet/kernel_tests:gen_geometry_header) {} > $@".format(
+            geometry),
+    )
+
 def riscv_kernel(
         name,
         srcs,
@@ -77,6 +102,7 @@ def riscv_kernel(
         copts = [],
         march = "rv64gcv",
         mabi = "lp64d",
+        geometry = None,
         visibility = None):
     """Compile C and assembly sources into a RISC-V ELF for kernel tests.
 
@@ -89,8 +115,19 @@ def riscv_kernel(
         copts: Extra compiler flags (e.g. ["-ffast-math", "-DPREALLOCATE=1"])
         march: RISC-V architecture string
         mabi: RISC-V ABI string
+        geometry: If set, specialize the kernel for this geometry: a geometry_header
+            named {name}_geometry is generated and passed as ZAMLET_GEOMETRY_HEADER.
+            Only run the result on that geometry.
         visibility: Bazel visibility
     """
+    if geometry != None:
+        geometry_name = name + "_geometry"
+        geometry_header(name = geometry_name, geometry = geometry)
+        hdrs = hdrs + [":" + geometry_name]
+        copts = copts + [
+            "-DZAMLET_GEOMETRY_HEADER=\\\"{}.h\\\"".format(geometry_name),
+            "-I$$(dirname $(location :{}))".format(geometry_name),
+        ]
     all_srcs = srcs + common_srcs + hdrs
     src_locations = " ".join(["$(locations {})".format(s) for s in srcs + common_srcs])
     copts_str = " ".join(copts)
@@ -150,6 +187,143 @@ def kernel_test(
         tags: Extra Bazel tags
         deps: Extra Python deps
     """
+    _kernel_py_tests(name, kernel, geometries, expected_failure, max_cycles, symbol_values,
+                     timeout, tags, deps, budgets = None)
+
+def kernel_bench(
+        name,
+        kernel,
+        budgets,
+        geometries = None,
+        max_cycles = 1000000,
+        symbol_values = None,
+        timeout = "long",
+        expected_over_budget = False,
+        tags = [],
+        deps = []):
+    """Generate py_test targets that hold a kernel to cycle budgets across geometries.
+
+    Like kernel_test, but each test also reads the kernel's bench_begin/bench_end
+    records and fails if a budgeted region is missing or takes more cycles than its
+    budget. The cycles of every budgeted region are printed in the test log.
+
+    Args:
+        name: Base test name (e.g. "bench_fftN64")
+        kernel: Label of the riscv_kernel target
+        budgets: Dict of bench region name -> maximum cycles. A value may instead be a
+            dict of geometry name -> maximum cycles; geometries missing from it run
+            with that region unbudgeted.
+        geometries: List of geometry name strings; defaults to BENCH_GEOMETRY_NAMES
+        max_cycles: Maximum simulation cycles
+        symbol_values: Dict of symbol name -> int value to inject before running
+        expected_over_budget: If True, the test passes only if some budgeted region is
+            missing or over budget; guards against budgets that are never checked
+        tags: Extra Bazel tags
+        deps: Extra Python deps
+    """
+    if geometries == None:
+        geometries = BENCH_GEOMETRY_NAMES
+    _kernel_py_tests(name, kernel, geometries, False, max_cycles, symbol_values,
+                     timeout, tags, deps, budgets = budgets,
+                     expected_over_budget = expected_over_budget)
+
+def dataset_kernel(
+        name,
+        label,
+        gen_args,
+        data_label = None,
+        gen = None,
+        header_define = None,
+        srcs = None,
+        common_srcs = [],
+        hdrs = [],
+        copts = [],
+        tests = None,
+        max_cycles = 100000,
+        timeout = "long",
+        geometries = None):
+    """A benchmark kernel built against a generated dataset header, and its tests.
+
+    The package holds vec-<name>.c, with _ in name written as -, and gen_<name>.py, which
+    prints the header to stdout. gen_<name>.py <gen_args> writes <name>_data_<data_label>.h
+    and the kernel vec-<name>-<label> includes it through <NAME>_HEADER. Calls with the
+    same data_label share one header. The generator can import gen_header
+    (kernel_tests/common/gen_header.py) for its array declarations.
+
+    Args:
+        name: Kernel family, e.g. "compact"
+        label: Suffix of the kernel and test names, e.g. "1000_k5"
+        gen_args: Command line of the generator
+        data_label: Suffix of the header name; defaults to label
+        gen: Generator script; defaults to gen_<name>.py
+        header_define: Macro naming the header; defaults to <NAME>_HEADER
+        srcs: Kernel sources; default to vec-<name>.c
+        common_srcs: Extra runtime sources, besides ara_runtime
+        hdrs: Extra headers
+        copts: Extra compiler flags, besides BENCH_COPTS
+        tests: Dict of test name suffix -> symbol_values, one kernel_test each, named
+            test_<name>_<label><suffix>; defaults to one test with no symbol values
+        max_cycles, timeout, geometries: Passed to every kernel_test
+    """
+    dashed = name.replace("_", "-")
+    if data_label == None:
+        data_label = label
+    if gen == None:
+        gen = "gen_{}.py".format(name)
+    if header_define == None:
+        header_define = name.upper() + "_HEADER"
+    if srcs == None:
+        srcs = ["vec-{}.c".format(dashed)]
+    if tests == None:
+        tests = {"": None}
+    data_name = "{}_data_{}".format(name, data_label)
+    kernel_name = "vec-{}-{}".format(dashed, label)
+    helper = "//python/zamlet/kernel_tests/common:gen_header.py"
+    if native.existing_rule(data_name) == None:
+        native.genrule(
+            name = data_name,
+            tools = [gen, helper],
+            outs = [data_name + ".h"],
+            cmd = "PYTHONPATH=$$(dirname $(location {})) python3 $(location {}) {} > $@".format(
+                helper, gen, gen_args),
+        )
+    riscv_kernel(
+        name = kernel_name,
+        srcs = srcs,
+        common_srcs = ["//python/zamlet/kernel_tests/common:ara_runtime"] + common_srcs,
+        hdrs = ["//python/zamlet/kernel_tests/common:headers", ":" + data_name] + hdrs,
+        linker_script = "//python/zamlet/kernel_tests/common:test.ld",
+        copts = BENCH_COPTS + copts + [
+            "-DPREALLOCATE=1",
+            "-D{}=\\\"{}.h\\\"".format(header_define, data_name),
+            "-I$$(dirname $(location :{}))".format(data_name),
+        ],
+    )
+    for suffix, symbol_values in tests.items():
+        kernel_test(
+            name = "test_{}_{}{}".format(name, label, suffix),
+            kernel = ":" + kernel_name,
+            max_cycles = max_cycles,
+            symbol_values = symbol_values,
+            timeout = timeout,
+            geometries = geometries,
+        )
+
+def _geometry_budgets(budgets, geom):
+    result = {}
+    for region, budget in budgets.items():
+        if type(budget) == "dict":
+            if geom in budget:
+                result[region] = budget[geom]
+        else:
+            result[region] = budget
+    for region, budget in result.items():
+        if budget <= 0:
+            fail("budget for {} on {} must be positive, got {}".format(region, geom, budget))
+    return result
+
+def _kernel_py_tests(name, kernel, geometries, expected_failure, max_cycles, symbol_values,
+                     timeout, tags, deps, budgets, expected_over_budget = False):
     if geometries == None:
         geometries = SMALL_GEOMETRY_NAMES
 
@@ -165,6 +339,10 @@ def kernel_test(
         }
         if symbol_values:
             env["SYMBOL_VALUES"] = json.encode(symbol_values)
+        if budgets:
+            env["CYCLE_BUDGETS"] = json.encode(_geometry_budgets(budgets, geom))
+        if expected_over_budget:
+            env["EXPECTED_OVER_BUDGET"] = "1"
         native.py_test(
             name = test_name,
             srcs = ["//python/zamlet/kernel_tests:run_kernel_test.py"],
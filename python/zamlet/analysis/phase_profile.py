@@ -0,0 +1,201 @@
+"""Per-phase cycle profile from zamlet_mark trace markers.
+
+Kernels delimit phases with zamlet_mark(id) (kernel_tests/common/zamlet_custom.h). Every
+kamlet logs a "marker" event when it admits the marker, so on each kamlet a phase runs
+from its marker to the kamlet's next marker (or to the end of the run).
+
+Markers are broadcast in program order, so the i-th marker event on every kamlet belongs
+to the same dynamic phase instance. An instance costs the cycles of its slowest kamlet.
+
+Outputs:
+  phase table  per marker id: instances, total / mean cycles, share of marked cycles
+  timeline     Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev), one track
+               per kamlet
+
+Usage on a monitor.dump_to_file() JSON:
+  python -m zamlet.analysis.phase_profile dump.json [--trace phases_trace.json]
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+from dataclasses import dataclass
+from typing import Dict, List, Optional
+
+
+@dataclass
+class Phase:
+    component: str
+    marker_id: int
+    instance: int
+    start: int
+    end: int
+
+    @property
+    def cycles(self) -> int:
+        return self.end - self.start
+
+
+@dataclass
+class PhaseRow:
+    marker_id: int
+    name: str
+    instances: int
+    cycles: int
+    share: float
+
+    @property
+    def mean(self) -> float:
+        return self.cycles / self.instances
+
+
+def _field(obj, name):
+    if isinstance(obj, dict):
+        return obj[name]
+    return getattr(obj, name)
+
+
+def collect_markers(spans) -> Dict[str, List[tuple]]:
+    """Return {component: [(cycle, marker_id), ...]} sorted by cycle.
+
+    `spans` is Monitor.spans or the 'spans' dict of a dump_to_file() JSON.
+    """
+    markers: Dict[str, List[tuple]] = {}
+    for span in spans.values():
+        for event in _field(span, 'events'):
+            if _field(event, 'event') != 'marker':
+                continue
+            marker_id = _field(event, 'details')['marker_id']
+            markers.setdefault(_field(span, 'component'), []).append(
+                (_field(event, 'cycle'), marker_id))
+    for events in markers.values():
+        events.sort()
+    return markers
+
+
+def build_phases(markers: Dict[str, List[tuple]], end_cycle: int) -> List[Phase]:
+    phases = []
+    for component, events in markers.items():
+        for i, (cycle, marker_id) in enumerate(events):
+            end = events[i + 1][0] if i + 1 < len(events) else end_cycle
+            phases.append(Phase(component, marker_id, i, cycle, max(end, cycle)))
+    return phases
+
+
+def phase_table(phases: List[Phase], names: Optional[Dict[int, str]] = None
+                ) -> List[PhaseRow]:
+    """Aggregate phases by marker id, ordered by first appearance."""
+    names = names or {}
+    # (marker_id, instance) -> slowest kamlet's cycles
+    instance_cycles: Dict[tuple, int] = {}
+    first_start: Dict[int, int] = {}
+    for p in phases:
+        key = (p.marker_id, p.instance)
+        instance_cycles[key] = max(instance_cycles.get(key, 0), p.cycles)
+        first_start[p.marker_id] = min(first_start.get(p.marker_id, p.start), p.start)
+
+    totals: Dict[int, List[int]] = {}
+    for (marker_id, _instance), cycles in instance_cycles.items():
+        totals.setdefault(marker_id, []).append(cycles)
+    grand_total = sum(sum(c) for c in totals.values())
+
+    rows = []
+    for marker_id in sorted(totals, key=lambda m: first_start[m]):
+        cycles = sum(totals[marker_id])
+        share = 100.0 * cycles / grand_total if grand_total else 0.0
+        rows.append(PhaseRow(marker_id, names.get(marker_id, ''),
+                             len(totals[marker_id]), cycles, share))
+    return rows
+
+
+def format_phase_table(rows: List[PhaseRow]) -> str:
+    lines = [f"{'marker':>8}  {'name':<24} {'count':>6} {'cycles':>10} {'mean':>10} "
+             f"{'share':>7}"]
+    for r in rows:
+        lines.append(f"{r.marker_id:>8}  {r.name:<24} {r.instances:>6} {r.cycles:>10} "
+                     f"{r.mean:>10.1f} {r.share:>6.1f}%")
+    return '\n'.join(lines) + '\n'
+
+
+def _kamlet_sort_key(component: str):
+    nums = [int(n) for n in re.findall(r'\d+', component)]
+    return (component.split('(')[0], nums)
+
+
+def chrome_trace(phases: List[Phase], names: Optional[Dict[int, str]] = None) -> dict:
+    """Chrome trace-event JSON with one complete ("X") event per phase.
+
+    Timestamps are cycles (displayed as microseconds).
+    """
+    names = names or {}
+    components = sorted({p.component for p in phases}, key=_kamlet_sort_key)
+    tids = {c: i for i, c in enumerate(components)}
+    events = [{'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': tids[c],
+               'args': {'name': c}} for c in components]
+    for p in phases:
+        events.append({
+            'name': names.get(p.marker_id, str(p.marker_id)),
+            'cat': 'phase',
+            'ph': 'X',
+            'pid': 0,
+            'tid': tids[p.component],
+            'ts': p.start,
+            'dur': p.cycles,
+            'args': {'marker_id': p.marker_id, 'instance': p.instance},
+        })
+    return {'traceEvents': events, 'displayTimeUnit': 'ns'}
+
+
+def write_phase_profile(monitor, out_dir: str,
+                        names: Optional[Dict[int, str]] = None) -> bool:
+    """Write phases.txt and phases_trace.json to out_dir if the run emitted markers."""
+    markers = collect_markers(monitor.spans)
+    if not markers:
+        return False
+    phases = build_phases(markers, monitor.clock.cycle)
+    with open(os.path.join(out_dir, 'phases.txt'), 'w') as f:
+        f.write(format_phase_table(phase_table(phases, names)))
+    with open(os.path.join(out_dir, 'phases_trace.json'), 'w') as f:
+        json.dump(chrome_trace(phases, names), f)
+    return True
+
+
+def _dump_end_cycle(spans: dict) -> int:
+    end = 0
+    for span in spans.values():
+        end = max(end, span['created_cycle'], span['completed_cycle'] or 0)
+        for event in span['events']:
+            end = max(end, event['cycle'])
+    return end
+
+
+def main(argv=None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('dump', help='JSON written by Monitor.dump_to_file')
+    parser.add_argument('--trace', help='write a Chrome trace-event timeline here')
+    parser.add_argument('--names', help='JSON object mapping marker id to phase name')
+    args = parser.parse_args(argv)
+
+    with open(args.dump) as f:
+        spans = json.load(f)['spans']
+    names = None
+    if args.names:
+        with open(args.names) as f:
+            names = {int(k): v for k, v in json.load(f).items()}
+
+    markers = collect_markers(spans)
+    if not markers:
+        print('no marker events in dump', file=sys.stderr)
+        return 1
+    phases = build_phases(markers, _dump_end_cycle(spans))
+    sys.stdout.write(format_phase_table(phase_table(phases, names)))
+    if args.trace:
+        with open(args.trace, 'w') as f:
+            json.dump(chrome_trace(phases, names), f)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -361,6 +361,9 @@ def decode_standard(instruction_bytes: bytes) -> Instruction:
     #   funct3=1: BeginWriteset — open shared writeset scope to skip completion sync
     #   funct3=2: EndWriteset — close writeset scope
     #   funct3=3: Mark — broadcast a trace marker to every kamlet
+    #   funct3=4: Prefetch — start cache fills for a byte range (R-type, rs1/rs2)
+    #   funct3=5: BeginNontemporal — open non-temporal store scope
+    #   funct3=6: EndNontemporal — close non-temporal store scope
     elif opcode == 0x0b:
         imm = decode_i_imm(inst)
         if funct3 == 0x0:
@@ -371,6 +374,12 @@ def decode_standard(instruction_bytes: bytes) -> Instruction:
             return CUSTOM.EndWriteset()
         elif funct3 == 0x3:
             return CUSTOM.Mark(rs1=rs1, imm=imm)
+        elif funct3 == 0x4:
+            return CUSTOM.Prefetch(rs1=rs1, rs2=rs2)
+        elif funct3 == 0x5:
+            return CUSTOM.BeginNontemporal()
+        elif funct3 == 0x6:
+            return CUSTOM.EndNontemporal()
 
     elif opcode == 0x07:
         width = funct3
@@ -398,17 +407,24 @@ def decode_standard(instruction_bytes: bytes) -> Instruction:
                         vd=rd, rs1=rs1, vm=vm, element_width=ew, nf=nf + 1,
                     )
             elif mop == 0x1:
-                # Indexed-unordered load (vluxei*.v)
+                # Indexed-unordered load (vluxei*.v, vluxseg*.v)
                 return V.VIndexedLoad(
                     vd=rd, rs1=rs1, vs2=rs2, vm=vm, index_width=ew, ordered=False,
+                    nf=nf + 1,
                 )
             elif mop == 0x2:
-                # Constant-stride load (vlse*.v)
-                return V.VlseV(vd=rd, rs1=rs1, rs2=rs2, vm=vm, element_width=ew)
+                # Constant-stride load (vlse*.v, vlsseg*.v)
+                if nf == 0:
+                    return V.VlseV(vd=rd, rs1=rs1, rs2=rs2, vm=vm, element_width=ew)
+                else:
+                    return V.VlsegV(
+                        vd=rd, rs1=rs1, vm=vm, element_width=ew, nf=nf + 1, rs2=rs2,
+                    )
             elif mop == 0x3:
-                # Indexed-ordered load (vloxei*.v)
+                # Indexed-ordered load (vloxei*.v, vloxseg*.v)
                 return V.VIndexedLoad(
                     vd=rd, rs1=rs1, vs2=rs2, vm=vm, index_width=ew, ordered=True,
+                    nf=nf + 1,
                 )
         elif width == 0x2:
             return F.Flw(fd=rd, rs1=rs1, imm=decode_i_imm(inst))
@@ -495,19 +511,26 @@ def decode_standard(instruction_bytes: bytes) -> Instruction:
                         vs3=vs3, rs1=rs1, vm=vm, element_width=ew, nf=nf + 1,
                     )
             elif mop == 0x1:
-                # Indexed-unordered store (vsuxei*.v)
+                # Indexed-unordered store (vsuxei*.v, vsuxseg*.v)
                 return V.VIndexedStore(
                     vs3=vs3, rs1=rs1, vs2=rs2, vm=vm, index_width=ew, ordered=False,
+                    nf=nf + 1,
                 )
             elif mop == 0x2:
-                # Constant-stride store (vsse*.v)
-                return V.VsseV(
-                    vs3=vs3, rs1=rs1, rs2=rs2, vm=vm, element_width=ew,
-                )
+                # Constant-stride store (vsse*.v, vssseg*.v)
+                if nf == 0:
+                    return V.VsseV(
+                        vs3=vs3, rs1=rs1, rs2=rs2, vm=vm, element_width=ew,
+                    )
+                else:
+                    return V.VssegV(
+                        vs3=vs3, rs1=rs1, vm=vm, element_width=ew, nf=nf + 1, rs2=rs2,
+                    )
             elif mop == 0x3:
-                # Indexed-ordered store (vsoxei*.v)
+                # Indexed-ordered store (vsoxei*.v, vsoxseg*.v)
                 return V.VIndexedStore(
                     vs3=vs3, rs1=rs1, vs2=rs2, vm=vm, index_width=ew, ordered=True,
+                    nf=nf + 1,
                 )
         elif width == 0x2:
             return F.Fsw(rs2=rs2, rs1=rs1, imm=decode_s_imm(inst))
@@ -810,6 +833,18 @@ def decode_standard(instruction_bytes: bytes) -> Instruction:
         elif funct6 == 0x29 and funct3 == 0x0:
             vs1 = rs1
             return V.VArithVv(vd=rd, vs1=vs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.SRA)
+        elif funct6 == 0x04 and funct3 == 0x0:
+            vs1 = rs1
+            return V.VArithVv(vd=rd, vs1=vs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.MINU)
+        elif funct6 == 0x05 and funct3 == 0x0:
+            vs1 = rs1
+            return V.VArithVv(vd=rd, vs1=vs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.MIN)
+        elif funct6 == 0x06 and funct3 == 0x0:
+            vs1 = rs1
+            return V.VArithVv(vd=rd, vs1=vs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.MAXU)
+        elif funct6 == 0x07 and funct3 == 0x0:
+            vs1 = rs1
+            return V.VArithVv(vd=rd, vs1=vs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.MAX)
         # OPIVX (funct3 = 0x4) - integer vector-scalar
         elif funct6 == 0x00 and funct3 == 0x4:
             return V.VArithVx(vd=rd, rs1=rs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.ADD)
@@ -832,6 +867,14 @@ def decode_standard(instruction_bytes: bytes) -> Instruction:
             return V.VArithVx(vd=rd, rs1=rs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.SRL)
         elif funct6 == 0x29 and funct3 == 0x4:
             return V.VArithVx(vd=rd, rs1=rs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.SRA)
+        elif funct6 == 0x04 and funct3 == 0x4:
+            return V.VArithVx(vd=rd, rs1=rs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.MINU)
+        elif funct6 == 0x05 and funct3 == 0x4:
+            return V.VArithVx(vd=rd, rs1=rs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.MIN)
+        elif funct6 == 0x06 and funct3 == 0x4:
+            return V.VArithVx(vd=rd, rs1=rs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.MAXU)
+        elif funct6 == 0x07 and funct3 == 0x4:
+            return V.VArithVx(vd=rd, rs1=rs1, vs2=vs2, vm=vm, op=kinstructions.VArithOp.MAX)
         # OPIVI (funct3 = 0x3) - integer vector-immediate
         elif funct6 == 0x00 and funct3 == 0x3:
             simm5 = rs1
@@ -1051,6 +1094,9 @@ def decode_standard(instruction_bytes: bytes) -> Instruction:
         elif funct6 == 0x0e and funct3 == 0x0:
             vs1 = rs1
             return V.Vrgather(vd=rd, vs2=vs2, vs1=vs1, vm=vm, index_ew_fixed=16)
+        elif funct6 == 0x17 and funct3 == 0x2 and vm == 1:
+            vs1 = rs1
+            return V.VcompressVm(vd=rd, vs2=vs2, vs1=vs1)
         # Slides: funct6 0x0e = vslideup, 0x0f = vslidedown.
         # funct3 0x4 = .vx (rs1 offset), 0x3 = .vi (uimm5 offset).
         elif funct6 == 0x0e and funct3 == 0x4:
@@ -1180,6 +1226,17 @@ def decode_standard(instruction_bytes: bytes) -> Instruction:
                 op, mnemonic = vfcvt_ops[rs1]
                 return V.VUnary(vd=rd, vs2=vs2, vm=vm, op=op,
                                 factor=1, widening=True, mnemonic=mnemonic)
+        elif funct6 == 0x13 and funct3 == 0x1:
+            # vfunary1: square root and estimates, vs1 selects variant
+            vfunary1_ops = {
+                0x00: (kinstructions.VUnaryOp.FSQRT, 'vfsqrt.v'),
+                0x04: (kinstructions.VUnaryOp.FRSQRT7, 'vfrsqrt7.v'),
+                0x05: (kinstructions.VUnaryOp.FREC7, 'vfrec7.v'),
+            }
+            if rs1 in vfunary1_ops:
+                op, mnemonic = vfunary1_ops[rs1]
+                return V.VUnary(vd=rd, vs2=vs2, vm=vm, op=op,
+                                factor=1, widening=True, mnemonic=mnemonic)
         # Widening integer add/sub family (OPMVV funct3=0x2, OPMVX funct3=0x6).
         # Encoding: src2_signed reflects the .wv/.wx signedness of vs2; src1
         # is at SEW (BASE) or already-widened to 2*SEW (WIDE); dst always 2*SEW.
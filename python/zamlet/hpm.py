@@ -0,0 +1,94 @@
+"""
+Hardware performance counters.
+
+Backs the machine counter CSRs read by kernels:
+  mcycle/cycle           clock cycles
+  minstret/instret       retired scalar-core instructions
+  mhpmcounterN (N=3..31) the event selected by writing its HpmEvent id to mhpmeventN;
+                         selecting an event restarts the counter from zero
+
+Counting is unconditional; it does not depend on Monitor.enabled. Keep HpmEvent in sync
+with the HPM_EVENT_* defines in kernel_tests/common/util.h.
+"""
+from enum import IntEnum
+from typing import Dict
+
+
+CSR_MCYCLE = 0xb00
+CSR_MINSTRET = 0xb02
+CSR_MHPMCOUNTER3 = 0xb03
+CSR_MHPMCOUNTER31 = 0xb1f
+CSR_CYCLE = 0xc00
+CSR_INSTRET = 0xc02
+CSR_HPMCOUNTER3 = 0xc03
+CSR_HPMCOUNTER31 = 0xc1f
+CSR_MHPMEVENT3 = 0x323
+CSR_MHPMEVENT31 = 0x33f
+
+
+class HpmEvent(IntEnum):
+    NONE = 0
+    # Kinstrs placed in the lamlet instruction buffer.
+    KINSTR_DISPATCHED = 1
+    # Cache requests created by kamlet cache tables (line fills and evictions).
+    CACHE_MISS = 2
+    # Router output-cycles where a word was waiting but could not move.
+    NETWORK_STALL = 3
+    # Cycles the lamlet could not send on the instruction network.
+    INSTR_NET_STALL = 4
+    # Indexed (gather/scatter) loads and stores that returned a fault.
+    INDEXED_FAULT = 5
+
+
+class HpmCounters:
+
+    def __init__(self, clock):
+        self.clock = clock
+        self.counts: Dict[HpmEvent, int] = {event: 0 for event in HpmEvent}
+        self.instret = 0
+        # Per-CSR event selection and write offset, keyed by counter index 3..31.
+        self._event: Dict[int, HpmEvent] = {}
+        self._offset: Dict[int, int] = {}
+
+    def count(self, event: HpmEvent, n: int = 1) -> None:
+        self.counts[event] += n
+
+    def retire(self) -> None:
+        self.instret += 1
+
+    @staticmethod
+    def handles(csr: int) -> bool:
+        return (CSR_MCYCLE <= csr <= CSR_MHPMCOUNTER31 or
+                CSR_CYCLE <= csr <= CSR_HPMCOUNTER31 or
+                CSR_MHPMEVENT3 <= csr <= CSR_MHPMEVENT31)
+
+    def _raw(self, index: int) -> int:
+        if index == 0:
+            return self.clock.cycle
+        if index == 2:
+            return self.instret
+        if index == 1:
+            # time: there is no separate timebase.
+            return self.clock.cycle
+        return self.counts[self._event.get(index, HpmEvent.NONE)]
+
+    def read(self, csr: int) -> int:
+        assert self.handles(csr)
+        if csr >= CSR_MHPMEVENT3 and csr <= CSR_MHPMEVENT31:
+            return int(self._event.get(csr - CSR_MHPMEVENT3 + 3, HpmEvent.NONE))
+        index = csr & 0x1f
+        return self._raw(index) - self._offset.get(index, 0)
+
+    def write(self, csr: int, value: int) -> None:
+        assert self.handles(csr)
+        if csr >= CSR_MHPMEVENT3 and csr <= CSR_MHPMEVENT31:
+            index = csr - CSR_MHPMEVENT3 + 3
+            try:
+                self._event[index] = HpmEvent(value)
+            except ValueError:
+                self._event[index] = HpmEvent.NONE
+            self._offset[index] = self._raw(index)
+            return
+        assert csr < CSR_CYCLE, f'CSR 0x{csr:x} is read-only'
+        index = csr & 0x1f
+        self._offset[index] = self._raw(index) - value
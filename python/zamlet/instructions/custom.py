@@ -1,11 +1,15 @@
 """Custom-0 opcode instructions (opcode 0x0B) for VPU optimization.
 
-All use I-type encoding (opcode=0x0B, with rd, rs1, imm fields).
+All but Prefetch use I-type encoding (opcode=0x0B, with rd, rs1, imm fields);
+Prefetch is R-type so it can take two registers.
 Instructions distinguished by funct3:
 - SetIndexBound (funct3=0): Bounds index register values to lower N bits
 - BeginWriteset (funct3=1): Opens a shared writeset scope
 - EndWriteset (funct3=2): Closes the writeset scope
 - Mark (funct3=3): Trace marker; broadcasts a Marker KInstr with id=imm
+- Prefetch (funct3=4): Starts cache fills for x[rs1] .. x[rs1] + x[rs2]
+- BeginNontemporal (funct3=5): Opens a non-temporal store scope
+- EndNontemporal (funct3=6): Closes the non-temporal store scope
 """
 
 import logging
@@ -166,3 +170,130 @@ class Mark:
         if self.rs1 != 0:
             return f'Mark(rs1={reg_name(self.rs1)})'
         return f'Mark(imm={self.imm})'
+
+
+@dataclass
+class Prefetch:
+    """prefetch rs1, rs2 - Start filling the caches with [x[rs1], x[rs1] + x[rs2]).
+
+    A hint: it never faults and the scalar core continues at once. Each VPU page the range
+    touches becomes a Prefetch KInstr broadcast to every kamlet with the kamlet-memory
+    range of its vlines, which is the same on every kamlet. Scalar and unmapped pages are
+    skipped, since only VPU memory is cached in the kamlets.
+
+    Assembly: .insn r 0x0b, 4, 0, x0, a0, a1
+    """
+    rs1: int
+    rs2: int
+
+    @riscv_instr
+    async def update_state(self, s: 'Oamlet', span_id: int):
+        await s.scalar.wait_all_regs_ready(0, None, [self.rs1, self.rs2], [])
+        addr = int.from_bytes(
+            s.scalar.read_reg(self.rs1), byteorder='little', signed=False)
+        n_bytes = int.from_bytes(
+            s.scalar.read_reg(self.rs2), byteorder='little', signed=False)
+        ranges = prefetch_k_ranges(s, addr, n_bytes)
+        logger.debug(f'{s.clock.cycle}: prefetch: addr=0x{addr:x} n_bytes={n_bytes} '
+                     f'k_ranges={[(hex(a), n) for a, n in ranges]}')
+        for k_addr, k_bytes in ranges:
+            instr_ident = await ident_query.get_instr_ident(s)
+            kinstr = kinstructions.Prefetch(
+                k_addr=k_addr, n_bytes=k_bytes, instr_ident=instr_ident)
+            await s.add_to_instruction_buffer(kinstr, span_id)
+        s.pc += 4
+
+    def disasm(self, pc: int) -> str:
+        return f'prefetch {reg_name(self.rs1)}, {reg_name(self.rs2)}'
+
+    def __str__(self):
+        return f'Prefetch(rs1={reg_name(self.rs1)}, rs2={reg_name(self.rs2)})'
+
+
+@dataclass
+class BeginNontemporal:
+    """begin_nontemporal - Open a non-temporal store scope.
+
+    Unit-stride vector stores issued within the scope are marked non-temporal. Once such
+    a store has written a cache line and the stream has moved on to another line, the
+    kamlet writes the line back to memory and frees its slot, and until then the line is
+    the first one evicted. A stream of results that is never re-read then does not evict
+    the rest of the cache.
+
+    Assembly: .insn i 0x0b, 5, x0, x0, 0
+    """
+
+    @riscv_instr
+    async def update_state(self, s: 'Oamlet', span_id: int):
+        assert not s.nontemporal_active, \
+            "begin_nontemporal while already in a nontemporal scope"
+        s.nontemporal_active = True
+        logger.debug(f'{s.clock.cycle}: begin_nontemporal')
+        s.pc += 4
+
+    def disasm(self, pc: int) -> str:
+        return 'begin_nontemporal'
+
+    def __str__(self):
+        return 'BeginNontemporal()'
+
+
+@dataclass
+class EndNontemporal:
+    """end_nontemporal - Close the non-temporal store scope.
+
+    Stores issued after it allocate and stay in the cache as usual. Lines already written
+    by the scope's stores are still written back and freed.
+
+    Assembly: .insn i 0x0b, 6, x0, x0, 0
+    """
+
+    @riscv_instr
+    async def update_state(self, s: 'Oamlet', span_id: int):
+        assert s.nontemporal_active, \
+            "end_nontemporal without an active nontemporal scope"
+        s.nontemporal_active = False
+        logger.debug(f'{s.clock.cycle}: end_nontemporal')
+        s.pc += 4
+
+    def disasm(self, pc: int) -> str:
+        return 'end_nontemporal'
+
+    def __str__(self):
+        return 'EndNontemporal()'
+
+
+def prefetch_k_ranges(s: 'Oamlet', addr: int, n_bytes: int) -> list[tuple[int, int]]:
+    """Kamlet-memory (k_addr, n_bytes) ranges holding the VPU bytes of [addr, addr + n_bytes).
+
+    Vline v of VPU memory is bytes [v * k_vline_bytes, (v + 1) * k_vline_bytes) of every
+    kamlet's memory, so the range of a page covers whole vlines. Ranges of consecutive
+    pages that are adjacent in VPU memory are merged. Only mapped pages are visited, and
+    the ranges stop once they fill a kamlet's cache, since the kamlets drop the lines past
+    that anyway.
+    """
+    params = s.params
+    page_bytes = params.page_bytes
+    cache_bytes = params.jamlet_sram_bytes * params.j_in_k
+    end = addr + n_bytes
+    first_page = addr // page_bytes * page_bytes
+    ranges: list[tuple[int, int]] = []
+    total = 0
+    for page in sorted(p for p in s.tlb.pages if first_page <= p < end):
+        info = s.tlb.pages[page]
+        if not (info.is_vpu and info.readable):
+            continue
+        lo = max(addr, page) - page + info.physical_addr
+        hi = min(end, page + page_bytes) - page + info.physical_addr
+        first_vline = lo // params.vline_bytes
+        end_vline = (hi - 1) // params.vline_bytes + 1
+        k_addr = first_vline * params.k_vline_bytes
+        k_bytes = min((end_vline - first_vline) * params.k_vline_bytes, cache_bytes - total)
+        total += k_bytes
+        if ranges and sum(ranges[-1]) == k_addr:
+            ranges[-1] = (ranges[-1][0], ranges[-1][1] + k_bytes)
+        else:
+            ranges.append((k_addr, k_bytes))
+        if total == cache_bytes:
+            break
+    return ranges
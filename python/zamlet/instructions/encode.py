@@ -141,3 +141,22 @@ def encode_begin_writeset() -> int:
 def encode_end_writeset() -> int:
     """Encode end_writeset (custom-0, funct3=2)."""
     return _encode_custom0_i_type(funct3=2)
+
+
+def encode_begin_nontemporal() -> int:
+    """Encode begin_nontemporal (custom-0, funct3=5)."""
+    return _encode_custom0_i_type(funct3=5)
+
+
+def encode_end_nontemporal() -> int:
+    """Encode end_nontemporal (custom-0, funct3=6)."""
+    return _encode_custom0_i_type(funct3=6)
+
+
+def encode_prefetch(rs1: int, rs2: int) -> int:
+    """Encode prefetch (custom-0, funct3=4), R-type with funct7=0 and rd=0.
+
+    Prefetches the x[rs2] bytes starting at x[rs1].
+    """
+    opcode = 0x0B
+    return ((rs2 & 0x1f) << 20) | ((rs1 & 0x1f) << 15) | (0x4 << 12) | opcode
@@ -453,6 +453,9 @@ class VlsegV:
       v1: G0 G1 G2 ...
       v2: B0 B1 B2 ...
 
+    With rs2 set this is the strided form vlsseg: segment i starts at rs1 + i * x[rs2].
+    Field f goes to register group vd + f * EMUL.
+
     Reference: riscv-isa-manual/src/v-st-ext.adoc lines 1758-1888
     """
     vd: int
@@ -460,10 +463,15 @@ class VlsegV:
     vm: int
     element_width: int
     nf: int  # Number of fields (2-8)
+    rs2: int | None = None
 
     def __str__(self):
         vm_str = '' if self.vm else ',v0.t'
-        return f'vlseg{self.nf}e{self.element_width}.v\tv{self.vd},({reg_name(self.rs1)}){vm_str}'
+        if self.rs2 is None:
+            return (f'vlseg{self.nf}e{self.element_width}.v\tv{self.vd},'
+                    f'({reg_name(self.rs1)}){vm_str}')
+        return (f'vlsseg{self.nf}e{self.element_width}.v\tv{self.vd},'
+                f'({reg_name(self.rs1)}),{reg_name(self.rs2)}{vm_str}')
 
     async def update_state(self, s: 'Oamlet'):
         span_id = s.monitor.create_span(
@@ -473,9 +481,16 @@ class VlsegV:
             mnemonic=str(self),
             pc=s.pc,
         )
-        await s.scalar.wait_all_regs_ready(None, None, [self.rs1], [])
+        addr_regs = [self.rs1] if self.rs2 is None else [self.rs1, self.rs2]
+        await s.scalar.wait_all_regs_ready(None, None, addr_regs, [])
         rs1_bytes = s.scalar.read_reg(self.rs1)
         addr = int.from_bytes(rs1_bytes, byteorder='little', signed=False)
+        element_bytes = self.element_width // 8
+        if self.rs2 is None:
+            stride = self.nf * element_bytes
+        else:
+            rs2_bytes = s.scalar.read_reg(self.rs2)
+            stride = int.from_bytes(rs2_bytes, byteorder='little', signed=True)
         if self.vm:
             mask_reg = None
         else:
@@ -483,12 +498,22 @@ class VlsegV:
             await s.ensure_vrf_ordering(mask_reg, 1, span_id, vl=s.vl, vstart=s.vstart)
         logger.debug(f'{s.clock.cycle}: VLSEG{self.nf}E{self.element_width}.V: '
                     f'vd=v{self.vd}, addr=0x{addr:x}, vl={s.vl}, nf={self.nf}, '
-                    f'masked={not self.vm}, mask_reg={mask_reg}')
+                    f'stride={stride}, masked={not self.vm}, mask_reg={mask_reg}')
         ordering = addresses.Ordering(s.word_order, self.element_width)
-        await s.vsegload(self.vd, addr, ordering, s.vl, mask_reg, s.vstart, self.nf)
+        emul = max(1, (self.element_width * s.lmul) // s.sew)
+        result = await s.vsegload(
+            self.vd, addr, ordering, s.vl, mask_reg, s.vstart, self.nf,
+            parent_span_id=span_id, emul=emul, stride_bytes=stride)
+        if s.maybe_trap_vector(
+                result, is_store=False,
+                fault_addr_fallback=addr + (result.element_index or 0) * stride):
+            s.monitor.finalize_children(span_id)
+            return
+        s.vstart = 0
         s.monitor.finalize_children(span_id)
         s.pc += 4
-        logger.debug(f'Loaded segment into vd=v{self.vd} through v{self.vd + self.nf - 1}')
+        logger.debug(f'Loaded segment into vd=v{self.vd} through '
+                     f'v{self.vd + self.nf * emul - 1}')
 
 
 @dataclass
@@ -504,6 +529,9 @@ class VssegV:
       v2: B0 B1 B2 ...
       Memory: R0 G0 B0 R1 G1 B1 R2 G2 B2 ...
 
+    With rs2 set this is the strided form vssseg: segment i starts at rs1 + i * x[rs2].
+    Field f comes from register group vs3 + f * EMUL.
+
     Reference: riscv-isa-manual/src/v-st-ext.adoc lines 1758-1888
     """
     vs3: int
@@ -511,10 +539,15 @@ class VssegV:
     vm: int
     element_width: int
     nf: int  # Number of fields (2-8)
+    rs2: int | None = None
 
     def __str__(self):
         vm_str = '' if self.vm else ',v0.t'
-        return f'vsseg{self.nf}e{self.element_width}.v\tv{self.vs3},({reg_name(self.rs1)}){vm_str}'
+        if self.rs2 is None:
+            return (f'vsseg{self.nf}e{self.element_width}.v\tv{self.vs3},'
+                    f'({reg_name(self.rs1)}){vm_str}')
+        return (f'vssseg{self.nf}e{self.element_width}.v\tv{self.vs3},'
+                f'({reg_name(self.rs1)}),{reg_name(self.rs2)}{vm_str}')
 
     async def update_state(self, s: 'Oamlet'):
         span_id = s.monitor.create_span(
@@ -524,9 +557,16 @@ class VssegV:
             mnemonic=str(self),
             pc=s.pc,
         )
-        await s.scalar.wait_all_regs_ready(None, None, [self.rs1], [])
+        addr_regs = [self.rs1] if self.rs2 is None else [self.rs1, self.rs2]
+        await s.scalar.wait_all_regs_ready(None, None, addr_regs, [])
         rs1_bytes = s.scalar.read_reg(self.rs1)
         addr = int.from_bytes(rs1_bytes, byteorder='little', signed=False)
+        element_bytes = self.element_width // 8
+        if self.rs2 is None:
+            stride = self.nf * element_bytes
+        else:
+            rs2_bytes = s.scalar.read_reg(self.rs2)
+            stride = int.from_bytes(rs2_bytes, byteorder='little', signed=True)
         if self.vm:
             mask_reg = None
         else:
@@ -534,12 +574,22 @@ class VssegV:
             await s.ensure_vrf_ordering(mask_reg, 1, span_id, vl=s.vl, vstart=s.vstart)
         logger.debug(f'{s.clock.cycle}: VSSEG{self.nf}E{self.element_width}.V: '
                     f'vs3=v{self.vs3}, addr=0x{addr:x}, vl={s.vl}, nf={self.nf}, '
-                    f'masked={not self.vm}, mask_reg={mask_reg}')
+                    f'stride={stride}, masked={not self.vm}, mask_reg={mask_reg}')
         ordering = addresses.Ordering(s.word_order, self.element_width)
-        await s.vsegstore(self.vs3, addr, ordering, s.vl, mask_reg, s.vstart, self.nf)
+        emul = max(1, (self.element_width * s.lmul) // s.sew)
+        result = await s.vsegstore(
+            self.vs3, addr, ordering, s.vl, mask_reg, s.vstart, self.nf,
+            parent_span_id=span_id, emul=emul, stride_bytes=stride)
+        if s.maybe_trap_vector(
+                result, is_store=True,
+                fault_addr_fallback=addr + (result.element_index or 0) * stride):
+            s.monitor.finalize_children(span_id)
+            return
+        s.vstart = 0
         s.monitor.finalize_children(span_id)
         s.pc += 4
-        logger.debug(f'Stored segment from vs3=v{self.vs3} through v{self.vs3 + self.nf - 1}')
+        logger.debug(f'Stored segment from vs3=v{self.vs3} through '
+                     f'v{self.vs3 + self.nf * emul - 1}')
 
 
 @dataclass
@@ -2336,6 +2386,10 @@ class VIndexedLoad:
     The index width (8/16/32/64) is encoded in the instruction.
     The data width comes from SEW in vtype.
 
+    With nf > 1 this is the segment form vluxseg/vloxseg: field f of segment i is
+    loaded from rs1 + vs2[i] + f * SEW / 8 into register group vd + f * LMUL, issued
+    as one gather per field.
+
     Reference: riscv-isa-manual/src/v-st-ext.adoc lines 1651-1679
     """
     vd: int
@@ -2344,10 +2398,12 @@ class VIndexedLoad:
     vm: int
     index_width: int
     ordered: bool
+    nf: int = 1
 
     def __str__(self):
         vm_str = '' if self.vm else ',v0.t'
-        op = 'vloxei' if self.ordered else 'vluxei'
+        seg = '' if self.nf == 1 else f'seg{self.nf}'
+        op = f'vlox{seg}ei' if self.ordered else f'vlux{seg}ei'
         return f'{op}{self.index_width}.v\tv{self.vd},({reg_name(self.rs1)}),v{self.vs2}{vm_str}'
 
     async def update_state(self, s: 'Oamlet'):
@@ -2372,20 +2428,29 @@ class VIndexedLoad:
         scratch_regs: list[int] | None = None
         index_reg = self.vs2
         if self.vd == self.vs2:
+            assert self.nf == 1, 'segment gathers may not overlap vd with vs2'
             scratch_regs = await _copy_vreg_to_scratch(
                 s, self.vs2, self.index_width, s.vl, span_id)
             index_reg = scratch_regs[0]
 
-        if self.ordered:
-            result = await s.vload_indexed_ordered(
-                self.vd, base_addr, index_reg, self.index_width, data_ew,
-                s.vl, mask_reg, s.vstart, parent_span_id=span_id
-            )
-        else:
-            result = await s.vload_indexed_unordered(
-                self.vd, base_addr, index_reg, self.index_width, data_ew,
-                s.vl, mask_reg, s.vstart, parent_span_id=span_id
-            )
+        # Report the fault with the lowest element index over all fields.
+        result = addresses.VectorOpResult()
+        for field in range(self.nf):
+            field_vd = self.vd + field * s.lmul
+            field_addr = base_addr + field * (data_ew // 8)
+            if self.ordered:
+                field_result = await s.vload_indexed_ordered(
+                    field_vd, field_addr, index_reg, self.index_width, data_ew,
+                    s.vl, mask_reg, s.vstart, parent_span_id=span_id
+                )
+            else:
+                field_result = await s.vload_indexed_unordered(
+                    field_vd, field_addr, index_reg, self.index_width, data_ew,
+                    s.vl, mask_reg, s.vstart, parent_span_id=span_id
+                )
+            if not field_result.success and (
+                    result.success or field_result.element_index < result.element_index):
+                result = field_result
 
         if scratch_regs is not None:
             await s.free_temp_regs(scratch_regs, span_id)
@@ -2408,6 +2473,9 @@ class VIndexedStore:
     The index width (8/16/32/64) is encoded in the instruction.
     The data width comes from SEW in vtype.
 
+    With nf > 1 this is the segment form vsuxseg/vsoxseg, issued as one scatter per
+    field. The first fault is returned, so earlier fields have been stored past it.
+
     Reference: riscv-isa-manual/src/v-st-ext.adoc lines 1651-1679
     """
     vs3: int
@@ -2416,10 +2484,12 @@ class VIndexedStore:
     vm: int
     index_width: int
     ordered: bool
+    nf: int = 1
 
     def __str__(self):
         vm_str = '' if self.vm else ',v0.t'
-        op = 'vsoxei' if self.ordered else 'vsuxei'
+        seg = '' if self.nf == 1 else f'seg{self.nf}'
+        op = f'vsox{seg}ei' if self.ordered else f'vsux{seg}ei'
         return f'{op}{self.index_width}.v\tv{self.vs3},({reg_name(self.rs1)}),v{self.vs2}{vm_str}'
 
     async def update_state(self, s: 'Oamlet'):
@@ -2436,16 +2506,22 @@ class VIndexedStore:
         )
         vsew = (s.vtype >> 3) & 0x7
         data_ew = 8 << vsew
-        if self.ordered:
-            result = await s.vstore_indexed_ordered(
-                self.vs3, base_addr, self.vs2, self.index_width, data_ew,
-                s.vl, mask_reg, s.vstart, parent_span_id=span_id
-            )
-        else:
-            result = await s.vstore_indexed_unordered(
-                self.vs3, base_addr, self.vs2, self.index_width, data_ew,
-                s.vl, mask_reg, s.vstart, parent_span_id=span_id
-            )
+        result = addresses.VectorOpResult()
+        for field in range(self.nf):
+            field_vs3 = self.vs3 + field * s.lmul
+            field_addr = base_addr + field * (data_ew // 8)
+            if self.ordered:
+                result = await s.vstore_indexed_ordered(
+                    field_vs3, field_addr, self.vs2, self.index_width, data_ew,
+                    s.vl, mask_reg, s.vstart, parent_span_id=span_id
+                )
+            else:
+                result = await s.vstore_indexed_unordered(
+                    field_vs3, field_addr, self.vs2, self.index_width, data_ew,
+                    s.vl, mask_reg, s.vstart, parent_span_id=span_id
+                )
+            if not result.success:
+                break
         if s.maybe_trap_vector(result, is_store=True, fault_addr_fallback=base_addr):
             s.monitor.finalize_children(span_id)
             return
@@ -3279,3 +3355,75 @@ class VrgatherVxVi:
         )
         await s.add_to_instruction_buffer(read_kinstr, span_id, src_k)
         s.pc += 4
+
+
+@dataclass
+class VcompressVm:
+    """VCOMPRESS.VM - Pack the vs2 elements selected by mask vs1 into vd.
+
+    vd[j] = vs2[i] where i is the position of the j-th set bit of vs1 in [0, vl).
+    The elements of vd past the number of set bits are tail. The instruction is
+    always unmasked, vstart must be 0 and vd may overlap neither vs2 nor vs1.
+
+    Decomposed at the lamlet. The destination of each source element depends on
+    every mask bit below it, which no single jamlet holds, so the lamlet reads the
+    whole mask (read_mask_bits) and stalls until it arrives. It then issues
+    RegCompress kinstrs that carry the packed source positions.
+
+    Reference: riscv-isa-manual/src/v-st-ext.adoc
+    """
+    vd: int
+    vs2: int
+    vs1: int
+
+    def __str__(self):
+        return f'vcompress.vm\tv{self.vd},v{self.vs2},v{self.vs1}'
+
+    async def update_state(self, s: 'Oamlet'):
+        assert s.vstart == 0, 'vcompress.vm requires vstart == 0'
+
+        span_id = s.monitor.create_span(
+            span_type=SpanType.RISCV_INSTR,
+            component="lamlet",
+            completion_type=CompletionType.FIRE_AND_FORGET,
+            mnemonic=str(self),
+            pc=s.pc,
+        )
+
+        if s.vl == 0:
+            s.monitor.finalize_children(span_id)
+            s.pc += 4
+            return
+
+        vsew = (s.vtype >> 3) & 0x7
+        data_ew = 8 << vsew
+        word_order = s.word_order
+        n_vlines = s.emul_for_eew(data_ew)
+        assert not (self.vd <= self.vs1 < self.vd + n_vlines), \
+            f'vcompress.vm: vd v{self.vd} overlaps vs1 v{self.vs1}'
+        assert not (self.vd < self.vs2 + n_vlines and self.vs2 < self.vd + n_vlines), \
+            f'vcompress.vm: vd v{self.vd} overlaps vs2 v{self.vs2}'
+
+        await s.await_vreg_write_pending(self.vs1, 1)
+        await s.ensure_vrf_ordering(self.vs1, 1, span_id, vl=s.vl, vstart=0)
+        await s.await_vreg_write_pending(self.vs2, n_vlines)
+        await s.ensure_vrf_ordering(self.vs2, data_ew, span_id, vl=s.vl, vstart=0)
+
+        bits = await s.read_mask_bits(self.vs1, s.vl)
+        src_indices = [i for i, bit in enumerate(bits) if bit]
+
+        await s.await_vreg_write_pending(self.vd, n_vlines)
+        await s.set_vrf_ordering_for_write(
+            self.vd, data_ew, 0, len(src_indices),
+            masked=False, emul=n_vlines, span_id=span_id)
+        await s.vcompress(
+            vd=self.vd,
+            vs2=self.vs2,
+            src_indices=src_indices,
+            data_ew=data_ew,
+            word_order=word_order,
+            vlmax=_compute_vlmax(s, data_ew),
+            parent_span_id=span_id,
+        )
+        s.monitor.finalize_children(span_id)
+        s.pc += 4
@@ -229,6 +229,12 @@ class CacheTable:
 
         self.acquiring_slot = False
 
+        # Lines queued by Prefetch kinstrs, oldest first, filled by _issue_prefetches.
+        self.prefetch_lines: deque[KMAddr] = deque()
+        # memory_locs of lines written by non-temporal stores, oldest first, written back
+        # and freed by _issue_write_throughs.
+        self.write_through_lines: deque[int] = deque()
+
     def receive_cache_data_response(self, header: IdentHeader) -> None:
         """Per-jamlet response (READ_LINE_RESP, WRITE_LINE_READ_LINE_RESP)."""
         ident = header.ident
@@ -528,6 +534,11 @@ class CacheTable:
             # For WRITE_LINE_READ_LINE, addr is the OLD address to flush
             request_addr = slot_state.old_memory_loc * self.params.cache_line_bytes
             n_data_to_send = self.params.j_in_k
+        elif slot_state.state == CacheState.MODIFIED:
+            # Only a write-through asks for this; the line stays at its address.
+            request_type = CacheRequestType.WRITE_LINE
+            request_addr = slot_state.memory_loc * self.params.cache_line_bytes
+            n_data_to_send = self.params.j_in_k
         else:
             assert False
         assert self.cache_requests[cache_request_index] is None
@@ -564,6 +575,8 @@ class CacheTable:
             slot_state.state = CacheState.READING
         elif request_type == CacheRequestType.WRITE_LINE_READ_LINE:
             slot_state.state = CacheState.WRITING_READING
+        elif request_type == CacheRequestType.WRITE_LINE:
+            slot_state.state = CacheState.WRITING
 
     def _check_slots(self):
         assert len(self.free_slots) + len(self.used_slots) == self.n_slots
@@ -677,6 +690,20 @@ class CacheTable:
         else:
             return slot
 
+    def _slot_evictable(self, slot: int) -> bool:
+        # No waiting item uses the slot. Prefetch fills and write-throughs run with no
+        # waiting item holding the slot, so a slot with a line request in flight is kept too.
+        if self.slot_in_use(slot):
+            return False
+        return not any(request is not None and request.slot == slot
+                       for request in self.cache_requests)
+
+    def _eviction_order(self) -> List[int]:
+        # Lines written by non-temporal stores go first, oldest first, since they are not
+        # read again. Evicting one merges its write-through with the new line's read.
+        queued = [self._memory_loc_to_slot(loc) for loc in self.write_through_lines]
+        return [slot for slot in queued if slot is not None] + self.used_slots
+
     def _can_get_new_slot(self, k_maddr: KMAddr) -> bool:
         # Block allocation if another slot is writing back this memory_loc
         memory_loc = k_maddr.addr // self.cache_line_bytes
@@ -689,8 +716,7 @@ class CacheTable:
         else:
             for check_slot in self.used_slots:
                 # Check to see if there are any waiting items using this slot.
-                slot_in_use = self.slot_in_use(check_slot)
-                if not slot_in_use:
+                if self._slot_evictable(check_slot):
                     return True
         return False
 
@@ -709,10 +735,9 @@ class CacheTable:
         if self.free_slots:
             slot = self.free_slots.popleft()
         else:
-            for check_slot in self.used_slots:
+            for check_slot in self._eviction_order():
                 # Check to see if there are any waiting items using this slot.
-                slot_in_use = self.slot_in_use(check_slot)
-                if not slot_in_use:
+                if self._slot_evictable(check_slot):
                     slot = check_slot
                     self.used_slots.remove(slot)
                     break
@@ -762,7 +787,9 @@ class CacheTable:
         return slot
 
     def addr_to_slot(self, k_maddr):
-        memory_loc = k_maddr.addr // self.params.cache_line_bytes
+        return self._memory_loc_to_slot(k_maddr.addr // self.params.cache_line_bytes)
+
+    def _memory_loc_to_slot(self, memory_loc: int):
         matching_slots = []
         for slot, slot_state in enumerate(self.slot_states):
             if slot_state.memory_loc == memory_loc:
@@ -834,7 +861,16 @@ class CacheTable:
         self.cache_requests[request.ident] = None
         state = self.slot_states[request.slot]
         assert state.state == CacheState.WRITING
-        state.state = CacheState.INVALID
+        if self.slot_in_use(request.slot):
+            # A witem arrived for the line while it was written; it reads it back.
+            state.state = CacheState.INVALID
+        else:
+            state.state = CacheState.UNALLOCATED
+            state.memory_loc = None
+            state.old_memory_loc = None
+            self.used_slots.remove(request.slot)
+            self.free_slots.append(request.slot)
+            self._check_slots()
         self.monitor.record_cache_request_completed(
             self.kamlet_x, self.kamlet_y, request.slot)
 
@@ -874,6 +910,72 @@ class CacheTable:
                             )
                             await self.update_cache(slot, witem=witem)
 
+    def queue_prefetch(self, lines: List[KMAddr]) -> None:
+        """Queue fills for the cache lines at `lines`, in order.
+
+        The queue holds at most n_slots lines, since a longer prefetch would evict its own
+        first lines; the excess is dropped, which is safe because a prefetch is a hint.
+        """
+        room = self.n_slots - len(self.prefetch_lines)
+        self.prefetch_lines.extend(lines[:max(room, 0)])
+
+    async def _issue_prefetches(self) -> None:
+        """
+        Starts a READ_LINE (or WRITE_LINE_READ_LINE, when the victim is dirty) for one
+        queued prefetch line per cycle. Lines already in the cache are dropped. The head
+        line waits while no cache request or evictable slot is free.
+        """
+        while True:
+            await self.clock.next_cycle
+            while self.prefetch_lines:
+                k_maddr = self.prefetch_lines[0]
+                if self.addr_to_slot(k_maddr) is not None:
+                    self.prefetch_lines.popleft()
+                    continue
+                if self.acquiring_slot or not self.can_get_free_cache_request():
+                    break
+                slot = self._get_new_slot_if_exists(k_maddr)
+                if slot is None:
+                    break
+                self.prefetch_lines.popleft()
+                logger.debug(
+                    f'{self.clock.cycle}: {self.name}: prefetch '
+                    f'memory_loc=0x{self.slot_states[slot].memory_loc:x} slot={slot}')
+                await self.update_cache(slot)
+                break
+
+    def queue_write_through(self, slot: int) -> None:
+        """Queue the line in `slot`, just written by a non-temporal store, for a write-back
+        that frees the slot. A line queued again moves to the back."""
+        memory_loc = self.slot_states[slot].memory_loc
+        if memory_loc in self.write_through_lines:
+            self.write_through_lines.remove(memory_loc)
+        self.write_through_lines.append(memory_loc)
+
+    async def _issue_write_throughs(self) -> None:
+        """
+        Starts a WRITE_LINE for the oldest queued non-temporal line, one per cycle. The
+        newest line stays, since the stream's next stores usually still land in it. Lines
+        no longer modified (evicted, or written back already) and lines a witem is using
+        again are dropped.
+        """
+        while True:
+            await self.clock.next_cycle
+            while len(self.write_through_lines) > 1:
+                slot = self._memory_loc_to_slot(self.write_through_lines[0])
+                if (slot is None or self.slot_states[slot].state != CacheState.MODIFIED
+                        or self.slot_in_use(slot)):
+                    self.write_through_lines.popleft()
+                    continue
+                if not self.can_get_free_cache_request():
+                    break
+                self.write_through_lines.popleft()
+                logger.debug(
+                    f'{self.clock.cycle}: {self.name}: write-through '
+                    f'memory_loc=0x{self.slot_states[slot].memory_loc:x} slot={slot}')
+                await self.update_cache(slot)
+                break
+
     async def _monitor_cache_responses(self):
         """
         Check to see if any of the open cache requests have received all of their responses.
@@ -901,6 +1003,8 @@ class CacheTable:
     async def run(self):
         self.clock.create_task(self._monitor_cache_responses())
         self.clock.create_task(self._monitor_items())
+        self.clock.create_task(self._issue_prefetches())
+        self.clock.create_task(self._issue_write_throughs())
 
     def update(self):
         for index, state in enumerate(self.cache_requests):
@@ -705,6 +705,8 @@ class Kamlet:
 
     async def handle_item(self, witem: WaitingItem) -> None:
         await witem.finalize(self)
+        if witem.nontemporal:
+            self.cache_table.queue_write_through(witem.cache_slot)
         source_x, source_y = None, None
         if witem.source is not None:
             source_x, source_y = witem.source
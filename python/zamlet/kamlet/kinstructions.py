@@ -13,6 +13,7 @@ Send             src (6 bit)    target (6 bit) mask (5 bit)  length (3)  =  26 b
 
 import copy
 import logging
+import math
 import struct
 from dataclasses import dataclass, field
 from enum import Enum, IntEnum
@@ -80,6 +81,9 @@ class VUnaryOp(Enum):
     FCVT_F_X = "f.x"
     FCVT_RTZ_XU_F = "rtz.xu.f"
     FCVT_RTZ_X_F = "rtz.x.f"
+    FSQRT = "fsqrt"
+    FRSQRT7 = "frsqrt7"
+    FREC7 = "frec7"
 
 
 class VCmpOp(Enum):
@@ -346,6 +350,32 @@ class Marker(KInstr):
         return None
 
 
+@dataclass
+class Prefetch(KInstr):
+    """Start filling the cache lines of kamlet memory [k_addr, k_addr + n_bytes).
+
+    Broadcast: every kamlet holds the same k-local range of the prefetched vlines. Admit
+    hands the lines to the cache table, which issues the fills in the background, and
+    returns None, so later instructions never wait on it.
+    """
+    k_addr: int
+    n_bytes: int
+    instr_ident: int
+
+    async def admit(self, kamlet) -> 'Prefetch | None':
+        line_bytes = kamlet.params.cache_line_bytes
+        first_line = self.k_addr // line_bytes
+        end_line = (self.k_addr + self.n_bytes + line_bytes - 1) // line_bytes
+        # Slot lookup only uses the address; a line holds vlines of any ordering.
+        kamlet.cache_table.queue_prefetch([
+            KMAddr(k_index=kamlet.k_index, ordering=None,
+                   bit_addr=line * line_bytes * 8, params=kamlet.params)
+            for line in range(first_line, end_line)])
+        kamlet.monitor.finalize_kinstr_exec(
+            self.instr_ident, kamlet.min_x, kamlet.min_y)
+        return None
+
+
 @dataclass
 class FreeRegister(KInstr):
     """Release the rename-table entry for an architectural register.
@@ -1386,10 +1416,72 @@ class VUnaryOvOp(KInstr):
             float_fmt = {8: 'd', 4: 'f'}[dst_eb]
             sint_val = struct.unpack(sint_fmt, src_bytes)[0]
             return struct.pack(float_fmt, float(sint_val))
+        elif self.op in (VUnaryOp.FSQRT, VUnaryOp.FRSQRT7, VUnaryOp.FREC7):
+            assert src_eb == dst_eb
+            float_fmt = {8: '<d', 4: '<f'}[src_eb]
+            float_val = struct.unpack(float_fmt, src_bytes)[0]
+            if self.op == VUnaryOp.FSQRT:
+                result = float('nan') if float_val < 0 else math.sqrt(float_val)
+            elif self.op == VUnaryOp.FRSQRT7:
+                result = _frsqrt7(float_val)
+            else:
+                result = _frec7(float_val)
+            float_max = {8: 1.7976931348623157e308, 4: 3.4028234663852886e38}[dst_eb]
+            if abs(result) > float_max:
+                result = math.copysign(math.inf, result)
+            return struct.pack(float_fmt, result)
         else:
             raise NotImplementedError(f"Unknown VUnaryOp: {self.op}")
 
 
+def _estimate_7(x: float, sqrt: bool) -> tuple[int, int]:
+    """The 7-bit table lookup shared by vfrec7 and vfrsqrt7 on a finite positive x.
+
+    Returns (exp, frac) with x = sig * 2**exp and frac the 7-bit fraction of the
+    estimate's significand. For the reciprocal sig is in [1, 2), 128 buckets split it
+    and the estimate is 2 / sig. For the square root exp is made even and sig is in
+    [1, 4); the exponent parity picks a half of the table, 64 buckets split each
+    octave and the estimate is 2 / sqrt(sig). Each bucket's estimate is the value at
+    its midpoint, rounded to the nearest 7-bit fraction.
+    """
+    m, e = math.frexp(x)
+    sig, exp = 2 * m, e - 1
+    if sqrt:
+        if exp % 2:
+            sig, exp = 2 * sig, exp - 1
+        step = (1 if sig < 2 else 2) / 64
+        est = 2 / math.sqrt((math.floor(sig / step) + 0.5) * step)
+    else:
+        est = 2 / (1 + (math.floor((sig - 1) * 128) + 0.5) / 128)
+    return exp, min(127, round((est - 1) * 128))
+
+
+def _frec7(x: float) -> float:
+    """vfrec7.v: 1 / x to 7 bits of significand."""
+    if math.isnan(x):
+        return x
+    if x == 0:
+        return math.copysign(math.inf, x)
+    if math.isinf(x):
+        return math.copysign(0.0, x)
+    exp, frac = _estimate_7(abs(x), sqrt=False)
+    if -exp - 1 > 1023:
+        return math.copysign(math.inf, x)
+    return math.copysign(math.ldexp(1 + frac / 128, -exp - 1), x)
+
+
+def _frsqrt7(x: float) -> float:
+    """vfrsqrt7.v: 1 / sqrt(x) to 7 bits of significand."""
+    if math.isnan(x) or (x < 0):
+        return float('nan')
+    if x == 0:
+        return math.copysign(math.inf, x)
+    if math.isinf(x):
+        return 0.0
+    exp, frac = _estimate_7(x, sqrt=True)
+    return math.ldexp(1 + frac / 128, -exp // 2 - 1)
+
+
 @dataclass
 class ReadRegWord(TrackedKInstr):
     """Read a word from the register file and send it back to the lamlet."""
@@ -3,10 +3,11 @@
 #include <stdlib.h>
 
 volatile int64_t *vpu_mem64 = (volatile int64_t *)0x90000000;
-volatile int32_t *vpu_mem32 = (volatile int32_t *)0x90080000;
 volatile int32_t skip_verify = 0;
 volatile int32_t n = 0;
 volatile int32_t reverse_bits = 0;
+// Register group size of the reorder loop: 1, 2, 4 or 8.
+volatile int32_t lmul = 1;
 
 static inline size_t get_vl_e64(void) {
     size_t vl;
@@ -36,22 +37,19 @@ static inline int count_bits(size_t val) {
     return bits;
 }
 
-void compute_indices(size_t n, size_t vl, uint32_t* read_idx,
-                     uint32_t* write_idx, int reverse_bits);
-void bitreverse_reorder64(size_t n, const int64_t* src, int64_t* dst,
-                          const uint64_t* read_idx,
-                          const uint64_t* write_idx);
+void compute_indices64(size_t n, size_t vl, uint64_t* read_idx,
+                       uint64_t* write_idx, int reverse_bits);
+void bitreverse_reorder64_lmul(size_t n, const int64_t* src, int64_t* dst,
+                               const uint64_t* read_idx,
+                               const uint64_t* write_idx, unsigned lmul);
 
 int main() {
     size_t vl_e32 = get_vl_e32();
     int n_bits = reverse_bits ? (int)reverse_bits : count_bits(n);
 
-    // e64 data in vpu_mem64, e32 indices in vpu_mem32.
-    // 64-bit widened/scaled indices live in vpu_mem64 after dst.
+    // e64 data in vpu_mem64; 64-bit byte-offset indices live after dst.
     int64_t* src = (int64_t*)&vpu_mem64[0];
     int64_t* dst = (int64_t*)&vpu_mem64[n];
-    uint32_t* read_idx32 = (uint32_t*)&vpu_mem32[0];
-    uint32_t* write_idx32 = (uint32_t*)&vpu_mem32[n];
     uint64_t* read_idx = (uint64_t*)&vpu_mem64[2 * n];
     uint64_t* write_idx = (uint64_t*)&vpu_mem64[3 * n];
 
@@ -100,16 +98,9 @@ int main() {
         }
     }
 
-    compute_indices(n, vl_e32, read_idx32, write_idx32, n_bits);
+    compute_indices64(n, vl_e32, read_idx, write_idx, n_bits);
 
-    // Widen 32-bit element indices to 64-bit byte offsets (*8 for e64).
-    // Scalar loop — outside the timed kernel region, so simplicity wins.
-    for (size_t i = 0; i < (size_t)n; i++) {
-        read_idx[i]  = ((uint64_t)read_idx32[i])  << 3;
-        write_idx[i] = ((uint64_t)write_idx32[i]) << 3;
-    }
-
-    bitreverse_reorder64(n, src, dst, read_idx, write_idx);
+    bitreverse_reorder64_lmul(n, src, dst, read_idx, write_idx, lmul);
 
     if (!skip_verify) {
         for (size_t i = 0; i < (size_t)n; i++) {
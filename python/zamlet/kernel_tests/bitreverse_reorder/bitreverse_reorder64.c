@@ -9,39 +9,62 @@
  * scatter. The kamlet register rename lets iterations pipeline across the
  * gather/scatter even though every iteration reuses the same architectural
  * destination registers.
+ *
+ * bitreverse_reorder64_lmul runs the same loop on register groups of lmul = 1, 2, 4
+ * or 8 registers, for fewer and longer gathers per pass; any other lmul fails the
+ * assert. bitreverse_reorder64 is the lmul = 1 form.
  */
 
 #include <stddef.h>
 #include <stdint.h>
+#include <assert.h>
 #include <riscv_vector.h>
 #include "zamlet_custom.h"
 
-void bitreverse_reorder64(size_t n,
-                          const int64_t* __restrict__ src,
-                          int64_t* __restrict__ dst,
-                          const uint64_t* __restrict__ read_idx,
-                          const uint64_t* __restrict__ write_idx) {
+#define REORDER64_STRIPS(LM)                                                     \
+    for (size_t avl = n; avl > 0; ) {                                            \
+        size_t vl = __riscv_vsetvl_e64##LM(avl);                                 \
+        vuint64##LM##_t ri = __riscv_vle64_v_u64##LM(read_idx, vl);              \
+        vuint64##LM##_t wi = __riscv_vle64_v_u64##LM(write_idx, vl);             \
+        vint64##LM##_t data = __riscv_vluxei64_v_i64##LM(src, ri, vl);           \
+        __riscv_vsuxei64_v_i64##LM(dst, wi, data, vl);                           \
+        read_idx += vl;                                                          \
+        write_idx += vl;                                                         \
+        avl -= vl;                                                               \
+    }
+
+void bitreverse_reorder64_lmul(size_t n,
+                               const int64_t* __restrict__ src,
+                               int64_t* __restrict__ dst,
+                               const uint64_t* __restrict__ read_idx,
+                               const uint64_t* __restrict__ write_idx,
+                               unsigned lmul) {
+    assert(lmul == 1 || lmul == 2 || lmul == 4 || lmul == 8);
     if (n == 0) return;
 
     // Bound indexed byte offsets to the minimum range that covers [0, n*8).
     // Lets the lamlet pre-check all pages in that range and skip per-element
     // fault detection. Largest element index is n-1, so the largest byte
     // offset the gather/scatter will use is (n-1)*8 < n*8.
-    unsigned bits = 64 - __builtin_clzl((unsigned long)(n * sizeof(int64_t)) - 1UL);
+    unsigned bits = zamlet_index_bound_bits(n * sizeof(int64_t));
     zamlet_set_index_bound(bits);
     zamlet_begin_writeset();
 
-    for (size_t avl = n; avl > 0; ) {
-        size_t vl = __riscv_vsetvl_e64m1(avl);
-        vuint64m1_t ri = __riscv_vle64_v_u64m1(read_idx, vl);
-        vuint64m1_t wi = __riscv_vle64_v_u64m1(write_idx, vl);
-        vint64m1_t data = __riscv_vluxei64_v_i64m1(src, ri, vl);
-        __riscv_vsuxei64_v_i64m1(dst, wi, data, vl);
-        read_idx += vl;
-        write_idx += vl;
-        avl -= vl;
+    switch (lmul) {
+    case 8: REORDER64_STRIPS(m8) break;
+    case 4: REORDER64_STRIPS(m4) break;
+    case 2: REORDER64_STRIPS(m2) break;
+    case 1: REORDER64_STRIPS(m1) break;
     }
 
     zamlet_end_writeset();
     zamlet_set_index_bound(0);
 }
+
+void bitreverse_reorder64(size_t n,
+                          const int64_t* __restrict__ src,
+                          int64_t* __restrict__ dst,
+                          const uint64_t* __restrict__ read_idx,
+                          const uint64_t* __restrict__ write_idx) {
+    bitreverse_reorder64_lmul(n, src, dst, read_idx, write_idx, 1);
+}
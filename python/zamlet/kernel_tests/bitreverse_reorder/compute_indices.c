@@ -1,6 +1,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <riscv_vector.h>
 
 void bitreverse_vec(size_t n, uint32_t* src, uint32_t* dst, int reverse_bits);
 
@@ -125,3 +126,89 @@ void compute_indices(size_t n, size_t vl, uint32_t* read_idx, uint32_t* write_id
         //printf("  write_idx[%d] = %d\n", i, write_idx[i]);
     }
 }
+
+// Reverse the lower reverse_bits bits of each lane, preserving the upper bits
+// (the e64 counterpart of bitreverse_vec).
+static inline vuint64m2_t bitreverse_lanes64(vuint64m2_t x, int reverse_bits, size_t vl) {
+    if (reverse_bits == 0) return x;
+    uint64_t lower_mask = (reverse_bits == 64) ? ~0ULL : ((1ULL << reverse_bits) - 1);
+    vuint64m2_t r = __riscv_vand_vx_u64m2(x, lower_mask, vl);
+    static const uint64_t masks[5] = {
+        0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+        0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL,
+    };
+    for (int stage = 0; stage < 5; stage++) {
+        size_t sh = (size_t)1 << stage;
+        vuint64m2_t lo = __riscv_vand_vx_u64m2(r, masks[stage], vl);
+        vuint64m2_t hi = __riscv_vand_vx_u64m2(__riscv_vsrl_vx_u64m2(r, sh, vl),
+                                               masks[stage], vl);
+        r = __riscv_vor_vv_u64m2(__riscv_vsll_vx_u64m2(lo, sh, vl), hi, vl);
+    }
+    r = __riscv_vor_vv_u64m2(__riscv_vsll_vx_u64m2(r, 32, vl),
+                             __riscv_vsrl_vx_u64m2(r, 32, vl), vl);
+    r = __riscv_vsrl_vx_u64m2(r, 64 - reverse_bits, vl);
+    return __riscv_vor_vv_u64m2(
+        r, __riscv_vand_vx_u64m2(x, ~lower_mask, vl), vl);
+}
+
+// Same permutation as compute_indices, emitted directly as e64 byte offsets
+// (element index << 3) for 64-bit indexed gathers and scatters, so callers
+// need no widening pass. vl is the block size compute_indices would be given
+// (its e32 m1 vl); the blocks are built at e64 m2, which holds the same
+// number of elements.
+void compute_indices64(size_t n, size_t vl, uint64_t* read_idx, uint64_t* write_idx,
+                       int reverse_bits) {
+    if (vl > n) vl = n;
+    vl = __riscv_vsetvl_e64m2(vl);
+
+    int clog2_n = clog2(n);
+    size_t stride = n / vl;
+    size_t n_cycles = n / vl;
+    vuint64m2_t vid = __riscv_vid_v_u64m2(vl);
+
+    // Per-algorithm loop invariants, matching compute_indices:
+    //   sequential: read = vid + cycle·vl
+    //   algo A:     read = vid·stride + ((vid + offset(cycle)) & (stride - 1))
+    //   algo B:     read = base + ((v9 + cycle) & (vl - 1))
+    int sequential = (1 << reverse_bits) <= (int)vl;
+    int use_algo_a = (n >= vl * vl);
+    size_t middle_size = stride / vl;
+    vuint64m2_t base, v9;
+    uint64_t cycle_mask;
+    if (sequential) {
+        base = vid;
+        v9 = vid;
+        cycle_mask = 0;
+    } else if (use_algo_a) {
+        base = __riscv_vmul_vx_u64m2(vid, stride, vl);
+        v9 = vid;
+        cycle_mask = stride - 1;
+    } else {
+        int log2_section_size = 2 * clog2(vl) - clog2_n;
+        uint64_t section_mask = ((uint64_t)1 << log2_section_size) - 1;
+        vuint64m2_t hi = __riscv_vsrl_vx_u64m2(vid, log2_section_size, vl);
+        base = __riscv_vmul_vx_u64m2(hi, vl, vl);
+        v9 = __riscv_vadd_vv_u64m2(
+            __riscv_vmul_vx_u64m2(__riscv_vand_vx_u64m2(vid, section_mask, vl), stride, vl),
+            hi, vl);
+        cycle_mask = vl - 1;
+    }
+
+    for (size_t cycle = 0; cycle < n_cycles; cycle++) {
+        vuint64m2_t rd;
+        if (sequential) {
+            rd = __riscv_vadd_vx_u64m2(base, cycle * vl, vl);
+        } else {
+            size_t offset = use_algo_a ? cycle * vl + cycle / middle_size : cycle;
+            rd = __riscv_vadd_vv_u64m2(
+                base,
+                __riscv_vand_vx_u64m2(__riscv_vadd_vx_u64m2(v9, offset, vl),
+                                      cycle_mask, vl), vl);
+        }
+        vuint64m2_t wr = bitreverse_lanes64(rd, reverse_bits, vl);
+        __riscv_vse64_v_u64m2(read_idx, __riscv_vsll_vx_u64m2(rd, 3, vl), vl);
+        __riscv_vse64_v_u64m2(write_idx, __riscv_vsll_vx_u64m2(wr, 3, vl), vl);
+        read_idx += vl;
+        write_idx += vl;
+    }
+}
@@ -0,0 +1,79 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "vpu_alloc.h"
+
+// Checks compute_indices64 against compute_indices on the same n, vl and
+// reverse_bits: read_idx must be a permutation of 0..n-1, write_idx the lower
+// reverse_bits of each read index reversed, and both the e32 indices times 8.
+volatile int32_t n = 0;
+volatile int32_t reverse_bits = 0;
+
+#define MAX_N 4096
+
+static uint8_t seen[MAX_N];
+
+static inline size_t get_vl_e32(void) {
+    size_t vl;
+    asm volatile ("vsetvli %0, %1, e32, m1, ta, ma" : "=r"(vl) : "r"(1024));
+    return vl;
+}
+
+static inline uint32_t bitreverse(uint32_t value, int n_bits) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < n_bits; i++) {
+        if (value & (1 << i)) {
+            reversed |= (1 << (n_bits - 1 - i));
+        }
+    }
+    return reversed;
+}
+
+static inline int count_bits(size_t val) {
+    int bits = 0;
+    while (val > 1) { val >>= 1; bits++; }
+    return bits;
+}
+
+void compute_indices(size_t n, size_t vl, uint32_t* read_idx, uint32_t* write_idx,
+                     int reverse_bits);
+void compute_indices64(size_t n, size_t vl, uint64_t* read_idx,
+                       uint64_t* write_idx, int reverse_bits);
+
+int main() {
+    if (n <= 0 || n > MAX_N || (n & (n - 1)) != 0) {
+        exit(0x01);
+    }
+    size_t vl_e32 = get_vl_e32();
+    int n_bits = reverse_bits ? (int)reverse_bits : count_bits(n);
+    uint32_t mask = ((uint32_t)1 << n_bits) - 1;
+
+    uint32_t* read32 = vpu_alloc_ew(n * sizeof(uint32_t), 32);
+    uint32_t* write32 = vpu_alloc_ew(n * sizeof(uint32_t), 32);
+    uint64_t* read64 = vpu_alloc_ew(n * sizeof(uint64_t), 64);
+    uint64_t* write64 = vpu_alloc_ew(n * sizeof(uint64_t), 64);
+
+    compute_indices(n, vl_e32, read32, write32, n_bits);
+    compute_indices64(n, vl_e32, read64, write64, n_bits);
+
+    for (size_t i = 0; i < (size_t)n; i++) {
+        uint64_t r = read64[i];
+        uint64_t w = write64[i];
+        uint32_t idx = (uint32_t)(r >> 3);
+        // Byte offsets of distinct in-range elements.
+        if ((r & 7) || idx >= (uint32_t)n || seen[idx]) {
+            exit((i << 8) | 0x80);
+        }
+        seen[idx] = 1;
+        uint32_t want = (idx & ~mask) | bitreverse(idx & mask, n_bits);
+        if (w != (uint64_t)want << 3) {
+            exit((i << 8) | 0x81);
+        }
+        if (r != (uint64_t)read32[i] << 3 || w != (uint64_t)write32[i] << 3) {
+            exit((i << 8) | 0x82);
+        }
+    }
+
+    exit(0);
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Working-set sweep in the style of lmbench's bw_mem / lat_mem_rd. For each working set
+ * of 256 bytes, 512 bytes and so on up to wset_max_bytes, one untimed pass brings it in
+ * and wset_passes timed passes then load it again, one e64 element every
+ * wset_stride_bytes (vle64 when that is 8, vlse64 otherwise). Each size is a bench
+ * region wset_<bytes> and a line of cycles per byte of the working set swept, so the
+ * step where the working set stops fitting in the kamlet caches (jamlet_sram_bytes per
+ * jamlet) and the bandwidth on either side of it are recorded for every geometry the test
+ * runs on.
+ *
+ * The buffer is all ones, so the sum of the loaded elements checks that every pass
+ * covered its working set. It comes from the general VPU pool (vpu_alloc.h), which
+ * bounds wset_max_bytes at WSET_MAX_BYTES.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "vinit.h"
+
+#define WSET_MIN_BYTES 256
+// Half the 1 MiB pool.
+#define WSET_MAX_BYTES (512 * 1024)
+
+// kernel_test overrides these through symbol_values.
+volatile int32_t wset_max_bytes = 16 * 1024;
+volatile int32_t wset_stride_bytes = 8;
+volatile int32_t wset_passes = 2;
+
+// Adds the n elements at buf, stride bytes apart, to the lanes of acc.
+static vuint64m8_t wset_pass(vuint64m8_t acc, const uint64_t* buf, size_t n, long stride) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        vuint64m8_t v = stride == sizeof(uint64_t)
+            ? __riscv_vle64_v_u64m8(&buf[i], vl)
+            : __riscv_vlse64_v_u64m8(&buf[i * (stride / sizeof(uint64_t))], stride, vl);
+        acc = __riscv_vadd_vv_u64m8_tu(acc, acc, v, vl);
+        i += vl;
+    }
+    return acc;
+}
+
+static uint64_t sum_lanes(vuint64m8_t acc) {
+    size_t vlmax = __riscv_vsetvlmax_e64m8();
+    vuint64m1_t zero = __riscv_vmv_v_x_u64m1(0, 1);
+    return __riscv_vmv_x_s_u64m1_u64(__riscv_vredsum_vs_u64m8_u64m1(acc, zero, vlmax));
+}
+
+static char region[32];
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    size_t max_bytes = wset_max_bytes;
+    long stride = wset_stride_bytes;
+    int passes = wset_passes;
+    if (max_bytes < WSET_MIN_BYTES || max_bytes > WSET_MAX_BYTES) {
+        printf("FAIL need %d <= wset_max_bytes <= %d\n", WSET_MIN_BYTES, WSET_MAX_BYTES);
+        return 1;
+    }
+    if (stride < 8 || stride % 8 != 0 || stride > WSET_MIN_BYTES) {
+        printf("FAIL wset_stride_bytes must be a multiple of 8 in [8, %d]\n",
+               WSET_MIN_BYTES);
+        return 1;
+    }
+    if (passes < 1) {
+        printf("FAIL need wset_passes >= 1\n");
+        return 1;
+    }
+    printf("wset sweep %d .. %zu bytes, stride %ld, %d passes\n", WSET_MIN_BYTES, max_bytes,
+           stride, passes);
+
+    uint64_t* buf = vpu_alloc(max_bytes);
+    vinit_fill_u64(buf, max_bytes / sizeof(uint64_t), 1);
+
+    for (size_t bytes = WSET_MIN_BYTES; bytes <= max_bytes; bytes *= 2) {
+        size_t n = bytes / stride;
+        vuint64m8_t acc = __riscv_vmv_v_x_u64m8(0, __riscv_vsetvlmax_e64m8());
+        acc = wset_pass(acc, buf, n, stride);
+
+        sprintf(region, "wset_%zu", bytes);
+        unsigned long start = bench_timed_begin(region);
+        for (int p = 0; p < passes; p++)
+            acc = wset_pass(acc, buf, n, stride);
+        unsigned long cycles = bench_timed_end(start);
+
+        uint64_t sum = sum_lanes(acc);
+        if (sum != (uint64_t)(passes + 1) * n) {
+            printf("FAIL %zu bytes: sum %lu, expected %lu\n", bytes, (unsigned long)sum,
+                   (unsigned long)((passes + 1) * n));
+            return 1;
+        }
+        unsigned long swept = (unsigned long)passes * bytes;
+        printf("%zu bytes: %lu cycles, " BENCH_RATE_FMT " cycles/byte\n", bytes, cycles,
+               BENCH_RATE(cycles, swept));
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
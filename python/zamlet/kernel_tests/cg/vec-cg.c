@@ -0,0 +1,323 @@
+/*
+ * Conjugate gradient on the 5-point stencil of a cg_grid x cg_grid grid, with CG_DIAG on
+ * the diagonal so the matrix is symmetric positive definite with eigenvalues in (2, 10).
+ * Each solve starts from x = 0 with b[i] = i / 2 + 1 and runs exactly cg_iters
+ * iterations of
+ *
+ *   ap = A p                 spmv_csr_idx32 (common/ara/spmv.c)
+ *   alpha = rr / (p . ap)    fdotp_v64b (common/ara/fdotproduct.c)
+ *   x += alpha p, r -= alpha ap
+ *   rr' = r . r
+ *   p = r + (rr' / rr) p
+ *
+ * cg_unfused does the two updates as axpy passes and rr' as another fdotp_v64b, which
+ * reads r twice more after it is stored. cg_fused does both updates in one sweep that
+ * also accumulates r . r per lane and reduces once at the end, so each iteration makes
+ * two fewer passes over r and waits on one reduction fewer. The axpy, xpay and fused
+ * sweeps all run at e64m4. The fdotp_v64b calls run at e64m8 in both variants, and
+ * cg_unfused makes one more of them per iteration.
+ *
+ * With cg_phases set, each phase of each iteration is also a bench region of its own:
+ * cg_spmv, cg_pap, cg_update, cg_rr and cg_xpay, with cg_fused_update in place of
+ * cg_update and cg_rr. bench_begin and bench_end fence, so the phases stop overlapping;
+ * cg_phases = 0 gives the totals without them.
+ *
+ * The matrix is built by scalar stores in CSR form, column indices as byte offsets. A
+ * scalar CG on the same stencil in scalar memory gives the expected rr of every
+ * iteration, and each solve ends by checking |A x - b|^2 against its last rr.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "vinit.h"
+#include "ara/spmv.h"
+#include "ara/fdotproduct.h"
+
+#define CG_MIN_GRID 8
+#define CG_MAX_GRID 32
+#define CG_MAX_N (CG_MAX_GRID * CG_MAX_GRID)
+#define CG_MAX_NNZ (5 * CG_MAX_N)
+#define CG_MAX_ITERS 32
+#define CG_DIAG 6.0
+#define CG_B_SCALE 0.5
+
+// kernel_test overrides these through symbol_values.
+volatile int32_t cg_grid = 8;
+volatile int32_t cg_iters = 8;
+volatile int32_t cg_phases = 1;
+
+static int32_t cg_prow[CG_MAX_N + 1];
+static int32_t cg_index[CG_MAX_NNZ] __attribute__((section(".bss.vpu32")));
+static double cg_data[CG_MAX_NNZ] __attribute__((section(".bss.vpu64")));
+
+static double ref_x[CG_MAX_N];
+static double ref_r[CG_MAX_N];
+static double ref_p[CG_MAX_N];
+static double ref_ap[CG_MAX_N];
+// rr before each iteration of the scalar CG, and after the last.
+static double rr_want[CG_MAX_ITERS + 1];
+
+typedef struct {
+    size_t n;
+    double* b;
+    double* x;
+    double* r;
+    double* p;
+    double* ap;
+} cg_vectors;
+
+static int phases;
+
+static void phase_begin(const char* name) {
+    if (phases)
+        bench_begin(name);
+}
+
+static void phase_end(void) {
+    if (phases)
+        bench_end();
+}
+
+static int32_t add_entry(int32_t k, int32_t col, double value) {
+    cg_index[k] = col * (int32_t)sizeof(double);
+    cg_data[k] = value;
+    return k + 1;
+}
+
+// Fills the CSR arrays with the stencil, columns in ascending order, and returns nnz.
+static int32_t build_matrix(int32_t g) {
+    int32_t k = 0;
+    for (int32_t row = 0; row < g * g; row++) {
+        int32_t y = row / g;
+        int32_t x = row % g;
+        cg_prow[row] = k;
+        if (y > 0)
+            k = add_entry(k, row - g, -1.0);
+        if (x > 0)
+            k = add_entry(k, row - 1, -1.0);
+        k = add_entry(k, row, CG_DIAG);
+        if (x < g - 1)
+            k = add_entry(k, row + 1, -1.0);
+        if (y < g - 1)
+            k = add_entry(k, row + g, -1.0);
+    }
+    cg_prow[g * g] = k;
+    return k;
+}
+
+static void ref_apply(int32_t g, const double* p, double* ap) {
+    for (int32_t row = 0; row < g * g; row++) {
+        int32_t y = row / g;
+        int32_t x = row % g;
+        double s = CG_DIAG * p[row];
+        if (y > 0)
+            s -= p[row - g];
+        if (x > 0)
+            s -= p[row - 1];
+        if (x < g - 1)
+            s -= p[row + 1];
+        if (y < g - 1)
+            s -= p[row + g];
+        ap[row] = s;
+    }
+}
+
+static double ref_dot(const double* a, const double* b, size_t n) {
+    double s = 0.0;
+    for (size_t i = 0; i < n; i++)
+        s += a[i] * b[i];
+    return s;
+}
+
+static void ref_cg(int32_t g, long iters) {
+    size_t n = (size_t)(g * g);
+    for (size_t i = 0; i < n; i++) {
+        ref_x[i] = 0.0;
+        ref_r[i] = CG_B_SCALE * (double)i + 1.0;
+        ref_p[i] = ref_r[i];
+    }
+    rr_want[0] = ref_dot(ref_r, ref_r, n);
+    for (long k = 0; k < iters; k++) {
+        ref_apply(g, ref_p, ref_ap);
+        double alpha = rr_want[k] / ref_dot(ref_p, ref_ap, n);
+        for (size_t i = 0; i < n; i++) {
+            ref_x[i] += alpha * ref_p[i];
+            ref_r[i] -= alpha * ref_ap[i];
+        }
+        rr_want[k + 1] = ref_dot(ref_r, ref_r, n);
+        double beta = rr_want[k + 1] / rr_want[k];
+        for (size_t i = 0; i < n; i++)
+            ref_p[i] = ref_r[i] + beta * ref_p[i];
+    }
+}
+
+// y += a x, the form of axpy_intrinsics (daxpy/vec-daxpy_main.c) at e64m4 like
+// cg_update_fused, so the two variants differ only in the fusion.
+static void cg_axpy(double a, const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m4(n - i);
+        vfloat64m4_t v_x = __riscv_vle64_v_f64m4(&x[i], vl);
+        vfloat64m4_t v_y = __riscv_vle64_v_f64m4(&y[i], vl);
+        __riscv_vse64_v_f64m4(&y[i], __riscv_vfmacc_vf_f64m4(v_y, a, v_x, vl), vl);
+        i += vl;
+    }
+}
+
+// p = r + beta p.
+static void cg_xpay(const double* r, double beta, double* p, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m4(n - i);
+        vfloat64m4_t v_r = __riscv_vle64_v_f64m4(&r[i], vl);
+        vfloat64m4_t v_p = __riscv_vle64_v_f64m4(&p[i], vl);
+        __riscv_vse64_v_f64m4(&p[i], __riscv_vfmacc_vf_f64m4(v_r, beta, v_p, vl), vl);
+        i += vl;
+    }
+}
+
+// x += alpha p and r -= alpha ap in one sweep, returning the new r . r. At e64m4 the four
+// streams and the accumulator fit in the register file together; at e64m8 they would not.
+static double cg_update_fused(double alpha, const double* p, const double* ap, double* x,
+                              double* r, size_t n) {
+    size_t vlmax = __riscv_vsetvlmax_e64m4();
+    vfloat64m4_t acc = __riscv_vfmv_v_f_f64m4(0.0, vlmax);
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m4(n - i);
+        vfloat64m4_t v_p = __riscv_vle64_v_f64m4(&p[i], vl);
+        vfloat64m4_t v_x = __riscv_vle64_v_f64m4(&x[i], vl);
+        __riscv_vse64_v_f64m4(&x[i], __riscv_vfmacc_vf_f64m4(v_x, alpha, v_p, vl), vl);
+        vfloat64m4_t v_ap = __riscv_vle64_v_f64m4(&ap[i], vl);
+        vfloat64m4_t v_r = __riscv_vfnmsac_vf_f64m4(
+            __riscv_vle64_v_f64m4(&r[i], vl), alpha, v_ap, vl);
+        __riscv_vse64_v_f64m4(&r[i], v_r, vl);
+        // Tail-undisturbed so a short last strip keeps the earlier partial sums.
+        acc = __riscv_vfmacc_vv_f64m4_tu(acc, v_r, v_r, vl);
+        i += vl;
+    }
+    vfloat64m1_t zero = __riscv_vfmv_v_f_f64m1(0.0, 1);
+    return __riscv_vfmv_f_s_f64m1_f64(__riscv_vfredusum_vs_f64m4_f64m1(acc, zero, vlmax));
+}
+
+// Runs iters iterations from x = 0, storing rr before each and after the last in rr.
+static void cg_solve(cg_vectors* v, long iters, int fused, double* rr) {
+    size_t n = v->n;
+    int32_t rows = (int32_t)n;
+    rr[0] = fdotp_v64b(v->r, v->r, n);
+    for (long k = 0; k < iters; k++) {
+        phase_begin("cg_spmv");
+        spmv_csr_idx32(rows, cg_prow, cg_index, cg_data, v->p, v->ap);
+        phase_end();
+
+        phase_begin("cg_pap");
+        double alpha = rr[k] / fdotp_v64b(v->p, v->ap, n);
+        phase_end();
+
+        if (fused) {
+            phase_begin("cg_fused_update");
+            rr[k + 1] = cg_update_fused(alpha, v->p, v->ap, v->x, v->r, n);
+            phase_end();
+        } else {
+            phase_begin("cg_update");
+            cg_axpy(alpha, v->p, v->x, n);
+            cg_axpy(-alpha, v->ap, v->r, n);
+            phase_end();
+
+            phase_begin("cg_rr");
+            rr[k + 1] = fdotp_v64b(v->r, v->r, n);
+            phase_end();
+        }
+
+        phase_begin("cg_xpay");
+        cg_xpay(v->r, rr[k + 1] / rr[k], v->p, n);
+        phase_end();
+    }
+}
+
+// Within a millionth of want, or of 1e-14 rr0 once rr is down in the rounding noise.
+static int close_to(double got, double want) {
+    double d = got > want ? got - want : want - got;
+    double w = want < 0.0 ? -want : want;
+    return d <= 1e-6 * w + 1e-14 * rr_want[0];
+}
+
+// In units of 1e-12 rr0, for the failure messages.
+static long in_rr0(double rr) {
+    return (long)(rr / rr_want[0] * 1e12);
+}
+
+// Solves in bench region name, sets *cycles_out to the cycles taken and returns 1 if an
+// rr or the final residual is off.
+static int run(const char* name, cg_vectors* v, long iters, int fused,
+               unsigned long* cycles_out) {
+    double rr[CG_MAX_ITERS + 1];
+    size_t n = v->n;
+    vinit_fill_f64(v->x, n, 0.0);
+    vinit_affine_f64(v->r, n, CG_B_SCALE, 1.0);
+    vinit_affine_f64(v->p, n, CG_B_SCALE, 1.0);
+
+    unsigned long start = bench_timed_begin(name);
+    cg_solve(v, iters, fused, rr);
+    unsigned long cycles = bench_timed_end(start);
+
+    for (long k = 0; k <= iters; k++) {
+        if (!close_to(rr[k], rr_want[k])) {
+            printf("FAIL %s: rr before iteration %ld is %ld, expected %ld (1e-12 rr0)\n", name,
+                   k, in_rr0(rr[k]), in_rr0(rr_want[k]));
+            return 1;
+        }
+    }
+    spmv_csr_idx32((int32_t)n, cg_prow, cg_index, cg_data, v->x, v->ap);
+    cg_axpy(-1.0, v->b, v->ap, n);
+    double residual = fdotp_v64b(v->ap, v->ap, n);
+    if (!close_to(residual, rr[iters])) {
+        printf("FAIL %s: |A x - b|^2 is %ld, rr is %ld (1e-12 rr0)\n", name,
+               in_rr0(residual), in_rr0(rr[iters]));
+        return 1;
+    }
+    printf("%s: %lu cycles, %lu per iteration\n", name, cycles, cycles / iters);
+    *cycles_out = cycles;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int32_t g = cg_grid;
+    int32_t iters = cg_iters;
+    if (g < CG_MIN_GRID || g > CG_MAX_GRID) {
+        printf("FAIL cg_grid = %d, must be in [%d, %d]\n", (int)g, CG_MIN_GRID, CG_MAX_GRID);
+        return 1;
+    }
+    if (iters < 1 || iters > CG_MAX_ITERS) {
+        printf("FAIL cg_iters = %d, must be in [1, %d]\n", (int)iters, CG_MAX_ITERS);
+        return 1;
+    }
+    phases = cg_phases;
+    size_t n = (size_t)(g * g);
+    int32_t nnz = build_matrix(g);
+    printf("cg %dx%d grid: n = %zu, nnz = %d, %d iterations, phase regions %s\n", (int)g,
+           (int)g, n, (int)nnz, (int)iters, phases ? "on" : "off");
+
+    cg_vectors v = {
+        .n = n,
+        .b = vpu_alloc_ew(n * sizeof(double), 64),
+        .x = vpu_alloc_ew(n * sizeof(double), 64),
+        .r = vpu_alloc_ew(n * sizeof(double), 64),
+        .p = vpu_alloc_ew(n * sizeof(double), 64),
+        .ap = vpu_alloc_ew(n * sizeof(double), 64),
+    };
+    vinit_affine_f64(v.b, n, CG_B_SCALE, 1.0);
+    ref_cg(g, iters);
+
+    unsigned long unfused, fused;
+    if (run("cg_unfused", &v, iters, 0, &unfused) || run("cg_fused", &v, iters, 1, &fused))
+        return 1;
+    printf("cg_fused: " BENCH_RATE_FMT " times as fast as cg_unfused\n",
+           BENCH_RATE(unfused, fused));
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -71,12 +71,18 @@ inline vfloat##w##m##l##_t __exp_f##w##m##l(vfloat##w##m##l##_t x, size_t gvl) {
   									\
   z = __riscv_vfmul_vv_f##w##m##l(x, x, gvl);				\
   									\
+  /* Horner: y = y * x + p_k */					\
   y = __riscv_vfmv_v_f_f##w##m##l(cephes_exp_p0, gvl);			\
-  y = __riscv_vfmadd_vf_f##w##m##l(y, cephes_exp_p1, x, gvl);		\
-  y = __riscv_vfmadd_vf_f##w##m##l(y, cephes_exp_p2, x, gvl);		\
-  y = __riscv_vfmadd_vf_f##w##m##l(y, cephes_exp_p3, x, gvl);		\
-  y = __riscv_vfmadd_vf_f##w##m##l(y, cephes_exp_p4, x, gvl);		\
-  y = __riscv_vfmadd_vf_f##w##m##l(y, cephes_exp_p5, x, gvl);		\
+  y = __riscv_vfmul_vv_f##w##m##l(y, x, gvl);				\
+  y = __riscv_vfadd_vf_f##w##m##l(y, cephes_exp_p1, gvl);		\
+  y = __riscv_vfmul_vv_f##w##m##l(y, x, gvl);				\
+  y = __riscv_vfadd_vf_f##w##m##l(y, cephes_exp_p2, gvl);		\
+  y = __riscv_vfmul_vv_f##w##m##l(y, x, gvl);				\
+  y = __riscv_vfadd_vf_f##w##m##l(y, cephes_exp_p3, gvl);		\
+  y = __riscv_vfmul_vv_f##w##m##l(y, x, gvl);				\
+  y = __riscv_vfadd_vf_f##w##m##l(y, cephes_exp_p4, gvl);		\
+  y = __riscv_vfmul_vv_f##w##m##l(y, x, gvl);				\
+  y = __riscv_vfadd_vf_f##w##m##l(y, cephes_exp_p5, gvl);		\
   y = __riscv_vfmadd_vv_f##w##m##l(y, z, x, gvl);			\
   y = __riscv_vfadd_vv_f##w##m##l(y, one, gvl);				\
 									\
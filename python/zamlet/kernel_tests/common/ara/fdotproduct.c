@@ -17,7 +17,11 @@
 // Author: Matteo Perotti <mperotti@iis.ee.ethz.ch>
 
 #include "fdotproduct.h"
+#include "dotp_batch.h"
+// -DFDOTP_ASM builds the inline-assembly forms instead
+#ifndef FDOTP_ASM
 #define INTRINSICS
+#endif
 // 64-bit dot-product: a * b
 double fdotp_v64b(const double *a, const double *b, size_t avl) {
 #ifdef INTRINSICS
@@ -31,8 +35,8 @@ double fdotp_v64b(const double *a, const double *b, size_t avl) {
   double *a_ = (double *)a;
   double *b_ = (double *)b;
 
-  // Clean the accumulator
-  acc = __riscv_vfmv_s_f_f64m8(0, vl);
+  // Clean the accumulator, every lane of it since the reduction covers VLMAX
+  acc = __riscv_vfmv_v_f_f64m8(0, vl);
   red = __riscv_vfmv_s_f_f64m1(0, vl);
   // Stripmine and accumulate a partial reduced vector
   for (; avl > 0; avl -= vl) {
@@ -40,8 +44,9 @@ double fdotp_v64b(const double *a, const double *b, size_t avl) {
     // Load chunk a and b
     buf_a = __riscv_vle64_v_f64m8(a_, vl);
     buf_b = __riscv_vle64_v_f64m8(b_, vl);
-    // Multiply and accumulate
-    acc = __riscv_vfmacc_vv_f64m8(acc, buf_a, buf_b, vl);
+    // Multiply and accumulate, tail-undisturbed so a short last strip keeps the
+    // partial sums above it
+    acc = __riscv_vfmacc_vv_f64m8_tu(acc, buf_a, buf_b, vl);
     // Bump pointers
     a_ += vl;
     b_ += vl;
@@ -63,26 +68,25 @@ double fdotp_v64b(const double *a, const double *b, size_t avl) {
   double *a_ = (double *)a;
   double *b_ = (double *)b;
 
-  // Clean the accumulator
+  // Clean the accumulator over the lanes of the first, widest strip, and the seed
+  asm volatile("vmv.v.i v24, 0");
   asm volatile("vmv.s.x v0, zero");
   // Stripmine and accumulate a partial reduced vector
   for (; avl > 0; avl -= vl) {
-    asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(avl));
+    asm volatile("vsetvli %0, %1, e64, m8, tu, ma" : "=r"(vl) : "r"(avl));
     // Load chunk a and b
     asm volatile("vle64.v v8,  (%0)" ::"r"(a_));
     asm volatile("vle64.v v16, (%0)" ::"r"(b_));
-    // Multiply and accumulate
-    if (avl == orig_avl) {
-      asm volatile("vfmul.vv v24, v8, v16");
-    } else {
-      asm volatile("vfmacc.vv v24, v8, v16");
-    }
+    // Multiply and accumulate, tail-undisturbed so a short last strip keeps the
+    // partial sums above it
+    asm volatile("vfmacc.vv v24, v8, v16");
     // Bump pointers
     a_ += vl;
     b_ += vl;
   }
 
-  // Reduce and return
+  // Reduce over the lanes of the first strip and return
+  asm volatile("vsetvli zero, %0, e64, m8, ta, ma" ::"r"(orig_avl));
   asm volatile("vfredusum.vs v0, v24, v0");
   asm volatile("vfmv.f.s %0, v0" : "=f"(red));
   return red;
@@ -344,3 +348,6 @@ _Float16 fdotp_s16b(const _Float16 *a, const _Float16 *b, size_t avl) {
 
   return acc0;
 }
+
+DOTP_BATCH_DEFINE(fdotp_batch_v64b, double, 64, float, f64, vfmacc, vfadd, vfmv_v_f)
+DOTP_BATCH_DEFINE(fdotp_batch_v32b, float, 32, float, f32, vfmacc, vfadd, vfmv_v_f)
@@ -32,4 +32,9 @@ double fdotp_s64b(const double *a, const double *b, size_t avl);
 float fdotp_s32b(const float *a, const float *b, size_t avl);
 _Float16 fdotp_s16b(const _Float16 *a, const _Float16 *b, size_t avl);
 
+// K independent dot products out[k] = a[k] . b[k], reduced together at the
+// end (see common/dotp_batch.h).
+void fdotp_batch_v64b(double *a[], double *b[], size_t K, size_t avl, double out[]);
+void fdotp_batch_v32b(float *a[], float *b[], size_t K, size_t avl, float out[]);
+
 #endif
@@ -18,6 +18,7 @@
 
 #include "gemv.h"
 #include "util.h"
+#include "vinit.h"
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -28,17 +29,13 @@
 void init_gemv_data(const unsigned long int m_row,
                     const unsigned long int v_len, double *matrix,
                     double *vector, double a, double b, double c) {
-  // initialize matrix
+  // initialize matrix: row i is b * j + (a * i + c)
   for (uint64_t i = 0; i < m_row; ++i) {
-    for (uint64_t j = 0; j < v_len; ++j) {
-      matrix[i * v_len + j] = a * (double)i + b * (double)j + c;
-    }
+    vinit_affine_f64(&matrix[i * v_len], v_len, b, a * (double)i + c);
   }
 
   // initialize vector
-  for (uint64_t i = 0; i < v_len; ++i) {
-    vector[i] = a * (double)i + b;
-  }
+  vinit_affine_f64(vector, v_len, a, b);
 }
 
 //=====================================//
@@ -47,6 +44,14 @@ void init_gemv_data(const unsigned long int m_row,
 
 #define SLICE_SIZE 128
 
+// Slices are one e64,m2 register group wide and high, so they shrink to VLMAX
+// on geometries where that is below SLICE_SIZE.
+static uint64_t slice_size() {
+  uint64_t vlmax;
+  asm volatile("vsetvli %0, zero, e64, m2, ta, ma" : "=r"(vlmax));
+  return vlmax < SLICE_SIZE ? vlmax : SLICE_SIZE;
+}
+
 void clear_reduction_register() {
   asm volatile("vsetvli zero, %0, e64, m2, ta, ma" ::"r"(SLICE_SIZE));
   asm volatile("vmv.v.i v16,  0");
@@ -85,7 +90,7 @@ void gemv_rowwise_small_than_slice(const unsigned long int m_row,
       // multiply with vector
       asm volatile("vfmul.vv v8, v4, v0");
       // reduction
-      asm volatile("vfredsum.vs v16, v8, v16");
+      asm volatile("vfredusum.vs v16, v8, v16");
       // store previous data
       if (i != 0) {
         // asm volatile("vse64.v v24, (%0);" ::"r"(_dst_));
@@ -103,7 +108,7 @@ void gemv_rowwise_small_than_slice(const unsigned long int m_row,
       // multiply with vector
       asm volatile("vfmul.vv v6, v2, v0");
       // reduction
-      asm volatile("vfredsum.vs v24, v6, v24");
+      asm volatile("vfredusum.vs v24, v6, v24");
       // store previous data
       // asm volatile("vse64.v v16, (%0);" ::"r"(_dst_));
       double tmp;
@@ -153,7 +158,7 @@ void gemv_rowwise_kernel_slice(const unsigned long int v_len,
       asm volatile("vfslide1down.vf  v16, v24, %0" ::"f"(tmp));
       // reduction
       asm volatile("vsetvli zero, %0, e64, m2, ta, ma" ::"r"(slice_width));
-      asm volatile("vfredsum.vs v16, v8, v16");
+      asm volatile("vfredusum.vs v16, v8, v16");
     } else {
       // round slide
       asm volatile("vsetvli zero, %0, e64, m2, ta, ma" ::"r"(slice_height));
@@ -161,7 +166,7 @@ void gemv_rowwise_kernel_slice(const unsigned long int v_len,
       asm volatile("vfslide1down.vf  v24, v16, %0" ::"f"(tmp));
       // reduction
       asm volatile("vsetvli zero, %0, e64, m2, ta, ma" ::"r"(slice_width));
-      asm volatile("vfredsum.vs v24, v8, v24");
+      asm volatile("vfredusum.vs v24, v8, v24");
     }
   }
 
@@ -173,16 +178,18 @@ void gemv_rowwise_kernel_slice(const unsigned long int v_len,
 
 void gemv_rowwise(const unsigned long int m_row, const unsigned long int v_len,
                   double *matrix, double *vector, double *dest) {
+  uint64_t slice = slice_size();
+
   // when matrix is samller than a slice
-  if (v_len <= SLICE_SIZE) {
+  if (v_len <= slice) {
     gemv_rowwise_small_than_slice(m_row, v_len, matrix, vector, dest);
     return;
   }
 
-  uint64_t num_slice_row = m_row / SLICE_SIZE;
-  uint64_t rest_row = m_row % SLICE_SIZE;
-  uint64_t num_slice_col = v_len / SLICE_SIZE;
-  uint64_t rest_col = v_len % SLICE_SIZE;
+  uint64_t num_slice_row = m_row / slice;
+  uint64_t rest_row = m_row % slice;
+  uint64_t num_slice_col = v_len / slice;
+  uint64_t rest_col = v_len % slice;
 
   // each slice row
   for (uint64_t i = 0; i < num_slice_row; ++i) {
@@ -190,20 +197,20 @@ void gemv_rowwise(const unsigned long int m_row, const unsigned long int v_len,
     clear_reduction_register();
     // each full slice
     for (uint64_t j = 0; j < num_slice_col; ++j) {
-      double *_mat_ = matrix + i * SLICE_SIZE * v_len + j * SLICE_SIZE;
-      double *_vec_ = vector + j * SLICE_SIZE;
-      gemv_rowwise_kernel_slice(v_len, SLICE_SIZE, SLICE_SIZE, _mat_, _vec_);
+      double *_mat_ = matrix + i * slice * v_len + j * slice;
+      double *_vec_ = vector + j * slice;
+      gemv_rowwise_kernel_slice(v_len, slice, slice, _mat_, _vec_);
     }
     // margin slice
     if (rest_col > 0) {
       double *_mat_ =
-          matrix + i * SLICE_SIZE * v_len + num_slice_col * SLICE_SIZE;
-      double *_vec_ = vector + num_slice_col * SLICE_SIZE;
-      gemv_rowwise_kernel_slice(v_len, rest_col, SLICE_SIZE, _mat_, _vec_);
+          matrix + i * slice * v_len + num_slice_col * slice;
+      double *_vec_ = vector + num_slice_col * slice;
+      gemv_rowwise_kernel_slice(v_len, rest_col, slice, _mat_, _vec_);
     }
     // store dest vector value
-    double *_dst_ = dest + i * SLICE_SIZE;
-    store_slice_results(_dst_, SLICE_SIZE);
+    double *_dst_ = dest + i * slice;
+    store_slice_results(_dst_, slice);
   }
 
   // margin slice row
@@ -213,23 +220,125 @@ void gemv_rowwise(const unsigned long int m_row, const unsigned long int v_len,
     // each bottom slice
     for (uint64_t j = 0; j < num_slice_col; ++j) {
       double *_mat_ =
-          matrix + num_slice_row * SLICE_SIZE * v_len + j * SLICE_SIZE;
-      double *_vec_ = vector + j * SLICE_SIZE;
-      gemv_rowwise_kernel_slice(v_len, SLICE_SIZE, rest_row, _mat_, _vec_);
+          matrix + num_slice_row * slice * v_len + j * slice;
+      double *_vec_ = vector + j * slice;
+      gemv_rowwise_kernel_slice(v_len, slice, rest_row, _mat_, _vec_);
     }
     // margin slice
     if (rest_col > 0) {
-      double *_mat_ = matrix + num_slice_row * SLICE_SIZE * v_len +
-                      num_slice_col * SLICE_SIZE;
-      double *_vec_ = vector + num_slice_col * SLICE_SIZE;
+      double *_mat_ = matrix + num_slice_row * slice * v_len +
+                      num_slice_col * slice;
+      double *_vec_ = vector + num_slice_col * slice;
       gemv_rowwise_kernel_slice(v_len, rest_col, rest_row, _mat_, _vec_);
     }
     // store dest vector value
-    double *_dst_ = dest + num_slice_row * SLICE_SIZE;
+    double *_dst_ = dest + num_slice_row * slice;
     store_slice_results(_dst_, rest_row);
   }
 }
 
+//=====================================//
+//========= GEMV COLUMN WISE KERNEL ===//
+//=====================================//
+
+// Column-major (axpy form): dest[i] = sum_j matrix[j * m_row + i] * vector[j].
+// A block of output rows stays in the v16 / v24 accumulators for all v_len
+// columns while each column slice streams in with a unit-stride load and is
+// scaled by the scalar vector[j] with vfmacc.vf. There is no reduction and no
+// slide, and vector is read once per block.
+
+// 2 * vl rows: v16 accumulates rows [0, vl), v24 rows [vl, 2 * vl)
+void gemv_colwise_kernel_block2(const unsigned long int m_row,
+                                const unsigned long int v_len,
+                                const unsigned long int vl, double *matrix,
+                                double *vector, double *dest) {
+  asm volatile("vsetvli zero, %0, e64, m8, ta, ma" ::"r"(vl));
+  asm volatile("vmv.v.i v16,  0");
+  asm volatile("vmv.v.i v24,  0");
+  for (uint64_t j = 0; j < v_len; ++j) {
+    double *_col_ = matrix + j * m_row;
+    double x = vector[j];
+    // load the column slices
+    asm volatile("vle64.v v0, (%0);" ::"r"(_col_));
+    asm volatile("vle64.v v8, (%0);" ::"r"(_col_ + vl));
+    // multiply and accumulate
+    asm volatile("vfmacc.vf v16, %0, v0" ::"f"(x));
+    asm volatile("vfmacc.vf v24, %0, v8" ::"f"(x));
+  }
+  asm volatile("vse64.v v16, (%0);" ::"r"(dest));
+  asm volatile("vse64.v v24, (%0);" ::"r"(dest + vl));
+}
+
+// vl rows in v16
+void gemv_colwise_kernel_block(const unsigned long int m_row,
+                               const unsigned long int v_len,
+                               const unsigned long int vl, double *matrix,
+                               double *vector, double *dest) {
+  asm volatile("vsetvli zero, %0, e64, m8, ta, ma" ::"r"(vl));
+  asm volatile("vmv.v.i v16,  0");
+  for (uint64_t j = 0; j < v_len; ++j) {
+    double *_col_ = matrix + j * m_row;
+    double x = vector[j];
+    asm volatile("vle64.v v0, (%0);" ::"r"(_col_));
+    asm volatile("vfmacc.vf v16, %0, v0" ::"f"(x));
+  }
+  asm volatile("vse64.v v16, (%0);" ::"r"(dest));
+}
+
+void gemv_colwise(const unsigned long int m_row, const unsigned long int v_len,
+                  double *matrix, double *vector, double *dest) {
+  uint64_t vlmax;
+  asm volatile("vsetvli %0, zero, e64, m8, ta, ma" : "=r"(vlmax));
+
+  uint64_t i = 0;
+  // full blocks of two register groups
+  for (; i + 2 * vlmax <= m_row; i += 2 * vlmax) {
+    gemv_colwise_kernel_block2(m_row, v_len, vlmax, matrix + i, vector,
+                               dest + i);
+  }
+  // margin rows, at most two single-group blocks
+  while (i < m_row) {
+    uint64_t vl = m_row - i < vlmax ? m_row - i : vlmax;
+    gemv_colwise_kernel_block(m_row, v_len, vl, matrix + i, vector, dest + i);
+    i += vl;
+  }
+}
+
+//=====================================//
+//========= GEMV SELECTION ============//
+//=====================================//
+
+// Tall and square matrices go column wise: each vfmacc covers a whole
+// register group of rows, while the row-wise kernel pays a reduction and a
+// slide per row and slice. Wide matrices keep the row-wise kernel, whose
+// reductions are amortized over long rows.
+int gemv_use_colwise(const unsigned long int m_row,
+                     const unsigned long int v_len) {
+  return m_row >= v_len;
+}
+
+void gemv_layout(const unsigned long int m_row, const unsigned long int v_len,
+                 double *src, double *matrix) {
+  if (!gemv_use_colwise(m_row, v_len)) {
+    memcpy(matrix, src, m_row * v_len * sizeof(double));
+    return;
+  }
+  for (uint64_t i = 0; i < m_row; ++i) {
+    for (uint64_t j = 0; j < v_len; ++j) {
+      matrix[j * m_row + i] = src[i * v_len + j];
+    }
+  }
+}
+
+void gemv(const unsigned long int m_row, const unsigned long int v_len,
+          double *matrix, double *vector, double *dest) {
+  if (gemv_use_colwise(m_row, v_len)) {
+    gemv_colwise(m_row, v_len, matrix, vector, dest);
+  } else {
+    gemv_rowwise(m_row, v_len, matrix, vector, dest);
+  }
+}
+
 int gemv_verify(const unsigned long int m_row, const unsigned long int v_len,
                 double *matrix, double *vector, double *dest) {
   for (uint64_t i = 0; i < m_row; ++i) {
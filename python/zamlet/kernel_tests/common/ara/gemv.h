@@ -31,6 +31,25 @@ void gemv_rowwise_small_than_slice(const unsigned long int m_row,
                                    double *matrix, double *vector,
                                    double *dest);
 
+// Column-major matrix (matrix[j * m_row + i]); vector is read by the scalar
+// core.
+void gemv_colwise(const unsigned long int m_row, const unsigned long int v_len,
+                  double *matrix, double *vector, double *dest);
+
+// 1 when gemv() runs the column-wise kernel for this shape.
+int gemv_use_colwise(const unsigned long int m_row,
+                     const unsigned long int v_len);
+
+// Copy the row-major m_row x v_len matrix src into the layout gemv() expects
+// for this shape: column-major when gemv_use_colwise(), otherwise unchanged.
+void gemv_layout(const unsigned long int m_row, const unsigned long int v_len,
+                 double *src, double *matrix);
+
+// dest = matrix · vector with the kernel chosen by gemv_use_colwise().
+// matrix must be in the gemv_layout() layout.
+void gemv(const unsigned long int m_row, const unsigned long int v_len,
+          double *matrix, double *vector, double *dest);
+
 int gemv_verify(const unsigned long int m_row, const unsigned long int v_len,
                 double *matrix, double *vector, double *dest);
 
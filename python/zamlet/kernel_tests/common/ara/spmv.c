@@ -44,7 +44,7 @@ void spmv_csr_idx32(int32_t N_ROW, int32_t *CSR_PROW, int32_t *CSR_INDEX,
       volatile size_t slice_size = __riscv_vsetvl_e64m8(len);
       asm volatile("vle64.v v8, (%0)" ::"r"(data));          // fetch entries
       asm volatile("vle32.v v16, (%0)" ::"r"(index));         // fetch indices
-      asm volatile("vloxei32.v v0, (%0), v16" ::"r"(IN_VEC)); // load data
+      asm volatile("vluxei32.v v0, (%0), v16" ::"r"(IN_VEC)); // load data
       asm volatile("vfmacc.vv v24, v8, v0");      // vector multiply
       /* if (i == 0) { */
       /* 	printf("slice=%ld\n", slice_size); */
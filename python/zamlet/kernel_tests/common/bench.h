@@ -0,0 +1,25 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/*
+ * Machine-readable benchmark regions.
+ *
+ *   bench_begin("gemv");
+ *   ... timed code ...
+ *   bench_end();
+ *
+ * bench_end sends one record to the host over HTIF (SYS_bench in syscalls.c)
+ * holding the region name, mcycle and minstret deltas, and the deltas of
+ * mhpmcounter3..6 with the events selected on them (HPM_EVENT3..6 in util.h).
+ * run_kernel_test.py writes the records to bench.json in the test outputs.
+ *
+ * Regions may nest up to BENCH_MAX_DEPTH deep. The name must stay valid until
+ * the matching bench_end.
+ */
+
+#define BENCH_MAX_DEPTH 8
+
+void bench_begin(const char* name);
+void bench_end(void);
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef BENCH_CHECK_H
+#define BENCH_CHECK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "bench.h"
+#include "encoding.h"
+
+/*
+ * Helpers the benchmark kernels share to time a region, poison its output first and
+ * check the result.
+ *
+ *   unsigned long start = bench_timed_begin("name");
+ *   ... timed code ...
+ *   unsigned long cycles = bench_timed_end(start);
+ *   printf("%lu cycles (" BENCH_RATE_FMT " cycles/element)\n", cycles,
+ *          BENCH_RATE(cycles, n));
+ *
+ * The poison and mismatch helpers run e<EW>m4 strips, so both arrays should be VPU data
+ * (vpu_alloc or a .data.vpu section) and the scalar core never reads them.
+ */
+
+// Open bench region name and return mcycle at its start.
+static inline unsigned long bench_timed_begin(const char* name) {
+    unsigned long start = read_csr(mcycle);
+    bench_begin(name);
+    return start;
+}
+
+// Close the innermost bench region and return the cycles since start.
+static inline unsigned long bench_timed_end(unsigned long start) {
+    bench_end();
+    return read_csr(mcycle) - start;
+}
+
+// printf format and arguments for num / den with two decimals.
+#define BENCH_RATE_FMT "%lu.%02lu"
+#define BENCH_RATE(num, den) \
+    (unsigned long)(num) / (den), (unsigned long)(num) * 100 / (den) % 100
+
+// Fill n 32-bit words at p with ones, a NaN as f32 and f64, so a kernel that leaves an
+// element unwritten cannot pass on the output of the run before it.
+static inline void bench_poison32(void* p, size_t n) {
+    uint32_t* y = p;
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m4(n - i);
+        __riscv_vse32_v_u32m4(&y[i], __riscv_vmv_v_x_u32m4(~0U, vl), vl);
+        i += vl;
+    }
+}
+
+// BENCH_MISMATCHES_DEFINE(EW, MB) defines bench_mismatches<EW>(a, b, n), the number of
+// i < n where the EW-bit elements a[i] and b[i] differ in any bit. MB is the mask ratio
+// of an EW m4 register group.
+#define BENCH_MISMATCHES_DEFINE(EW, MB)                                                  \
+static inline size_t bench_mismatches##EW(const void* a, const void* b, size_t n) {      \
+    const uint##EW##_t* x = a;                                                           \
+    const uint##EW##_t* y = b;                                                           \
+    size_t bad = 0;                                                                      \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vbool##MB##_t ne = __riscv_vmsne_vv_u##EW##m4_b##MB(                             \
+            __riscv_vle##EW##_v_u##EW##m4(&x[i], vl),                                    \
+            __riscv_vle##EW##_v_u##EW##m4(&y[i], vl), vl);                               \
+        bad += __riscv_vcpop_m_b##MB(ne, vl);                                            \
+        i += vl;                                                                         \
+    }                                                                                    \
+    return bad;                                                                          \
+}
+
+BENCH_MISMATCHES_DEFINE(16, 4)
+BENCH_MISMATCHES_DEFINE(32, 8)
+BENCH_MISMATCHES_DEFINE(64, 16)
+
+#endif
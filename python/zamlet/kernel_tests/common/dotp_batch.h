@@ -0,0 +1,90 @@
+#ifndef DOTP_BATCH_H
+#define DOTP_BATCH_H
+
+#include <stddef.h>
+#include <riscv_vector.h>
+#include "vpu_alloc.h"
+
+/*
+ * Batched dot products: out[k] = a[k] · b[k] for k < K, each of length avl.
+ *
+ * Four dot products are stripmined together, each into its own e<EW>m2
+ * accumulator, so consecutive multiply-accumulates do not depend on each
+ * other. Each accumulator is then written as column k of a W x K scratch
+ * matrix Q (Q[l · K + k], W = VLMAX at e<EW>m2) with one strided store.
+ * A tree folds the lower half of Q's rows onto the upper half,
+ * W -> W/2 -> ... -> 1, using unit-stride adds over all K columns at once;
+ * row 0 is the result. There is no per-product vredsum.
+ *
+ * Q is a vpu_scratch_alloc block, freed before returning, so repeated
+ * calls of one size reuse the same lines.
+ *
+ * DOTP_BATCH_DEFINE(name, T, EW, TY, S, MACC, ADD, SPLAT) defines
+ *   void name(T* a[], T* b[], size_t K, size_t avl, T out[])
+ * where TY is the vector type stem (int / float), S the intrinsic type
+ * suffix (i64, f32, ...), MACC / ADD the multiply-accumulate and add
+ * intrinsic stems (vmacc / vadd or vfmacc / vfadd) and SPLAT the splat stem
+ * (vmv_v_x or vfmv_v_f).
+ */
+#define DOTP_BATCH_DEFINE(name, T, EW, TY, S, MACC, ADD, SPLAT)                          \
+void name(T* a[], T* b[], size_t K, size_t avl, T out[]) {                               \
+    if (K == 0)                                                                          \
+        return;                                                                          \
+    size_t w = __riscv_vsetvlmax_e##EW##m2();                                            \
+    size_t q_bytes = w * K * sizeof(T);                                                  \
+    T* q = vpu_scratch_alloc(q_bytes);                                                   \
+    ptrdiff_t stride = (ptrdiff_t)(K * sizeof(T));                                       \
+    size_t k = 0;                                                                        \
+    for (; k + 4 <= K; k += 4) {                                                         \
+        v##TY##EW##m2_t acc0 = __riscv_##SPLAT##_##S##m2(0, w);                          \
+        v##TY##EW##m2_t acc1 = __riscv_##SPLAT##_##S##m2(0, w);                          \
+        v##TY##EW##m2_t acc2 = __riscv_##SPLAT##_##S##m2(0, w);                          \
+        v##TY##EW##m2_t acc3 = __riscv_##SPLAT##_##S##m2(0, w);                          \
+        for (size_t i = 0; i < avl; ) {                                                  \
+            size_t vl = __riscv_vsetvl_e##EW##m2(avl - i);                               \
+            acc0 = __riscv_##MACC##_vv_##S##m2_tu(acc0,                                  \
+                __riscv_vle##EW##_v_##S##m2(&a[k][i], vl),                               \
+                __riscv_vle##EW##_v_##S##m2(&b[k][i], vl), vl);                          \
+            acc1 = __riscv_##MACC##_vv_##S##m2_tu(acc1,                                  \
+                __riscv_vle##EW##_v_##S##m2(&a[k + 1][i], vl),                           \
+                __riscv_vle##EW##_v_##S##m2(&b[k + 1][i], vl), vl);                      \
+            acc2 = __riscv_##MACC##_vv_##S##m2_tu(acc2,                                  \
+                __riscv_vle##EW##_v_##S##m2(&a[k + 2][i], vl),                           \
+                __riscv_vle##EW##_v_##S##m2(&b[k + 2][i], vl), vl);                      \
+            acc3 = __riscv_##MACC##_vv_##S##m2_tu(acc3,                                  \
+                __riscv_vle##EW##_v_##S##m2(&a[k + 3][i], vl),                           \
+                __riscv_vle##EW##_v_##S##m2(&b[k + 3][i], vl), vl);                      \
+            i += vl;                                                                     \
+        }                                                                                \
+        __riscv_vsse##EW##_v_##S##m2(&q[k], stride, acc0, w);                            \
+        __riscv_vsse##EW##_v_##S##m2(&q[k + 1], stride, acc1, w);                        \
+        __riscv_vsse##EW##_v_##S##m2(&q[k + 2], stride, acc2, w);                        \
+        __riscv_vsse##EW##_v_##S##m2(&q[k + 3], stride, acc3, w);                        \
+    }                                                                                    \
+    for (; k < K; k++) {                                                                 \
+        v##TY##EW##m2_t acc = __riscv_##SPLAT##_##S##m2(0, w);                           \
+        for (size_t i = 0; i < avl; ) {                                                  \
+            size_t vl = __riscv_vsetvl_e##EW##m2(avl - i);                               \
+            acc = __riscv_##MACC##_vv_##S##m2_tu(acc,                                    \
+                __riscv_vle##EW##_v_##S##m2(&a[k][i], vl),                               \
+                __riscv_vle##EW##_v_##S##m2(&b[k][i], vl), vl);                          \
+            i += vl;                                                                     \
+        }                                                                                \
+        __riscv_vsse##EW##_v_##S##m2(&q[k], stride, acc, w);                             \
+    }                                                                                    \
+    for (size_t rows = w; rows > 1; rows /= 2) {                                         \
+        size_t n = rows / 2 * K;                                                         \
+        for (size_t i = 0; i < n; ) {                                                    \
+            size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                 \
+            __riscv_vse##EW##_v_##S##m8(&q[i], __riscv_##ADD##_vv_##S##m8(               \
+                __riscv_vle##EW##_v_##S##m8(&q[i], vl),                                  \
+                __riscv_vle##EW##_v_##S##m8(&q[n + i], vl), vl), vl);                    \
+            i += vl;                                                                     \
+        }                                                                                \
+    }                                                                                    \
+    for (k = 0; k < K; k++)                                                              \
+        out[k] = q[k];                                                                   \
+    vpu_scratch_free(q, q_bytes);                                                        \
+}
+
+#endif
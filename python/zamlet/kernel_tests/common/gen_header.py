@@ -0,0 +1,26 @@
+"""Array declarations for the dataset headers the kernel tests generate.
+
+Each gen_<name>.py prints its header to stdout. dataset_kernel (bazel/defs.bzl) puts this
+directory on PYTHONPATH, so the generators import it as gen_header.
+"""
+import struct
+
+
+def f32(v):
+    """v rounded to the nearest float."""
+    return struct.unpack("<f", struct.pack("<f", v))[0]
+
+
+def emit(ctype, name, values, section=None, fmt=str, per_line=16):
+    """Print `ctype name[len(values)] = {...};`, per_line values to a line.
+
+    With a section (.data.vpu8 to .data.vpu64, test.ld) the array goes in VPU memory
+    reserved for that element width, aligned to 64 bytes; without one it stays in scalar
+    memory.
+    """
+    attr = f' __attribute__((section("{section}"), aligned(64)))' if section else ""
+    print(f"{ctype} {name}[{len(values)}]{attr} = {{")
+    for i in range(0, len(values), per_line):
+        print("  " + ", ".join(fmt(v) for v in values[i:i + per_line]) + ",")
+    print("};")
+    print()
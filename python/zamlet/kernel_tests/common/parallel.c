@@ -0,0 +1,23 @@
+#include "parallel.h"
+#include "util.h"
+
+void parallel_slice(int cid, int nc, size_t n, size_t grain, size_t* begin, size_t* end) {
+    size_t chunks = (n + grain - 1) / grain;
+    size_t lo = chunks * cid / nc * grain;
+    size_t hi = chunks * (cid + 1) / nc * grain;
+    *begin = lo < n ? lo : n;
+    *end = hi < n ? hi : n;
+}
+
+void parallel_barrier(int nc) {
+    if (nc > 1)
+        barrier(nc);
+}
+
+void parallel_for(int cid, int nc, size_t n, size_t grain, parallel_fn fn, void* arg) {
+    size_t begin, end;
+    parallel_slice(cid, nc, n, grain, &begin, &end);
+    if (begin < end)
+        fn(begin, end, arg);
+    parallel_barrier(nc);
+}
@@ -0,0 +1,33 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stddef.h>
+
+/*
+ * Work partitioning across harts. thread_entry(cid, nc) (syscalls.c) runs on every
+ * hart; a kernel that overrides it calls parallel_for on all of them with the same
+ * arguments, and each hart drives its own slice of [0, n) through the VPU.
+ *
+ * Slices are contiguous and their boundaries fall on multiples of grain, so with grain
+ * set to the VLMAX of the kernel's strips every slice but the last is whole strips and
+ * two harts never store into the same vector-register-sized chunk. The chunks are dealt
+ * out as evenly as they go: slice sizes differ by at most one grain.
+ *
+ * parallel_for ends with barrier(nc) (util.h), so on return every hart's slice is done.
+ * With nc == 1 the barrier is skipped; it is built on amoadd, which a single hart has no
+ * need for. crt.S starts NHARTS harts (default 1).
+ */
+
+typedef void (*parallel_fn)(size_t begin, size_t end, void* arg);
+
+// Slice [*begin, *end) of [0, n) for hart cid of nc; empty when n has fewer than nc
+// chunks of grain.
+void parallel_slice(int cid, int nc, size_t n, size_t grain, size_t* begin, size_t* end);
+
+// fn(begin, end, arg) over hart cid's slice (if it is not empty), then the barrier.
+void parallel_for(int cid, int nc, size_t n, size_t grain, parallel_fn fn, void* arg);
+
+// barrier(nc) for nc > 1, for phases between parallel_for calls.
+void parallel_barrier(int nc);
+
+#endif
@@ -9,5 +9,7 @@
 int printf(const char* fmt, ...);
 int sprintf(char* str, const char* fmt, ...);
 int putchar(int ch);
+// Send the calling hart's deferred output (PRINT_RING_BYTES builds) to the host now.
+void print_flush(void);
 
 #endif
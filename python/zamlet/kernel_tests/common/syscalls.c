@@ -7,11 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <riscv_vector.h>
 #include "util.h"
+#include "vpu_alloc.h"
+#include "bench.h"
 
 #define SIGABRT 6
 
 #define SYS_write 64
+// Host-side handler: Oamlet.handle_tohost. Not a Linux syscall number.
+#define SYS_bench 0x5a01
 
 #undef strcmp
 
@@ -36,26 +41,102 @@ static uintptr_t syscall(uintptr_t which, uint64_t arg0, uint64_t arg1, uint64_t
   return magic_mem[0];
 }
 
-#define NUM_COUNTERS 2
+#define NUM_COUNTERS 6
 static uintptr_t counters[NUM_COUNTERS];
-static char* counter_names[NUM_COUNTERS];
+static const char* counter_names[NUM_COUNTERS];
+
+static const char* hpm_event_name(int event)
+{
+  switch (event) {
+    case HPM_EVENT_KINSTR_DISPATCHED: return "kinstrs";
+    case HPM_EVENT_CACHE_MISS: return "cache_misses";
+    case HPM_EVENT_NETWORK_STALL: return "network_stalls";
+    case HPM_EVENT_INSTR_NET_STALL: return "instr_net_stalls";
+    case HPM_EVENT_INDEXED_FAULT: return "indexed_faults";
+    default: return "none";
+  }
+}
+
+// Program mhpmevent3..6 from the HPM_EVENT* selection in util.h.
+static void init_hpm(void)
+{
+  write_csr(mhpmevent3, HPM_EVENT3);
+  write_csr(mhpmevent4, HPM_EVENT4);
+  write_csr(mhpmevent5, HPM_EVENT5);
+  write_csr(mhpmevent6, HPM_EVENT6);
+}
 
 void setStats(int enable)
 {
   int i = 0;
-#define READ_CTR(name) do { \
+#define READ_CTR(name, label) do { \
     while (i >= NUM_COUNTERS) ; \
     uintptr_t csr = read_csr(name); \
-    if (!enable) { csr -= counters[i]; counter_names[i] = #name; } \
+    if (!enable) { csr -= counters[i]; counter_names[i] = (label); } \
     counters[i++] = csr; \
   } while (0)
 
-  READ_CTR(mcycle);
-  READ_CTR(minstret);
+  READ_CTR(mcycle, "mcycle");
+  READ_CTR(minstret, "minstret");
+  READ_CTR(mhpmcounter3, hpm_event_name(HPM_EVENT3));
+  READ_CTR(mhpmcounter4, hpm_event_name(HPM_EVENT4));
+  READ_CTR(mhpmcounter5, hpm_event_name(HPM_EVENT5));
+  READ_CTR(mhpmcounter6, hpm_event_name(HPM_EVENT6));
 
 #undef READ_CTR
 }
 
+// Layout read by Oamlet.handle_tohost for SYS_bench: eleven little-endian u64s.
+typedef struct {
+  uint64_t name;
+  uint64_t cycles;
+  uint64_t instret;
+  uint64_t hpm_event[4];
+  uint64_t hpm[4];
+} bench_record_t;
+
+static bench_record_t bench_stack[BENCH_MAX_DEPTH];
+static int bench_depth;
+
+static void bench_sample(bench_record_t* r)
+{
+  r->cycles = read_csr(mcycle);
+  r->instret = read_csr(minstret);
+  r->hpm[0] = read_csr(mhpmcounter3);
+  r->hpm[1] = read_csr(mhpmcounter4);
+  r->hpm[2] = read_csr(mhpmcounter5);
+  r->hpm[3] = read_csr(mhpmcounter6);
+}
+
+void bench_begin(const char* name)
+{
+  if (bench_depth == BENCH_MAX_DEPTH)
+    abort();
+  bench_record_t* r = &bench_stack[bench_depth++];
+  r->name = (uintptr_t)name;
+  asm volatile("fence");
+  bench_sample(r);
+}
+
+void bench_end(void)
+{
+  bench_record_t end;
+  asm volatile("fence");
+  bench_sample(&end);
+  if (bench_depth == 0)
+    abort();
+  bench_record_t* r = &bench_stack[--bench_depth];
+  r->cycles = end.cycles - r->cycles;
+  r->instret = end.instret - r->instret;
+  for (int i = 0; i < 4; i++)
+    r->hpm[i] = end.hpm[i] - r->hpm[i];
+  r->hpm_event[0] = HPM_EVENT3;
+  r->hpm_event[1] = HPM_EVENT4;
+  r->hpm_event[2] = HPM_EVENT5;
+  r->hpm_event[3] = HPM_EVENT6;
+  syscall(SYS_bench, (uintptr_t)r, sizeof(*r), 0);
+}
+
 void __attribute__((noreturn)) tohost_exit(uintptr_t code)
 {
   tohost = (code << 1) | 1;
@@ -64,11 +145,13 @@ void __attribute__((noreturn)) tohost_exit(uintptr_t code)
 
 uintptr_t __attribute__((weak)) handle_trap(uintptr_t cause, uintptr_t epc, uintptr_t regs[32])
 {
+  print_flush();
   tohost_exit(1337);
 }
 
 void exit(int code)
 {
+  print_flush();
   tohost_exit(code);
 }
 
@@ -77,9 +160,48 @@ void abort()
   exit(128 + SIGABRT);
 }
 
+// Deferred output. With PRINT_RING_BYTES > 0 (benchmark builds), putchar and
+// printstr append to a ring in scalar memory. The ring goes to the host only
+// when it fills, on print_flush, or at exit, so printing inside a timed region
+// costs no HTIF round trips. Otherwise putchar issues one SYS_write per line.
+// Like putchar's line buffer, the ring is thread-local, so each hart appends to
+// its own ring and print_flush (and exit) send only the calling hart's output.
+#ifndef PRINT_RING_BYTES
+#define PRINT_RING_BYTES 0
+#endif
+
+#if PRINT_RING_BYTES > 0
+static __thread char print_ring[PRINT_RING_BYTES] __attribute__((aligned(64)));
+static __thread size_t print_ring_len;
+
+void print_flush(void)
+{
+  if (print_ring_len != 0) {
+    syscall(SYS_write, 1, (uintptr_t)print_ring, print_ring_len);
+    print_ring_len = 0;
+  }
+}
+
+static void print_ring_put(char ch)
+{
+  print_ring[print_ring_len++] = ch;
+  if (print_ring_len == PRINT_RING_BYTES)
+    print_flush();
+}
+#else
+void print_flush(void)
+{
+}
+#endif
+
 void printstr(const char* s)
 {
+#if PRINT_RING_BYTES > 0
+  while (*s)
+    print_ring_put(*s++);
+#else
   syscall(SYS_write, 1, (uintptr_t)s, strlen(s));
+#endif
 }
 
 void __attribute__((weak)) thread_entry(int cid, int nc)
@@ -109,6 +231,7 @@ static void init_tls()
 void _init(int cid, int nc)
 {
   init_tls();
+  init_hpm();
   thread_entry(cid, nc);
 
   // only single-threaded programs should ever get here.
@@ -128,6 +251,9 @@ void _init(int cid, int nc)
 #undef putchar
 int putchar(int ch)
 {
+#if PRINT_RING_BYTES > 0
+  print_ring_put(ch);
+#else
   static __thread char buf[64] __attribute__((aligned(64)));
   static __thread int buflen = 0;
 
@@ -138,6 +264,7 @@ int putchar(int ch)
     syscall(SYS_write, 1, (uintptr_t)buf, buflen);
     buflen = 0;
   }
+#endif
 
   return 0;
 }
@@ -276,6 +403,12 @@ static void vprintfmt(void (*putch)(int, void**), void **putdat, const char *fmt
       lflag++;
       goto reswitch;
 
+    // size_t flag, as wide as long
+    case 'z':
+      static_assert(sizeof(size_t) == sizeof(long));
+      lflag++;
+      goto reswitch;
+
     // character
     case 'c':
       putch(va_arg(ap, int), putdat);
@@ -464,8 +597,83 @@ int sprintf(char* str, const char* fmt, ...)
   return str - str0;
 }
 
+// VPU memory: the static sections, dynamic pool and VPU stack laid out in
+// vpu_alloc.h. Everything else is scalar memory.
+
+static inline int is_vpu_range(const void* p, size_t len)
+{
+  uintptr_t lo = (uintptr_t)p;
+  uintptr_t hi = lo + len;
+  return (lo >= VPU_DATA_BASE && hi <= VPU_DATA_END) ||
+         (lo >= VPU_POOL_BASE && hi <= VPU_POOL_END) ||
+         (lo >= VPU_STACK_BASE && hi <= VPU_STACK_END);
+}
+
+// Element width for a vector copy or fill into dest. Stores at the width the
+// destination is reserved for (vpu_addr_ew) keep its lines in that layout;
+// unreserved VPU memory defaults to e64. Anything not aligned to that width
+// stripmines bytes.
+static int vec_ew(const void* dest, uintptr_t align_bits)
+{
+  int ew = vpu_addr_ew(dest);
+  if (ew == 0)
+    ew = 64;
+  if ((align_bits & (ew / 8 - 1)) != 0)
+    ew = 8;
+  return ew;
+}
+
+#define VEC_COPY_LOOP(EW) do {                                              \
+    uint##EW##_t* d = dest;                                                 \
+    const uint##EW##_t* s = src;                                            \
+    for (size_t n = len / (EW / 8); n > 0; ) {                              \
+      size_t vl = __riscv_vsetvl_e##EW##m8(n);                              \
+      __riscv_vse##EW##_v_u##EW##m8(d, __riscv_vle##EW##_v_u##EW##m8(s, vl), vl); \
+      d += vl;                                                              \
+      s += vl;                                                              \
+      n -= vl;                                                              \
+    }                                                                       \
+  } while (0)
+
+#define VEC_FILL_LOOP(EW) do {                                              \
+    uint##EW##_t* d = dest;                                                 \
+    uint##EW##_t x = (uint##EW##_t)(byte * 0x0101010101010101UL);           \
+    size_t vl = __riscv_vsetvlmax_e##EW##m8();                              \
+    vuint##EW##m8_t v = __riscv_vmv_v_x_u##EW##m8(x, vl);                   \
+    for (size_t n = len / (EW / 8); n > 0; ) {                              \
+      vl = __riscv_vsetvl_e##EW##m8(n);                                     \
+      __riscv_vse##EW##_v_u##EW##m8(d, v, vl);                              \
+      d += vl;                                                              \
+      n -= vl;                                                              \
+    }                                                                       \
+  } while (0)
+
+static void vec_memcpy(void* dest, const void* src, size_t len)
+{
+  switch (vec_ew(dest, (uintptr_t)dest | (uintptr_t)src | len)) {
+  case 64: VEC_COPY_LOOP(64); break;
+  case 32: VEC_COPY_LOOP(32); break;
+  case 16: VEC_COPY_LOOP(16); break;
+  default: VEC_COPY_LOOP(8); break;
+  }
+}
+
+static void vec_memset(void* dest, uint8_t byte, size_t len)
+{
+  switch (vec_ew(dest, (uintptr_t)dest | len)) {
+  case 64: VEC_FILL_LOOP(64); break;
+  case 32: VEC_FILL_LOOP(32); break;
+  case 16: VEC_FILL_LOOP(16); break;
+  default: VEC_FILL_LOOP(8); break;
+  }
+}
+
 void* memcpy(void* dest, const void* src, size_t len)
 {
+  if (len != 0 && is_vpu_range(dest, len) && is_vpu_range(src, len)) {
+    vec_memcpy(dest, src, len);
+    return dest;
+  }
   if ((((uintptr_t)dest | (uintptr_t)src | len) & (sizeof(uintptr_t)-1)) == 0) {
     const uintptr_t* s = src;
     uintptr_t *d = dest;
@@ -496,6 +704,10 @@ void* memcpy(void* dest, const void* src, size_t len)
 
 void* memset(void* dest, int byte, size_t len)
 {
+  if (len != 0 && is_vpu_range(dest, len)) {
+    vec_memset(dest, byte, len);
+    return dest;
+  }
   if ((((uintptr_t)dest | len) & (sizeof(uintptr_t)-1)) == 0) {
     uintptr_t word = byte & 0xFF;
     word |= word << 8;
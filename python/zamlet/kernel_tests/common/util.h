@@ -8,6 +8,30 @@
 
 extern void setStats(int enable);
 
+/* Performance events for mhpmcounter3..6. Keep in sync with HpmEvent in
+ * python/zamlet/hpm.py. */
+#define HPM_EVENT_NONE              0
+#define HPM_EVENT_KINSTR_DISPATCHED 1
+#define HPM_EVENT_CACHE_MISS        2
+#define HPM_EVENT_NETWORK_STALL     3
+#define HPM_EVENT_INSTR_NET_STALL   4
+#define HPM_EVENT_INDEXED_FAULT     5
+
+/* Events selected onto mhpmcounter3..6 before main runs. Override per kernel with
+ * e.g. -DHPM_EVENT6=HPM_EVENT_INSTR_NET_STALL. */
+#ifndef HPM_EVENT3
+#define HPM_EVENT3 HPM_EVENT_KINSTR_DISPATCHED
+#endif
+#ifndef HPM_EVENT4
+#define HPM_EVENT4 HPM_EVENT_CACHE_MISS
+#endif
+#ifndef HPM_EVENT5
+#define HPM_EVENT5 HPM_EVENT_NETWORK_STALL
+#endif
+#ifndef HPM_EVENT6
+#define HPM_EVENT6 HPM_EVENT_INDEXED_FAULT
+#endif
+
 #include <stdint.h>
 
 #define static_assert(cond) switch(0) { case 0: case !!(long)(cond): ; }
@@ -60,6 +84,64 @@ static int verifyFloat(int n, const volatile float* test, const float* verify)
   return 0;
 }
 
+#ifdef __riscv_vector
+#include <riscv_vector.h>
+
+/*
+ * Vector versions of verifyFloat and verifyDouble, with the same result: 1 + the index
+ * of the first element that differs, or 0 if all n match. Each m8 strip of both arrays
+ * is compared with vmfne and the first mismatch found with vfirst.m, so the
+ * scalar core waits on one result per strip instead of loading every element. Both arrays
+ * are read with vector loads, so they should be VPU data (vpu_alloc or a .data.vpu
+ * section).
+ *
+ * vverifyFloatTol and vverifyDoubleTol accept |test[i * stride] - verify[i]| <= tol
+ * instead; a NaN on either side is a mismatch. stride counts elements of test, e.g. 2 for
+ * one component of an interleaved complex array.
+ */
+
+// VVERIFY_FP_DEFINE(NAME, T, S, EW, MB) defines vverify<NAME> and vverify<NAME>Tol for
+// element type T, intrinsic suffix S, element width EW and m8 mask type vbool<MB>_t.
+#define VVERIFY_FP_DEFINE(NAME, T, S, EW, MB)                                           \
+static int vverify##NAME(int n, const volatile T* test, const T* verify)                \
+{                                                                                       \
+  for (int i = 0; i < n; ) {                                                            \
+    size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                        \
+    vfloat##EW##m8_t t = __riscv_vle##EW##_v_##S##m8((const T*)&test[i], vl);           \
+    vbool##MB##_t ne = __riscv_vmfne_vv_##S##m8_b##MB(                                  \
+        t, __riscv_vle##EW##_v_##S##m8(&verify[i], vl), vl);                            \
+    long first = __riscv_vfirst_m_b##MB(ne, vl);                                        \
+    if (first >= 0)                                                                     \
+      return i + first + 1;                                                             \
+    i += vl;                                                                            \
+  }                                                                                     \
+  return 0;                                                                             \
+}                                                                                       \
+                                                                                        \
+static int vverify##NAME##Tol(int n, const volatile T* test, long stride,               \
+                              const T* verify, T tol)                                   \
+{                                                                                       \
+  for (int i = 0; i < n; ) {                                                            \
+    size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                        \
+    const T* p = (const T*)&test[(long)i * stride];                                     \
+    vfloat##EW##m8_t t = stride == 1 ? __riscv_vle##EW##_v_##S##m8(p, vl)               \
+        : __riscv_vlse##EW##_v_##S##m8(p, stride * (long)sizeof(T), vl);                \
+    vfloat##EW##m8_t d = __riscv_vfsub_vv_##S##m8(                                      \
+        t, __riscv_vle##EW##_v_##S##m8(&verify[i], vl), vl);                            \
+    vbool##MB##_t ok = __riscv_vmfle_vf_##S##m8_b##MB(__riscv_vfabs_v_##S##m8(d, vl),   \
+                                                      tol, vl);                         \
+    long first = __riscv_vfirst_m_b##MB(__riscv_vmnot_m_b##MB(ok, vl), vl);             \
+    if (first >= 0)                                                                     \
+      return i + first + 1;                                                             \
+    i += vl;                                                                            \
+  }                                                                                     \
+  return 0;                                                                             \
+}
+
+VVERIFY_FP_DEFINE(Float, float, f32, 32, 4)
+VVERIFY_FP_DEFINE(Double, double, f64, 64, 8)
+#endif
+
 static void __attribute__((noinline)) barrier(int ncores)
 {
   static volatile int sense;
@@ -99,11 +181,17 @@ static uintptr_t insn_len(uintptr_t pc)
 #define stringify(s) stringify_1(s)
 #define stats(code, iter) do { \
     unsigned long _c = -read_csr(mcycle), _i = -read_csr(minstret); \
+    unsigned long _h3 = -read_csr(mhpmcounter3), _h4 = -read_csr(mhpmcounter4); \
+    unsigned long _h5 = -read_csr(mhpmcounter5), _h6 = -read_csr(mhpmcounter6); \
     code; \
     _c += read_csr(mcycle), _i += read_csr(minstret); \
-    if (cid == 0) \
+    _h3 += read_csr(mhpmcounter3), _h4 += read_csr(mhpmcounter4); \
+    _h5 += read_csr(mhpmcounter5), _h6 += read_csr(mhpmcounter6); \
+    if (cid == 0) { \
       printf("\n%s: %ld cycles, %ld.%ld cycles/iter, %ld.%ld CPI\n", \
              stringify(code), _c, _c/iter, 10*_c/iter%10, _c/_i, 10*_c/_i%10); \
+      printf("  hpm3 = %ld, hpm4 = %ld, hpm5 = %ld, hpm6 = %ld\n", _h3, _h4, _h5, _h6); \
+    } \
   } while(0)
 
 #endif //__UTIL_H
@@ -0,0 +1,120 @@
+#include <riscv_vector.h>
+#include "vinit.h"
+#include "util.h"
+
+/*
+ * VINIT_STORE(S, T, EW, TY) defines store_<S>, with TY the vector type stem (uint /
+ * float): one strip v of vl elements to dst[i * stride] on, unit-stride when stride
+ * is 1.
+ */
+#define VINIT_STORE(S, T, EW, TY)                                                        \
+static inline void store_##S(T* dst, ptrdiff_t stride, size_t i, v##TY##EW##m8_t v,      \
+                             size_t vl) {                                                \
+    if (stride == 1)                                                                     \
+        __riscv_vse##EW##_v_##S##m8(&dst[i], v, vl);                                     \
+    else                                                                                 \
+        __riscv_vsse##EW##_v_##S##m8(&dst[(ptrdiff_t)i * stride],                        \
+                                     stride * (ptrdiff_t)sizeof(T), v, vl);              \
+}
+
+/*
+ * VINIT_INT_DEFINE(S, T, EW) defines the fill and affine functions for unsigned element
+ * type T with intrinsic suffix S.
+ */
+#define VINIT_INT_DEFINE(S, T, EW)                                                       \
+VINIT_STORE(S, T, EW, uint)                                                              \
+                                                                                         \
+void vinit_fill_##S(T* dst, size_t n, T c) {                                             \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                     \
+        __riscv_vse##EW##_v_##S##m8(&dst[i], __riscv_vmv_v_x_##S##m8(c, vl), vl);        \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+void vinit_affine_stride_##S(T* dst, ptrdiff_t stride, size_t n, T a, T b) {             \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                     \
+        vuint##EW##m8_t k = __riscv_vadd_vx_##S##m8(__riscv_vid_v_##S##m8(vl), (T)i, vl); \
+        vuint##EW##m8_t v = __riscv_vadd_vx_##S##m8(__riscv_vmul_vx_##S##m8(k, a, vl),   \
+                                                    b, vl);                              \
+        store_##S(dst, stride, i, v, vl);                                                \
+        i += vl;                                                                         \
+    }                                                                                    \
+}
+
+/*
+ * VINIT_FP_DEFINE(S, T, EW, U) is the same for float type T, with U the unsigned
+ * suffix of its width for the vid.v index.
+ */
+#define VINIT_FP_DEFINE(S, T, EW, U)                                                     \
+VINIT_STORE(S, T, EW, float)                                                             \
+                                                                                         \
+void vinit_fill_##S(T* dst, size_t n, T c) {                                             \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                     \
+        __riscv_vse##EW##_v_##S##m8(&dst[i], __riscv_vfmv_v_f_##S##m8(c, vl), vl);       \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+void vinit_affine_stride_##S(T* dst, ptrdiff_t stride, size_t n, T a, T b) {             \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                     \
+        vuint##EW##m8_t k = __riscv_vadd_vx_##U##m8(__riscv_vid_v_##U##m8(vl), i, vl);   \
+        vfloat##EW##m8_t x = __riscv_vfcvt_f_xu_v_##S##m8(k, vl);                        \
+        vfloat##EW##m8_t v = __riscv_vfadd_vf_##S##m8(__riscv_vfmul_vf_##S##m8(x, a, vl), \
+                                                      b, vl);                            \
+        store_##S(dst, stride, i, v, vl);                                                \
+        i += vl;                                                                         \
+    }                                                                                    \
+}
+
+VINIT_INT_DEFINE(u8, uint8_t, 8)
+VINIT_INT_DEFINE(u32, uint32_t, 32)
+VINIT_INT_DEFINE(u64, uint64_t, 64)
+VINIT_FP_DEFINE(f32, float, 32, u32)
+VINIT_FP_DEFINE(f64, double, 64, u64)
+
+// Longest jump lfsr_jump takes in one step; see lfsr_jump.
+#define LFSR_MAX_JUMP 62
+
+// k <= LFSR_MAX_JUMP steps of lfsr() on every lane, for states with bit 63 clear (every
+// state after the first step). The k feedback bits are bits 0..k-1 of x ^ (x >> 1), all
+// taken from the starting state, and they land above the k-bit right shift of x.
+static inline vuint64m8_t lfsr_jump(vuint64m8_t x, size_t k, size_t vl) {
+    uint64_t mask = (1ull << k) - 1;
+    vuint64m8_t fb = __riscv_vand_vx_u64m8(
+        __riscv_vxor_vv_u64m8(x, __riscv_vsrl_vx_u64m8(x, 1, vl), vl), mask, vl);
+    return __riscv_vor_vv_u64m8(__riscv_vsrl_vx_u64m8(x, k, vl),
+                                __riscv_vsll_vx_u64m8(fb, 63 - k, vl), vl);
+}
+
+static vuint64m8_t lfsr_advance(vuint64m8_t x, size_t k, size_t vl) {
+    while (k > 0) {
+        size_t step = k < LFSR_MAX_JUMP ? k : LFSR_MAX_JUMP;
+        x = lfsr_jump(x, step, vl);
+        k -= step;
+    }
+    return x;
+}
+
+void vinit_lfsr_u64(uint64_t* dst, size_t n, uint64_t seed) {
+    // The first step is lfsr() itself, which also clears bit 63 of the seed.
+    uint64_t first = lfsr(seed);
+
+    // Lane j holds the state j steps after first, built by doubling: lanes [len, 2 len)
+    // are lanes [0, len) advanced by len.
+    size_t vlmax = __riscv_vsetvlmax_e64m8();
+    vuint64m8_t x = __riscv_vmv_v_x_u64m8(first, vlmax);
+    for (size_t len = 1; len < vlmax; len *= 2)
+        x = __riscv_vslideup_vx_u64m8(x, lfsr_advance(x, len, vlmax), len, vlmax);
+
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        __riscv_vse64_v_u64m8(&dst[i], x, vl);
+        i += vl;
+        if (i < n)
+            x = lfsr_advance(x, vl, vl);
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef VINIT_H
+#define VINIT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Vector fills for kernel input data, so setup runs at vector store bandwidth instead
+ * of one scalar store per element. Each function writes e<EW>m8 strips of dst.
+ *
+ *   vinit_fill_*          dst[i] = c
+ *   vinit_affine_*        dst[i] = a * i + b
+ *   vinit_affine_stride_* dst[i * stride] = a * i + b, stride in elements (vsse when
+ *                         stride != 1), e.g. 2 for one half of interleaved pairs
+ *   vinit_iota_*          dst[i] = i
+ *   vinit_lfsr_u64        dst[i] = the (i + 1)th value of x = lfsr(x) from seed
+ *
+ * The affine index comes from vid.v plus the strip's start, converted with vfcvt.f.xu
+ * for the float types, then multiplied by a and offset by b as two rounded operations,
+ * so a float fill matches the scalar a * (double)i + b unless the compiler fuses it.
+ * The integer types wrap: vinit_iota_u8 gives i mod 256.
+ *
+ * vinit_lfsr_u64 produces the same sequence as the scalar loop over lfsr() (util.h).
+ * k steps of that 63-bit LFSR for k <= 62 are one closed-form shift and mask, so each
+ * lane of a strip holds the state i steps along and every lane jumps by vl at once.
+ */
+
+void vinit_fill_u8(uint8_t* dst, size_t n, uint8_t c);
+void vinit_fill_u32(uint32_t* dst, size_t n, uint32_t c);
+void vinit_fill_u64(uint64_t* dst, size_t n, uint64_t c);
+void vinit_fill_f32(float* dst, size_t n, float c);
+void vinit_fill_f64(double* dst, size_t n, double c);
+
+void vinit_affine_stride_u8(uint8_t* dst, ptrdiff_t stride, size_t n, uint8_t a, uint8_t b);
+void vinit_affine_stride_u32(uint32_t* dst, ptrdiff_t stride, size_t n, uint32_t a,
+                             uint32_t b);
+void vinit_affine_stride_u64(uint64_t* dst, ptrdiff_t stride, size_t n, uint64_t a,
+                             uint64_t b);
+void vinit_affine_stride_f32(float* dst, ptrdiff_t stride, size_t n, float a, float b);
+void vinit_affine_stride_f64(double* dst, ptrdiff_t stride, size_t n, double a, double b);
+
+void vinit_lfsr_u64(uint64_t* dst, size_t n, uint64_t seed);
+
+#define VINIT_AFFINE(S, T)                                                               \
+static inline void vinit_affine_##S(T* dst, size_t n, T a, T b) {                        \
+    vinit_affine_stride_##S(dst, 1, n, a, b);                                            \
+}                                                                                        \
+                                                                                         \
+static inline void vinit_iota_##S(T* dst, size_t n) {                                    \
+    vinit_affine_stride_##S(dst, 1, n, 1, 0);                                            \
+}
+
+VINIT_AFFINE(u8, uint8_t)
+VINIT_AFFINE(u32, uint32_t)
+VINIT_AFFINE(u64, uint64_t)
+VINIT_AFFINE(f32, float)
+VINIT_AFFINE(f64, double)
+
+#undef VINIT_AFFINE
+
+#endif
@@ -0,0 +1,78 @@
+#include <riscv_vector.h>
+#include "vminmax.h"
+
+/*
+ * VMINMAX_DEFINE(S, T, EW, TY, B, MIN, MAX, RMIN, RMAX, LT, EQ, MV, SC) defines the four
+ * functions for element type T, where S is the intrinsic type suffix (i32, f64, ...), TY
+ * the vector type stem (int / float), B the mask ratio of e<EW>m4 (8 / 16), MIN / MAX the
+ * elementwise stems (vmin / vfmin ...), RMIN / RMAX the reduction stems (vredmin /
+ * vfredmin ...), LT / EQ the compare stems (vmslt / vmflt, vmseq / vmfeq), MV the move
+ * stem (vmv / vfmv) and SC the scalar operand letter (x / f).
+ */
+#define VMINMAX_DEFINE(S, T, EW, TY, B, MIN, MAX, RMIN, RMAX, LT, EQ, MV, SC)               \
+static inline T min_max_##S(const T* src, size_t n, int max) {                           \
+    size_t vl0 = __riscv_vsetvl_e##EW##m8(n);                                            \
+    v##TY##EW##m8_t best = __riscv_vle##EW##_v_##S##m8(src, vl0);                        \
+    for (size_t i = vl0; i < n; ) {                                                      \
+        size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                     \
+        v##TY##EW##m8_t v = __riscv_vle##EW##_v_##S##m8(&src[i], vl);                    \
+        best = max ? __riscv_##MAX##_vv_##S##m8_tu(best, best, v, vl)                    \
+                   : __riscv_##MIN##_vv_##S##m8_tu(best, best, v, vl);                   \
+        i += vl;                                                                         \
+    }                                                                                    \
+    v##TY##EW##m1_t seed = __riscv_vlmul_trunc_v_##S##m8_##S##m1(best);                  \
+    return __riscv_##MV##_##SC##_s_##S##m1_##S(                                          \
+        max ? __riscv_##RMAX##_vs_##S##m8_##S##m1(best, seed, vl0)                       \
+            : __riscv_##RMIN##_vs_##S##m8_##S##m1(best, seed, vl0));                     \
+}                                                                                        \
+                                                                                         \
+static inline size_t arg_##S(const T* src, size_t n, int max) {                          \
+    size_t vl0 = __riscv_vsetvl_e##EW##m4(n);                                            \
+    v##TY##EW##m4_t best = __riscv_vle##EW##_v_##S##m4(src, vl0);                        \
+    vuint##EW##m4_t idx = __riscv_vid_v_u##EW##m4(vl0);                                  \
+    for (size_t i = vl0; i < n; ) {                                                      \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        v##TY##EW##m4_t v = __riscv_vle##EW##_v_##S##m4(&src[i], vl);                    \
+        vbool##B##_t better = max ? __riscv_##LT##_vv_##S##m4_b##B(best, v, vl)          \
+                                  : __riscv_##LT##_vv_##S##m4_b##B(v, best, vl);         \
+        best = __riscv_vmerge_vvm_##S##m4_tu(best, best, v, better, vl);                 \
+        idx = __riscv_vmerge_vvm_u##EW##m4_tu(                                           \
+            idx, idx, __riscv_vadd_vx_u##EW##m4(__riscv_vid_v_u##EW##m4(vl), i, vl),     \
+            better, vl);                                                                 \
+        i += vl;                                                                         \
+    }                                                                                    \
+    v##TY##EW##m1_t seed = __riscv_vlmul_trunc_v_##S##m4_##S##m1(best);                  \
+    T want = __riscv_##MV##_##SC##_s_##S##m1_##S(                                        \
+        max ? __riscv_##RMAX##_vs_##S##m4_##S##m1(best, seed, vl0)                       \
+            : __riscv_##RMIN##_vs_##S##m4_##S##m1(best, seed, vl0));                     \
+    vbool##B##_t hit = __riscv_##EQ##_v##SC##_##S##m4_b##B(best, want, vl0);             \
+    vuint##EW##m1_t none = __riscv_vmv_s_x_u##EW##m1(UINT##EW##_MAX, 1);                 \
+    return __riscv_vmv_x_s_u##EW##m1_u##EW(                                              \
+        __riscv_vredminu_vs_u##EW##m4_u##EW##m1_m(hit, idx, none, vl0));                 \
+}                                                                                        \
+                                                                                         \
+T vminmax_min_##S(const T* src, size_t n) {                                              \
+    return min_max_##S(src, n, 0);                                                       \
+}                                                                                        \
+                                                                                         \
+T vminmax_max_##S(const T* src, size_t n) {                                              \
+    return min_max_##S(src, n, 1);                                                       \
+}                                                                                        \
+                                                                                         \
+size_t vminmax_argmin_##S(const T* src, size_t n) {                                      \
+    return arg_##S(src, n, 0);                                                           \
+}                                                                                        \
+                                                                                         \
+size_t vminmax_argmax_##S(const T* src, size_t n) {                                      \
+    return arg_##S(src, n, 1);                                                           \
+}
+
+#define VMINMAX_DEFINE_INT(S, T, EW, B) \
+    VMINMAX_DEFINE(S, T, EW, int, B, vmin, vmax, vredmin, vredmax, vmslt, vmseq, vmv, x)
+#define VMINMAX_DEFINE_FLOAT(S, T, EW, B) \
+    VMINMAX_DEFINE(S, T, EW, float, B, vfmin, vfmax, vfredmin, vfredmax, vmflt, vmfeq, vfmv, f)
+
+VMINMAX_DEFINE_INT(i32, int32_t, 32, 8)
+VMINMAX_DEFINE_INT(i64, int64_t, 64, 16)
+VMINMAX_DEFINE_FLOAT(f32, float, 32, 8)
+VMINMAX_DEFINE_FLOAT(f64, double, 64, 16)
@@ -0,0 +1,47 @@
+#ifndef VMINMAX_H
+#define VMINMAX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Min, max, argmin and argmax over i32, i64, f32 and f64 arrays of n > 0 elements.
+ * vminmax_arg* return the lowest index holding the min / max.
+ *
+ * Each function makes one pass of strips and keeps a per-lane best in vector registers,
+ * so nothing crosses the kamlets until the end:
+ *
+ *   min / max        e<EW>m8 vmin / vmax (vfmin / vfmax) into the best, tail undisturbed,
+ *                    then one vredmin / vredmax (vfredmin / vfredmax).
+ *   argmin / argmax  e<EW>m4 best values and e<EW> indices. Where a strip element beats
+ *                    its lane's best (vmslt / vmflt) both are replaced with vmerge, so
+ *                    each lane keeps its first best. At the end two reductions cross the
+ *                    kamlets: one over the values gives the best, then vmseq / vmfeq
+ *                    marks the lanes holding it and a masked vredminu over their indices
+ *                    picks the lowest.
+ *
+ * The first strip seeds the lanes, so the final reductions only cover lanes that saw an
+ * element. The float versions assume there are no NaNs.
+ */
+
+int32_t vminmax_min_i32(const int32_t* src, size_t n);
+int32_t vminmax_max_i32(const int32_t* src, size_t n);
+size_t vminmax_argmin_i32(const int32_t* src, size_t n);
+size_t vminmax_argmax_i32(const int32_t* src, size_t n);
+
+int64_t vminmax_min_i64(const int64_t* src, size_t n);
+int64_t vminmax_max_i64(const int64_t* src, size_t n);
+size_t vminmax_argmin_i64(const int64_t* src, size_t n);
+size_t vminmax_argmax_i64(const int64_t* src, size_t n);
+
+float vminmax_min_f32(const float* src, size_t n);
+float vminmax_max_f32(const float* src, size_t n);
+size_t vminmax_argmin_f32(const float* src, size_t n);
+size_t vminmax_argmax_f32(const float* src, size_t n);
+
+double vminmax_min_f64(const double* src, size_t n);
+double vminmax_max_f64(const double* src, size_t n);
+size_t vminmax_argmin_f64(const double* src, size_t n);
+size_t vminmax_argmax_f64(const double* src, size_t n);
+
+#endif
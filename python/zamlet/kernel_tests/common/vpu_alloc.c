@@ -1,27 +1,148 @@
 #include "vpu_alloc.h"
 #include <stdint.h>
 #include <stdlib.h>
+#include <riscv_vector.h>
 
-#define VPU_BASE      0x90000000
-#define VPU_POOL_SIZE (1024 * 1024)  // 1MB
-
-#define N_LANES 4
 #define WORD_WIDTH 8
-#define ALIGNMENT (N_LANES * WORD_WIDTH)
 
-static uintptr_t brk = VPU_BASE;
+// Scratch size classes are MIN_CLASS_SIZE << c for c in [0, N_SIZE_CLASSES).
+// Free lists live in scalar memory so recycling a block never touches VPU
+// memory. A block freed into a full list is simply dropped until the next
+// arena reset below it.
+#define N_SIZE_CLASSES 12
+#define MAX_FREE_PER_CLASS 16
+#define MIN_CLASS_SIZE 32
 
-void* vpu_alloc(size_t size) {
-    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+static uintptr_t brk = VPU_POOL_BASE;
+
+static uintptr_t ew_brk[4] = {
+    VPU_EW_HEAP_BASE + 0 * VPU_EW_HEAP_SIZE,
+    VPU_EW_HEAP_BASE + 1 * VPU_EW_HEAP_SIZE,
+    VPU_EW_HEAP_BASE + 2 * VPU_EW_HEAP_SIZE,
+    VPU_EW_HEAP_BASE + 3 * VPU_EW_HEAP_SIZE,
+};
 
-    brk = (brk + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+static uintptr_t free_blocks[N_SIZE_CLASSES][MAX_FREE_PER_CLASS];
+static int n_free[N_SIZE_CLASSES];
+
+// Default alignment is one full vector register (VLEN / 8 bytes), read from
+// the hardware so it follows the geometry the kernel runs on. A buffer that
+// starts on this boundary puts element 0 in the first jamlet, so unit-stride
+// accesses take the aligned path. test.ld's VLMAX_BYTES is a single constant
+// shared by every geometry, so it is not used here.
+static size_t default_alignment(void) {
+    static size_t alignment;
+    if (alignment == 0) {
+        alignment = __riscv_vsetvlmax_e8m1();
+        if (alignment < WORD_WIDTH) {
+            alignment = WORD_WIDTH;
+        }
+    }
+    return alignment;
+}
+
+size_t vpu_alloc_alignment(void) {
+    return default_alignment();
+}
+
+void* vpu_alloc_aligned(size_t size, size_t align) {
+    if (align < WORD_WIDTH) {
+        align = WORD_WIDTH;
+    }
+    if ((align & (align - 1)) != 0) {
+        exit(4);
+    }
+    size = (size + WORD_WIDTH - 1) & ~(size_t)(WORD_WIDTH - 1);
+
+    brk = (brk + align - 1) & ~(uintptr_t)(align - 1);
 
     void* ptr = (void*)brk;
     brk += size;
 
-    if (brk > VPU_BASE + VPU_POOL_SIZE) {
+    if (brk > VPU_POOL_BASE + VPU_POOL_SIZE) {
+        exit(2);
+    }
+
+    return ptr;
+}
+
+void* vpu_alloc(size_t size) {
+    size_t align = default_alignment();
+    size = (size + align - 1) & ~(align - 1);
+    return vpu_alloc_aligned(size, align);
+}
+
+void* vpu_alloc_ew(size_t size, int ew) {
+    int i;
+    switch (ew) {
+    case 8:  i = 0; break;
+    case 16: i = 1; break;
+    case 32: i = 2; break;
+    case 64: i = 3; break;
+    default: exit(5);
+    }
+    size_t align = default_alignment();
+    size = (size + align - 1) & ~(align - 1);
+
+    ew_brk[i] = (ew_brk[i] + align - 1) & ~(uintptr_t)(align - 1);
+
+    void* ptr = (void*)ew_brk[i];
+    ew_brk[i] += size;
+
+    if (ew_brk[i] > VPU_EW_HEAP_BASE + (uintptr_t)(i + 1) * VPU_EW_HEAP_SIZE) {
         exit(2);
     }
 
     return ptr;
 }
+
+vpu_arena_mark_t vpu_arena_mark(void) {
+    return brk;
+}
+
+void vpu_arena_reset(vpu_arena_mark_t mark) {
+    if (mark < VPU_POOL_BASE || mark > brk) {
+        exit(3);
+    }
+    brk = mark;
+
+    for (int c = 0; c < N_SIZE_CLASSES; c++) {
+        int kept = 0;
+        for (int i = 0; i < n_free[c]; i++) {
+            if (free_blocks[c][i] < mark) {
+                free_blocks[c][kept++] = free_blocks[c][i];
+            }
+        }
+        n_free[c] = kept;
+    }
+}
+
+// Size class for a request, or -1 if it is larger than the biggest class.
+static int size_class(size_t size) {
+    int c = 0;
+    size_t class_size = MIN_CLASS_SIZE;
+    while (class_size < size) {
+        class_size <<= 1;
+        c++;
+    }
+    return c < N_SIZE_CLASSES ? c : -1;
+}
+
+void* vpu_scratch_alloc(size_t size) {
+    int c = size_class(size);
+    if (c < 0) {
+        return vpu_alloc(size);
+    }
+    if (n_free[c] > 0) {
+        return (void*)free_blocks[c][--n_free[c]];
+    }
+    return vpu_alloc((size_t)MIN_CLASS_SIZE << c);
+}
+
+void vpu_scratch_free(void* ptr, size_t size) {
+    int c = size_class(size);
+    if (c < 0 || n_free[c] == MAX_FREE_PER_CLASS) {
+        return;
+    }
+    free_blocks[c][n_free[c]++] = (uintptr_t)ptr;
+}
@@ -1,8 +1,71 @@
 #ifndef VPU_ALLOC_H
 #define VPU_ALLOC_H
 
+// VPU address map. The static .data.vpu{8,16,32,64} sections (test.ld) sit
+// VPU_DATA_EW_STRIDE apart. The dynamic pool is the general heap used by
+// vpu_alloc and the scratch lists, followed by one heap per element width for
+// vpu_alloc_ew. run_oamlet.py allocates [VPU_POOL_BASE, VPU_POOL_END) and the
+// VPU stack [VPU_STACK_BASE, VPU_STACK_END).
+#define VPU_DATA_BASE       0x20000000UL
+#define VPU_DATA_EW_STRIDE  0x00800000UL
+#define VPU_DATA_END        (VPU_DATA_BASE + 4 * VPU_DATA_EW_STRIDE)
+#define VPU_POOL_BASE       0x90000000UL
+#define VPU_POOL_SIZE       0x00100000UL
+#define VPU_EW_HEAP_BASE    (VPU_POOL_BASE + VPU_POOL_SIZE)
+#define VPU_EW_HEAP_SIZE    0x00040000UL
+#define VPU_POOL_END        (VPU_EW_HEAP_BASE + 4 * VPU_EW_HEAP_SIZE)
+
+// The VPU stack, which crt.S points s11 at (top down) and splits between harts.
+// No UL suffix, so the assembler can read these too.
+#define VPU_STACK_BASE      0xA0000000
+#define VPU_STACK_SIZE      0x00040000
+#define VPU_STACK_END       (VPU_STACK_BASE + VPU_STACK_SIZE)
+
+#ifndef __ASSEMBLER__
+
 #include <stddef.h>
+#include <stdint.h>
 
+// Element width a VPU address is reserved for: 8, 16, 32 or 64 inside a
+// .data.vpuN section or a vpu_alloc_ew heap, 0 anywhere else.
+static inline int vpu_addr_ew(const void* p) {
+    uintptr_t a = (uintptr_t)p;
+    if (a >= VPU_DATA_BASE && a < VPU_DATA_END) {
+        return 8 << ((a - VPU_DATA_BASE) / VPU_DATA_EW_STRIDE);
+    }
+    if (a >= VPU_EW_HEAP_BASE && a < VPU_POOL_END) {
+        return 8 << ((a - VPU_EW_HEAP_BASE) / VPU_EW_HEAP_SIZE);
+    }
+    return 0;
+}
+
+// vpu_alloc aligns to vpu_alloc_alignment(), the byte length of one vector
+// register on this geometry. vpu_alloc_aligned takes an explicit power-of-two
+// alignment, e.g. a cache line or several VLENs; it is raised to at least 8.
 void* vpu_alloc(size_t size);
+void* vpu_alloc_aligned(size_t size, size_t align);
+size_t vpu_alloc_alignment(void);
+
+// Allocate from the heap for element width ew (8, 16, 32 or 64). Buffers that
+// are only ever accessed at one element width should come from here so that
+// memcpy/memset touch them at that width too. These heaps are bump-only and
+// are not affected by arena marks.
+void* vpu_alloc_ew(size_t size, int ew);
+
+// Arena marks. vpu_arena_reset releases everything allocated since the mark
+// was taken, including blocks sitting on the scratch free lists.
+typedef uintptr_t vpu_arena_mark_t;
+
+vpu_arena_mark_t vpu_arena_mark(void);
+void vpu_arena_reset(vpu_arena_mark_t mark);
+
+// Fixed-size scratch buffers, rounded up to a power-of-two size class.
+// vpu_scratch_free must be passed the same size the block was allocated with.
+// A freed block is handed back by the next request in its class, so repeated
+// temporaries reuse the same lines rather than growing the pool.
+void* vpu_scratch_alloc(size_t size);
+void vpu_scratch_free(void* ptr, size_t size);
+
+#endif
 
 #endif
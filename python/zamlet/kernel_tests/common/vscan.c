@@ -0,0 +1,95 @@
+#include <riscv_vector.h>
+#include "vscan.h"
+
+/*
+ * VSCAN_DEFINE(S, T, EW, TY, ADD, MV, SC, RED) defines the scans for element type T,
+ * where S is the intrinsic type suffix (u32, f64, ...), TY the vector type stem
+ * (uint / float), ADD the add stem (vadd / vfadd), MV the move stem (vmv / vfmv), SC
+ * the scalar operand letter (x / f) and RED the sum reduction stem (vredsum /
+ * vfredusum).
+ */
+#define VSCAN_DEFINE(S, T, EW, TY, ADD, MV, SC, RED)                                     \
+static inline v##TY##EW##m4_t strip_scan_##S(v##TY##EW##m4_t v, size_t vl) {             \
+    v##TY##EW##m4_t zero = __riscv_##MV##_v_##SC##_##S##m4(0, vl);                       \
+    for (size_t d = 1; d < vl; d *= 2)                                                   \
+        v = __riscv_##ADD##_vv_##S##m4(v, __riscv_vslideup_vx_##S##m4(zero, v, d, vl), vl); \
+    return v;                                                                            \
+}                                                                                        \
+                                                                                         \
+static T scan_##S(const T* src, T* dst, size_t n, int inclusive) {                       \
+    T carry = 0;                                                                         \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        v##TY##EW##m4_t v = __riscv_vle##EW##_v_##S##m4(&src[i], vl);                    \
+        v##TY##EW##m4_t s = __riscv_##ADD##_v##SC##_##S##m4(strip_scan_##S(v, vl), carry, vl); \
+        if (!inclusive)                                                                  \
+            v = __riscv_vslideup_vx_##S##m4(__riscv_##MV##_v_##SC##_##S##m4(carry, vl), s, 1, vl); \
+        __riscv_vse##EW##_v_##S##m4(&dst[i], inclusive ? s : v, vl);                     \
+        carry = __riscv_##MV##_##SC##_s_##S##m4_##S(                                     \
+            __riscv_vslidedown_vx_##S##m4(s, vl - 1, vl));                               \
+        i += vl;                                                                         \
+    }                                                                                    \
+    return carry;                                                                        \
+}                                                                                        \
+                                                                                         \
+static T block_scan_##S(const T* src, T* dst, size_t n, T* sums, int inclusive) {        \
+    size_t vlmax = __riscv_vsetvlmax_e##EW##m4();                                        \
+    size_t block = VSCAN_BLOCK_STRIPS * vlmax;                                           \
+    size_t n_blocks = (n + block - 1) / block;                                           \
+    for (size_t b = 0; b < n_blocks; b++) {                                              \
+        size_t end = b * block + block < n ? b * block + block : n;                      \
+        v##TY##EW##m4_t acc = __riscv_##MV##_v_##SC##_##S##m4(0, vlmax);                 \
+        for (size_t i = b * block; i < end; ) {                                          \
+            size_t vl = __riscv_vsetvl_e##EW##m4(end - i);                               \
+            acc = __riscv_##ADD##_vv_##S##m4_tu(                                         \
+                acc, acc, __riscv_vle##EW##_v_##S##m4(&src[i], vl), vl);                 \
+            i += vl;                                                                     \
+        }                                                                                \
+        v##TY##EW##m1_t total = __riscv_##RED##_vs_##S##m4_##S##m1(                      \
+            acc, __riscv_##MV##_s_##SC##_##S##m1(0, 1), vlmax);                          \
+        __riscv_vse##EW##_v_##S##m1(&sums[b], total, 1);                                 \
+    }                                                                                    \
+    T total = scan_##S(sums, sums, n_blocks, 0);                                         \
+    for (size_t b = 0; b < n_blocks; b++) {                                              \
+        size_t end = b * block + block < n ? b * block + block : n;                      \
+        v##TY##EW##m4_t carry = __riscv_vrgather_vx_##S##m4(                             \
+            __riscv_vle##EW##_v_##S##m4(&sums[b], 1), 0, vlmax);                         \
+        for (size_t i = b * block; i < end; ) {                                          \
+            size_t vl = __riscv_vsetvl_e##EW##m4(end - i);                               \
+            v##TY##EW##m4_t v = __riscv_vle##EW##_v_##S##m4(&src[i], vl);                \
+            v##TY##EW##m4_t s = __riscv_##ADD##_vv_##S##m4(strip_scan_##S(v, vl), carry, vl); \
+            if (!inclusive)                                                              \
+                v = __riscv_vslideup_vx_##S##m4(carry, s, 1, vl);                        \
+            __riscv_vse##EW##_v_##S##m4(&dst[i], inclusive ? s : v, vl);                 \
+            carry = __riscv_vrgather_vx_##S##m4(s, vl - 1, vlmax);                       \
+            i += vl;                                                                     \
+        }                                                                                \
+    }                                                                                    \
+    return total;                                                                        \
+}                                                                                        \
+                                                                                         \
+T vscan_inclusive_##S(const T* src, T* dst, size_t n) {                                  \
+    return scan_##S(src, dst, n, 1);                                                     \
+}                                                                                        \
+                                                                                         \
+T vscan_exclusive_##S(const T* src, T* dst, size_t n) {                                  \
+    return scan_##S(src, dst, n, 0);                                                     \
+}                                                                                        \
+                                                                                         \
+T vscan_block_inclusive_##S(const T* src, T* dst, size_t n, T* sums) {                   \
+    return block_scan_##S(src, dst, n, sums, 1);                                         \
+}                                                                                        \
+                                                                                         \
+T vscan_block_exclusive_##S(const T* src, T* dst, size_t n, T* sums) {                   \
+    return block_scan_##S(src, dst, n, sums, 0);                                         \
+}
+
+VSCAN_DEFINE(u32, uint32_t, 32, uint, vadd, vmv, x, vredsum)
+VSCAN_DEFINE(u64, uint64_t, 64, uint, vadd, vmv, x, vredsum)
+VSCAN_DEFINE(f64, double, 64, float, vfadd, vfmv, f, vfredusum)
+
+size_t vscan_block_sums_len(size_t n, unsigned ew) {
+    size_t vlmax = ew == 64 ? __riscv_vsetvlmax_e64m4() : __riscv_vsetvlmax_e32m4();
+    size_t block = VSCAN_BLOCK_STRIPS * vlmax;
+    return (n + block - 1) / block;
+}
@@ -0,0 +1,62 @@
+#ifndef VSCAN_H
+#define VSCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Prefix sums over u32, u64 and f64 arrays. Signed integers scan the same way as
+ * their unsigned counterparts, so callers cast.
+ *
+ *   inclusive  dst[i] = src[0] + ... + src[i]
+ *   exclusive  dst[i] = src[0] + ... + src[i - 1], dst[0] = 0
+ *
+ * Every function returns the sum of all n elements, and src may equal dst.
+ *
+ * vscan_{inclusive,exclusive}_* make one pass of e<EW>m4 strips. Each strip is scanned
+ * in registers with log2(vl) vslideup + add steps, and the running total is carried to
+ * the next strip through the scalar core (vmv.x.s / vfmv.f.s). That round trip puts
+ * every strip behind the last one, so the pass runs at one strip per scan latency.
+ *
+ * vscan_block_{inclusive,exclusive}_* are for large arrays. They split src into
+ * blocks of VSCAN_BLOCK_STRIPS strips and make three passes:
+ *
+ *   1  per-block totals, summed with vector adds and one reduction into sums[b]
+ *   2  a one-pass exclusive scan of sums, giving each block's starting offset
+ *   3  the in-register scan of each block, starting from its offset
+ *
+ * Passes 1 and 3 keep their carries in vector registers (vrgather.vx broadcasts the
+ * last element), so the scalar core never waits on them and only the short pass 2
+ * is serial. The price is reading src twice. sums holds vscan_block_sums_len(n, EW)
+ * elements of the scanned type, from vpu_alloc_ew.
+ *
+ * The f64 scans reassociate the additions, so they match a sequential sum only when
+ * the partial sums are exact.
+ */
+
+#ifndef VSCAN_BLOCK_STRIPS
+#define VSCAN_BLOCK_STRIPS 8
+#endif
+
+uint32_t vscan_inclusive_u32(const uint32_t* src, uint32_t* dst, size_t n);
+uint32_t vscan_exclusive_u32(const uint32_t* src, uint32_t* dst, size_t n);
+uint64_t vscan_inclusive_u64(const uint64_t* src, uint64_t* dst, size_t n);
+uint64_t vscan_exclusive_u64(const uint64_t* src, uint64_t* dst, size_t n);
+double vscan_inclusive_f64(const double* src, double* dst, size_t n);
+double vscan_exclusive_f64(const double* src, double* dst, size_t n);
+
+// Elements of sums needed by the block scans for n elements of width ew bits.
+size_t vscan_block_sums_len(size_t n, unsigned ew);
+
+uint32_t vscan_block_inclusive_u32(const uint32_t* src, uint32_t* dst, size_t n,
+                                   uint32_t* sums);
+uint32_t vscan_block_exclusive_u32(const uint32_t* src, uint32_t* dst, size_t n,
+                                   uint32_t* sums);
+uint64_t vscan_block_inclusive_u64(const uint64_t* src, uint64_t* dst, size_t n,
+                                   uint64_t* sums);
+uint64_t vscan_block_exclusive_u64(const uint64_t* src, uint64_t* dst, size_t n,
+                                   uint64_t* sums);
+double vscan_block_inclusive_f64(const double* src, double* dst, size_t n, double* sums);
+double vscan_block_exclusive_f64(const double* src, double* dst, size_t n, double* sums);
+
+#endif
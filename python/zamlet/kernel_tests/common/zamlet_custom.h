@@ -4,10 +4,14 @@
 /*
  * Wrappers for zamlet custom-0 opcode (0x0b) instructions.
  *
- * Three instructions, distinguished by funct3:
+ * Seven instructions, distinguished by funct3:
  *   funct3=0  set_index_bound   bound indexed-access offsets to lower N bits
  *   funct3=1  begin_writeset    open a shared writeset scope
  *   funct3=2  end_writeset      close the writeset scope
+ *   funct3=3  mark              emit a trace marker
+ *   funct3=4  prefetch          start cache fills for an address range (R-type)
+ *   funct3=5  begin_nontemporal open a non-temporal store scope
+ *   funct3=6  end_nontemporal   close the non-temporal store scope
  *
  * See python/zamlet/instructions/custom.py for semantics.
  */
@@ -27,6 +31,30 @@ static inline void zamlet_set_index_bound(unsigned bits) {
     asm volatile(".insn i 0x0b, 0, x0, %0, 0" : : "r"(bits));
 }
 
+/*
+ * Smallest index bound covering byte offsets [0, bytes): the N for which
+ * 2^N >= bytes. For an indexed access into an array of n elements of size e,
+ * pass n · e.
+ */
+static inline unsigned zamlet_index_bound_bits(unsigned long bytes) {
+    if (bytes <= 1)
+        return 1;
+    return 64 - __builtin_clzl(bytes - 1UL);
+}
+
+/*
+ * Bound indexed accesses to an array of `bytes` bytes until the matching
+ * zamlet_end_index_bound. Every indexed load/store issued in between must use
+ * offsets below that size, whatever its base register.
+ */
+static inline void zamlet_begin_index_bound(unsigned long bytes) {
+    zamlet_set_index_bound(zamlet_index_bound_bits(bytes));
+}
+
+static inline void zamlet_end_index_bound(void) {
+    zamlet_set_index_bound(0);
+}
+
 /*
  * Open a writeset scope. Vector operations within the scope share a
  * writeset_ident and bypass each other in the cache table — use this to mark
@@ -43,4 +71,48 @@ static inline void zamlet_end_writeset(void) {
     asm volatile(".insn i 0x0b, 2, x0, x0, 0");
 }
 
+/*
+ * Emit trace marker `id`. Every kamlet logs a "marker" event when it admits
+ * the marker, so a phase runs from its marker to the next one in program
+ * order. python/zamlet/analysis/phase_profile.py turns the events into a
+ * per-phase cycle table and timeline.
+ *
+ * Register form, so `id` may be a runtime value. ZAMLET_MARK_IMM(id) encodes
+ * a compile-time id (< 2048) in the immediate and needs no register.
+ */
+static inline void zamlet_mark(unsigned long id) {
+    asm volatile(".insn i 0x0b, 3, x0, %0, 0" : : "r"(id));
+}
+
+#define ZAMLET_MARK_IMM(id) asm volatile(".insn i 0x0b, 3, x0, x0, %0" : : "i"(id))
+
+/*
+ * Ask the kamlets to fetch the cache lines holding [addr, addr + bytes) from memory in
+ * the background, and return at once. It is a hint: it never faults, scalar and
+ * unmapped pages are ignored, lines already cached are left alone, and a range larger
+ * than a kamlet's cache is cut to what fits. Issue it for the next tile while working
+ * on the current one, or before a timed region instead of a warm-up run.
+ */
+static inline void zamlet_prefetch(const volatile void* addr, unsigned long bytes) {
+    asm volatile(".insn r 0x0b, 4, 0, x0, %0, %1" : : "r"(addr), "r"(bytes));
+}
+
+/*
+ * Open a non-temporal store scope. Unit-stride vector stores issued within it write
+ * their lines back to memory and free the cache slots once the stream moves past them,
+ * and those lines are the first evicted, so a stream of results that is not re-read
+ * soon leaves the rest of the cache in place. Strided and indexed stores, and all
+ * loads, are unaffected. Scopes do not nest.
+ */
+static inline void zamlet_begin_nontemporal(void) {
+    asm volatile(".insn i 0x0b, 5, x0, x0, 0");
+}
+
+/*
+ * Close the scope opened by zamlet_begin_nontemporal.
+ */
+static inline void zamlet_end_nontemporal(void) {
+    asm volatile(".insn i 0x0b, 6, x0, x0, 0");
+}
+
 #endif /* ZAMLET_CUSTOM_H */
@@ -0,0 +1,46 @@
+"""Generate a stream compaction dataset header.
+
+Usage:
+    python gen_compact.py N KEEP [--seed S] > compact_data.h
+
+Declares:
+    #define COMPACT_N N
+    #define COMPACT_KEEP KEEP
+    #define COMPACT_COUNT <number of kept elements>
+    int8_t compact_x[N] __attribute__((section(".data.vpu8")));     // in [0, 10)
+    int16_t compact_a[N] __attribute__((section(".data.vpu16")));   // in [0, 999)
+    int16_t compact_expected[max(COUNT, 1)] __attribute__((section(".data.vpu16")));
+
+The draws follow conditional_gendata.pl. Element i is kept when x[i] < KEEP, so KEEP
+sets the selectivity in steps of 10%: 0 keeps nothing and 10 keeps everything.
+compact_expected holds the kept a[i] in order.
+"""
+import argparse
+import random
+
+from gen_header import emit
+
+parser = argparse.ArgumentParser()
+parser.add_argument("N", type=int)
+parser.add_argument("KEEP", type=int)
+parser.add_argument("--seed", type=int, default=1)
+args = parser.parse_args()
+n, keep = args.N, args.KEEP
+assert 0 <= keep <= 10, "KEEP must be in [0, 10]"
+
+rng = random.Random(args.seed)
+x = [rng.randrange(10) for _ in range(n)]
+a = [rng.randrange(999) for _ in range(n)]
+expected = [av for xv, av in zip(x, a) if xv < keep]
+
+
+print(f"// Generated by gen_compact.py {n} {keep} --seed {args.seed}")
+print("#include <stdint.h>")
+print()
+print(f"#define COMPACT_N {n}")
+print(f"#define COMPACT_KEEP {keep}")
+print(f"#define COMPACT_COUNT {len(expected)}")
+print()
+emit("int8_t", "compact_x", x, ".data.vpu8")
+emit("int16_t", "compact_a", a, ".data.vpu16")
+emit("int16_t", "compact_expected", expected or [0], ".data.vpu16")
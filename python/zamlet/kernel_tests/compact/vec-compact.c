@@ -0,0 +1,127 @@
+/*
+ * Stream compaction: out = the a[i] with x[i] < COMPACT_KEEP, in order, for the
+ * COMPACT_N int8 x and int16 a of the conditional workload. The output length depends
+ * on the data, so each strip writes where the previous one stopped.
+ *
+ * compact_vcompress packs the kept elements of a strip to the front of a register with
+ * vcompress.vm, counts them with vcpop.m and writes them with one unit-stride vse of
+ * that many elements.
+ *
+ * compact_masked leaves the kept elements in place and scatters them instead. Each
+ * kept element's slot is the number of kept elements before it in the strip, an
+ * in-register prefix count of the mask (log2(vl) vslideup + add steps), and a masked
+ * vsuxei16 writes them. The store moves the same data but goes through the indexed
+ * path.
+ *
+ * The model decomposes vcompress.vm at the lamlet: Oamlet.read_mask_bits gathers the
+ * whole mask there with one ReadRegWord per jamlet before any element moves. That
+ * serialization is a modeling shortcut, so the cycles of the two regions do not rank
+ * the two approaches for hardware.
+ *
+ * Strips are e8m1 for x and e16m2 for a, the same grouping as vec-conditional.S, so
+ * one vbool8_t mask covers both. COMPACT_HEADER (gen_compact.py N KEEP) supplies the
+ * data, the expected output and its length.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "zamlet_custom.h"
+#include COMPACT_HEADER
+
+size_t compact_vcompress(size_t n, const int8_t* x, const int16_t* a, int16_t* out) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e8m1(n - i);
+        vbool8_t keep = __riscv_vmslt_vx_i8m1_b8(__riscv_vle8_v_i8m1(&x[i], vl),
+                                                 COMPACT_KEEP, vl);
+        vint16m2_t v = __riscv_vle16_v_i16m2(&a[i], vl);
+        size_t k = __riscv_vcpop_m_b8(keep, vl);
+        __riscv_vse16_v_i16m2(&out[count], __riscv_vcompress_vm_i16m2(v, keep, vl), k);
+        count += k;
+        i += vl;
+    }
+    return count;
+}
+
+size_t compact_masked(size_t n, const int8_t* x, const int16_t* a, int16_t* out) {
+    size_t count = 0;
+    zamlet_begin_index_bound(__riscv_vsetvlmax_e8m1() * sizeof(int16_t));
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e8m1(n - i);
+        vbool8_t keep = __riscv_vmslt_vx_i8m1_b8(__riscv_vle8_v_i8m1(&x[i], vl),
+                                                 COMPACT_KEEP, vl);
+        vint16m2_t v = __riscv_vle16_v_i16m2(&a[i], vl);
+        vuint16m2_t zero = __riscv_vmv_v_x_u16m2(0, vl);
+        vuint16m2_t one = __riscv_vmerge_vxm_u16m2(zero, 1, keep, vl);
+        vuint16m2_t incl = one;
+        for (size_t d = 1; d < vl; d *= 2)
+            incl = __riscv_vadd_vv_u16m2(incl, __riscv_vslideup_vx_u16m2(zero, incl, d, vl),
+                                         vl);
+        // Slot of each kept element is the exclusive count, in bytes.
+        vuint16m2_t off = __riscv_vsll_vx_u16m2(__riscv_vsub_vv_u16m2(incl, one, vl), 1, vl);
+        __riscv_vsuxei16_v_i16m2_m(keep, &out[count], off, v, vl);
+        count += __riscv_vcpop_m_b8(keep, vl);
+        i += vl;
+    }
+    zamlet_end_index_bound();
+    return count;
+}
+
+static void fill(int16_t* x, size_t n, int16_t value) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e16m4(n - i);
+        __riscv_vse16_v_i16m4(&x[i], __riscv_vmv_v_x_i16m4(value, vl), vl);
+        i += vl;
+    }
+}
+
+typedef size_t (*compact_fn)(size_t, const int8_t*, const int16_t*, int16_t*);
+
+static int run_compact(const char* name, compact_fn fn, int16_t* out) {
+    // Poison the buffer so a run cannot pass on the output of the one before.
+    fill(out, COMPACT_N, -1);
+
+    unsigned long start = bench_timed_begin(name);
+    size_t count = fn(COMPACT_N, compact_x, compact_a, out);
+    unsigned long cycles = bench_timed_end(start);
+
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " cycles/element), kept %zu\n", name, cycles,
+           BENCH_RATE(cycles, COMPACT_N), count);
+
+    if (count != (size_t)COMPACT_COUNT) {
+        printf("FAIL %s: kept %zu, expected %d\n", name, count, COMPACT_COUNT);
+        return 1;
+    }
+    size_t bad = bench_mismatches16(out, compact_expected, COMPACT_COUNT);
+    if (bad) {
+        printf("FAIL %s: %zu of %d elements wrong\n", name, bad, COMPACT_COUNT);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int16_t* out = vpu_alloc_ew(COMPACT_N * sizeof(int16_t), 16);
+
+    printf("compact n = %d, keep x < %d (%d kept), vl = %zu\n", COMPACT_N, COMPACT_KEEP,
+           COMPACT_COUNT, __riscv_vsetvlmax_e8m1());
+
+#if PREALLOCATE
+    compact_vcompress(COMPACT_N, compact_x, compact_a, out);
+#endif
+
+    if (run_compact("compact_vcompress", compact_vcompress, out))
+        return 1;
+    if (run_compact("compact_masked", compact_masked, out))
+        return 1;
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -12,6 +12,11 @@
 #include <string.h>
 #include "util.h"
 #include "vpu_alloc.h"
+#include "zamlet_custom.h"
+
+// Phase markers for analysis/phase_profile.py.
+#define MARK_KERNEL 1
+#define MARK_VERIFY 2
 
 //--------------------------------------------------------------------------
 // Input/Reference Data
@@ -45,14 +50,19 @@ int main( int argc, char* argv[] )
   int16_t* results_data = (int16_t*)vpu_alloc(DATA_SIZE * sizeof(int16_t));
 
 #if PREALLOCATE
-  // If needed we preallocate everything in the caches
-  vec_conditional(DATA_SIZE, input1_data, input2_data, input3_data, results_data);
+  // If needed we preallocate everything in the caches, by prefetch rather than a
+  // warm-up run.
+  zamlet_prefetch(input1_data, sizeof(input1_data));
+  zamlet_prefetch(input2_data, sizeof(input2_data));
+  zamlet_prefetch(input3_data, sizeof(input3_data));
 #endif
 
   // Do the conditional
   setStats(1);
+  ZAMLET_MARK_IMM(MARK_KERNEL);
   vec_conditional(DATA_SIZE, input1_data, input2_data, input3_data, results_data);
   setStats(0);
 
+  ZAMLET_MARK_IMM(MARK_VERIFY);
   return verify_short(DATA_SIZE, results_data, verify_data );
 }
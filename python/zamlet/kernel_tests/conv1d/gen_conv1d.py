@@ -0,0 +1,60 @@
+"""Generate an N-tap FIR dataset header.
+
+Usage:
+    python gen_conv1d.py N TAPS [--seed S] > conv1d_data.h
+
+Declares:
+    #define CONV1D_N N
+    #define CONV1D_TAPS TAPS
+    float conv1d_xf[N + TAPS - 1] __attribute__((section(".data.vpu32")));   // in [-1, 1)
+    float conv1d_hf[TAPS];                                                  // in [-1, 1)
+    float conv1d_ef[N] __attribute__((section(".data.vpu32")));
+    int16_t conv1d_xi[N + TAPS - 1] __attribute__((section(".data.vpu16"))); // in [-1000, 1000]
+    int16_t conv1d_hi[TAPS];                                                // in [-100, 100]
+    int32_t conv1d_ei[N] __attribute__((section(".data.vpu32")));
+
+e[i] = h[0] * x[i] + ... + h[TAPS - 1] * x[i + TAPS - 1], the valid part of the
+correlation. The f32 samples are rounded to float before the reference sum, which is
+taken in double; the int16 one is exact. The taps stay in scalar memory because the
+kernel reads them as scalar operands.
+"""
+import argparse
+import random
+
+from gen_header import emit, f32
+
+parser = argparse.ArgumentParser()
+parser.add_argument("N", type=int)
+parser.add_argument("TAPS", type=int)
+parser.add_argument("--seed", type=int, default=1)
+args = parser.parse_args()
+n, taps = args.N, args.TAPS
+assert n > 0 and taps > 0
+
+rng = random.Random(args.seed)
+
+
+xf = [f32(rng.uniform(-1.0, 1.0)) for _ in range(n + taps - 1)]
+hf = [f32(rng.uniform(-1.0, 1.0)) for _ in range(taps)]
+ef = [f32(sum(hf[k] * xf[i + k] for k in range(taps))) for i in range(n)]
+xi = [rng.randint(-1000, 1000) for _ in range(n + taps - 1)]
+hi = [rng.randint(-100, 100) for _ in range(taps)]
+ei = [sum(hi[k] * xi[i + k] for k in range(taps)) for i in range(n)]
+
+
+def float_literal(v):
+    return f"{v:.9e}f"
+
+
+print(f"// Generated by gen_conv1d.py {n} {taps} --seed {args.seed}")
+print("#include <stdint.h>")
+print()
+print(f"#define CONV1D_N {n}")
+print(f"#define CONV1D_TAPS {taps}")
+print()
+emit("float", "conv1d_xf", xf, ".data.vpu32", float_literal, 5)
+emit("float", "conv1d_hf", hf, None, float_literal, 5)
+emit("float", "conv1d_ef", ef, ".data.vpu32", float_literal, 5)
+emit("int16_t", "conv1d_xi", xi, ".data.vpu16", per_line=10)
+emit("int16_t", "conv1d_hi", hi, per_line=10)
+emit("int32_t", "conv1d_ei", ei, ".data.vpu32", per_line=10)
@@ -0,0 +1,193 @@
+/*
+ * N-tap FIR filter (vec-conv-3): y[i] = h[0]·x[i] + ... + h[T-1]·x[i + T - 1] for
+ * i < CONV1D_N and T = CONV1D_TAPS, on f32 samples and on int16 samples with int32
+ * outputs. CONV1D_HEADER (gen_conv1d.py N TAPS) supplies x (N + T - 1 samples), the
+ * taps in scalar memory and the expected y.
+ *
+ * conv1d_reload_* loads the window x[i + k ..] of every tap straight from memory: T
+ * unit-stride loads per strip of outputs, each overlapping the last in all but one
+ * element.
+ *
+ * conv1d_slide_* loads each strip of x once. The window of tap k is the strip slid
+ * down by k with the first k samples of the following strip slid up into its top.
+ * That following strip becomes the next iteration's own, so every sample crosses the
+ * memory interface once and the shifts run on the slide network between jamlets.
+ *
+ * f32 strips are e32m4. int16 strips are e16m2 and accumulate into e32m4 with vwmacc,
+ * so both run at VLMAX(e32, m4), and the slide variants need T - 1 <= that VLMAX.
+ * Both variants add the taps in the same order, so their f32 results are identical;
+ * they are checked against the double-precision reference within CONV1D_TOL.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include CONV1D_HEADER
+
+#define CONV1D_TOL 1e-4f
+
+// Samples after strip [i, i + vl) to load as the next strip: enough for the next
+// strip and for the T - 1 samples the windows of this one reach into, within x.
+static inline size_t next_len(size_t n, size_t i, size_t vl) {
+    size_t avail = n + CONV1D_TAPS - 1 - i - vl;
+    size_t want = vl > CONV1D_TAPS - 1 ? vl : CONV1D_TAPS - 1;
+    return want < avail ? want : avail;
+}
+
+static inline vfloat32m4_t window_f32(vfloat32m4_t cur, vfloat32m4_t next, size_t k,
+                                      size_t vl) {
+    if (k >= vl)
+        return __riscv_vslidedown_vx_f32m4(next, k - vl, vl);
+    return __riscv_vslideup_vx_f32m4(__riscv_vslidedown_vx_f32m4(cur, k, vl), next,
+                                     vl - k, vl);
+}
+
+static inline vint16m2_t window_i16(vint16m2_t cur, vint16m2_t next, size_t k, size_t vl) {
+    if (k >= vl)
+        return __riscv_vslidedown_vx_i16m2(next, k - vl, vl);
+    return __riscv_vslideup_vx_i16m2(__riscv_vslidedown_vx_i16m2(cur, k, vl), next,
+                                     vl - k, vl);
+}
+
+void conv1d_reload_f32(size_t n, const float* x, const float* h, float* y) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m4(n - i);
+        vfloat32m4_t acc = __riscv_vfmul_vf_f32m4(__riscv_vle32_v_f32m4(&x[i], vl), h[0], vl);
+        for (size_t k = 1; k < CONV1D_TAPS; k++)
+            acc = __riscv_vfmacc_vf_f32m4(acc, h[k], __riscv_vle32_v_f32m4(&x[i + k], vl), vl);
+        __riscv_vse32_v_f32m4(&y[i], acc, vl);
+        i += vl;
+    }
+}
+
+void conv1d_slide_f32(size_t n, const float* x, const float* h, float* y) {
+    vfloat32m4_t cur = __riscv_vle32_v_f32m4(x, __riscv_vsetvl_e32m4(n));
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m4(n - i);
+        vfloat32m4_t next = __riscv_vle32_v_f32m4(&x[i + vl], next_len(n, i, vl));
+        vfloat32m4_t acc = __riscv_vfmul_vf_f32m4(cur, h[0], vl);
+        for (size_t k = 1; k < CONV1D_TAPS; k++)
+            acc = __riscv_vfmacc_vf_f32m4(acc, h[k], window_f32(cur, next, k, vl), vl);
+        __riscv_vse32_v_f32m4(&y[i], acc, vl);
+        cur = next;
+        i += vl;
+    }
+}
+
+void conv1d_reload_i16(size_t n, const int16_t* x, const int16_t* h, int32_t* y) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e16m2(n - i);
+        vint32m4_t acc = __riscv_vwmul_vx_i32m4(__riscv_vle16_v_i16m2(&x[i], vl), h[0], vl);
+        for (size_t k = 1; k < CONV1D_TAPS; k++)
+            acc = __riscv_vwmacc_vx_i32m4(acc, h[k], __riscv_vle16_v_i16m2(&x[i + k], vl), vl);
+        __riscv_vse32_v_i32m4(&y[i], acc, vl);
+        i += vl;
+    }
+}
+
+void conv1d_slide_i16(size_t n, const int16_t* x, const int16_t* h, int32_t* y) {
+    vint16m2_t cur = __riscv_vle16_v_i16m2(x, __riscv_vsetvl_e16m2(n));
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e16m2(n - i);
+        vint16m2_t next = __riscv_vle16_v_i16m2(&x[i + vl], next_len(n, i, vl));
+        vint32m4_t acc = __riscv_vwmul_vx_i32m4(cur, h[0], vl);
+        for (size_t k = 1; k < CONV1D_TAPS; k++)
+            acc = __riscv_vwmacc_vx_i32m4(acc, h[k], window_i16(cur, next, k, vl), vl);
+        __riscv_vse32_v_i32m4(&y[i], acc, vl);
+        cur = next;
+        i += vl;
+    }
+}
+
+// Number of i < n where |y[i] - conv1d_ef[i]| > CONV1D_TOL, or y[i] is NaN.
+static size_t mismatches_f32(const float* y, size_t n) {
+    size_t bad = 0;
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m4(n - i);
+        vfloat32m4_t v = __riscv_vle32_v_f32m4(&y[i], vl);
+        vfloat32m4_t d = __riscv_vfsub_vv_f32m4(v, __riscv_vle32_v_f32m4(&conv1d_ef[i], vl),
+                                                vl);
+        vbool8_t far = __riscv_vmfgt_vf_f32m4_b8(__riscv_vfabs_v_f32m4(d, vl), CONV1D_TOL, vl);
+        vbool8_t nan = __riscv_vmfne_vv_f32m4_b8(v, v, vl);
+        bad += __riscv_vcpop_m_b8(__riscv_vmor_mm_b8(far, nan, vl), vl);
+        i += vl;
+    }
+    return bad;
+}
+
+typedef void (*conv1d_f32_fn)(size_t, const float*, const float*, float*);
+typedef void (*conv1d_i16_fn)(size_t, const int16_t*, const int16_t*, int32_t*);
+
+static int run_f32(const char* name, conv1d_f32_fn fn, float* y) {
+    bench_poison32(y, CONV1D_N);
+    unsigned long start = bench_timed_begin(name);
+    fn(CONV1D_N, conv1d_xf, conv1d_hf, y);
+    unsigned long cycles = bench_timed_end(start);
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " cycles/output)\n", name, cycles,
+           BENCH_RATE(cycles, CONV1D_N));
+    size_t bad = mismatches_f32(y, CONV1D_N);
+    if (bad) {
+        printf("FAIL %s: %zu of %d outputs wrong\n", name, bad, CONV1D_N);
+        return 1;
+    }
+    return 0;
+}
+
+static int run_i16(const char* name, conv1d_i16_fn fn, int32_t* y) {
+    bench_poison32(y, CONV1D_N);
+    unsigned long start = bench_timed_begin(name);
+    fn(CONV1D_N, conv1d_xi, conv1d_hi, y);
+    unsigned long cycles = bench_timed_end(start);
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " cycles/output)\n", name, cycles,
+           BENCH_RATE(cycles, CONV1D_N));
+    size_t bad = bench_mismatches32(y, conv1d_ei, CONV1D_N);
+    if (bad) {
+        printf("FAIL %s: %zu of %d outputs wrong\n", name, bad, CONV1D_N);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    size_t vlmax = __riscv_vsetvlmax_e32m4();
+    printf("conv1d n = %d, %d taps, vl = %zu\n", CONV1D_N, CONV1D_TAPS, vlmax);
+    if (CONV1D_TAPS - 1 > vlmax) {
+        printf("FAIL %d taps need VLMAX(e32, m4) >= %d\n", CONV1D_TAPS, CONV1D_TAPS - 1);
+        return 1;
+    }
+
+    float* yf = vpu_alloc_ew(CONV1D_N * sizeof(float), 32);
+    float* yf_slide = vpu_alloc_ew(CONV1D_N * sizeof(float), 32);
+    int32_t* yi = vpu_alloc_ew(CONV1D_N * sizeof(int32_t), 32);
+    int32_t* yi_slide = vpu_alloc_ew(CONV1D_N * sizeof(int32_t), 32);
+
+#if PREALLOCATE
+    conv1d_slide_f32(CONV1D_N, conv1d_xf, conv1d_hf, yf_slide);
+    conv1d_slide_i16(CONV1D_N, conv1d_xi, conv1d_hi, yi_slide);
+#endif
+
+    if (run_f32("conv1d_reload_f32", conv1d_reload_f32, yf))
+        return 1;
+    if (run_f32("conv1d_slide_f32", conv1d_slide_f32, yf_slide))
+        return 1;
+    if (run_i16("conv1d_reload_i16", conv1d_reload_i16, yi))
+        return 1;
+    if (run_i16("conv1d_slide_i16", conv1d_slide_i16, yi_slide))
+        return 1;
+
+    // Same taps in the same order: the two f32 variants must agree bit for bit.
+    size_t diff = bench_mismatches32(yf, yf_slide, CONV1D_N);
+    if (diff) {
+        printf("FAIL conv1d_slide_f32 differs from conv1d_reload_f32 in %zu outputs\n", diff);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
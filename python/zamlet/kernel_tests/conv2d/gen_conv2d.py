@@ -0,0 +1,68 @@
+"""Generate a K x K 2D convolution dataset header.
+
+Usage:
+    python gen_conv2d.py ROWS COLS K [--seed S] > conv2d_data.h
+
+Declares, with W = COLS + K - 1 the padded row length:
+    #define CONV2D_ROWS ROWS
+    #define CONV2D_COLS COLS
+    #define CONV2D_K K
+    int32_t conv2d_xi[(ROWS + K - 1) * W] __attribute__((section(".data.vpu32")));
+    int32_t conv2d_fi[K * K];                                   // in [-10, 10]
+    int32_t conv2d_ei[ROWS * COLS] __attribute__((section(".data.vpu32")));
+    double conv2d_xf[(ROWS + K - 1) * W] __attribute__((section(".data.vpu64")));
+    double conv2d_ff[K * K];                                    // in [-1, 1)
+    double conv2d_ef[ROWS * COLS] __attribute__((section(".data.vpu64")));
+
+e[r][c] = sum over i, j < K of f[i][j] * x[r + i][c + j], the valid part of the
+correlation of the padded image x, as in the Ara iconv2d/fconv2d benchmarks. int32
+samples are in [-1000, 1000] and the reference is exact; f64 samples are in [-1, 1)
+and the reference sum runs in row-major tap order without fused multiply-adds. The
+filters stay in scalar memory because the kernel reads them as scalar operands.
+"""
+import argparse
+import random
+
+from gen_header import emit
+
+parser = argparse.ArgumentParser()
+parser.add_argument("ROWS", type=int)
+parser.add_argument("COLS", type=int)
+parser.add_argument("K", type=int)
+parser.add_argument("--seed", type=int, default=1)
+args = parser.parse_args()
+rows, cols, k = args.ROWS, args.COLS, args.K
+assert rows > 0 and cols > 0 and k > 0
+w = cols + k - 1
+
+rng = random.Random(args.seed)
+
+
+def conv(x, f):
+    return [sum(f[i * k + j] * x[(r + i) * w + c + j] for i in range(k) for j in range(k))
+            for r in range(rows) for c in range(cols)]
+
+
+xi = [rng.randint(-1000, 1000) for _ in range((rows + k - 1) * w)]
+fi = [rng.randint(-10, 10) for _ in range(k * k)]
+xf = [rng.uniform(-1.0, 1.0) for _ in range((rows + k - 1) * w)]
+ff = [rng.uniform(-1.0, 1.0) for _ in range(k * k)]
+
+
+def double_literal(v):
+    return f"{v:.17e}"
+
+
+print(f"// Generated by gen_conv2d.py {rows} {cols} {k} --seed {args.seed}")
+print("#include <stdint.h>")
+print()
+print(f"#define CONV2D_ROWS {rows}")
+print(f"#define CONV2D_COLS {cols}")
+print(f"#define CONV2D_K {k}")
+print()
+emit("int32_t", "conv2d_xi", xi, ".data.vpu32", per_line=10)
+emit("int32_t", "conv2d_fi", fi, per_line=10)
+emit("int32_t", "conv2d_ei", conv(xi, fi), ".data.vpu32", per_line=10)
+emit("double", "conv2d_xf", xf, ".data.vpu64", double_literal, 3)
+emit("double", "conv2d_ff", ff, None, double_literal, 3)
+emit("double", "conv2d_ef", conv(xf, ff), ".data.vpu64", double_literal, 3)
@@ -0,0 +1,210 @@
+/*
+ * K x K 2D convolution (vec-iconv2d, vec-fconv2d) after the Ara iconv2d/fconv2d
+ * benchmarks: out[r][c] = sum over i, j < K of f[i][j]·x[r + i][c + j] for an
+ * (R + K - 1) x (C + K - 1) padded image x, on int32 and on f64. CONV2D_HEADER
+ * (gen_conv2d.py R C K) supplies the images, the filters in scalar memory and the
+ * expected outputs, and fixes K at 3, 5 or 7.
+ *
+ * conv2d_rows_* walks the image in column strips of vl outputs. Each strip keeps the
+ * K input rows under the current output row resident in registers, vl + K - 1
+ * samples each. Going down one output row shifts the rows up by one register group
+ * and loads only the new bottom row, and tap (i, j) is row i slid down by j, so each
+ * sample is loaded once per strip (plus the K - 1 columns the strips overlap by).
+ * Rows are e<EW>m4, or m2 for K = 7 so that 7 rows, the accumulator and a slide
+ * temporary fit in the register file, and vl = VLMAX - (K - 1).
+ *
+ * conv2d_reload_* loads the window of every tap straight from memory, K·K loads per
+ * strip of outputs, for comparison. Both add the taps in the same order, so their
+ * f64 results are identical; they are checked against the reference within
+ * CONV2D_TOL, and the int32 results exactly.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include CONV2D_HEADER
+
+#define CONV2D_TOL 1e-9
+#define CONV2D_W (CONV2D_COLS + CONV2D_K - 1)
+
+/*
+ * CONV2D_ROWS_X(X, a, b) expands X(a, b, i) for the resident rows i < K, and
+ * CONV2D_SHIFT_X(X) expands X(i, i + 1) for i < K - 1.
+ */
+#if CONV2D_K == 3
+#define CONV2D_LMUL m4
+#define CONV2D_ROWS_X(X, a, b) X(a, b, 0) X(a, b, 1) X(a, b, 2)
+#define CONV2D_SHIFT_X(X) X(0, 1) X(1, 2)
+#define CONV2D_BOTTOM r2
+#elif CONV2D_K == 5
+#define CONV2D_LMUL m4
+#define CONV2D_ROWS_X(X, a, b) X(a, b, 0) X(a, b, 1) X(a, b, 2) X(a, b, 3) X(a, b, 4)
+#define CONV2D_SHIFT_X(X) X(0, 1) X(1, 2) X(2, 3) X(3, 4)
+#define CONV2D_BOTTOM r4
+#elif CONV2D_K == 7
+#define CONV2D_LMUL m2
+#define CONV2D_ROWS_X(X, a, b) \
+    X(a, b, 0) X(a, b, 1) X(a, b, 2) X(a, b, 3) X(a, b, 4) X(a, b, 5) X(a, b, 6)
+#define CONV2D_SHIFT_X(X) X(0, 1) X(1, 2) X(2, 3) X(3, 4) X(4, 5) X(5, 6)
+#define CONV2D_BOTTOM r6
+#else
+#error "CONV2D_K must be 3, 5 or 7"
+#endif
+
+#define CONV2D_DECLARE(V, unused, i) V r##i;
+#define CONV2D_MOVE(dst, src) r##dst = r##src;
+// Rows 1..K-1 are loaded ahead of the first output row, which shifts them up.
+#define CONV2D_PRELOAD(SL, EW, i)                                                        \
+    if (i > 0)                                                                           \
+        r##i = __riscv_vle##EW##_v_##SL(&x[(i - 1) * CONV2D_W + c], vl_in);
+#define CONV2D_ROW_TAPS(SL, MACC, i)                                                     \
+    acc = __riscv_##MACC##_##SL(acc, f[i * CONV2D_K], r##i, vl);                         \
+    for (size_t j = 1; j < CONV2D_K; j++)                                                \
+        acc = __riscv_##MACC##_##SL(acc, f[i * CONV2D_K + j],                            \
+                                    __riscv_vslidedown_vx_##SL(r##i, j, vl), vl);
+
+/*
+ * CONV2D_DEFINE(S, T, EW, TY, MACC, MV, SC) defines conv2d_rows_S and conv2d_reload_S
+ * for element type T, where TY is the vector type stem (int / float), MACC the
+ * multiply-add stem (vmacc_vx / vfmacc_vf), MV the splat stem (vmv / vfmv) and SC the
+ * scalar operand letter (x / f). LM is the row LMUL.
+ */
+#define CONV2D_DEFINE(...) CONV2D_DEFINE_(__VA_ARGS__)
+#define CONV2D_DEFINE_(S, T, EW, TY, MACC, MV, SC, LM)                                   \
+void conv2d_rows_##S(const T* x, const T* f, T* out) {                                   \
+    size_t strip = __riscv_vsetvlmax_e##EW##LM() - (CONV2D_K - 1);                       \
+    CONV2D_ROWS_X(CONV2D_DECLARE, v##TY##EW##LM##_t, _)                                  \
+    for (size_t c = 0; c < CONV2D_COLS; ) {                                              \
+        size_t vl = CONV2D_COLS - c < strip ? CONV2D_COLS - c : strip;                   \
+        size_t vl_in = vl + CONV2D_K - 1;                                                \
+        CONV2D_ROWS_X(CONV2D_PRELOAD, S##LM, EW)                                         \
+        for (size_t r = 0; r < CONV2D_ROWS; r++) {                                       \
+            CONV2D_SHIFT_X(CONV2D_MOVE)                                                  \
+            CONV2D_BOTTOM = __riscv_vle##EW##_v_##S##LM(                                 \
+                &x[(r + CONV2D_K - 1) * CONV2D_W + c], vl_in);                           \
+            v##TY##EW##LM##_t acc = __riscv_##MV##_v_##SC##_##S##LM(0, vl);              \
+            CONV2D_ROWS_X(CONV2D_ROW_TAPS, S##LM, MACC)                                  \
+            __riscv_vse##EW##_v_##S##LM(&out[r * CONV2D_COLS + c], acc, vl);             \
+        }                                                                                \
+        c += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+void conv2d_reload_##S(const T* x, const T* f, T* out) {                                 \
+    for (size_t c = 0; c < CONV2D_COLS; ) {                                              \
+        size_t vl = __riscv_vsetvl_e##EW##LM(CONV2D_COLS - c);                           \
+        for (size_t r = 0; r < CONV2D_ROWS; r++) {                                       \
+            v##TY##EW##LM##_t acc = __riscv_##MV##_v_##SC##_##S##LM(0, vl);              \
+            for (size_t i = 0; i < CONV2D_K; i++)                                        \
+                for (size_t j = 0; j < CONV2D_K; j++)                                    \
+                    acc = __riscv_##MACC##_##S##LM(                                      \
+                        acc, f[i * CONV2D_K + j],                                        \
+                        __riscv_vle##EW##_v_##S##LM(&x[(r + i) * CONV2D_W + c + j], vl), \
+                        vl);                                                             \
+            __riscv_vse##EW##_v_##S##LM(&out[r * CONV2D_COLS + c], acc, vl);             \
+        }                                                                                \
+        c += vl;                                                                         \
+    }                                                                                    \
+}
+
+CONV2D_DEFINE(i32, int32_t, 32, int, vmacc_vx, vmv, x, CONV2D_LMUL)
+CONV2D_DEFINE(f64, double, 64, float, vfmacc_vf, vfmv, f, CONV2D_LMUL)
+
+#define CONV2D_N (CONV2D_ROWS * CONV2D_COLS)
+
+// Number of i < n where |y[i] - conv2d_ef[i]| > CONV2D_TOL, or y[i] is NaN.
+static size_t mismatches_f64(const double* y, size_t n) {
+    size_t bad = 0;
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m1(n - i);
+        vfloat64m1_t v = __riscv_vle64_v_f64m1(&y[i], vl);
+        vfloat64m1_t d = __riscv_vfsub_vv_f64m1(v, __riscv_vle64_v_f64m1(&conv2d_ef[i], vl),
+                                                vl);
+        vbool64_t far = __riscv_vmfgt_vf_f64m1_b64(__riscv_vfabs_v_f64m1(d, vl), CONV2D_TOL,
+                                                   vl);
+        vbool64_t nan = __riscv_vmfne_vv_f64m1_b64(v, v, vl);
+        bad += __riscv_vcpop_m_b64(__riscv_vmor_mm_b64(far, nan, vl), vl);
+        i += vl;
+    }
+    return bad;
+}
+
+typedef void (*conv2d_i32_fn)(const int32_t*, const int32_t*, int32_t*);
+typedef void (*conv2d_f64_fn)(const double*, const double*, double*);
+
+static int run_i32(const char* name, conv2d_i32_fn fn, int32_t* out) {
+    bench_poison32(out, CONV2D_N);
+    unsigned long start = bench_timed_begin(name);
+    fn(conv2d_xi, conv2d_fi, out);
+    unsigned long cycles = bench_timed_end(start);
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " cycles/output)\n", name, cycles,
+           BENCH_RATE(cycles, CONV2D_N));
+    size_t bad = bench_mismatches32(out, conv2d_ei, CONV2D_N);
+    if (bad) {
+        printf("FAIL %s: %zu of %d outputs wrong\n", name, bad, CONV2D_N);
+        return 1;
+    }
+    return 0;
+}
+
+static int run_f64(const char* name, conv2d_f64_fn fn, double* out) {
+    bench_poison32(out, 2 * CONV2D_N);
+    unsigned long start = bench_timed_begin(name);
+    fn(conv2d_xf, conv2d_ff, out);
+    unsigned long cycles = bench_timed_end(start);
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " cycles/output)\n", name, cycles,
+           BENCH_RATE(cycles, CONV2D_N));
+    size_t bad = mismatches_f64(out, CONV2D_N);
+    if (bad) {
+        printf("FAIL %s: %zu of %d outputs wrong\n", name, bad, CONV2D_N);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    // e64 rows are the narrower ones.
+    size_t vlmax = CONV2D_K == 7 ? __riscv_vsetvlmax_e64m2() : __riscv_vsetvlmax_e64m4();
+    printf("conv2d %dx%d, %dx%d filter, f64 strip = %zu\n", CONV2D_ROWS, CONV2D_COLS,
+           CONV2D_K, CONV2D_K, vlmax - (CONV2D_K - 1));
+    if (vlmax <= CONV2D_K - 1) {
+        printf("FAIL %dx%d filter needs more than %d e64 elements per row group\n",
+               CONV2D_K, CONV2D_K, CONV2D_K - 1);
+        return 1;
+    }
+
+    int32_t* yi = vpu_alloc_ew(CONV2D_N * sizeof(int32_t), 32);
+    int32_t* yi_rows = vpu_alloc_ew(CONV2D_N * sizeof(int32_t), 32);
+    double* yf = vpu_alloc_ew(CONV2D_N * sizeof(double), 64);
+    double* yf_rows = vpu_alloc_ew(CONV2D_N * sizeof(double), 64);
+
+#if PREALLOCATE
+    conv2d_rows_i32(conv2d_xi, conv2d_fi, yi_rows);
+    conv2d_rows_f64(conv2d_xf, conv2d_ff, yf_rows);
+#endif
+
+    if (run_i32("conv2d_reload_i32", conv2d_reload_i32, yi))
+        return 1;
+    if (run_i32("conv2d_rows_i32", conv2d_rows_i32, yi_rows))
+        return 1;
+    if (run_f64("conv2d_reload_f64", conv2d_reload_f64, yf))
+        return 1;
+    if (run_f64("conv2d_rows_f64", conv2d_rows_f64, yf_rows))
+        return 1;
+
+    // Same taps in the same order: the two f64 variants must agree bit for bit.
+    size_t diff = bench_mismatches64(yf, yf_rows, CONV2D_N);
+    if (diff) {
+        printf("FAIL conv2d_rows_f64 differs from conv2d_reload_f64 in %zu outputs\n", diff);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
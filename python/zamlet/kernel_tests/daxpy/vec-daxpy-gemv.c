@@ -0,0 +1,150 @@
+/*
+ * Daxpy then gemv, once as usual and once with the daxpy inside a non-temporal store
+ * scope (zamlet_begin_nontemporal), in bench regions daxpy / gemv and daxpy_nt / gemv_nt.
+ *
+ * Built for one geometry, so the sizes follow its cache: the column-major gemv matrix
+ * fills half of the kamlet caches and x and y of the daxpy fill the other half. Each run
+ * first sweeps a cache-sized scratch buffer and then runs the gemv once, so the matrix
+ * is cached and the scratch lines are the oldest. The plain daxpy brings in all of x and
+ * y, which evicts the scratch lines and then the matrix, and the gemv after it reads
+ * the matrix from memory again. In the scope each y line is written back and becomes
+ * the next one evicted once the daxpy moves past it, so only x displaces the scratch
+ * lines and the matrix stays cached for the gemv.
+ *
+ * The kernel fails unless gemv_nt has under half of the plain gemv's cache misses
+ * (mhpmcounter4, HPM_EVENT_CACHE_MISS).
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include ZAMLET_GEOMETRY_HEADER
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "vinit.h"
+#include "zamlet_custom.h"
+#include "ara/gemv.h"
+
+// One register group of e64m8 rows, and as many columns as fill half the cache.
+#define M_ROW ZAMLET_VLMAX(64, 8)
+#define V_LEN (ZAMLET_CACHE_BYTES / 2 / (M_ROW * sizeof(double)))
+// x and y together fill the other half.
+#define N_AXPY (ZAMLET_CACHE_BYTES / 4 / sizeof(double))
+#define AXPY_A 2.5
+
+_Static_assert(V_LEN >= 1, "the gemv matrix needs a column");
+_Static_assert(N_AXPY >= M_ROW, "the daxpy tail check reads M_ROW elements");
+#if HPM_EVENT4 != HPM_EVENT_CACHE_MISS
+#error "vec-daxpy-gemv counts cache misses on mhpmcounter4"
+#endif
+
+// Read by the scalar core in gemv_colwise.
+static double vector_s[V_LEN];
+
+static void axpy(double a, double* dx, double* dy, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        vfloat64m8_t v_dx = __riscv_vle64_v_f64m8(&dx[i], vl);
+        vfloat64m8_t v_dy = __riscv_vle64_v_f64m8(&dy[i], vl);
+        __riscv_vse64_v_f64m8(&dy[i], __riscv_vfmacc_vf_f64m8(v_dy, a, v_dx, vl), vl);
+        i += vl;
+    }
+}
+
+struct buffers {
+    double* matrix;
+    double* x;
+    double* y;
+    double* dest;
+    double* want_y;
+    double* want_dest;
+    uint64_t* scratch;
+};
+
+// Run the daxpy and the gemv and check both. The cache misses from the gemv's start to
+// the check of its result go to *gemv_misses. The daxpy's last strip is checked before
+// the gemv starts, so its stores are done and none of its misses are counted.
+static int run(const struct buffers* b, int nontemporal, unsigned long* gemv_misses) {
+    const char* axpy_name = nontemporal ? "daxpy_nt" : "daxpy";
+    const char* gemv_name = nontemporal ? "gemv_nt" : "gemv";
+
+    vinit_affine_f64(b->y, N_AXPY, 2.0, 0.0);
+    vinit_fill_u64(b->scratch, ZAMLET_CACHE_BYTES / sizeof(uint64_t), 0);
+    gemv_colwise(M_ROW, V_LEN, b->matrix, vector_s, b->dest);
+
+    unsigned long start = bench_timed_begin(axpy_name);
+    if (nontemporal)
+        zamlet_begin_nontemporal();
+    axpy(AXPY_A, b->x, b->y, N_AXPY);
+    if (nontemporal)
+        zamlet_end_nontemporal();
+    unsigned long axpy_cycles = bench_timed_end(start);
+
+    size_t tail = N_AXPY - M_ROW;
+    int bad = vverifyDoubleTol(M_ROW, &b->y[tail], 1, &b->want_y[tail], 1e-10);
+    if (bad) {
+        printf("FAIL %s: y[%d] = %f, expected %f\n", axpy_name, (int)tail + bad - 1,
+               b->y[tail + bad - 1], b->want_y[tail + bad - 1]);
+        return 1;
+    }
+
+    unsigned long misses = read_csr(mhpmcounter4);
+    start = bench_timed_begin(gemv_name);
+    gemv_colwise(M_ROW, V_LEN, b->matrix, vector_s, b->dest);
+    unsigned long gemv_cycles = bench_timed_end(start);
+
+    bad = vverifyDoubleTol(M_ROW, b->dest, 1, b->want_dest, 1e-10);
+    *gemv_misses = read_csr(mhpmcounter4) - misses;
+    if (bad) {
+        printf("FAIL %s: dest[%d] = %f, expected %f\n", gemv_name, bad - 1,
+               b->dest[bad - 1], b->want_dest[bad - 1]);
+        return 1;
+    }
+    bad = vverifyDoubleTol(N_AXPY, b->y, 1, b->want_y, 1e-10);
+    if (bad) {
+        printf("FAIL %s: y[%d] = %f, expected %f\n", axpy_name, bad - 1, b->y[bad - 1],
+               b->want_y[bad - 1]);
+        return 1;
+    }
+    printf("%s: %lu cycles, %s after it: %lu cycles, %lu cache misses\n", axpy_name,
+           axpy_cycles, gemv_name, gemv_cycles, *gemv_misses);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    printf("daxpy-gemv on %s: %d x %d matrix, n = %d\n", ZAMLET_GEOMETRY_NAME, (int)M_ROW,
+           (int)V_LEN, (int)N_AXPY);
+
+    struct buffers b;
+    b.matrix = vpu_alloc_ew(M_ROW * V_LEN * sizeof(double), 64);
+    b.x = vpu_alloc_ew(N_AXPY * sizeof(double), 64);
+    b.y = vpu_alloc_ew(N_AXPY * sizeof(double), 64);
+    b.dest = vpu_alloc_ew(M_ROW * sizeof(double), 64);
+    b.want_y = vpu_alloc_ew(N_AXPY * sizeof(double), 64);
+    b.want_dest = vpu_alloc_ew(M_ROW * sizeof(double), 64);
+    b.scratch = vpu_alloc_ew(ZAMLET_CACHE_BYTES, 64);
+
+    // Column j holds i + j, so with a vector of ones dest[i] = V_LEN * i + sum of j.
+    for (size_t j = 0; j < V_LEN; j++) {
+        vinit_affine_f64(&b.matrix[j * M_ROW], M_ROW, 1.0, (double)j);
+        vector_s[j] = 1.0;
+    }
+    vinit_affine_f64(b.want_dest, M_ROW, (double)V_LEN, (double)(V_LEN * (V_LEN - 1) / 2));
+    // x[i] = i + 1 and y[i] = 2 * i, so y + a * x = (2 + a) * i + a.
+    vinit_affine_f64(b.x, N_AXPY, 1.0, 1.0);
+    vinit_affine_f64(b.want_y, N_AXPY, 2.0 + AXPY_A, AXPY_A);
+
+    unsigned long misses, misses_nt;
+    if (run(&b, 0, &misses) || run(&b, 1, &misses_nt))
+        return 1;
+    if (misses_nt * 2 >= misses) {
+        printf("FAIL gemv_nt: %lu cache misses, expected under half of gemv's %lu\n",
+               misses_nt, misses);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
@@ -13,6 +13,8 @@
 #include <riscv_vector.h>
 #include "util.h"
 #include "vpu_alloc.h"
+#include "bench.h"
+#include "vinit.h"
 
 void axpy_intrinsics(double a, double *dx, double *dy, size_t n) {
   for (size_t i = 0; i < n;) {
@@ -28,49 +30,44 @@ void axpy_intrinsics(double a, double *dx, double *dy, size_t n) {
 #define N 32
 double dx[N] __attribute__((section(".data.vpu64")));
 double dy[N] __attribute__((section(".data.vpu64")));
+// In VPU memory so the check can compare it against dy with vector loads.
+double expected[N] __attribute__((section(".data.vpu64")));
 
 int main(int argc, char *argv[])
 {
   double a = 2.5;
 
-  // Initialize input arrays with test data
-  for (size_t i = 0; i < N; i++) {
-    dx[i] = (double)(i + 1);
-    dy[i] = (double)(i * 2);
-  }
+  // Initialize input arrays with test data: dx[i] = i + 1, dy[i] = 2 * i
+  vinit_affine_f64(dx, N, 1.0, 1.0);
+  vinit_affine_f64(dy, N, 2.0, 0.0);
 
-  // Compute expected result for verification
-  double expected[N];
-  for (size_t i = 0; i < N; i++) {
-    expected[i] = dy[i] + a * dx[i];
-  }
+  // Compute expected result for verification: dy[i] + a * dx[i] = (2 + a) * i + a
+  vinit_affine_f64(expected, N, 2.0 + a, a);
 
   // Execute vector AXPY
   unsigned long cycles1, cycles2, instr2, instr1;
   instr1 = read_csr(minstret);
   cycles1 = read_csr(mcycle);
 
+  bench_begin("daxpy");
   axpy_intrinsics(a, dx, dy, N);
+  bench_end();
 
   asm volatile("fence");
   instr2 = read_csr(minstret);
   cycles2 = read_csr(mcycle);
 
   // Verify results
-  int errors = 0;
-  for (size_t i = 0; i < N; i++) {
-    if (fabs(dy[i] - expected[i]) > 1e-10) {
-      printf("ERROR at index %ld: got %f, expected %f\n", i, dy[i], expected[i]);
-      errors++;
-    }
-  }
+  int bad = vverifyDoubleTol(N, dy, 1, expected, 1e-10);
 
-  if (errors == 0) {
+  if (bad == 0) {
     printf("PASSED: vec-daxpy test\n");
     printf("Cycles: %lu\n", cycles2 - cycles1);
     printf("Instructions: %lu\n", instr2 - instr1);
   } else {
-    printf("FAILED: %d errors\n", errors);
+    printf("ERROR at index %d: got %f, expected %f\n", bad - 1, dy[bad - 1],
+           expected[bad - 1]);
+    printf("FAILED\n");
     return 1;
   }
 
@@ -0,0 +1,147 @@
+load("//bazel:defs.bzl", "BENCH_COPTS", "dataset_kernel", "kernel_test", "riscv_kernel")
+
+def compact_target(n, keep, timeout = "long", geometries = None, max_cycles = 100000):
+    """vcompress.vm compaction against a masked scatter, keeping a[i] where x[i] < keep.
+
+    gen_compact.py draws x from [0, 10), so keep sets the selectivity to keep · 10%.
+    Targets are labelled <n>_k<keep>.
+    """
+    dataset_kernel(
+        "compact", "{}_k{}".format(n, keep), "{} {}".format(n, keep),
+        max_cycles = max_cycles, timeout = timeout, geometries = geometries)
+
+def conv1d_target(n, taps, timeout = "long", geometries = None, max_cycles = 100000):
+    """N-tap FIR over n outputs, f32 and int16, reloading each tap window against
+    sliding one load per strip. Targets are labelled <n>_t<taps>.
+    """
+    dataset_kernel(
+        "conv1d", "{}_t{}".format(n, taps), "{} {}".format(n, taps),
+        max_cycles = max_cycles, timeout = timeout, geometries = geometries)
+
+def conv2d_target(rows, cols, k, timeout = "long", geometries = None, max_cycles = 100000):
+    """k x k filter over a rows x cols output, int32 and f64, reloading each window row
+    against keeping k input rows resident. Targets are labelled <rows>x<cols>_k<k>.
+    """
+    dataset_kernel(
+        "conv2d", "{}x{}_k{}".format(rows, cols, k), "{} {} {}".format(rows, cols, k),
+        max_cycles = max_cycles, timeout = timeout, geometries = geometries)
+
+def divsqrt_target(n, iters, timeout = "long", geometries = None, max_cycles = 100000):
+    """f32 and f64 division and square root over n elements, vfdiv / vfsqrt against the
+    vfrec7 / vfrsqrt7 estimates refined by Newton-Raphson. One kernel per n and one test
+    per entry of iters, labelled <n>_i<iterations>.
+    """
+    dataset_kernel(
+        "divsqrt", str(n), str(n),
+        tests = {"_i{}".format(i): {"divsqrt_iters": i} for i in iters},
+        max_cycles = max_cycles, timeout = timeout, geometries = geometries)
+
+def gemm_target(m, n, k, double = False, timeout = "long", geometries = None):
+    """Tiled GEMM C = A · B for an m x k by k x n problem.
+
+    gen_gemm.py emits the dataset header; vec-gemm.c runs the packed-panel
+    outer-product kernel and checks C against it. double=True builds DGEMM and
+    carries a "_d" suffix.
+    """
+    dataset_kernel(
+        "gemm", "{}x{}x{}{}".format(m, n, k, "_d" if double else ""),
+        "{} {} {}{}".format(m, n, k, " --double" if double else ""),
+        copts = ["-ffast-math"], timeout = timeout, geometries = geometries)
+
+def histogram_target(n, bins, dist = "uniform", timeout = "long", geometries = None):
+    """Privatized per-lane bins against sort-then-segmented-reduce on n bin indices.
+
+    gen_histogram.py draws the indices from `dist` ("uniform" or "skewed"). Targets
+    are labelled <n>x<bins>_<dist>.
+    """
+    dataset_kernel(
+        "histogram", "{}x{}_{}".format(n, bins, dist),
+        "{} {} --dist {}".format(n, bins, dist), header_define = "HIST_HEADER",
+        timeout = timeout, geometries = geometries)
+
+def qgemv_target(m, n, timeout = "long", geometries = None):
+    """Quantized int8 GEMV y = diag(scale) · (W · x) for an m x n weight matrix.
+
+    gen_qgemv.py emits the dataset header; vec-qgemv.c runs the scalar reference and
+    the RVV kernel and checks y against it.
+    """
+    dataset_kernel(
+        "qgemv", "{}x{}".format(m, n), "{} {}".format(m, n),
+        timeout = timeout, geometries = geometries)
+
+def softmax_target(rows, cols, timeout = "long", geometries = None):
+    """Row softmax over a rows x cols f32 matrix.
+
+    gen_softmax.py emits the dataset header; vec-softmax.c runs the four-pass and the
+    fused two-pass kernels and checks both against it.
+    """
+    dataset_kernel(
+        "softmax", "{}x{}".format(rows, cols), "{} {}".format(rows, cols),
+        timeout = timeout, geometries = geometries)
+
+def radix_sort_target(n, key_bits = 32, radix_bits = 4, timeout = "long", geometries = None):
+    """LSD radix sort of n 32-bit key/value pairs, radix_bits bits per pass.
+
+    gen_sort.py draws the keys from [0, 2^key_bits), so a small key_bits gives many
+    equal keys and checks stability. Targets are labelled <n>_k<key_bits>_r<radix_bits>.
+    """
+    data_label = "{}_k{}".format(n, key_bits)
+    dataset_kernel(
+        "radix_sort", "{}_r{}".format(data_label, radix_bits),
+        "{} --key-bits {}".format(n, key_bits), data_label = data_label,
+        gen = "gen_sort.py", header_define = "SORT_HEADER",
+        common_srcs = ["//python/zamlet/kernel_tests/common:vscan"],
+        copts = ["-DRADIX_BITS={}".format(radix_bits)],
+        timeout = timeout, geometries = geometries)
+
+def spmv_target(rows, cols, sigma = 1, min_nnz = 5, max_nnz = 30, seed = 0,
+                timeout = "long", geometries = None):
+    """CSR (unbounded and index-bounded) vs SELL-C-sigma spmv on a rows x cols
+    matrix from gen_spmv.py.
+
+    C is VLMAX at e64m4 on the running geometry; sigma is the sorting window
+    (1 = sliced ELLPACK). Targets carry a "_s<sigma>" suffix.
+    """
+    data_label = "{}x{}_nnz{}_{}".format(rows, cols, min_nnz, max_nnz)
+    dataset_kernel(
+        "spmv", "{}_s{}".format(data_label, sigma),
+        "{} {} --min-nnz {} --max-nnz {} --seed {}".format(
+            rows, cols, min_nnz, max_nnz, seed),
+        data_label = data_label,
+        srcs = ["vec-spmv.c", "sell.c", "csr.c", "//python/zamlet/kernel_tests/common:ara/spmv.c"],
+        hdrs = ["sell.h", "csr.h"],
+        copts = ["-DSPMV_SIGMA={}".format(sigma)],
+        timeout = timeout, geometries = geometries)
+
+def transpose_target(m, n, ew, block = None, timeout = "long", geometries = None,
+                     max_cycles = 100000):
+    """Tiled strided, segment and scatter transposes of an m x n matrix of ew-bit elements.
+
+    Targets are labelled <m>x<n>_e<ew>. block overrides the kernel's tile side through
+    symbol_values and adds _b<block> to the test name; calls that differ only in block
+    share one kernel.
+    """
+    label = "{}x{}_e{}".format(m, n, ew)
+    kernel_name = "vec-transpose-{}".format(label)
+    test_label = label if block == None else "{}_b{}".format(label, block)
+    if native.existing_rule(kernel_name) == None:
+        riscv_kernel(
+            name = kernel_name,
+            srcs = ["vec-transpose.c"],
+            common_srcs = ["//python/zamlet/kernel_tests/common:ara_runtime"],
+            hdrs = ["//python/zamlet/kernel_tests/common:headers"],
+            linker_script = "//python/zamlet/kernel_tests/common:test.ld",
+            copts = BENCH_COPTS + [
+                "-DTRANSPOSE_M={}".format(m),
+                "-DTRANSPOSE_N={}".format(n),
+                "-DTRANSPOSE_EW={}".format(ew),
+            ],
+        )
+    kernel_test(
+        name = "test_transpose_{}".format(test_label),
+        kernel = ":" + kernel_name,
+        max_cycles = max_cycles,
+        symbol_values = None if block == None else {"transpose_block": block},
+        timeout = timeout,
+        geometries = geometries,
+    )
@@ -0,0 +1,60 @@
+"""Generate a division and square-root dataset header.
+
+Usage:
+    python gen_divsqrt.py N [--seed S] > divsqrt_data.h
+
+Declares, for T = float (suffix f, section .data.vpu32) and double (suffix d,
+.data.vpu64):
+    #define DIVSQRT_N N
+    T divsqrt_a{f,d}[N];   // numerators, |a| in [2^-20, 2^20], either sign
+    T divsqrt_b{f,d}[N];   // denominators, same range
+    T divsqrt_x{f,d}[N];   // square-root operands in [2^-40, 2^40]
+    T divsqrt_q{f,d}[N];   // a / b, rounded to T
+    T divsqrt_s{f,d}[N];   // sqrt(x), rounded to T
+
+Magnitudes are log-uniform so every bucket of the 7-bit estimate tables and both exponent
+parities are hit. The references are correctly rounded: the float quotient and root are
+taken in double and rounded to float, which rounds the same as the float op would.
+"""
+import argparse
+import math
+import random
+
+from gen_header import emit, f32
+
+parser = argparse.ArgumentParser()
+parser.add_argument("N", type=int)
+parser.add_argument("--seed", type=int, default=1)
+args = parser.parse_args()
+n = args.N
+assert n > 0
+
+rng = random.Random(args.seed)
+
+
+def magnitude(lo, hi):
+    return 2.0 ** rng.uniform(lo, hi)
+
+
+def signed(lo, hi):
+    return rng.choice((-1.0, 1.0)) * magnitude(lo, hi)
+
+
+def dataset(rnd):
+    a = [rnd(signed(-20, 20)) for _ in range(n)]
+    b = [rnd(signed(-20, 20)) for _ in range(n)]
+    x = [rnd(magnitude(-40, 40)) for _ in range(n)]
+    q = [rnd(ai / bi) for ai, bi in zip(a, b)]
+    s = [rnd(math.sqrt(xi)) for xi in x]
+    return a, b, x, q, s
+
+
+print(f"// Generated by gen_divsqrt.py {n} --seed {args.seed}")
+print()
+print(f"#define DIVSQRT_N {n}")
+print()
+for suffix, ctype, section, rnd, fmt, per_line in (
+        ("f", "float", ".data.vpu32", f32, lambda v: f"{v:.9e}f", 5),
+        ("d", "double", ".data.vpu64", float, lambda v: f"{v!r}", 3)):
+    for name, values in zip("abxqs", dataset(rnd)):
+        emit(ctype, f"divsqrt_{name}{suffix}", values, section, fmt, per_line)
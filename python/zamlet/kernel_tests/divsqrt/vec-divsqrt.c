@@ -0,0 +1,242 @@
+/*
+ * Division and square root from the vfrec7 / vfrsqrt7 estimates (vec-div-approx,
+ * vec-square-root-approx), checked and timed next to the vfdiv / vfsqrt they stand in
+ * for, in f32 and f64. DIVSQRT_HEADER (gen_divsqrt.py N) supplies the operands and the
+ * correctly rounded quotients and roots.
+ *
+ * div_approx_* refines r = vfrec7(b) with divsqrt_iters Newton-Raphson steps
+ * e = 1 - b·r, r = r + r·e, then returns a·r. sqrt_approx_* refines y = vfrsqrt7(x)
+ * with steps y = y·(1.5 - (x/2)·y²), then returns x·y. Each step roughly doubles the
+ * correct bits from the estimates' 7: two steps reach f32 precision and three are
+ * needed for f64. The estimates are pure lookups, so the approximate paths run only
+ * multiplies and fused multiply-adds.
+ *
+ * The model gives vfdiv and vfsqrt no latency of their own: their kinstrs execute like
+ * those of any other vector arithmetic op. The exact variants therefore issue one
+ * instruction per strip against the approximate ones' several, and the region cycles
+ * compare instruction counts, not the cost of division on hardware.
+ *
+ * divsqrt_iters is set with SYMBOL_VALUES, so one binary measures every precision.
+ * The exact variants must match the references bit for bit. The approximate ones are
+ * reported with their maximum relative error and must be within 2^-bound_bits(iters).
+ * All checks are vector compares and reductions, so the scalar core never reads VPU
+ * memory.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include DIVSQRT_HEADER
+
+#define DIVSQRT_MAX_ITERS 3
+
+// Newton-Raphson steps; kernel_test overrides it through symbol_values.
+volatile int32_t divsqrt_iters = 2;
+
+// Correct bits required after iters steps of a p-bit significand: 7 from the estimate,
+// each step at least 2·b - 2 (the square of the error plus the rsqrt step's 3/2 factor
+// and rounding), and never more than p - 3, leaving a few ulps for the rounding of the
+// steps themselves.
+static int bound_bits(int iters, int p) {
+    int b = 7;
+    for (int k = 0; k < iters; k++)
+        b = 2 * b - 2;
+    return b < p - 3 ? b : p - 3;
+}
+
+// Exponent E with e < 2^E, for reporting errors as powers of two.
+static int err_exp(double e) {
+    uint64_t bits;
+    memcpy(&bits, &e, sizeof(bits));
+    return (int)((bits >> 52) & 0x7ff) - 1022;
+}
+
+// Report the cycles bench region name took.
+static void report(const char* name, unsigned long cycles) {
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " cycles/element)\n", name, cycles,
+           BENCH_RATE(cycles, DIVSQRT_N));
+}
+
+/*
+ * DIVSQRT_DEFINE(S, T, EW, P, MB, F) defines the kernels and their checks for element
+ * type T, where S is the intrinsic type suffix (f32 / f64), EW the element width, P the
+ * significand bits, MB the mask ratio of an EW m4 register group and F the suffix of
+ * the gen_divsqrt.py arrays.
+ */
+#define DIVSQRT_DEFINE(S, T, EW, P, MB, F)                                               \
+void div_exact_##S(const T* a, const T* b, T* q, size_t n) {                             \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vfloat##EW##m4_t va = __riscv_vle##EW##_v_##S##m4(&a[i], vl);                    \
+        vfloat##EW##m4_t vb = __riscv_vle##EW##_v_##S##m4(&b[i], vl);                    \
+        __riscv_vse##EW##_v_##S##m4(&q[i], __riscv_vfdiv_vv_##S##m4(va, vb, vl), vl);    \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+void div_approx_##S(const T* a, const T* b, T* q, size_t n, int iters) {                 \
+    vfloat##EW##m4_t one = __riscv_vfmv_v_f_##S##m4(1.0, __riscv_vsetvlmax_e##EW##m4()); \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vfloat##EW##m4_t vb = __riscv_vle##EW##_v_##S##m4(&b[i], vl);                    \
+        vfloat##EW##m4_t r = __riscv_vfrec7_v_##S##m4(vb, vl);                           \
+        for (int k = 0; k < iters; k++) {                                                \
+            vfloat##EW##m4_t e = __riscv_vfnmsac_vv_##S##m4(one, vb, r, vl);             \
+            r = __riscv_vfmacc_vv_##S##m4(r, r, e, vl);                                  \
+        }                                                                                \
+        vfloat##EW##m4_t va = __riscv_vle##EW##_v_##S##m4(&a[i], vl);                    \
+        __riscv_vse##EW##_v_##S##m4(&q[i], __riscv_vfmul_vv_##S##m4(va, r, vl), vl);     \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+void sqrt_exact_##S(const T* x, T* s, size_t n) {                                        \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vfloat##EW##m4_t vx = __riscv_vle##EW##_v_##S##m4(&x[i], vl);                    \
+        __riscv_vse##EW##_v_##S##m4(&s[i], __riscv_vfsqrt_v_##S##m4(vx, vl), vl);        \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+void sqrt_approx_##S(const T* x, T* s, size_t n, int iters) {                            \
+    vfloat##EW##m4_t three_halves =                                                      \
+        __riscv_vfmv_v_f_##S##m4(1.5, __riscv_vsetvlmax_e##EW##m4());                    \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vfloat##EW##m4_t vx = __riscv_vle##EW##_v_##S##m4(&x[i], vl);                    \
+        vfloat##EW##m4_t h = __riscv_vfmul_vf_##S##m4(vx, 0.5, vl);                      \
+        vfloat##EW##m4_t y = __riscv_vfrsqrt7_v_##S##m4(vx, vl);                         \
+        for (int k = 0; k < iters; k++) {                                                \
+            vfloat##EW##m4_t y2 = __riscv_vfmul_vv_##S##m4(y, y, vl);                    \
+            y = __riscv_vfmul_vv_##S##m4(                                                \
+                y, __riscv_vfnmsac_vv_##S##m4(three_halves, h, y2, vl), vl);             \
+        }                                                                                \
+        __riscv_vse##EW##_v_##S##m4(&s[i], __riscv_vfmul_vv_##S##m4(vx, y, vl), vl);     \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+/* max |y[i] - e[i]| / |e[i]| over i < n, with the number of NaN y[i] in *nans. */       \
+static T max_rel_err_##S(const T* y, const T* e, size_t n, size_t* nans) {               \
+    size_t vlmax = __riscv_vsetvlmax_e##EW##m4();                                        \
+    vfloat##EW##m4_t worst = __riscv_vfmv_v_f_##S##m4(0.0, vlmax);                       \
+    *nans = 0;                                                                           \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vfloat##EW##m4_t vy = __riscv_vle##EW##_v_##S##m4(&y[i], vl);                    \
+        vfloat##EW##m4_t ve = __riscv_vle##EW##_v_##S##m4(&e[i], vl);                    \
+        vfloat##EW##m4_t d = __riscv_vfdiv_vv_##S##m4(                                   \
+            __riscv_vfabs_v_##S##m4(__riscv_vfsub_vv_##S##m4(vy, ve, vl), vl),           \
+            __riscv_vfabs_v_##S##m4(ve, vl), vl);                                        \
+        worst = __riscv_vfmax_vv_##S##m4_tu(worst, worst, d, vl);                        \
+        *nans += __riscv_vcpop_m_b##MB(__riscv_vmfne_vv_##S##m4_b##MB(vy, vy, vl), vl);  \
+        i += vl;                                                                         \
+    }                                                                                    \
+    vfloat##EW##m1_t init = __riscv_vfmv_s_f_##S##m1(0.0, 1);                            \
+    return __riscv_vfmv_f_s_##S##m1_##S(                                                 \
+        __riscv_vfredmax_vs_##S##m4_##S##m1(worst, init, vlmax));                        \
+}                                                                                        \
+                                                                                         \
+static int check_exact_##S(const char* name, const T* y, const T* e) {                   \
+    size_t bad = bench_mismatches##EW(y, e, DIVSQRT_N);                                  \
+    if (bad) {                                                                           \
+        printf("FAIL %s: %zu of %d results not correctly rounded\n", name, bad,         \
+               DIVSQRT_N);                                                               \
+        return 1;                                                                        \
+    }                                                                                    \
+    return 0;                                                                            \
+}                                                                                        \
+                                                                                         \
+static int check_approx_##S(const char* name, const T* y, const T* e, int iters) {       \
+    size_t nans;                                                                         \
+    double err = max_rel_err_##S(y, e, DIVSQRT_N, &nans);                                \
+    int bits = bound_bits(iters, P);                                                     \
+    if (err == 0.0)                                                                      \
+        printf("%s: exact\n", name);                                                     \
+    else                                                                                 \
+        printf("%s: max relative error < 2^%d\n", name, err_exp(err));                   \
+    if (nans) {                                                                          \
+        printf("FAIL %s: %zu of %d results are NaN\n", name, nans, DIVSQRT_N);           \
+        return 1;                                                                        \
+    }                                                                                    \
+    double bound = 1.0;                                                                  \
+    for (int k = 0; k < bits; k++)                                                       \
+        bound *= 0.5;                                                                    \
+    if (err > bound) {                                                                   \
+        printf("FAIL %s: error above 2^-%d after %d iterations\n", name, bits, iters);   \
+        return 1;                                                                        \
+    }                                                                                    \
+    return 0;                                                                            \
+}                                                                                        \
+                                                                                         \
+static int run_##S(int iters) {                                                          \
+    T* q = vpu_alloc_ew(DIVSQRT_N * sizeof(T), EW);                                      \
+    T* q_approx = vpu_alloc_ew(DIVSQRT_N * sizeof(T), EW);                               \
+    T* s = vpu_alloc_ew(DIVSQRT_N * sizeof(T), EW);                                      \
+    T* s_approx = vpu_alloc_ew(DIVSQRT_N * sizeof(T), EW);                               \
+    size_t words = DIVSQRT_N * sizeof(T) / sizeof(uint32_t);                             \
+    bench_poison32(q, words);                                                            \
+    bench_poison32(q_approx, words);                                                     \
+    bench_poison32(s, words);                                                            \
+    bench_poison32(s_approx, words);                                                     \
+                                                                                         \
+    unsigned long start = bench_timed_begin("div_exact_" #S);                            \
+    div_exact_##S(divsqrt_a##F, divsqrt_b##F, q, DIVSQRT_N);                             \
+    report("div_exact_" #S, bench_timed_end(start));                                     \
+    start = bench_timed_begin("div_approx_" #S);                                         \
+    div_approx_##S(divsqrt_a##F, divsqrt_b##F, q_approx, DIVSQRT_N, iters);              \
+    report("div_approx_" #S, bench_timed_end(start));                                    \
+    start = bench_timed_begin("sqrt_exact_" #S);                                         \
+    sqrt_exact_##S(divsqrt_x##F, s, DIVSQRT_N);                                          \
+    report("sqrt_exact_" #S, bench_timed_end(start));                                    \
+    start = bench_timed_begin("sqrt_approx_" #S);                                        \
+    sqrt_approx_##S(divsqrt_x##F, s_approx, DIVSQRT_N, iters);                           \
+    report("sqrt_approx_" #S, bench_timed_end(start));                                   \
+                                                                                         \
+    if (check_exact_##S("div_exact_" #S, q, divsqrt_q##F))                               \
+        return 1;                                                                        \
+    if (check_exact_##S("sqrt_exact_" #S, s, divsqrt_s##F))                              \
+        return 1;                                                                        \
+    if (check_approx_##S("div_approx_" #S, q_approx, divsqrt_q##F, iters))               \
+        return 1;                                                                        \
+    return check_approx_##S("sqrt_approx_" #S, s_approx, divsqrt_s##F, iters);           \
+}
+
+DIVSQRT_DEFINE(f32, float, 32, 24, 8, f)
+DIVSQRT_DEFINE(f64, double, 64, 53, 16, d)
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int iters = divsqrt_iters;
+    printf("divsqrt n = %d, %d iterations\n", DIVSQRT_N, iters);
+    if (iters < 0 || iters > DIVSQRT_MAX_ITERS) {
+        printf("FAIL divsqrt_iters must be in [0, %d]\n", DIVSQRT_MAX_ITERS);
+        return 1;
+    }
+
+#if PREALLOCATE
+    {
+        float* yf = vpu_alloc_ew(DIVSQRT_N * sizeof(float), 32);
+        double* yd = vpu_alloc_ew(DIVSQRT_N * sizeof(double), 64);
+        div_approx_f32(divsqrt_af, divsqrt_bf, yf, DIVSQRT_N, iters);
+        sqrt_approx_f32(divsqrt_xf, yf, DIVSQRT_N, iters);
+        div_approx_f64(divsqrt_ad, divsqrt_bd, yd, DIVSQRT_N, iters);
+        sqrt_approx_f64(divsqrt_xd, yd, DIVSQRT_N, iters);
+    }
+#endif
+
+    if (run_f32(iters))
+        return 1;
+    if (run_f64(iters))
+        return 1;
+
+    printf("PASSED\n");
+    return 0;
+}
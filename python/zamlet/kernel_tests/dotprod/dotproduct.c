@@ -17,6 +17,7 @@
 // Author: Matteo Perotti <mperotti@iis.ee.ethz.ch>
 
 #include "dotproduct.h"
+#include "dotp_batch.h"
 
 int64_t dotp_v64b(int64_t *a, int64_t *b, uint64_t avl) {
   size_t orig_avl = avl;
@@ -154,6 +155,53 @@ int8_t dotp_v8b(int8_t *a, int8_t *b, uint64_t avl) {
   return __riscv_vmv_x_s_i8m1_i8(red);
 }
 
+// Widening dot products. The narrow versions above accumulate in the input
+// element width and overflow after a handful of 8- or 16-bit products.
+// dotp_vw16b accumulates with vwmacc into 32-bit lanes and sums the lanes
+// into a 64-bit result with vwredsum. dotp_vw8b is the quad-widening path:
+// vwmul forms exact 16-bit products of the 8-bit inputs and vwadd.wv adds
+// them into 32-bit lanes. Both stripmine at the narrow width, so each
+// iteration covers as many elements as one e32m8 register group.
+int64_t dotp_vw16b(int16_t *a, int16_t *b, uint64_t avl) {
+  size_t vlmax = __riscv_vsetvlmax_e32m8();
+
+  vint32m8_t acc = __riscv_vmv_v_x_i32m8(0, vlmax);
+  vint64m1_t red = __riscv_vmv_s_x_i64m1(0, 1);
+
+  for (size_t vl; avl > 0; avl -= vl) {
+    vl = __riscv_vsetvl_e16m4(avl);
+    vint16m4_t buf_a = __riscv_vle16_v_i16m4(a, vl);
+    vint16m4_t buf_b = __riscv_vle16_v_i16m4(b, vl);
+    // Tail undisturbed: lanes past a short final strip keep their sums
+    acc = __riscv_vwmacc_vv_i32m8_tu(acc, buf_a, buf_b, vl);
+    a += vl;
+    b += vl;
+  }
+
+  red = __riscv_vwredsum_vs_i32m8_i64m1(acc, red, vlmax);
+  return __riscv_vmv_x_s_i64m1_i64(red);
+}
+
+int32_t dotp_vw8b(int8_t *a, int8_t *b, uint64_t avl) {
+  size_t vlmax = __riscv_vsetvlmax_e32m8();
+
+  vint32m8_t acc = __riscv_vmv_v_x_i32m8(0, vlmax);
+  vint32m1_t red = __riscv_vmv_s_x_i32m1(0, 1);
+
+  for (size_t vl; avl > 0; avl -= vl) {
+    vl = __riscv_vsetvl_e8m2(avl);
+    vint8m2_t buf_a = __riscv_vle8_v_i8m2(a, vl);
+    vint8m2_t buf_b = __riscv_vle8_v_i8m2(b, vl);
+    vint16m4_t prod = __riscv_vwmul_vv_i16m4(buf_a, buf_b, vl);
+    acc = __riscv_vwadd_wv_i32m8_tu(acc, acc, prod, vl);
+    a += vl;
+    b += vl;
+  }
+
+  red = __riscv_vredsum_vs_i32m8_i32m1(acc, red, vlmax);
+  return __riscv_vmv_x_s_i32m1_i32(red);
+}
+
 int64_t dotp_s64b(int64_t *a, int64_t *b, uint64_t avl) {
   int64_t acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7;
 
@@ -297,3 +345,22 @@ int8_t dotp_s8b(int8_t *a, int8_t *b, uint64_t avl) {
 
   return acc0;
 }
+
+int64_t dotp_sw16b(int16_t *a, int16_t *b, uint64_t avl) {
+  int64_t acc = 0;
+  for (uint64_t i = 0; i < avl; i++)
+    acc += (int32_t)a[i] * b[i];
+  return acc;
+}
+
+int32_t dotp_sw8b(int8_t *a, int8_t *b, uint64_t avl) {
+  int32_t acc = 0;
+  for (uint64_t i = 0; i < avl; i++)
+    acc += (int16_t)(a[i] * b[i]);
+  return acc;
+}
+
+DOTP_BATCH_DEFINE(dotp_batch_v64b, int64_t, 64, int, i64, vmacc, vadd, vmv_v_x)
+DOTP_BATCH_DEFINE(dotp_batch_v32b, int32_t, 32, int, i32, vmacc, vadd, vmv_v_x)
+DOTP_BATCH_DEFINE(dotp_batch_v16b, int16_t, 16, int, i16, vmacc, vadd, vmv_v_x)
+DOTP_BATCH_DEFINE(dotp_batch_v8b, int8_t, 8, int, i8, vmacc, vadd, vmv_v_x)
@@ -29,9 +29,22 @@ int32_t dotp_v32b(int32_t *a, int32_t *b, uint64_t avl);
 int16_t dotp_v16b(int16_t *a, int16_t *b, uint64_t avl);
 int8_t dotp_v8b(int8_t *a, int8_t *b, uint64_t avl);
 
+// Widening: 16b inputs into 32b lanes and a 64b sum, 8b inputs into 32b
+int64_t dotp_vw16b(int16_t *a, int16_t *b, uint64_t avl);
+int32_t dotp_vw8b(int8_t *a, int8_t *b, uint64_t avl);
+
 int64_t dotp_s64b(int64_t *a, int64_t *b, uint64_t avl);
 int32_t dotp_s32b(int32_t *a, int32_t *b, uint64_t avl);
 int16_t dotp_s16b(int16_t *a, int16_t *b, uint64_t avl);
 int8_t dotp_s8b(int8_t *a, int8_t *b, uint64_t avl);
+int64_t dotp_sw16b(int16_t *a, int16_t *b, uint64_t avl);
+int32_t dotp_sw8b(int8_t *a, int8_t *b, uint64_t avl);
+
+// K independent dot products out[k] = a[k] . b[k], reduced together at the
+// end (see common/dotp_batch.h).
+void dotp_batch_v64b(int64_t *a[], int64_t *b[], size_t K, size_t avl, int64_t out[]);
+void dotp_batch_v32b(int32_t *a[], int32_t *b[], size_t K, size_t avl, int32_t out[]);
+void dotp_batch_v16b(int16_t *a[], int16_t *b[], size_t K, size_t avl, int16_t out[]);
+void dotp_batch_v8b(int8_t *a[], int8_t *b[], size_t K, size_t avl, int8_t out[]);
 
 #endif
@@ -28,6 +28,55 @@
 // Check the vector results against golden vectors
 #define CHECK 1
 
+// Batched dot products: BATCH_K slices of BATCH_AVL elements per call
+#define BATCH_K 16
+#define BATCH_AVL 8
+
+// Time BATCH_K single dotp_v<BITS>b calls against one dotp_batch_v<BITS>b
+// call on the same slices, and check every batched result against the scalar
+// dotp_s<BITS>b.
+#define BATCH_BENCH(BITS) do { \
+    int##BITS##_t *pa[BATCH_K], *pb[BATCH_K]; \
+    int##BITS##_t single[BATCH_K], batch[BATCH_K]; \
+    for (int k = 0; k < BATCH_K; k++) { \
+      pa[k] = v##BITS##a + k * BATCH_AVL; \
+      pb[k] = v##BITS##b + k * BATCH_AVL; \
+    } \
+    printf("Calculating %d %db dotps with length = %d\n", BATCH_K, BITS, BATCH_AVL); \
+    cycles1 = read_csr(mcycle); \
+    for (int k = 0; k < BATCH_K; k++) \
+      single[k] = dotp_v##BITS##b(pa[k], pb[k], BATCH_AVL); \
+    asm volatile("fence"); \
+    cycles2 = read_csr(mcycle); \
+    printf("Single cycles: %ld\n", cycles2 - cycles1); \
+    cycles1 = read_csr(mcycle); \
+    dotp_batch_v##BITS##b(pa, pb, BATCH_K, BATCH_AVL, batch); \
+    asm volatile("fence"); \
+    cycles2 = read_csr(mcycle); \
+    printf("Batch cycles: %ld\n", cycles2 - cycles1); \
+    if (CHECK) { \
+      for (int k = 0; k < BATCH_K; k++) { \
+        int##BITS##_t golden = dotp_s##BITS##b(pa[k], pb[k], BATCH_AVL); \
+        if (batch[k] != golden || single[k] != golden) { \
+          printf("Error: %db batch dotp %d\n", BITS, k); \
+          return -1; \
+        } \
+      } \
+    } \
+  } while (0)
+
+// Time FN over all vsize elements of A and B and report elements per cycle
+// (two decimals). The result is left in rate_res.
+#define RATE_BENCH(FN, A, B) do { \
+    cycles1 = read_csr(mcycle); \
+    rate_res = FN(A, B, vsize); \
+    asm volatile("fence"); \
+    cycles2 = read_csr(mcycle); \
+    unsigned long c = cycles2 - cycles1; \
+    printf("%s: %lu elements, %lu cycles (%lu.%02lu elements/cycle)\n", #FN, vsize, c, \
+           vsize / c, vsize * 100 / c % 100); \
+  } while (0)
+
 // Vector size (Byte)
 extern uint64_t vsize;
 // Vectors for benchmarks
@@ -98,6 +147,27 @@ int main() {
     printf("Vector cycles: %ld instructions: %ld\n", cycles2 - cycles1, instr2 - instr1);
   }
 
+  int64_t rate_res;
+  RATE_BENCH(dotp_v64b, v64a, v64b);
+  RATE_BENCH(dotp_v32b, v32a, v32b);
+  RATE_BENCH(dotp_v16b, v16a, v16b);
+  RATE_BENCH(dotp_v8b, v8a, v8b);
+  RATE_BENCH(dotp_vw16b, v16a, v16b);
+  if (CHECK && rate_res != dotp_sw16b(v16a, v16b, vsize)) {
+    printf("Error: widening 16b dotp\n");
+    return -1;
+  }
+  RATE_BENCH(dotp_vw8b, v8a, v8b);
+  if (CHECK && rate_res != dotp_sw8b(v8a, v8b, vsize)) {
+    printf("Error: widening 8b dotp\n");
+    return -1;
+  }
+
+  BATCH_BENCH(64);
+  BATCH_BENCH(32);
+  BATCH_BENCH(16);
+  BATCH_BENCH(8);
+
   printf("SUCCESS.\n");
 
   return 0;
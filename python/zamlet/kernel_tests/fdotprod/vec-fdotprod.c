@@ -0,0 +1,56 @@
+/*
+ * Checks fdotp_v64b (common/ara/fdotproduct.c) at lengths that end on a partial strip.
+ * a[i] = i + 1 and b[i] = i / 2, so every product and sum is exact and the expected value
+ * is the same sum over i on the scalar core. The lengths run down from fdotp_n, so each
+ * call starts with the registers still holding the partial sums of the call before it.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "vinit.h"
+#include "ara/fdotproduct.h"
+
+#define FDOTP_MAX_N 4096
+
+// kernel_test overrides it through symbol_values.
+volatile int32_t fdotp_n = 1001;
+
+static double expected(size_t n) {
+    double s = 0.0;
+    for (size_t i = 0; i < n; i++)
+        s += (double)(i + 1) * (0.5 * (double)i);
+    return s;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int32_t n_sym = fdotp_n;
+    if (n_sym < 8 || n_sym > FDOTP_MAX_N) {
+        printf("FAIL fdotp_n = %d, must be in [8, %d]\n", (int)n_sym, FDOTP_MAX_N);
+        return 1;
+    }
+    size_t n = (size_t)n_sym;
+    double* a = vpu_alloc_ew(n * sizeof(double), 64);
+    double* b = vpu_alloc_ew(n * sizeof(double), 64);
+    vinit_affine_f64(a, n, 1.0, 1.0);
+    vinit_affine_f64(b, n, 0.5, 0.0);
+
+    size_t lengths[] = {n, n - 1, n / 2 + 3, 7, 1};
+    for (size_t k = 0; k < sizeof(lengths) / sizeof(lengths[0]); k++) {
+        size_t len = lengths[k];
+        double got = fdotp_v64b(a, b, len);
+        double want = expected(len);
+        if (got != want) {
+            printf("FAIL fdotp_v64b n = %lu: got %ld, expected %ld\n", (unsigned long)len,
+                   (long)got, (long)want);
+            return 1;
+        }
+        printf("fdotp_v64b n = %lu: %ld\n", (unsigned long)len, (long)got);
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
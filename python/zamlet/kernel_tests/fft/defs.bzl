@@ -1,4 +1,28 @@
-load("//bazel:defs.bzl", "riscv_kernel", "kernel_test")
+load("//bazel:defs.bzl", "BENCH_COPTS", "SMALL_GEOMETRY_NAMES", "riscv_kernel", "kernel_test")
+
+# e32 VLMAX of k2x2_j2x2, the widest of SMALL_GEOMETRY_NAMES (16 jamlets, one
+# 64-bit word each).
+_BR_VL = 32
+
+
+def _fft_plan(n):
+    """Stage radices for vec-fftN-mixed.c: radix-5s, then radix-4s, radix-3s and
+    at most one radix-2, so each stage does as much work per pass as it can."""
+    plan = []
+    for r in [5, 4, 3, 2]:
+        for _ in range(n):
+            if n % r != 0:
+                break
+            plan.append(r)
+            n = n // r
+    if n != 1:
+        fail("vec-fftN-mixed.c needs N = 2^a * 3^b * 5^c, left with factor {}".format(n))
+    return plan
+
+
+def _is_power_of_two(n):
+    return n > 0 and (n & (n - 1)) == 0
+
 
 # vec-fftN: arbitrary-N (power of 2) FFT. One genrule + kernel + test per N.
 # The genrule emits a twiddles_N<N>.h containing omega[], seed_block[][], and
@@ -9,8 +33,146 @@ load("//bazel:defs.bzl", "riscv_kernel", "kernel_test")
 # corrupt_expected=True builds a sibling target whose expected[] array is
 # deliberately wrong, used as an expected-failure sanity check against a
 # vacuously-passing test harness.
+#
+# stockham=True builds vec-fftN-stockham.c instead: a self-sorting
+# out-of-place FFT with no bitreverse pass, for cycle comparison against the
+# DIT + bitreverse kernel. Its targets carry a "_stockham" suffix.
+#
+# fused_bitreverse=False builds the DIT kernel with the standalone
+# bitreverse_reorder64 passes instead of gathering in the first chunk load.
+# Its targets carry an "_unfused" suffix.
+#
+# radix=4 builds the DIT kernel with the fused radix-4 core for Regimes B and
+# C (REGIME_BC_RADIX=4). Its targets carry a "_radix4" suffix.
+#
+# batch=B builds vec-fftN-batch.c: B transforms vectorized across lanes (see
+# fft_n_batch_target). Its targets carry a "_batch<B>" suffix.
+#
+# real=True treats n as a real input length: the DIT kernel runs an n/2-point
+# complex FFT on packed samples plus the real-to-complex post-pass
+# (FFT_REAL=1), against a header generated with --real. Its targets carry a
+# "_real" suffix.
+#
+# mode="inverse" builds the inverse transform (FFT_INVERSE=1, header with
+# --inverse) and mode="conv" the fused FFT -> pointwise -> IFFT convolution
+# driver (FFT_CONV=1, header with --conv). Their targets carry "_inverse" and
+# "_conv" suffixes.
+#
+# The DIT kernel's headers carry prebuilt bit-reverse index tables
+# (gen_twiddles.py --br-vl) so startup skips compute_indices and the index
+# widening loop. The fused gather table is vl-independent; the unfused
+# read/write tables are built for _BR_VL and rebuilt at runtime on geometries
+# whose e32 VLMAX differs.
+#
+# otf_twiddles=True builds the DIT kernel with FFT_OTF_TWIDDLES=1: Regime A
+# and C twiddle vectors are derived in registers, and the header is generated
+# with --k 1, so the resident twiddle footprint is O(vl) rather than
+# O(log2N * vl). Its targets carry an "_otf" suffix.
+#
+# interleaved=True builds the DIT kernel with FFT_INTERLEAVED=1: the buffers
+# hold (re, im) pairs and every load/store is a vlseg2e64/vsseg2e64 (or a
+# vluxseg2ei64 gather). Needs the fused bitreverse and the forward or inverse
+# mode. Its targets carry an "_interleaved" suffix.
+#
+# pipelined=True builds the DIT kernel with FFT_PIPELINED=1: the R=8 chunk loop
+# and the full Regime C passes issue the next (super-)chunk's first two loads
+# ahead of the current one's butterflies and stores. Needs radix=2. Its targets
+# carry a "_pipelined" suffix.
+#
+# mixed=True builds vec-fftN-mixed.c: a Stockham FFT with one radix-2, 3, 4 or
+# 5 stage per factor of _fft_plan(n), against a header generated with --plan.
+# fft_n_target selects it for any n that is not a power of two; for a power of
+# two it is opt-in and the targets carry a "_mixed" suffix.
+#
+# f32=True builds the DIT kernel in single precision (FFT_F32=1) against a
+# header generated with --f32. Vectors run at e32, so max_vlmax is doubled to
+# bound the e32 vl. Needs the fused bitreverse, and does not combine with real,
+# mode, otf_twiddles or interleaved. Its targets carry an "_f32" suffix.
+#
+# geometry="<name>" specializes the DIT kernel for one geometry
+# (riscv_kernel(geometry = ...)): MAX_VLMAX becomes that geometry's exact
+# VLMAX(e64,m1) and the kernel only runs there. Its targets carry a
+# "_<name>" suffix.
 def _fft_n_kernel_and_test(n, k, max_vlmax, suffix, gen_flags, expected_failure,
-                           timeout, n_ffts = 1, geometries = None):
+                           timeout, n_ffts = 1, geometries = None, stockham = False,
+                           fused_bitreverse = True, radix = 2, batch = 0, real = False,
+                           mode = "forward", otf_twiddles = False, geometry = None,
+                           interleaved = False, pipelined = False, mixed = False,
+                           max_cycles = 100000, f32 = False):
+    if mode not in ["forward", "inverse", "conv"]:
+        fail("mode must be forward, inverse or conv, got {}".format(mode))
+    if (real or mode != "forward") and (stockham or batch):
+        fail("real and inverse/conv modes are only supported by the vec-fftN.c kernel")
+    if real and mode != "forward":
+        fail("real=True cannot be combined with mode = {}".format(mode))
+    if otf_twiddles and (stockham or batch):
+        fail("otf_twiddles is only supported by the vec-fftN.c kernel")
+    if pipelined and (stockham or batch):
+        fail("pipelined is only supported by the vec-fftN.c kernel")
+    if pipelined and radix != 2:
+        fail("pipelined needs radix = 2: the radix-4 core's temporaries do not fit beside it")
+    if geometry != None and (stockham or batch):
+        fail("geometry is only supported by the vec-fftN.c kernel")
+    if interleaved and (stockham or batch or real or mode == "conv" or not fused_bitreverse):
+        fail("interleaved needs the fused vec-fftN.c kernel in forward or inverse mode")
+    if mixed and (stockham or batch or real or mode != "forward" or radix != 2 or
+                  not fused_bitreverse or otf_twiddles or interleaved or pipelined or
+                  geometry != None):
+        fail("mixed builds vec-fftN-mixed.c, which has no variants")
+    if f32 and (stockham or batch or mixed or not fused_bitreverse):
+        fail("f32 needs the fused vec-fftN.c kernel")
+    if f32 and (real or mode != "forward" or otf_twiddles or interleaved):
+        fail("f32 is only tested for the forward split-array kernel with stored twiddles")
+    if not mixed and not _is_power_of_two(n):
+        fail("N = {} is not a power of two; only the mixed kernel supports it".format(n))
+    fft_n = n
+    if real:
+        suffix = suffix + "_real"
+        gen_flags = gen_flags + " --real"
+        fft_n = n // 2
+    if mode != "forward":
+        suffix = suffix + "_" + mode
+        gen_flags = gen_flags + " --" + mode
+    if radix not in [2, 4]:
+        fail("radix must be 2 or 4, got {}".format(radix))
+    if radix != 2:
+        suffix = suffix + "_radix{}".format(radix)
+    if not fused_bitreverse:
+        suffix = suffix + "_unfused"
+    if otf_twiddles:
+        suffix = suffix + "_otf"
+        k = 1
+    if interleaved:
+        suffix = suffix + "_interleaved"
+    if pipelined:
+        suffix = suffix + "_pipelined"
+    if f32:
+        suffix = suffix + "_f32"
+        gen_flags = gen_flags + " --f32"
+        if max_vlmax != None:
+            max_vlmax = max_vlmax * 2
+    if geometry != None:
+        suffix = suffix + "_" + geometry
+        geometries = [geometry]
+    if mixed:
+        if _is_power_of_two(n):
+            suffix = suffix + "_mixed"
+        gen_flags = gen_flags + " --plan " + ",".join([str(r) for r in _fft_plan(n)])
+        srcs = ["vec-fftN-mixed.c"]
+    elif batch:
+        suffix = suffix + "_batch{}".format(batch)
+        srcs = ["vec-fftN-batch.c"]
+    elif stockham:
+        suffix = suffix + "_stockham"
+        srcs = ["vec-fftN-stockham.c"]
+    else:
+        gen_flags = gen_flags + " --br-vl {}".format(_BR_VL)
+        srcs = [
+            "vec-fftN.c",
+            "//python/zamlet/kernel_tests/bitreverse_reorder:compute_indices.c",
+            "//python/zamlet/kernel_tests/bitreverse_reorder:bitreverse.S",
+            "//python/zamlet/kernel_tests/bitreverse_reorder:bitreverse_reorder64.c",
+        ]
     suffix_label = "{}{}".format(n, suffix)
     twiddles_name = "twiddles_N{}".format(suffix_label)
     kernel_name = "vec-fftN{}".format(suffix_label)
@@ -22,49 +184,101 @@ def _fft_n_kernel_and_test(n, k, max_vlmax, suffix, gen_flags, expected_failure,
         cmd = "python3 $(location gen_twiddles.py) {} --k {} {} > $@".format(
             n, k, gen_flags),
     )
-    copts = [
+    copts = BENCH_COPTS + [
         "-DPREALLOCATE=1",
         "-ffast-math",
-        "-DFFT_N={}".format(n),
-        "-DMAX_VLMAX={}".format(max_vlmax),
+        "-DFFT_N={}".format(fft_n),
         "-DTWIDDLE_HEADER=\\\"{}.h\\\"".format(twiddles_name),
         "-I$$(dirname $(location :{}))".format(twiddles_name),
     ]
+    if geometry == None:
+        copts.append("-DMAX_VLMAX={}".format(max_vlmax))
     if n_ffts != 1:
         copts.append("-DN_FFTS={}".format(n_ffts))
+    if not fused_bitreverse:
+        copts.append("-DFFT_FUSED_BITREVERSE=0")
+    if radix != 2:
+        copts.append("-DREGIME_BC_RADIX={}".format(radix))
+    if otf_twiddles:
+        copts.append("-DFFT_OTF_TWIDDLES=1")
+    if interleaved:
+        copts.append("-DFFT_INTERLEAVED=1")
+    if pipelined:
+        copts.append("-DFFT_PIPELINED=1")
+    if f32:
+        copts.append("-DFFT_F32=1")
+    if batch:
+        copts.append("-DFFT_BATCH={}".format(batch))
+    if real:
+        copts.append("-DFFT_REAL=1")
+    if mode == "inverse":
+        copts.append("-DFFT_INVERSE=1")
+    if mode == "conv":
+        copts.append("-DFFT_CONV=1")
+    hdrs = [
+        "//python/zamlet/kernel_tests/common:headers",
+        ":" + twiddles_name,
+    ]
+    if batch:
+        hdrs.append("fft_batch_core.h")
     riscv_kernel(
         name = kernel_name,
-        srcs = [
-            "vec-fftN.c",
-            "//python/zamlet/kernel_tests/bitreverse_reorder:compute_indices.c",
-            "//python/zamlet/kernel_tests/bitreverse_reorder:bitreverse.S",
-            "//python/zamlet/kernel_tests/bitreverse_reorder:bitreverse_reorder64.c",
-        ],
-        common_srcs = ["//python/zamlet/kernel_tests/common:ara_runtime"],
-        hdrs = [
-            "//python/zamlet/kernel_tests/common:headers",
-            ":" + twiddles_name,
+        srcs = srcs,
+        common_srcs = [
+            "//python/zamlet/kernel_tests/common:ara_runtime",
+            "//python/zamlet/kernel_tests/common:vinit",
         ],
+        hdrs = hdrs,
         linker_script = "//python/zamlet/kernel_tests/common:test.ld",
         copts = copts,
+        geometry = geometry,
     )
     kernel_test(
         name = test_name,
         kernel = ":" + kernel_name,
         expected_failure = expected_failure,
+        max_cycles = max_cycles,
         timeout = timeout,
         geometries = geometries,
     )
 
 
-def fft_n_target(n, k = 128, max_vlmax = 64, timeout = "moderate", geometries = None):
+def fft_n_target(n, k = 128, max_vlmax = 64, timeout = "moderate", geometries = None,
+                 stockham = False, fused_bitreverse = True, radix = 2,
+                 otf_twiddles = False, interleaved = False, pipelined = False,
+                 mixed = False, max_cycles = 100000, f32 = False):
     _fft_n_kernel_and_test(
         n, k, max_vlmax, suffix = "", gen_flags = "",
-        expected_failure = False, timeout = timeout, geometries = geometries)
+        expected_failure = False, timeout = timeout, geometries = geometries,
+        stockham = stockham, fused_bitreverse = fused_bitreverse, radix = radix,
+        otf_twiddles = otf_twiddles, interleaved = interleaved, pipelined = pipelined,
+        mixed = mixed or not _is_power_of_two(n), max_cycles = max_cycles, f32 = f32)
+
+
+def fft_n_specialized_target(n, k = 128, timeout = "moderate", geometries = None):
+    """fft_n_target built once per geometry with that geometry's header.
+
+    Each kernel sizes its per-stage tables to the exact VLMAX(e64,m1) of its
+    geometry instead of the max_vlmax bound. test_fftN<n>_specialized groups
+    the per-geometry tests.
+    """
+    if geometries == None:
+        geometries = SMALL_GEOMETRY_NAMES
+    for geom in geometries:
+        _fft_n_kernel_and_test(
+            n, k, max_vlmax = None, suffix = "", gen_flags = "",
+            expected_failure = False, timeout = timeout, geometry = geom)
+    native.test_suite(
+        name = "test_fftN{}_specialized".format(n),
+        tests = [":test_fftN{}_{}".format(n, geom) for geom in geometries],
+    )
 
 
 def fft_n_repeat_target(n, repeats, k = 128, max_vlmax = 64, timeout = "long",
-                        geometries = None):
+                        geometries = None, stockham = False, fused_bitreverse = True,
+                        radix = 2, otf_twiddles = False, interleaved = False,
+                        pipelined = False, mixed = False, max_cycles = 100000,
+                        f32 = False):
     """Same FFT kernel as fft_n_target, repeated `repeats` times in main().
 
     Each iteration emits an ITER(i) marker before its bitreverse so per-iter
@@ -73,7 +287,10 @@ def fft_n_repeat_target(n, repeats, k = 128, max_vlmax = 64, timeout = "long",
     _fft_n_kernel_and_test(
         n, k, max_vlmax, suffix = "_repeat{}".format(repeats), gen_flags = "",
         expected_failure = False, timeout = timeout, n_ffts = repeats,
-        geometries = geometries)
+        geometries = geometries, stockham = stockham,
+        fused_bitreverse = fused_bitreverse, radix = radix,
+        otf_twiddles = otf_twiddles, interleaved = interleaved, pipelined = pipelined,
+        mixed = mixed or not _is_power_of_two(n), max_cycles = max_cycles, f32 = f32)
 
 
 def fft_n_corrupt_target(n, k = 128, max_vlmax = 64, timeout = "moderate"):
@@ -86,3 +303,96 @@ def fft_n_corrupt_target(n, k = 128, max_vlmax = 64, timeout = "moderate"):
         n, k, max_vlmax, suffix = "_corrupt",
         gen_flags = "--corrupt-expected",
         expected_failure = True, timeout = timeout)
+
+
+def rfft_n_target(n, k = 128, max_vlmax = 64, timeout = "moderate", geometries = None,
+                  radix = 2):
+    """Real-input FFT of length n: an n/2-point complex FFT on packed samples
+    followed by a vectorized post-processing twiddle pass.
+
+    Checks bins 0..n/2 against the --real expected[] from gen_twiddles.py.
+    """
+    _fft_n_kernel_and_test(
+        n, k, max_vlmax, suffix = "", gen_flags = "",
+        expected_failure = False, timeout = timeout, geometries = geometries,
+        radix = radix, real = True)
+
+
+def ifft_n_target(n, k = 128, max_vlmax = 64, timeout = "moderate", geometries = None,
+                  interleaved = False):
+    """Inverse FFT: conjugated omega tables, 1/N scale fused into the final store."""
+    _fft_n_kernel_and_test(
+        n, k, max_vlmax, suffix = "", gen_flags = "",
+        expected_failure = False, timeout = timeout, geometries = geometries,
+        mode = "inverse", interleaved = interleaved)
+
+
+def fft_conv_target(n, k = 128, max_vlmax = 64, timeout = "long", geometries = None,
+                    repeats = 1):
+    """Circular convolution via fused FFT -> pointwise multiply -> IFFT.
+
+    The pointwise multiply by the filter spectrum happens in registers in the
+    forward pass's final stores; the inverse pass gathers straight from them.
+    """
+    _fft_n_kernel_and_test(
+        n, k, max_vlmax,
+        suffix = "_repeat{}".format(repeats) if repeats != 1 else "",
+        gen_flags = "", expected_failure = False, timeout = timeout,
+        n_ffts = repeats, geometries = geometries, mode = "conv")
+
+
+def fft_n_batch_target(n, batch, k = 128, timeout = "long", geometries = None):
+    """Batch of `batch` size-n FFTs vectorized across transforms.
+
+    Transforms are interleaved (element i of transform b at i*batch + b), so
+    every vector op runs at the full hardware vl whatever n is, and
+    twiddles are scalars shared across all lanes.
+    """
+    _fft_n_kernel_and_test(
+        n, k, max_vlmax = 64, suffix = "", gen_flags = "",
+        expected_failure = False, timeout = timeout, geometries = geometries,
+        batch = batch)
+
+
+def fft_2d_target(rows, cols, k = 128, timeout = "long", geometries = None):
+    """2D FFT of a rows x cols array: batched column FFTs, an indexed-scatter
+    transpose under one writeset, then batched row FFTs.
+
+    Both axes use the fft_batch_core.h passes. The header is generated with
+    --cols for max(rows, cols), and the output is checked in transposed layout.
+    """
+    label = "{}x{}".format(rows, cols)
+    twiddles_name = "twiddles_2d_{}".format(label)
+    kernel_name = "vec-fft2d-{}".format(label)
+    native.genrule(
+        name = twiddles_name,
+        tools = ["gen_twiddles.py"],
+        outs = ["{}.h".format(twiddles_name)],
+        cmd = "python3 $(location gen_twiddles.py) {} --cols {} --k {} > $@".format(
+            rows, cols, k),
+    )
+    riscv_kernel(
+        name = kernel_name,
+        srcs = ["vec-fft2d.c"],
+        common_srcs = ["//python/zamlet/kernel_tests/common:ara_runtime"],
+        hdrs = [
+            "//python/zamlet/kernel_tests/common:headers",
+            "fft_batch_core.h",
+            ":" + twiddles_name,
+        ],
+        linker_script = "//python/zamlet/kernel_tests/common:test.ld",
+        copts = BENCH_COPTS + [
+            "-DPREALLOCATE=1",
+            "-ffast-math",
+            "-DFFT_ROWS={}".format(rows),
+            "-DFFT_COLS={}".format(cols),
+            "-DTWIDDLE_HEADER=\\\"{}.h\\\"".format(twiddles_name),
+            "-I$$(dirname $(location :{}))".format(twiddles_name),
+        ],
+    )
+    kernel_test(
+        name = "test_fft2d_{}".format(label),
+        kernel = ":" + kernel_name,
+        timeout = timeout,
+        geometries = geometries,
+    )
@@ -0,0 +1,285 @@
+/*
+ * Batched radix-2 DIT FFT passes, vectorized across transforms. Shared by
+ * vec-fftN-batch.c and vec-fft2d.c.
+ *
+ * A plan describes t transforms of size n = 2^log2n stored interleaved:
+ * element i of transform b lives at x[i · t + b], so row i is a unit-stride
+ * run of t values. Every vector register holds the same element index for vl
+ * consecutive transforms, and each butterfly becomes a row-vs-row vector op
+ * with a single scalar twiddle shared by all lanes.
+ *
+ * Twiddles come from one scalar table batch_tw[k] = ω_N^k, k ∈ [0, N/2), with
+ * N = TWIDDLE_N from the generated header. Any n ≤ N reads the same table
+ * (see stage_tw), so several transform sizes can share it.
+ *
+ * Stages are grouped 3 per pass (radix-8 over rows, 8 row registers), with a
+ * 1- or 2-stage tail pass. At pass base stage s0 and group G, register k holds
+ * row G + a + k·2^s0 for a ∈ [0, 2^s0). Sub-stage r (stage s = s0 + r) pairs
+ * registers (k, k + 2^r) with twiddle ω_n^(pos · n / 2^(s+1)) where
+ * pos = a + (k mod 2^r) · 2^s0.
+ *
+ * The bit-reverse permutation is a row permutation, so the first pass reads
+ * source row rev(j) directly from the input (unit-stride within the row) and
+ * writes the plan's dst. Later passes run in place on dst.
+ *
+ * Include after TWIDDLE_HEADER and <riscv_vector.h>.
+ */
+#ifndef FFT_BATCH_CORE_H
+#define FFT_BATCH_CORE_H
+
+#include "zamlet_custom.h"
+
+// Trace marker (custom-0 opcode 0x0b, funct3=3). See vec-fftN.c.
+#define FFT_MARK_V(id) zamlet_mark(id)
+
+typedef struct {
+    int             log2n;   // Transform size n = 2^log2n, n ≤ TWIDDLE_N.
+    size_t          t;       // Number of transforms (row length).
+    const uint32_t* rev;     // rev[j]: bit-reversal of j over log2n bits.
+    double*         dst_re;  // n · t output, natural order.
+    double*         dst_im;
+} fft_batch_plan;
+
+static double batch_tw_re[TWIDDLE_N / 2];
+static double batch_tw_im[TWIDDLE_N / 2];
+
+// batch_tw[k + 2^j] = batch_tw[k] · omega[j] for k ∈ [0, 2^j), since
+// omega[j] = ω_N^(2^j).
+static void fft_batch_init_tw(void) {
+    batch_tw_re[0] = 1.0;
+    batch_tw_im[0] = 0.0;
+    for (int j = 0; j < TWIDDLE_LOG2N - 1; j++) {
+        size_t half = (size_t)1 << j;
+        double w_re = omega_re[j];
+        double w_im = omega_im[j];
+        for (size_t k = 0; k < half; k++) {
+            batch_tw_re[k + half] = batch_tw_re[k] * w_re - batch_tw_im[k] * w_im;
+            batch_tw_im[k + half] = batch_tw_re[k] * w_im + batch_tw_im[k] * w_re;
+        }
+    }
+}
+
+// rev[j] for j ∈ [0, 2^log2n).
+static void fft_batch_fill_rev(uint32_t* rev, int log2n) {
+    for (uint32_t j = 0; j < ((uint32_t)1 << log2n); j++) {
+        uint32_t r = 0;
+        for (int b = 0; b < log2n; b++) {
+            r |= ((j >> b) & 1u) << (log2n - 1 - b);
+        }
+        rev[j] = r;
+    }
+}
+
+// Scalar twiddle for stage s at butterfly position pos of any n-point
+// transform, n ≤ TWIDDLE_N: ω_n^(pos · n / 2^(s+1)) = ω_N^(pos · N / 2^(s+1)),
+// so the index does not depend on n.
+static inline void stage_tw(int s, size_t pos, double* w_re, double* w_im) {
+    size_t k = pos << (TWIDDLE_LOG2N - s - 1);
+    *w_re = batch_tw_re[k];
+    *w_im = batch_tw_im[k];
+}
+
+// A' = A + w·B, B' = A − w·B with scalar complex w.
+static inline void bf(vfloat64m1_t* A_re, vfloat64m1_t* A_im,
+                      vfloat64m1_t* B_re, vfloat64m1_t* B_im,
+                      double w_re, double w_im, size_t vl) {
+    vfloat64m1_t t_re = __riscv_vfsub_vv_f64m1(
+        __riscv_vfmul_vf_f64m1(*B_re, w_re, vl),
+        __riscv_vfmul_vf_f64m1(*B_im, w_im, vl), vl);
+    vfloat64m1_t t_im = __riscv_vfadd_vv_f64m1(
+        __riscv_vfmul_vf_f64m1(*B_re, w_im, vl),
+        __riscv_vfmul_vf_f64m1(*B_im, w_re, vl), vl);
+    vfloat64m1_t a_re = *A_re, a_im = *A_im;
+    *A_re = __riscv_vfadd_vv_f64m1(a_re, t_re, vl);
+    *A_im = __riscv_vfadd_vv_f64m1(a_im, t_im, vl);
+    *B_re = __riscv_vfsub_vv_f64m1(a_re, t_re, vl);
+    *B_im = __riscv_vfsub_vv_f64m1(a_im, t_im, vl);
+}
+
+// Source row offset for destination row j. The first pass (rev != NULL)
+// reads the bit-reversed row of the input.
+static inline size_t src_row(size_t j, const uint32_t* rev, size_t t) {
+    return (rev ? (size_t)rev[j] : j) * t;
+}
+
+// One-stage pass (tail only). Registers: rows G + a, G + a + 2^s0.
+static void batch_pass_R2(const fft_batch_plan* p, const double* src_re,
+                          const double* src_im, const uint32_t* rev, int s0) {
+    size_t n = (size_t)1 << p->log2n, t = p->t;
+    size_t d = (size_t)1 << s0;
+    double* dst_re = p->dst_re;
+    double* dst_im = p->dst_im;
+    for (size_t G = 0; G < n; G += 2 * d) {
+        for (size_t a = 0; a < d; a++) {
+            size_t j0 = G + a, j1 = j0 + d;
+            size_t s_0 = src_row(j0, rev, t), s_1 = src_row(j1, rev, t);
+            double w0_re, w0_im;
+            stage_tw(s0, a, &w0_re, &w0_im);
+            for (size_t col = 0; col < t; ) {
+                size_t vl = __riscv_vsetvl_e64m1(t - col);
+                vfloat64m1_t V0_re = __riscv_vle64_v_f64m1(&src_re[s_0 + col], vl);
+                vfloat64m1_t V0_im = __riscv_vle64_v_f64m1(&src_im[s_0 + col], vl);
+                vfloat64m1_t V1_re = __riscv_vle64_v_f64m1(&src_re[s_1 + col], vl);
+                vfloat64m1_t V1_im = __riscv_vle64_v_f64m1(&src_im[s_1 + col], vl);
+                bf(&V0_re, &V0_im, &V1_re, &V1_im, w0_re, w0_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[j0 * t + col], V0_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[j0 * t + col], V0_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[j1 * t + col], V1_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[j1 * t + col], V1_im, vl);
+                col += vl;
+            }
+        }
+    }
+}
+
+// Two-stage pass (tail only). Registers: rows G + a + k·2^s0, k ∈ [0, 4).
+static void batch_pass_R4(const fft_batch_plan* p, const double* src_re,
+                          const double* src_im, const uint32_t* rev, int s0) {
+    size_t n = (size_t)1 << p->log2n, t = p->t;
+    size_t d = (size_t)1 << s0;
+    double* dst_re = p->dst_re;
+    double* dst_im = p->dst_im;
+    for (size_t G = 0; G < n; G += 4 * d) {
+        for (size_t a = 0; a < d; a++) {
+            size_t j0 = G + a, j1 = j0 + d, j2 = j0 + 2 * d, j3 = j0 + 3 * d;
+            size_t s_0 = src_row(j0, rev, t), s_1 = src_row(j1, rev, t);
+            size_t s_2 = src_row(j2, rev, t), s_3 = src_row(j3, rev, t);
+            double r0_re, r0_im, r1a_re, r1a_im, r1b_re, r1b_im;
+            stage_tw(s0, a, &r0_re, &r0_im);
+            stage_tw(s0 + 1, a, &r1a_re, &r1a_im);
+            stage_tw(s0 + 1, a + d, &r1b_re, &r1b_im);
+            for (size_t col = 0; col < t; ) {
+                size_t vl = __riscv_vsetvl_e64m1(t - col);
+                vfloat64m1_t V0_re = __riscv_vle64_v_f64m1(&src_re[s_0 + col], vl);
+                vfloat64m1_t V0_im = __riscv_vle64_v_f64m1(&src_im[s_0 + col], vl);
+                vfloat64m1_t V1_re = __riscv_vle64_v_f64m1(&src_re[s_1 + col], vl);
+                vfloat64m1_t V1_im = __riscv_vle64_v_f64m1(&src_im[s_1 + col], vl);
+                vfloat64m1_t V2_re = __riscv_vle64_v_f64m1(&src_re[s_2 + col], vl);
+                vfloat64m1_t V2_im = __riscv_vle64_v_f64m1(&src_im[s_2 + col], vl);
+                vfloat64m1_t V3_re = __riscv_vle64_v_f64m1(&src_re[s_3 + col], vl);
+                vfloat64m1_t V3_im = __riscv_vle64_v_f64m1(&src_im[s_3 + col], vl);
+
+                // r=0: (0,1), (2,3) at pos a.
+                bf(&V0_re, &V0_im, &V1_re, &V1_im, r0_re, r0_im, vl);
+                bf(&V2_re, &V2_im, &V3_re, &V3_im, r0_re, r0_im, vl);
+                // r=1: (0,2) at pos a, (1,3) at pos a + d.
+                bf(&V0_re, &V0_im, &V2_re, &V2_im, r1a_re, r1a_im, vl);
+                bf(&V1_re, &V1_im, &V3_re, &V3_im, r1b_re, r1b_im, vl);
+
+                __riscv_vse64_v_f64m1(&dst_re[j0 * t + col], V0_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[j0 * t + col], V0_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[j1 * t + col], V1_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[j1 * t + col], V1_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[j2 * t + col], V2_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[j2 * t + col], V2_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[j3 * t + col], V3_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[j3 * t + col], V3_im, vl);
+                col += vl;
+            }
+        }
+    }
+}
+
+// Three-stage pass. Registers: rows G + a + k·2^s0, k ∈ [0, 8).
+static void batch_pass_R8(const fft_batch_plan* p, const double* src_re,
+                          const double* src_im, const uint32_t* rev, int s0) {
+    size_t n = (size_t)1 << p->log2n, t = p->t;
+    size_t d = (size_t)1 << s0;
+    double* dst_re = p->dst_re;
+    double* dst_im = p->dst_im;
+    for (size_t G = 0; G < n; G += 8 * d) {
+        for (size_t a = 0; a < d; a++) {
+            size_t j0 = G + a;
+            size_t s_0 = src_row(j0 + 0 * d, rev, t), s_1 = src_row(j0 + 1 * d, rev, t);
+            size_t s_2 = src_row(j0 + 2 * d, rev, t), s_3 = src_row(j0 + 3 * d, rev, t);
+            size_t s_4 = src_row(j0 + 4 * d, rev, t), s_5 = src_row(j0 + 5 * d, rev, t);
+            size_t s_6 = src_row(j0 + 6 * d, rev, t), s_7 = src_row(j0 + 7 * d, rev, t);
+            double r0_re, r0_im;
+            double r1a_re, r1a_im, r1b_re, r1b_im;
+            double r2a_re, r2a_im, r2b_re, r2b_im, r2c_re, r2c_im, r2d_re, r2d_im;
+            stage_tw(s0, a, &r0_re, &r0_im);
+            stage_tw(s0 + 1, a + 0 * d, &r1a_re, &r1a_im);
+            stage_tw(s0 + 1, a + 1 * d, &r1b_re, &r1b_im);
+            stage_tw(s0 + 2, a + 0 * d, &r2a_re, &r2a_im);
+            stage_tw(s0 + 2, a + 1 * d, &r2b_re, &r2b_im);
+            stage_tw(s0 + 2, a + 2 * d, &r2c_re, &r2c_im);
+            stage_tw(s0 + 2, a + 3 * d, &r2d_re, &r2d_im);
+            for (size_t col = 0; col < t; ) {
+                size_t vl = __riscv_vsetvl_e64m1(t - col);
+                vfloat64m1_t V0_re = __riscv_vle64_v_f64m1(&src_re[s_0 + col], vl);
+                vfloat64m1_t V0_im = __riscv_vle64_v_f64m1(&src_im[s_0 + col], vl);
+                vfloat64m1_t V1_re = __riscv_vle64_v_f64m1(&src_re[s_1 + col], vl);
+                vfloat64m1_t V1_im = __riscv_vle64_v_f64m1(&src_im[s_1 + col], vl);
+                vfloat64m1_t V2_re = __riscv_vle64_v_f64m1(&src_re[s_2 + col], vl);
+                vfloat64m1_t V2_im = __riscv_vle64_v_f64m1(&src_im[s_2 + col], vl);
+                vfloat64m1_t V3_re = __riscv_vle64_v_f64m1(&src_re[s_3 + col], vl);
+                vfloat64m1_t V3_im = __riscv_vle64_v_f64m1(&src_im[s_3 + col], vl);
+                vfloat64m1_t V4_re = __riscv_vle64_v_f64m1(&src_re[s_4 + col], vl);
+                vfloat64m1_t V4_im = __riscv_vle64_v_f64m1(&src_im[s_4 + col], vl);
+                vfloat64m1_t V5_re = __riscv_vle64_v_f64m1(&src_re[s_5 + col], vl);
+                vfloat64m1_t V5_im = __riscv_vle64_v_f64m1(&src_im[s_5 + col], vl);
+                vfloat64m1_t V6_re = __riscv_vle64_v_f64m1(&src_re[s_6 + col], vl);
+                vfloat64m1_t V6_im = __riscv_vle64_v_f64m1(&src_im[s_6 + col], vl);
+                vfloat64m1_t V7_re = __riscv_vle64_v_f64m1(&src_re[s_7 + col], vl);
+                vfloat64m1_t V7_im = __riscv_vle64_v_f64m1(&src_im[s_7 + col], vl);
+
+                // r=0: (0,1), (2,3), (4,5), (6,7) at pos a.
+                bf(&V0_re, &V0_im, &V1_re, &V1_im, r0_re, r0_im, vl);
+                bf(&V2_re, &V2_im, &V3_re, &V3_im, r0_re, r0_im, vl);
+                bf(&V4_re, &V4_im, &V5_re, &V5_im, r0_re, r0_im, vl);
+                bf(&V6_re, &V6_im, &V7_re, &V7_im, r0_re, r0_im, vl);
+                // r=1: (0,2), (4,6) at pos a; (1,3), (5,7) at pos a + d.
+                bf(&V0_re, &V0_im, &V2_re, &V2_im, r1a_re, r1a_im, vl);
+                bf(&V1_re, &V1_im, &V3_re, &V3_im, r1b_re, r1b_im, vl);
+                bf(&V4_re, &V4_im, &V6_re, &V6_im, r1a_re, r1a_im, vl);
+                bf(&V5_re, &V5_im, &V7_re, &V7_im, r1b_re, r1b_im, vl);
+                // r=2: (0,4), (1,5), (2,6), (3,7) at pos a + {0,1,2,3}·d.
+                bf(&V0_re, &V0_im, &V4_re, &V4_im, r2a_re, r2a_im, vl);
+                bf(&V1_re, &V1_im, &V5_re, &V5_im, r2b_re, r2b_im, vl);
+                bf(&V2_re, &V2_im, &V6_re, &V6_im, r2c_re, r2c_im, vl);
+                bf(&V3_re, &V3_im, &V7_re, &V7_im, r2d_re, r2d_im, vl);
+
+                __riscv_vse64_v_f64m1(&dst_re[(j0 + 0 * d) * t + col], V0_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[(j0 + 0 * d) * t + col], V0_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[(j0 + 1 * d) * t + col], V1_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[(j0 + 1 * d) * t + col], V1_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[(j0 + 2 * d) * t + col], V2_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[(j0 + 2 * d) * t + col], V2_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[(j0 + 3 * d) * t + col], V3_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[(j0 + 3 * d) * t + col], V3_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[(j0 + 4 * d) * t + col], V4_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[(j0 + 4 * d) * t + col], V4_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[(j0 + 5 * d) * t + col], V5_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[(j0 + 5 * d) * t + col], V5_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[(j0 + 6 * d) * t + col], V6_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[(j0 + 6 * d) * t + col], V6_im, vl);
+                __riscv_vse64_v_f64m1(&dst_re[(j0 + 7 * d) * t + col], V7_re, vl);
+                __riscv_vse64_v_f64m1(&dst_im[(j0 + 7 * d) * t + col], V7_im, vl);
+                col += vl;
+            }
+        }
+    }
+}
+
+// Run every pass of plan p. src holds the natural-order input; the first
+// pass marker is mark_base, later passes count up from it.
+static void fft_batch_run(const fft_batch_plan* p, const double* src_re,
+                          const double* src_im, int mark_base) {
+    int pass = 0;
+    for (int s0 = 0; s0 < p->log2n; s0 += 3, pass++) {
+        FFT_MARK_V(mark_base + pass);
+        int n_sub = p->log2n - s0;
+        if (n_sub > 3) n_sub = 3;
+        const double* s_re = (s0 == 0) ? src_re : p->dst_re;
+        const double* s_im = (s0 == 0) ? src_im : p->dst_im;
+        const uint32_t* rev = (s0 == 0) ? p->rev : NULL;
+        switch (n_sub) {
+            case 1: batch_pass_R2(p, s_re, s_im, rev, s0); break;
+            case 2: batch_pass_R4(p, s_re, s_im, rev, s0); break;
+            case 3: batch_pass_R8(p, s_re, s_im, rev, s0); break;
+            default: __builtin_unreachable();
+        }
+    }
+}
+
+#endif /* FFT_BATCH_CORE_H */
@@ -22,6 +22,41 @@ the kernel's `build_seed` primitive to load twiddle seeds via unit-stride vle64.
 
 expected_{re,im} are the DFT of the test input {0, 1, ..., N-1} + 0j, placed in
 VPU memory so on-device correctness checks can run via vector ops.
+
+With --real, N is the real input length and the header targets the N/2-point
+complex FFT that the real-input kernel packs it into:
+    #define TWIDDLE_N       N/2
+    #define TWIDDLE_REAL_N  N
+    static double rfft_tw_re[N/2], rfft_tw_im[N/2];   // ω_N^k, VPU memory
+    static double expected_re[N/2 + 1], expected_im[N/2 + 1];
+expected holds bins 0..N/2 of the DFT of the real input {0, 1, ..., N-1}; the
+remaining bins are their conjugates.
+
+With --inverse, omega and seed_block are conjugated (ω_N = exp(+2πi/N)), so the
+same kernel computes the unscaled inverse DFT; expected holds the scaled
+inverse DFT (1/N)·Σ x[j]·exp(+2πi·jk/N) of the test input.
+
+With --conv, the forward tables are unchanged and the header adds
+    #define TWIDDLE_CONV 1
+    static double conv_h_re[N], conv_h_im[N];   // DFT of the filter h, VPU memory
+where h[j] = j + 1 for j < 4 and 0 otherwise. expected holds the circular
+convolution of the test input {0, 1, ..., N-1} with h.
+
+With --cols C, N is the row count of an N x C 2D transform. The omega and
+seed_block tables are built for max(N, C), which serves both transform sizes,
+and the header adds
+    #define TWIDDLE_ROWS N
+    #define TWIDDLE_COLS C
+expected then holds the 2D DFT of the input x[r][c] = r·C + c in transposed
+layout: expected[kc·N + kr] = X[kr][kc].
+
+With --br-vl V, the header also carries the bit-reverse index tables that
+vec-fftN.c otherwise builds at startup, as 64-bit byte offsets in VPU memory:
+    #define TWIDDLE_BR_VL V
+    uint64_t br_read_idx[N], br_write_idx[N];   // compute_indices at e32 vl = V
+    uint64_t br_gather_idx[N];                  // bitrev(j)·8, vl-independent
+V is the e32 vl the kernel passes to compute_indices (min(N, VLMAX at e32));
+the kernel rebuilds read/write at runtime when the hardware vl differs.
 """
 import argparse
 import cmath
@@ -36,14 +71,50 @@ parser.add_argument("--corrupt-expected", action="store_true",
                     help="Emit a deliberately wrong `expected` array so a "
                     "passing FFT is reported as FAIL. Used by the sanity "
                     "negative test that guards against vacuous passes.")
+parser.add_argument("--real", action="store_true",
+                    help="N is a real input length: emit tables for the N/2-point "
+                    "complex FFT plus the real-to-complex post-processing "
+                    "twiddles and the half-spectrum expected output.")
+parser.add_argument("--inverse", action="store_true",
+                    help="Emit conjugated omega/seed_block tables and the scaled "
+                    "inverse DFT of the test input as expected.")
+parser.add_argument("--conv", action="store_true",
+                    help="Emit conv_h (DFT of a short filter) and the circular "
+                    "convolution of the test input with that filter as expected.")
+parser.add_argument("--cols", type=int, default=0,
+                    help="N is the row count of an N x COLS 2D transform: emit "
+                    "tables for max(N, COLS) and the transposed 2D DFT of the "
+                    "test input as expected.")
+parser.add_argument("--br-vl", type=int, default=0,
+                    help="Emit prebuilt bit-reverse read/write/gather index tables "
+                    "for this e32 vl (0 disables).")
+parser.add_argument("--f32", action="store_true",
+                    help="Emit float tables in .data.vpu32 and e32 gather offsets "
+                    "for the single-precision kernel build (FFT_F32).")
+parser.add_argument("--plan", default="",
+                    help="Comma-separated stage radices (each 2, 3, 4 or 5) whose "
+                    "product is N: emit the mixed-radix kernel's plan, twiddle "
+                    "table and expected output instead.")
 args = parser.parse_args()
+assert (args.real + args.inverse + args.conv + (args.cols > 0)) <= 1, \
+    "--real, --inverse, --conv and --cols are mutually exclusive"
+assert args.cols == 0 or (args.cols & (args.cols - 1)) == 0, "COLS must be a power of 2"
 
-N = args.N
-assert N > 0 and (N & (N - 1)) == 0, "N must be a power of 2"
+assert args.plan or (args.N > 0 and (args.N & (args.N - 1)) == 0), "N must be a power of 2"
+real_n = args.N if args.real else None
+N = args.N // 2 if args.real else args.N
+rows = args.N if args.cols else None
+if args.cols:
+    N = max(args.N, args.cols)
+assert N >= 2, "real-input N must be at least 4"
 
 log2_n = N.bit_length() - 1
 seed_block_k = min(args.k, N)
 out = sys.stdout
+assert not (args.f32 and rows is not None), "--f32 targets the 1D vec-fftN.c kernel"
+real_t = "float" if args.f32 else "double"
+vpu_attr = ' __attribute__((section(".data.vpu32")))' if args.f32 else \
+    ' __attribute__((section(".data.vpu64")))'
 
 
 def emit_array(decl, values):
@@ -63,19 +134,123 @@ def emit_2d_array(decl, rows):
     out.write("};\n\n")
 
 
+def clog2(value):
+    n = 0
+    value = value - 1
+    while value > 0:
+        n += 1
+        value = value >> 1
+    return n
+
+
+def bitreverse(value, n_bits):
+    r = 0
+    for b in range(n_bits):
+        if value & (1 << b):
+            r |= 1 << (n_bits - 1 - b)
+    return r
+
+
+def compute_read_indices(n, vl, reverse_bits):
+    """Port of compute_indices() in bitreverse_reorder/compute_indices.c: the
+    element read order for each vl-length block. write = bitrev(read)."""
+    vl = min(vl, n)
+    stride = n // vl
+    n_cycles = n // vl
+    vid = list(range(vl))
+    read = []
+    if (1 << reverse_bits) <= vl:
+        read = list(range(n_cycles * vl))
+    elif n >= vl * vl:
+        middle_size = stride // vl
+        stride_mask = stride - 1
+        for cycle in range(n_cycles):
+            offset = cycle * vl + cycle // middle_size
+            read += [i * stride + ((i + offset) & stride_mask) for i in vid]
+    else:
+        log2_section_size = 2 * clog2(vl) - clog2(n)
+        section_mask = (1 << log2_section_size) - 1
+        vl_mask = vl - 1
+        base = [(i >> log2_section_size) * vl for i in vid]
+        v9 = [(i & section_mask) * stride + (i >> log2_section_size) for i in vid]
+        for cycle in range(n_cycles):
+            read += [b + ((v + cycle) & vl_mask) for b, v in zip(base, v9)]
+    assert sorted(read) == list(range(n)), "compute_indices port is not a permutation"
+    return read
+
+
+def emit_u64_array(decl, values):
+    out.write(decl + " = {\n")
+    for v in values:
+        out.write(f"    {v}ULL,\n")
+    out.write("};\n\n")
+
+
+
+def exact_dft(v, k):
+    """Bin k of the DFT of v, with the angle reduced mod n and an fsum per part,
+    so the reference stays accurate for the non-power-of-two sizes."""
+    n = len(v)
+    terms = [v[j] * cmath.exp(-2j * math.pi * ((j * k) % n) / n) for j in range(n)]
+    return complex(math.fsum(t.real for t in terms), math.fsum(t.imag for t in terms))
+
+
+if args.plan:
+    plan = [int(r) for r in args.plan.split(",")]
+    assert all(r in (2, 3, 4, 5) for r in plan), "--plan radices must be 2, 3, 4 or 5"
+    assert math.prod(plan) == args.N, f"--plan {args.plan} does not multiply to {args.N}"
+    assert not (args.real or args.inverse or args.conv or args.cols or args.br_vl or
+                args.f32), \
+        "--plan does not combine with --real, --inverse, --conv, --cols, --br-vl or --f32"
+    N = args.N
+    out.write("/* Auto-generated by gen_twiddles.py. Do not edit. */\n")
+    out.write("#ifndef TWIDDLES_H\n#define TWIDDLES_H\n\n")
+    out.write(f"#define TWIDDLE_N {N}\n")
+    out.write(f"#define TWIDDLE_N_STAGES {len(plan)}\n\n")
+    out.write(f"static const int fft_plan[{len(plan)}] = {{"
+              + ", ".join(str(r) for r in plan) + "};\n\n")
+    tw = [cmath.exp(-2j * math.pi * k / N) for k in range(N)]
+    emit_array(f"static const double tw_s_re[{N}]", [w.real for w in tw])
+    emit_array(f"static const double tw_s_im[{N}]", [w.imag for w in tw])
+    input_vals = [complex(float(i), 0.0) for i in range(N)]
+    expected = [exact_dft(input_vals, k) for k in range(N)]
+    if args.corrupt_expected:
+        expected[0] = expected[0] + complex(1.0, 0.0)
+    emit_array(f'static double expected_re[{N}] __attribute__((section(".data.vpu64")))',
+               [v.real for v in expected])
+    emit_array(f'static double expected_im[{N}] __attribute__((section(".data.vpu64")))',
+               [v.imag for v in expected])
+    out.write("#endif\n")
+    sys.exit(0)
+
+
 out.write("/* Auto-generated by gen_twiddles.py. Do not edit. */\n")
 out.write("#ifndef TWIDDLES_H\n#define TWIDDLES_H\n\n")
 out.write(f"#define TWIDDLE_N {N}\n")
 out.write(f"#define TWIDDLE_LOG2N {log2_n}\n")
-out.write(f"#define SEED_BLOCK_K {seed_block_k}\n\n")
+out.write(f"#define SEED_BLOCK_K {seed_block_k}\n")
+if real_n is not None:
+    out.write(f"#define TWIDDLE_REAL_N {real_n}\n")
+if args.inverse:
+    out.write("#define TWIDDLE_INVERSE 1\n")
+if args.conv:
+    out.write("#define TWIDDLE_CONV 1\n")
+if rows is not None:
+    out.write(f"#define TWIDDLE_ROWS {rows}\n")
+    out.write(f"#define TWIDDLE_COLS {args.cols}\n")
+if args.f32:
+    out.write("#define TWIDDLE_F32 1\n")
+out.write("\n")
 
 # omega[i] = ω_N^(2^i) = exp(-2πi · 2^i / N) for i = 0..log2(N)-1.
 # Successive squarings of ω_N; a few dozen doubles regardless of N. The FFT
 # init code builds per-stage seed vectors from these by iterative
 # multiplication.
-omegas = [cmath.exp(-2j * math.pi * (1 << i) / N) for i in range(log2_n)]
-emit_array(f"static const double omega_re[{log2_n}]", [w.real for w in omegas])
-emit_array(f"static const double omega_im[{log2_n}]", [w.imag for w in omegas])
+# --inverse flips the sign of the exponent.
+sign = 1 if args.inverse else -1
+omegas = [cmath.exp(sign * 2j * math.pi * (1 << i) / N) for i in range(log2_n)]
+emit_array(f"static const {real_t} omega_re[{log2_n}]", [w.real for w in omegas])
+emit_array(f"static const {real_t} omega_im[{log2_n}]", [w.imag for w in omegas])
 
 # seed_block[j][k] = omega[j]^k for j in [0, log2N), k in [0, SEED_BLOCK_K).
 # Used by build_seed(): unit-stride vle64 of one row fills a length-SEED_BLOCK_K
@@ -89,29 +264,94 @@ for j in range(log2_n):
     seed_rows_im.append([v.imag for v in row])
 
 emit_2d_array(
-    f'static double seed_block_re[{log2_n}][{seed_block_k}]'
-    ' __attribute__((section(".data.vpu64")))',
+    f'static {real_t} seed_block_re[{log2_n}][{seed_block_k}]' + vpu_attr,
     seed_rows_re)
 emit_2d_array(
-    f'static double seed_block_im[{log2_n}][{seed_block_k}]'
-    ' __attribute__((section(".data.vpu64")))',
+    f'static {real_t} seed_block_im[{log2_n}][{seed_block_k}]' + vpu_attr,
     seed_rows_im)
 
 # Expected DFT output for input {0, 1, ..., N-1} + 0j. Direct O(N²) — fine for
 # N up to a few thousand; for larger N replace with a numpy.fft.fft call.
-input_vals = [complex(float(i), 0.0) for i in range(N)]
-expected = [sum(input_vals[j] * cmath.exp(-2j * math.pi * k * j / N)
-                for j in range(N))
-            for k in range(N)]
+# For --real the input is {0, 1, ..., real_n-1} and only bins 0..N are kept.
+if args.inverse:
+    input_vals = [complex(float(i), 0.0) for i in range(N)]
+    expected = [sum(input_vals[j] * cmath.exp(2j * math.pi * k * j / N)
+                    for j in range(N)) / N
+                for k in range(N)]
+elif args.conv:
+    input_vals = [float(i) for i in range(N)]
+    h = [float(j + 1) if j < 4 else 0.0 for j in range(N)]
+    expected = [complex(sum(input_vals[j] * h[(k - j) % N] for j in range(N)), 0.0)
+                for k in range(N)]
+
+    conv_h = [sum(h[j] * cmath.exp(-2j * math.pi * k * j / N) for j in range(N))
+              for k in range(N)]
+    emit_array(f'static {real_t} conv_h_re[{N}]' + vpu_attr,
+               [v.real for v in conv_h])
+    emit_array(f'static {real_t} conv_h_im[{N}]' + vpu_attr,
+               [v.imag for v in conv_h])
+elif rows is not None:
+    # Separable: DFT along each row, then along each column. O(R·C·(R + C)).
+    cols = args.cols
+
+    def dft(v):
+        n = len(v)
+        return [sum(v[j] * cmath.exp(-2j * math.pi * k * j / n) for j in range(n))
+                for k in range(n)]
+
+    row_dft = [dft([complex(float(r * cols + c), 0.0) for c in range(cols)])
+               for r in range(rows)]
+    col_dft = [dft([row_dft[r][kc] for r in range(rows)]) for kc in range(cols)]
+    expected = [col_dft[kc][kr] for kc in range(cols) for kr in range(rows)]
+elif real_n is None:
+    input_vals = [complex(float(i), 0.0) for i in range(N)]
+    expected = [sum(input_vals[j] * cmath.exp(-2j * math.pi * k * j / N)
+                    for j in range(N))
+                for k in range(N)]
+else:
+    input_vals = [float(i) for i in range(real_n)]
+    expected = [sum(input_vals[j] * cmath.exp(-2j * math.pi * k * j / real_n)
+                    for j in range(real_n))
+                for k in range(N + 1)]
+
+    # Post-processing twiddles ω_{real_n}^k for k in [0, N), read with
+    # unit-stride vle64 alongside Z[k].
+    rfft_tw = [cmath.exp(-2j * math.pi * k / real_n) for k in range(N)]
+    emit_array(f'static {real_t} rfft_tw_re[{N}]' + vpu_attr,
+               [w.real for w in rfft_tw])
+    emit_array(f'static {real_t} rfft_tw_im[{N}]' + vpu_attr,
+               [w.imag for w in rfft_tw])
+
+
+if args.br_vl:
+    assert rows is None, "--br-vl targets the 1D vec-fftN.c kernel"
+    br_read = compute_read_indices(N, args.br_vl, log2_n)
+    br_write = [bitreverse(r, log2_n) for r in br_read]
+    out.write(f"#define TWIDDLE_BR_VL {min(args.br_vl, N)}\n\n")
+    if args.f32:
+        # The f32 kernel only gathers, and takes e32 offsets without widening.
+        emit_u64_array('uint32_t br_gather_idx[%d] __attribute__((section(".data.vpu32")))'
+                       % N, [4 * bitreverse(j, log2_n) for j in range(N)])
+    else:
+        emit_u64_array('uint64_t br_read_idx[%d] __attribute__((section(".data.vpu64")))'
+                       % N, [8 * r for r in br_read])
+        emit_u64_array('uint64_t br_write_idx[%d] __attribute__((section(".data.vpu64")))'
+                       % N, [8 * w for w in br_write])
+        emit_u64_array('uint64_t br_gather_idx[%d] __attribute__((section(".data.vpu64")))'
+                       % N, [8 * bitreverse(j, log2_n) for j in range(N)])
 
 if args.corrupt_expected:
     # Flip element 0's real part so the on-device check must report FAIL.
     # Scale is well above the kernel's TOL (1e-3 today).
     expected[0] = expected[0] + complex(1.0, 0.0)
 
-emit_array(f'static double expected_re[{N}] __attribute__((section(".data.vpu64")))',
+emit_array(f'static {real_t} expected_re[{len(expected)}]' + vpu_attr,
            [v.real for v in expected])
-emit_array(f'static double expected_im[{N}] __attribute__((section(".data.vpu64")))',
+emit_array(f'static {real_t} expected_im[{len(expected)}]' + vpu_attr,
            [v.imag for v in expected])
+if args.f32:
+    # The f32 check tolerance scales with the largest expected component.
+    peak = max(max(abs(v.real), abs(v.imag)) for v in expected)
+    out.write(f"#define TWIDDLE_EXPECTED_PEAK {peak!r}\n\n")
 
 out.write("#endif\n")
@@ -0,0 +1,161 @@
+/*
+ * 2D FFT of a FFT_ROWS x FFT_COLS row-major complex array (both powers of 2).
+ *
+ * Both axes run as batches through fft_batch_core.h, so every vector op is
+ * a row-vs-row butterfly at the full hardware vl with scalar twiddles:
+ *   1. Column transforms. In row-major layout element r of column c sits at
+ *      x[r · COLS + c], which is already the interleaved batch layout
+ *      (n = ROWS, t = COLS). in → data.
+ *   2. Transpose. data[R][C] → tmp[C][R] by indexed scatter: each unit-stride
+ *      vle64 of a row segment is scattered with byte offsets vid · ROWS · 8.
+ *      The transpose is a permutation, so the whole sweep runs inside one
+ *      writeset under an index bound covering the array.
+ *   3. Row transforms. tmp now holds the original rows interleaved
+ *      (n = COLS, t = ROWS). tmp → data.
+ * The result is left transposed: data[kc · ROWS + kr] = X[kr][kc].
+ *
+ * The twiddles header (gen_twiddles.py ROWS --cols COLS) is built for
+ * max(ROWS, COLS); fft_batch_core.h's stage_tw reads the same table for
+ * either transform length.
+ *
+ * Test input: x[r][c] = r · COLS + c.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "zamlet_custom.h"
+#include TWIDDLE_HEADER
+#include "fft_batch_core.h"
+
+#if !defined(FFT_ROWS) || !defined(FFT_COLS)
+#error "FFT_ROWS and FFT_COLS must be defined on the command line"
+#endif
+#if !defined(TWIDDLE_ROWS) || FFT_ROWS != TWIDDLE_ROWS || FFT_COLS != TWIDDLE_COLS
+#error "FFT_ROWS/FFT_COLS must match a twiddles header generated with --cols"
+#endif
+
+#define ROWS      FFT_ROWS
+#define COLS      FFT_COLS
+#define TOL       1e-6
+
+// Phase markers. Each pass of a batch run is its base + pass index.
+#define FFT_MARK_2D_COL_PASS_START(p)  (700 + (p))
+#define FFT_MARK_2D_TRANSPOSE_START    750
+#define FFT_MARK_2D_ROW_PASS_START(p)  (800 + (p))
+#define FFT_MARK_ITER_START_BASE       900
+
+double in_re[ROWS * COLS]   __attribute__((section(".data.vpu64")));
+double in_im[ROWS * COLS]   __attribute__((section(".data.vpu64")));
+double data_re[ROWS * COLS] __attribute__((section(".data.vpu64")));
+double data_im[ROWS * COLS] __attribute__((section(".data.vpu64")));
+double tmp_re[ROWS * COLS]  __attribute__((section(".data.vpu64")));
+double tmp_im[ROWS * COLS]  __attribute__((section(".data.vpu64")));
+
+static uint32_t rev_rows[ROWS];
+static uint32_t rev_cols[COLS];
+
+static size_t vl_max;
+static int    log2_rows;
+static int    log2_cols;
+
+// expected_re / expected_im are declared in TWIDDLE_HEADER (VPU memory).
+
+static int ilog2(size_t v) {
+    int l = 0;
+    while (v > 1) {
+        v >>= 1;
+        l++;
+    }
+    return l;
+}
+
+static void init_tables(void) {
+    vl_max = __riscv_vsetvl_e64m1((size_t)1 << 30);
+    log2_rows = ilog2(ROWS);
+    log2_cols = ilog2(COLS);
+    fft_batch_init_tw();
+    fft_batch_fill_rev(rev_rows, log2_rows);
+    fft_batch_fill_rev(rev_cols, log2_cols);
+}
+
+// Smallest index bound covering byte offsets [0, ROWS·COLS·8).
+static inline unsigned transpose_index_bound_bits(void) {
+    return zamlet_index_bound_bits(ROWS * COLS * sizeof(double));
+}
+
+// dst[c · ROWS + r] = src[r · COLS + c] for both planes.
+static void transpose(const double* src_re, const double* src_im,
+                      double* dst_re, double* dst_im) {
+    size_t vl = __riscv_vsetvl_e64m1(COLS);
+    vuint64m1_t offs = __riscv_vmul_vx_u64m1(
+        __riscv_vid_v_u64m1(vl), (uint64_t)ROWS * sizeof(double), vl);
+
+    zamlet_set_index_bound(transpose_index_bound_bits());
+    zamlet_begin_writeset();
+    for (size_t r = 0; r < (size_t)ROWS; r++) {
+        for (size_t c = 0; c < (size_t)COLS; ) {
+            vl = __riscv_vsetvl_e64m1((size_t)COLS - c);
+            vfloat64m1_t V_re = __riscv_vle64_v_f64m1(&src_re[r * COLS + c], vl);
+            vfloat64m1_t V_im = __riscv_vle64_v_f64m1(&src_im[r * COLS + c], vl);
+            __riscv_vsuxei64_v_f64m1(&dst_re[c * ROWS + r], offs, V_re, vl);
+            __riscv_vsuxei64_v_f64m1(&dst_im[c * ROWS + r], offs, V_im, vl);
+            c += vl;
+        }
+    }
+    zamlet_end_writeset();
+    zamlet_set_index_bound(0);
+}
+
+static void run_fft2d(void) {
+    const fft_batch_plan col_plan = {log2_rows, COLS, rev_rows, data_re, data_im};
+    const fft_batch_plan row_plan = {log2_cols, ROWS, rev_cols, data_re, data_im};
+
+    fft_batch_run(&col_plan, in_re, in_im, FFT_MARK_2D_COL_PASS_START(0));
+    FFT_MARK_V(FFT_MARK_2D_TRANSPOSE_START);
+    transpose(data_re, data_im, tmp_re, tmp_im);
+    fft_batch_run(&row_plan, tmp_re, tmp_im, FFT_MARK_2D_ROW_PASS_START(0));
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    for (size_t i = 0; i < (size_t)(ROWS * COLS); i++) {
+        in_re[i] = (double)i;
+        in_im[i] = 0.0;
+    }
+
+    init_tables();
+
+    printf("Running 2D FFT-%dx%d (vlmax=%zu)\n", ROWS, COLS, vl_max);
+
+    unsigned long cycles1, cycles2;
+    cycles1 = read_csr(mcycle);
+
+    FFT_MARK_V(FFT_MARK_ITER_START_BASE);
+    run_fft2d();
+
+    asm volatile("fence");
+    cycles2 = read_csr(mcycle);
+
+    printf("Cycles: %lu\n", cycles2 - cycles1);
+
+    for (size_t i = 0; i < (size_t)(ROWS * COLS); i++) {
+        double err_re = data_re[i] - expected_re[i];
+        double err_im = data_im[i] - expected_im[i];
+        if (err_re < 0) err_re = -err_re;
+        if (err_im < 0) err_im = -err_im;
+        if (err_re > TOL || err_im > TOL) {
+            printf("FAIL [kr=%zu][kc=%zu]: got (%f, %f), expected (%f, %f)\n",
+                   i % ROWS, i / ROWS, data_re[i], data_im[i],
+                   expected_re[i], expected_im[i]);
+            return 1;
+        }
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,365 @@
+/*
+ * Mixed-radix Stockham autosort FFT for N = 2^a · 3^b · 5^c.
+ *
+ * Generalizes vec-fftN-stockham.c from radix-2 stages to one stage per factor
+ * of a plan (fft_plan[] in the generated header), each radix 2, 3, 4 or 5. The
+ * planner in fft/defs.bzl factors N into radix-5, radix-4, radix-3 and at most
+ * one radix-2 stage, so sizes like 384, 480, 960 and 1536 run natively rather
+ * than padded to the next power of two.
+ *
+ * Stage t with radix r, s = r_0 · ... · r_{t-1} and m = N / (r·s):
+ *   for p ∈ [0, m), q ∈ [0, s):
+ *     x_j = x[q + s·(p + j·m)]                    j ∈ [0, r)
+ *     X_k = Σ_j x_j · ω_r^(j·k)                   the r-point DFT
+ *     y[q + s·(r·p + k)] = X_k · ω_N^(p·s·k)      k ∈ [0, r)
+ * After the last stage (s·r = N) the output is in natural order.
+ *
+ * Each stage is vectorized along whichever of q or p is longer, as in the
+ * radix-2 kernel: q-major (s ≥ m) loads and stores unit-stride blocks of q
+ * and each twiddle ω_N^(p·s·k) is a scalar; p-major (s < m) loads blocks of p
+ * at stride s, stores them at stride r·s and reads the twiddles from tw[] at
+ * stride s·k. The radix-3 and radix-5 butterflies use the symmetric forms
+ * (x_j ± x_{r-j}), 12 and 32 real adds/multiplies per lane plus the twiddles.
+ *
+ * The twiddle table tw[k] = ω_N^k, k ∈ [0, N), comes from the header in
+ * scalar memory (tw_s_re/im) and is copied to VPU memory for the strided
+ * loads. Buffers ping-pong as in the radix-2 kernel, with the first
+ * destination chosen from the stage count so the last stage writes data_re/im.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "bench.h"
+#include "zamlet_custom.h"
+#include TWIDDLE_HEADER
+
+#ifndef FFT_N
+#error "FFT_N must be defined on the command line, e.g. -DFFT_N=384"
+#endif
+#if FFT_N != TWIDDLE_N
+#error "FFT_N must match TWIDDLE_N from the generated twiddles header"
+#endif
+#ifndef TWIDDLE_N_STAGES
+#error "vec-fftN-mixed.c needs a twiddles header generated with --plan"
+#endif
+
+#define N         FFT_N
+#ifndef N_FFTS
+#define N_FFTS    1
+#endif
+// Bins are checked to TOL relative to the largest, |X_0| = N·(N-1)/2.
+#define TOL       1e-13
+
+// Trace marker (custom-0 opcode 0x0b, funct3=3). See vec-fftN.c.
+#define FFT_MARK_V(id) zamlet_mark(id)
+
+// Marker IDs. ITER_START_BASE matches vec-fftN.c; STAGE_START(t) precedes
+// stage t.
+#define FFT_MARK_MIXED_STAGE_START(t)  (700 + (t))
+#define FFT_MARK_ITER_START_BASE       900
+
+// sin and cos of 2π/3, 2π/5 and 4π/5 for the radix-3 and radix-5 butterflies.
+#define R3_S   0.86602540378443864676
+#define R5_C1  0.30901699437494742410
+#define R5_C2 -0.80901699437494742410
+#define R5_S1  0.95105651629515357212
+#define R5_S2  0.58778525229247312917
+
+double in_re[N]   __attribute__((section(".data.vpu64")));
+double in_im[N]   __attribute__((section(".data.vpu64")));
+
+// Working buffers. Stages ping-pong between these two.
+double data_re[N] __attribute__((section(".data.vpu64")));
+double data_im[N] __attribute__((section(".data.vpu64")));
+double tmp_re[N]  __attribute__((section(".data.vpu64")));
+double tmp_im[N]  __attribute__((section(".data.vpu64")));
+
+// tw[k] = ω_N^k, the VPU copy of the header's tw_s_re/im for p-major stages.
+static double tw_re[N] __attribute__((section(".data.vpu64")));
+static double tw_im[N] __attribute__((section(".data.vpu64")));
+
+static size_t vl_max;       // Hardware VLMAX at e64,m1.
+
+// One stage's addressing for a vl-length block of butterflies. Input j of the
+// butterfly at lane 0 is at x + in_off + j·in_step, lanes in_stride bytes
+// apart; output k is at y + out_off + k·out_step, lanes out_stride bytes
+// apart. Its twiddle is ω_N^(k·(tw_e + lane·tw_lane)), a scalar when tw_lane
+// is 0.
+typedef struct {
+    size_t in_off, in_step, out_off, out_step;
+    ptrdiff_t in_stride, out_stride;
+    size_t tw_e, tw_lane;
+} block_addr;
+
+static inline void ld(const double* x_re, const double* x_im, const block_addr* a, int j,
+                      vfloat64m1_t* re, vfloat64m1_t* im, size_t vl) {
+    size_t off = a->in_off + (size_t)j * a->in_step;
+    if (a->in_stride == (ptrdiff_t)sizeof(double)) {
+        *re = __riscv_vle64_v_f64m1(x_re + off, vl);
+        *im = __riscv_vle64_v_f64m1(x_im + off, vl);
+    } else {
+        *re = __riscv_vlse64_v_f64m1(x_re + off, a->in_stride, vl);
+        *im = __riscv_vlse64_v_f64m1(x_im + off, a->in_stride, vl);
+    }
+}
+
+// Store output k, multiplied first by its twiddle for k > 0.
+static inline void st(double* y_re, double* y_im, const block_addr* a, int k,
+                      vfloat64m1_t re, vfloat64m1_t im, size_t vl) {
+    size_t e = (size_t)k * a->tw_e;
+    if (k > 0 && a->tw_lane != 0) {
+        ptrdiff_t tw_stride = (ptrdiff_t)((size_t)k * a->tw_lane * sizeof(double));
+        vfloat64m1_t w_re = __riscv_vlse64_v_f64m1(tw_re + e, tw_stride, vl);
+        vfloat64m1_t w_im = __riscv_vlse64_v_f64m1(tw_im + e, tw_stride, vl);
+        vfloat64m1_t t_re = __riscv_vfsub_vv_f64m1(
+            __riscv_vfmul_vv_f64m1(re, w_re, vl), __riscv_vfmul_vv_f64m1(im, w_im, vl), vl);
+        im = __riscv_vfadd_vv_f64m1(
+            __riscv_vfmul_vv_f64m1(re, w_im, vl), __riscv_vfmul_vv_f64m1(im, w_re, vl), vl);
+        re = t_re;
+    } else if (k > 0 && e != 0) {
+        double w_re = tw_s_re[e];
+        double w_im = tw_s_im[e];
+        vfloat64m1_t t_re = __riscv_vfsub_vv_f64m1(
+            __riscv_vfmul_vf_f64m1(re, w_re, vl), __riscv_vfmul_vf_f64m1(im, w_im, vl), vl);
+        im = __riscv_vfadd_vv_f64m1(
+            __riscv_vfmul_vf_f64m1(re, w_im, vl), __riscv_vfmul_vf_f64m1(im, w_re, vl), vl);
+        re = t_re;
+    }
+    size_t off = a->out_off + (size_t)k * a->out_step;
+    if (a->out_stride == (ptrdiff_t)sizeof(double)) {
+        __riscv_vse64_v_f64m1(y_re + off, re, vl);
+        __riscv_vse64_v_f64m1(y_im + off, im, vl);
+    } else {
+        __riscv_vsse64_v_f64m1(y_re + off, a->out_stride, re, vl);
+        __riscv_vsse64_v_f64m1(y_im + off, a->out_stride, im, vl);
+    }
+}
+
+static inline vfloat64m1_t vadd(vfloat64m1_t a, vfloat64m1_t b, size_t vl) {
+    return __riscv_vfadd_vv_f64m1(a, b, vl);
+}
+
+static inline vfloat64m1_t vsub(vfloat64m1_t a, vfloat64m1_t b, size_t vl) {
+    return __riscv_vfsub_vv_f64m1(a, b, vl);
+}
+
+static void bfly2(const double* x_re, const double* x_im, double* y_re, double* y_im,
+                  const block_addr* a, size_t vl) {
+    vfloat64m1_t a_re, a_im, b_re, b_im;
+    ld(x_re, x_im, a, 0, &a_re, &a_im, vl);
+    ld(x_re, x_im, a, 1, &b_re, &b_im, vl);
+    st(y_re, y_im, a, 0, vadd(a_re, b_re, vl), vadd(a_im, b_im, vl), vl);
+    st(y_re, y_im, a, 1, vsub(a_re, b_re, vl), vsub(a_im, b_im, vl), vl);
+}
+
+// X_1,2 = x_0 - (x_1 + x_2)/2 ∓ i·sin(2π/3)·(x_1 - x_2).
+static void bfly3(const double* x_re, const double* x_im, double* y_re, double* y_im,
+                  const block_addr* a, size_t vl) {
+    vfloat64m1_t x0_re, x0_im, x1_re, x1_im, x2_re, x2_im;
+    ld(x_re, x_im, a, 0, &x0_re, &x0_im, vl);
+    ld(x_re, x_im, a, 1, &x1_re, &x1_im, vl);
+    ld(x_re, x_im, a, 2, &x2_re, &x2_im, vl);
+    vfloat64m1_t t_re = vadd(x1_re, x2_re, vl);
+    vfloat64m1_t t_im = vadd(x1_im, x2_im, vl);
+    vfloat64m1_t h_re = __riscv_vfnmsac_vf_f64m1(x0_re, 0.5, t_re, vl);
+    vfloat64m1_t h_im = __riscv_vfnmsac_vf_f64m1(x0_im, 0.5, t_im, vl);
+    vfloat64m1_t u_re = __riscv_vfmul_vf_f64m1(vsub(x1_re, x2_re, vl), R3_S, vl);
+    vfloat64m1_t u_im = __riscv_vfmul_vf_f64m1(vsub(x1_im, x2_im, vl), R3_S, vl);
+    st(y_re, y_im, a, 0, vadd(x0_re, t_re, vl), vadd(x0_im, t_im, vl), vl);
+    st(y_re, y_im, a, 1, vadd(h_re, u_im, vl), vsub(h_im, u_re, vl), vl);
+    st(y_re, y_im, a, 2, vsub(h_re, u_im, vl), vadd(h_im, u_re, vl), vl);
+}
+
+static void bfly4(const double* x_re, const double* x_im, double* y_re, double* y_im,
+                  const block_addr* a, size_t vl) {
+    vfloat64m1_t x0_re, x0_im, x1_re, x1_im, x2_re, x2_im, x3_re, x3_im;
+    ld(x_re, x_im, a, 0, &x0_re, &x0_im, vl);
+    ld(x_re, x_im, a, 1, &x1_re, &x1_im, vl);
+    ld(x_re, x_im, a, 2, &x2_re, &x2_im, vl);
+    ld(x_re, x_im, a, 3, &x3_re, &x3_im, vl);
+    vfloat64m1_t s02_re = vadd(x0_re, x2_re, vl), s02_im = vadd(x0_im, x2_im, vl);
+    vfloat64m1_t d02_re = vsub(x0_re, x2_re, vl), d02_im = vsub(x0_im, x2_im, vl);
+    vfloat64m1_t s13_re = vadd(x1_re, x3_re, vl), s13_im = vadd(x1_im, x3_im, vl);
+    vfloat64m1_t d13_re = vsub(x1_re, x3_re, vl), d13_im = vsub(x1_im, x3_im, vl);
+    // X_1,3 = (x_0 - x_2) ∓ i·(x_1 - x_3).
+    st(y_re, y_im, a, 0, vadd(s02_re, s13_re, vl), vadd(s02_im, s13_im, vl), vl);
+    st(y_re, y_im, a, 1, vadd(d02_re, d13_im, vl), vsub(d02_im, d13_re, vl), vl);
+    st(y_re, y_im, a, 2, vsub(s02_re, s13_re, vl), vsub(s02_im, s13_im, vl), vl);
+    st(y_re, y_im, a, 3, vsub(d02_re, d13_im, vl), vadd(d02_im, d13_re, vl), vl);
+}
+
+// With a_j = x_j + x_{5-j} and b_j = x_j - x_{5-j}:
+//   X_1,4 = x_0 + c1·a_1 + c2·a_2 ∓ i·(s1·b_1 + s2·b_2)
+//   X_2,3 = x_0 + c2·a_1 + c1·a_2 ∓ i·(s2·b_1 - s1·b_2)
+// where c1, s1 = cos, sin(2π/5) and c2, s2 = cos, sin(4π/5).
+static void bfly5(const double* x_re, const double* x_im, double* y_re, double* y_im,
+                  const block_addr* a, size_t vl) {
+    vfloat64m1_t x0_re, x0_im, x1_re, x1_im, x2_re, x2_im, x3_re, x3_im, x4_re, x4_im;
+    ld(x_re, x_im, a, 0, &x0_re, &x0_im, vl);
+    ld(x_re, x_im, a, 1, &x1_re, &x1_im, vl);
+    ld(x_re, x_im, a, 2, &x2_re, &x2_im, vl);
+    ld(x_re, x_im, a, 3, &x3_re, &x3_im, vl);
+    ld(x_re, x_im, a, 4, &x4_re, &x4_im, vl);
+    vfloat64m1_t a1_re = vadd(x1_re, x4_re, vl), a1_im = vadd(x1_im, x4_im, vl);
+    vfloat64m1_t a2_re = vadd(x2_re, x3_re, vl), a2_im = vadd(x2_im, x3_im, vl);
+    vfloat64m1_t b1_re = vsub(x1_re, x4_re, vl), b1_im = vsub(x1_im, x4_im, vl);
+    vfloat64m1_t b2_re = vsub(x2_re, x3_re, vl), b2_im = vsub(x2_im, x3_im, vl);
+
+    vfloat64m1_t t1_re = __riscv_vfmacc_vf_f64m1(
+        __riscv_vfmacc_vf_f64m1(x0_re, R5_C1, a1_re, vl), R5_C2, a2_re, vl);
+    vfloat64m1_t t1_im = __riscv_vfmacc_vf_f64m1(
+        __riscv_vfmacc_vf_f64m1(x0_im, R5_C1, a1_im, vl), R5_C2, a2_im, vl);
+    vfloat64m1_t t2_re = __riscv_vfmacc_vf_f64m1(
+        __riscv_vfmacc_vf_f64m1(x0_re, R5_C2, a1_re, vl), R5_C1, a2_re, vl);
+    vfloat64m1_t t2_im = __riscv_vfmacc_vf_f64m1(
+        __riscv_vfmacc_vf_f64m1(x0_im, R5_C2, a1_im, vl), R5_C1, a2_im, vl);
+    vfloat64m1_t u1_re = __riscv_vfmacc_vf_f64m1(
+        __riscv_vfmul_vf_f64m1(b1_re, R5_S1, vl), R5_S2, b2_re, vl);
+    vfloat64m1_t u1_im = __riscv_vfmacc_vf_f64m1(
+        __riscv_vfmul_vf_f64m1(b1_im, R5_S1, vl), R5_S2, b2_im, vl);
+    vfloat64m1_t u2_re = __riscv_vfnmsac_vf_f64m1(
+        __riscv_vfmul_vf_f64m1(b1_re, R5_S2, vl), R5_S1, b2_re, vl);
+    vfloat64m1_t u2_im = __riscv_vfnmsac_vf_f64m1(
+        __riscv_vfmul_vf_f64m1(b1_im, R5_S2, vl), R5_S1, b2_im, vl);
+
+    st(y_re, y_im, a, 0, vadd(x0_re, vadd(a1_re, a2_re, vl), vl),
+       vadd(x0_im, vadd(a1_im, a2_im, vl), vl), vl);
+    st(y_re, y_im, a, 1, vadd(t1_re, u1_im, vl), vsub(t1_im, u1_re, vl), vl);
+    st(y_re, y_im, a, 2, vadd(t2_re, u2_im, vl), vsub(t2_im, u2_re, vl), vl);
+    st(y_re, y_im, a, 3, vsub(t2_re, u2_im, vl), vadd(t2_im, u2_re, vl), vl);
+    st(y_re, y_im, a, 4, vsub(t1_re, u1_im, vl), vadd(t1_im, u1_re, vl), vl);
+}
+
+typedef void (*bfly_fn)(const double*, const double*, double*, double*,
+                        const block_addr*, size_t);
+
+static bfly_fn radix_bfly(int r) {
+    switch (r) {
+        case 2: return bfly2;
+        case 3: return bfly3;
+        case 4: return bfly4;
+        case 5: return bfly5;
+        default: __builtin_unreachable();
+    }
+}
+
+// One radix-r stage from x to y at stride s, m = N / (r·s).
+static void run_stage(int r, const double* x_re, const double* x_im,
+                      double* y_re, double* y_im, size_t s, size_t m) {
+    bfly_fn bfly = radix_bfly(r);
+    block_addr a;
+    a.in_step = s * m;
+    a.out_step = s;
+    if (s >= m) {
+        // q-major: unit-stride blocks of q, one scalar twiddle per (p, k).
+        a.in_stride = a.out_stride = (ptrdiff_t)sizeof(double);
+        a.tw_lane = 0;
+        for (size_t p = 0; p < m; p++) {
+            for (size_t q = 0; q < s; ) {
+                size_t vl = __riscv_vsetvl_e64m1(s - q);
+                a.in_off = q + s * p;
+                a.out_off = q + s * (size_t)r * p;
+                a.tw_e = p * s;
+                bfly(x_re, x_im, y_re, y_im, &a, vl);
+                q += vl;
+            }
+        }
+    } else {
+        // p-major: blocks of p at stride s in, r·s out; twiddles at stride s·k.
+        a.in_stride = (ptrdiff_t)(s * sizeof(double));
+        a.out_stride = (ptrdiff_t)((size_t)r * s * sizeof(double));
+        a.tw_lane = s;
+        for (size_t q = 0; q < s; q++) {
+            for (size_t p = 0; p < m; ) {
+                size_t vl = __riscv_vsetvl_e64m1(m - p);
+                a.in_off = q + s * p;
+                a.out_off = q + s * (size_t)r * p;
+                a.tw_e = p * s;
+                bfly(x_re, x_im, y_re, y_im, &a, vl);
+                p += vl;
+            }
+        }
+    }
+}
+
+static void init_tables(void) {
+    vl_max = __riscv_vsetvl_e64m1((size_t)1 << 30);
+    for (size_t k = 0; k < (size_t)N; k++) {
+        tw_re[k] = tw_s_re[k];
+        tw_im[k] = tw_s_im[k];
+    }
+}
+
+static void run_fft(void) {
+    const double* x_re = in_re;
+    const double* x_im = in_im;
+    // Stage t writes data when (TWIDDLE_N_STAGES - 1 - t) is even, so the last
+    // stage always lands in data_re/im.
+    int to_data = ((TWIDDLE_N_STAGES - 1) % 2) == 0;
+    size_t s = 1;
+    for (int t = 0; t < TWIDDLE_N_STAGES; t++) {
+        FFT_MARK_V(FFT_MARK_MIXED_STAGE_START(t));
+        int r = fft_plan[t];
+        double* y_re = to_data ? data_re : tmp_re;
+        double* y_im = to_data ? data_im : tmp_im;
+        size_t m = (size_t)N / ((size_t)r * s);
+        run_stage(r, x_re, x_im, y_re, y_im, s, m);
+        x_re = y_re;
+        x_im = y_im;
+        to_data = !to_data;
+        s *= (size_t)r;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    // Input: x[i] = i + 0j, matching the expected[] table in the generated
+    // twiddles header.
+    for (size_t i = 0; i < (size_t)N; i++) {
+        in_re[i] = (double)i;
+        in_im[i] = 0.0;
+    }
+
+    init_tables();
+
+    printf("Running mixed-radix FFT-%d (", N);
+    for (int t = 0; t < TWIDDLE_N_STAGES; t++)
+        printf(t ? " x %d" : "%d", fft_plan[t]);
+    printf(", vlmax=%zu) x%d\n", vl_max, N_FFTS);
+
+    unsigned long cycles1, cycles2;
+    cycles1 = read_csr(mcycle);
+    bench_begin("fft");
+
+    for (int iter = 0; iter < N_FFTS; iter++) {
+        FFT_MARK_V(FFT_MARK_ITER_START_BASE + iter);
+        run_fft();
+    }
+
+    asm volatile("fence");
+    bench_end();
+    cycles2 = read_csr(mcycle);
+
+    printf("Cycles: %lu\n", cycles2 - cycles1);
+
+    double tol = TOL * (double)N * (double)(N - 1) / 2.0;
+    for (size_t i = 0; i < (size_t)N; i++) {
+        double err_re = data_re[i] - expected_re[i];
+        double err_im = data_im[i] - expected_im[i];
+        if (err_re < 0) err_re = -err_re;
+        if (err_im < 0) err_im = -err_im;
+        if (err_re > tol || err_im > tol) {
+            printf("FAIL [%zu]: got (%f, %f), expected (%f, %f)\n",
+                   i, data_re[i], data_im[i], expected_re[i], expected_im[i]);
+            return 1;
+        }
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,250 @@
+/*
+ * Arbitrary-N (power of 2) radix-2 Stockham autosort FFT.
+ *
+ * Sibling of vec-fftN.c that computes the same transform without a
+ * bit-reverse pre-pass. Each stage reads one buffer and writes the other, and
+ * the output ordering falls out of the strided write pattern, so the result is
+ * in natural order after log2(N) stages. All vector memory traffic is
+ * unit-stride (vle64/vse64) or constant-stride (vlse64/vsse64); no indexed
+ * gathers or scatters.
+ *
+ * Stage k (k ∈ [0, log2N)) with s = 2^k, m = N / (2s):
+ *   for p ∈ [0, m), q ∈ [0, s):
+ *     a = x[q + s·p];  b = x[q + s·(p + m)]
+ *     y[q + 2s·p]     = a + b
+ *     y[q + 2s·p + s] = (a − b) · ω_N^(p·s)
+ *
+ * Each stage is vectorized along whichever of q or p is longer:
+ *   - q-major (s ≥ m): loop over p, vl-blocks of q are unit-stride, and the
+ *     twiddle ω_N^(p·s) is a single scalar.
+ *   - p-major (s < m): loop over q, vl-blocks of p are strided (stride s on
+ *     the loads, 2s on the stores, s on the twiddle table).
+ *
+ * The twiddle table tw[k] = ω_N^k for k ∈ [0, N/2) is built once at startup
+ * from the generated omega[] squarings, so each entry is a product of at most
+ * log2N - 1 factors.
+ *
+ * Buffers: in_re/im hold the pristine input. Stage 0 reads in_re/im, then
+ * stages ping-pong between data_re/im and tmp_re/im. The first destination is
+ * chosen from the parity of log2N so the final stage always writes data_re/im.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "bench.h"
+#include "vinit.h"
+#include "zamlet_custom.h"
+#include TWIDDLE_HEADER
+
+#ifndef FFT_N
+#error "FFT_N must be defined on the command line, e.g. -DFFT_N=32"
+#endif
+#if FFT_N != TWIDDLE_N
+#error "FFT_N must match TWIDDLE_N from the generated twiddles header"
+#endif
+
+#define N         FFT_N
+#ifndef N_FFTS
+#define N_FFTS    1
+#endif
+#define TOL       1e-9
+
+// Trace marker (custom-0 opcode 0x0b, funct3=3). See vec-fftN.c.
+#define FFT_MARK_V(id) zamlet_mark(id)
+
+// Marker IDs. ITER_START_BASE matches vec-fftN.c so per-iteration spans can be
+// compared between the two kernels; STAGE_START(k) precedes stage k.
+#define FFT_MARK_STOCKHAM_STAGE_START(k)  (500 + (k))
+#define FFT_MARK_ITER_START_BASE          900
+
+double in_re[N]   __attribute__((section(".data.vpu64")));
+double in_im[N]   __attribute__((section(".data.vpu64")));
+
+// Working buffers. Stages ping-pong between these two.
+double data_re[N] __attribute__((section(".data.vpu64")));
+double data_im[N] __attribute__((section(".data.vpu64")));
+double tmp_re[N]  __attribute__((section(".data.vpu64")));
+double tmp_im[N]  __attribute__((section(".data.vpu64")));
+
+// tw[k] = ω_N^k. The vector copy feeds the strided p-major loads; the scalar
+// copy feeds the per-p twiddle of q-major stages without a VPU-memory read.
+static double tw_re[N / 2] __attribute__((section(".data.vpu64")));
+static double tw_im[N / 2] __attribute__((section(".data.vpu64")));
+static double tw_s_re[N / 2];
+static double tw_s_im[N / 2];
+
+static size_t vl_max;       // Hardware VLMAX at e64,m1.
+
+// expected_re / expected_im are declared in TWIDDLE_HEADER (VPU memory).
+
+static void init_tables(void) {
+    vl_max = __riscv_vsetvl_e64m1((size_t)1 << 30);
+
+    // tw[k + 2^j] = tw[k] · omega[j] for k ∈ [0, 2^j), since omega[j] = ω_N^(2^j).
+    tw_s_re[0] = 1.0;
+    tw_s_im[0] = 0.0;
+    for (int j = 0; j < TWIDDLE_LOG2N - 1; j++) {
+        size_t half = (size_t)1 << j;
+        double w_re = omega_re[j];
+        double w_im = omega_im[j];
+        for (size_t k = 0; k < half; k++) {
+            tw_s_re[k + half] = tw_s_re[k] * w_re - tw_s_im[k] * w_im;
+            tw_s_im[k + half] = tw_s_re[k] * w_im + tw_s_im[k] * w_re;
+        }
+    }
+    for (size_t k = 0; k < (size_t)(N / 2); k++) {
+        tw_re[k] = tw_s_re[k];
+        tw_im[k] = tw_s_im[k];
+    }
+}
+
+// q-major stage: unit-stride over q, one scalar twiddle per p.
+static void stage_q_major(const double* x_re, const double* x_im,
+                          double* y_re, double* y_im, size_t s, size_t m) {
+    for (size_t p = 0; p < m; p++) {
+        double w_re = tw_s_re[p * s];
+        double w_im = tw_s_im[p * s];
+        const double* a_re = x_re + s * p;
+        const double* a_im = x_im + s * p;
+        const double* b_re = x_re + s * (p + m);
+        const double* b_im = x_im + s * (p + m);
+        double* y0_re = y_re + 2 * s * p;
+        double* y0_im = y_im + 2 * s * p;
+        double* y1_re = y0_re + s;
+        double* y1_im = y0_im + s;
+
+        for (size_t q = 0; q < s; ) {
+            size_t vl = __riscv_vsetvl_e64m1(s - q);
+            vfloat64m1_t A_re = __riscv_vle64_v_f64m1(a_re + q, vl);
+            vfloat64m1_t A_im = __riscv_vle64_v_f64m1(a_im + q, vl);
+            vfloat64m1_t B_re = __riscv_vle64_v_f64m1(b_re + q, vl);
+            vfloat64m1_t B_im = __riscv_vle64_v_f64m1(b_im + q, vl);
+
+            vfloat64m1_t S_re = __riscv_vfadd_vv_f64m1(A_re, B_re, vl);
+            vfloat64m1_t S_im = __riscv_vfadd_vv_f64m1(A_im, B_im, vl);
+            vfloat64m1_t D_re = __riscv_vfsub_vv_f64m1(A_re, B_re, vl);
+            vfloat64m1_t D_im = __riscv_vfsub_vv_f64m1(A_im, B_im, vl);
+            vfloat64m1_t T_re = __riscv_vfsub_vv_f64m1(
+                __riscv_vfmul_vf_f64m1(D_re, w_re, vl),
+                __riscv_vfmul_vf_f64m1(D_im, w_im, vl), vl);
+            vfloat64m1_t T_im = __riscv_vfadd_vv_f64m1(
+                __riscv_vfmul_vf_f64m1(D_re, w_im, vl),
+                __riscv_vfmul_vf_f64m1(D_im, w_re, vl), vl);
+
+            __riscv_vse64_v_f64m1(y0_re + q, S_re, vl);
+            __riscv_vse64_v_f64m1(y0_im + q, S_im, vl);
+            __riscv_vse64_v_f64m1(y1_re + q, T_re, vl);
+            __riscv_vse64_v_f64m1(y1_im + q, T_im, vl);
+            q += vl;
+        }
+    }
+}
+
+// p-major stage: strided over p (loads stride s, stores stride 2s), twiddle
+// vector read from tw[] with stride s.
+static void stage_p_major(const double* x_re, const double* x_im,
+                          double* y_re, double* y_im, size_t s, size_t m) {
+    ptrdiff_t x_stride = (ptrdiff_t)(s * sizeof(double));
+    ptrdiff_t y_stride = (ptrdiff_t)(2 * s * sizeof(double));
+    for (size_t q = 0; q < s; q++) {
+        for (size_t p = 0; p < m; ) {
+            size_t vl = __riscv_vsetvl_e64m1(m - p);
+            size_t a_off = q + s * p;
+            size_t b_off = q + s * (p + m);
+            size_t y_off = q + 2 * s * p;
+            vfloat64m1_t A_re = __riscv_vlse64_v_f64m1(x_re + a_off, x_stride, vl);
+            vfloat64m1_t A_im = __riscv_vlse64_v_f64m1(x_im + a_off, x_stride, vl);
+            vfloat64m1_t B_re = __riscv_vlse64_v_f64m1(x_re + b_off, x_stride, vl);
+            vfloat64m1_t B_im = __riscv_vlse64_v_f64m1(x_im + b_off, x_stride, vl);
+            vfloat64m1_t W_re = __riscv_vlse64_v_f64m1(tw_re + s * p, x_stride, vl);
+            vfloat64m1_t W_im = __riscv_vlse64_v_f64m1(tw_im + s * p, x_stride, vl);
+
+            vfloat64m1_t S_re = __riscv_vfadd_vv_f64m1(A_re, B_re, vl);
+            vfloat64m1_t S_im = __riscv_vfadd_vv_f64m1(A_im, B_im, vl);
+            vfloat64m1_t D_re = __riscv_vfsub_vv_f64m1(A_re, B_re, vl);
+            vfloat64m1_t D_im = __riscv_vfsub_vv_f64m1(A_im, B_im, vl);
+            vfloat64m1_t T_re = __riscv_vfsub_vv_f64m1(
+                __riscv_vfmul_vv_f64m1(D_re, W_re, vl),
+                __riscv_vfmul_vv_f64m1(D_im, W_im, vl), vl);
+            vfloat64m1_t T_im = __riscv_vfadd_vv_f64m1(
+                __riscv_vfmul_vv_f64m1(D_re, W_im, vl),
+                __riscv_vfmul_vv_f64m1(D_im, W_re, vl), vl);
+
+            __riscv_vsse64_v_f64m1(y_re + y_off, y_stride, S_re, vl);
+            __riscv_vsse64_v_f64m1(y_im + y_off, y_stride, S_im, vl);
+            __riscv_vsse64_v_f64m1(y_re + y_off + s, y_stride, T_re, vl);
+            __riscv_vsse64_v_f64m1(y_im + y_off + s, y_stride, T_im, vl);
+            p += vl;
+        }
+    }
+}
+
+static void run_fft(void) {
+    const double* x_re = in_re;
+    const double* x_im = in_im;
+    // Stage k writes data when (log2N - 1 - k) is even, so the last stage
+    // (k = log2N - 1) always lands in data_re/im.
+    int to_data = ((TWIDDLE_LOG2N - 1) % 2) == 0;
+    for (int k = 0; k < TWIDDLE_LOG2N; k++) {
+        FFT_MARK_V(FFT_MARK_STOCKHAM_STAGE_START(k));
+        double* y_re = to_data ? data_re : tmp_re;
+        double* y_im = to_data ? data_im : tmp_im;
+        size_t s = (size_t)1 << k;
+        size_t m = (size_t)N / (2 * s);
+        if (s >= m) {
+            stage_q_major(x_re, x_im, y_re, y_im, s, m);
+        } else {
+            stage_p_major(x_re, x_im, y_re, y_im, s, m);
+        }
+        x_re = y_re;
+        x_im = y_im;
+        to_data = !to_data;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    // Input: x[i] = i + 0j, matching the expected[] table in the generated
+    // twiddles header.
+    vinit_affine_stride_f64(in_re, 1, N, 1.0, 0.0);
+    vinit_fill_f64(in_im, N, 0.0);
+
+    init_tables();
+
+    printf("Running Stockham FFT-%d (vlmax=%zu) x%d\n", N, vl_max, N_FFTS);
+
+    unsigned long cycles1, cycles2;
+    cycles1 = read_csr(mcycle);
+    bench_begin("fft");
+
+    for (int iter = 0; iter < N_FFTS; iter++) {
+        FFT_MARK_V(FFT_MARK_ITER_START_BASE + iter);
+        run_fft();
+    }
+
+    asm volatile("fence");
+    bench_end();
+    cycles2 = read_csr(mcycle);
+
+    printf("Cycles: %lu\n", cycles2 - cycles1);
+
+    int bad = vverifyDoubleTol(N, data_re, 1, expected_re, TOL);
+    int bad_im = vverifyDoubleTol(bad ? bad - 1 : N, data_im, 1, expected_im, TOL);
+    if (bad_im) {
+        bad = bad_im;
+    }
+    if (bad) {
+        size_t i = bad - 1;
+        printf("FAIL [%zu]: got (%f, %f), expected (%f, %f)\n",
+               i, data_re[i], data_im[i], expected_re[i], expected_im[i]);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
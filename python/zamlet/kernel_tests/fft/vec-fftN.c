@@ -29,10 +29,68 @@
  *     per memory round-trip. P_max passes, each pass multiplies D by 8.
  *     Partial last pass possible (2- or 4-reg super-chunk).
  *
+ * Bit-reverse input ordering. With FFT_FUSED_BITREVERSE (the default) the
+ * permutation is folded into the chunk loads: each V_i is gathered straight
+ * from the natural-order input in tmp_re/im by vluxei64 through
+ * br_gather_idx, under zamlet_set_index_bound. The chunk pass tiles all of
+ * data_re/im, so no standalone reorder pass runs. FFT_FUSED_BITREVERSE=0
+ * restores the two bitreverse_reorder64 passes (tmp → data) ahead of
+ * unit-stride chunk loads.
+ *
+ * Real input (FFT_REAL). The header is generated with --real for a real
+ * length TWIDDLE_REAL_N = 2·N. The real samples are packed as
+ * z[m] = x[2m] + i·x[2m+1] and run through the N-point complex FFT above.
+ * A vectorized post-processing pass (rfft_postprocess) then forms bins
+ * 0..N of the real spectrum in rfft_re/im.
+ *
+ * Inverse (FFT_INVERSE). The header is generated with --inverse, which
+ * conjugates omega and seed_block, so the same stages compute the unscaled
+ * inverse DFT. The 1/N scale is fused into the final pass's stores (the last
+ * Regime C pass, or the chunk pass when there is no Regime C).
+ *
+ * Convolution (FFT_CONV). The header is generated with --conv and supplies
+ * conv_h = DFT(h). Each iteration runs two forward transforms:
+ *   1. tmp → data. The final stores multiply by conv_h in registers and
+ *      conjugate, leaving conj(X·H) in data.
+ *   2. data → conv_out. The chunk loads gather the bit-reversed product
+ *      straight from data, and the final stores conjugate and scale by 1/N,
+ *      giving IFFT(X·H) = conj(FFT(conj(X·H))) / N.
+ * The pointwise product never gets its own vle64/vse64 sweep, and the
+ * inverse reuses the forward twiddle tables.
+ *
+ * Interleaved layout (FFT_INTERLEAVED). Input, working and output buffers
+ * hold (re, im) pairs in tmp_c/data_c instead of split re/im arrays. All
+ * buffer accesses go through buf_load/buf_store, which use vlseg2e64/
+ * vsseg2e64, and the fused chunk loads gather pairs with vluxseg2ei64, so
+ * the (de)interleave happens in the load/store units and there is no
+ * separate re/im shuffle pass. Needs the fused bit-reverse; FFT_REAL and
+ * FFT_CONV work on split arrays and are not supported in this layout.
+ *
+ * Software pipelining (FFT_PIPELINED). The R=8 chunk loop and the full
+ * Regime C passes issue the loads of the next chunk's (super-chunk's) first two
+ * registers before the current one's last butterflies and stores, and the other
+ * six right after the stores, so memory latency overlaps FP work where the
+ * passes are memory-bound. Only two fit beside the butterfly temporaries, and
+ * the radix-4 core needs more temporaries than that leaves, so FFT_PIPELINED
+ * needs REGIME_BC_RADIX=2. See run_chunks_R8_pipelined and
+ * regime_c_pass_R8_pipelined.
+ *
+ * Single precision (FFT_F32). The header is generated with --f32: every table
+ * is float, the VPU ones in .data.vpu32, and br_gather_idx holds e32 byte
+ * offsets that the fused chunk loads feed to vluxei32 as they are. Vector ops
+ * run at e32,m1 through the FFT_V* macros below, so each register holds twice
+ * the elements of the f64 build and vl, chunk sizes and MAX_VLMAX double with
+ * it. The output check is relative to the largest expected bin (FFT_F32_TOL).
+ * Only the forward split-array transform with stored twiddles is built and
+ * tested this way: FFT_REAL, FFT_INVERSE, FFT_CONV, FFT_OTF_TWIDDLES and
+ * FFT_INTERLEAVED are rejected with FFT_F32.
+ *
  * Twiddle sourcing. Every stage twiddle vector is derived from one seed_block
  * row (unit-stride vle64) via build_seed or build_regime_a_seed. Regime A
  * tile-replicates a length-d core to length vl. Regimes B/C split each pair's
- * twiddle as base_tw_scalar · seed_vector.
+ * twiddle as base_tw_scalar · seed_vector. FFT_OTF_TWIDDLES derives most of
+ * these vectors in registers at the point of use instead of keeping them
+ * resident (see below).
  */
 #include <stdlib.h>
 #include <stdio.h>
@@ -41,6 +99,9 @@
 #include <riscv_vector.h>
 #include "util.h"
 #include "vpu_alloc.h"
+#include "bench.h"
+#include "vinit.h"
+#include "zamlet_custom.h"
 #include TWIDDLE_HEADER
 
 #ifndef FFT_N
@@ -55,18 +116,166 @@
 #define N_FFTS    1
 #endif
 #define TOL       1e-9
+// FFT_F32 checks to FFT_F32_TOL times the largest expected component instead:
+// f32 rounding error grows with the magnitude of the transform.
+#define FFT_F32_TOL 1e-5
+
+#ifndef FFT_FUSED_BITREVERSE
+#define FFT_FUSED_BITREVERSE 1
+#endif
+
+#ifndef FFT_REAL
+#define FFT_REAL 0
+#endif
+#if FFT_REAL && !defined(TWIDDLE_REAL_N)
+#error "FFT_REAL needs a twiddles header generated with --real"
+#endif
+
+#ifndef FFT_INVERSE
+#define FFT_INVERSE 0
+#endif
+#if FFT_INVERSE && !defined(TWIDDLE_INVERSE)
+#error "FFT_INVERSE needs a twiddles header generated with --inverse"
+#endif
 
-// Trace marker (custom-0 opcode 0x0b, funct3=3). Broadcasts a Marker KInstr
-// to every kamlet, which logs a "marker" event on its kinstr-exec span and
-// discards the instruction. Used to delimit kernel phases in span traces.
+#ifndef FFT_CONV
+#define FFT_CONV 0
+#endif
+#if FFT_CONV && !defined(TWIDDLE_CONV)
+#error "FFT_CONV needs a twiddles header generated with --conv"
+#endif
+#if FFT_CONV && !FFT_FUSED_BITREVERSE
+#error "FFT_CONV gathers its second pass from data and needs FFT_FUSED_BITREVERSE"
+#endif
+#if (FFT_REAL + FFT_INVERSE + FFT_CONV) > 1
+#error "FFT_REAL, FFT_INVERSE and FFT_CONV are mutually exclusive"
+#endif
+
+#ifndef FFT_INTERLEAVED
+#define FFT_INTERLEAVED 0
+#endif
+#if FFT_INTERLEAVED && !FFT_FUSED_BITREVERSE
+#error "FFT_INTERLEAVED gathers (re, im) pairs and needs FFT_FUSED_BITREVERSE"
+#endif
+#if FFT_INTERLEAVED && (FFT_REAL || FFT_CONV)
+#error "FFT_INTERLEAVED does not support FFT_REAL or FFT_CONV"
+#endif
+
+#ifndef FFT_PIPELINED
+#define FFT_PIPELINED 0
+#endif
+
+#ifndef FFT_OTF_TWIDDLES
+#define FFT_OTF_TWIDDLES 0
+#endif
+
+#ifndef FFT_F32
+#define FFT_F32 0
+#endif
+#if FFT_F32 && !defined(TWIDDLE_F32)
+#error "FFT_F32 needs a twiddles header generated with --f32"
+#endif
+#if FFT_F32 && !(defined(TWIDDLE_BR_VL) && FFT_FUSED_BITREVERSE)
+#error "FFT_F32 gathers through the header's e32 br_gather_idx and needs FFT_FUSED_BITREVERSE"
+#endif
+#if FFT_F32 && (FFT_REAL || FFT_INVERSE || FFT_CONV || FFT_OTF_TWIDDLES || FFT_INTERLEAVED)
+#error "FFT_F32 supports only the forward split-array transform with stored twiddles"
+#endif
+
+// Element type and the intrinsics that depend on it. Everything below is
+// written against these; FFT_F32 swaps f64m1 for f32m1, the e32 index and mask
+// types, and the .bss.vpu32 section.
+#if FFT_F32
+typedef float          fft_t;
+typedef vfloat32m1_t   vfft_t;
+typedef vfloat32m1x2_t vfft2_t;
+typedef vuint32m1_t    vfft_idx_t;
+typedef vbool32_t      vfft_mask_t;
+typedef uint32_t       fft_idx_t;
+#define FFT_SEW              "e32"
+#define FFT_VPU_SECTION      ".bss.vpu32"
+#define FFT_VSETVL           __riscv_vsetvl_e32m1
+#define FFT_VSETVLMAX        __riscv_vsetvlmax_e32m1
+#define FFT_VLE              __riscv_vle32_v_f32m1
+#define FFT_VSE              __riscv_vse32_v_f32m1
+#define FFT_VLSE             __riscv_vlse32_v_f32m1
+#define FFT_VLUXEI           __riscv_vluxei32_v_f32m1
+#define FFT_VLSEG2           __riscv_vlseg2e32_v_f32m1x2
+#define FFT_VSSEG2           __riscv_vsseg2e32_v_f32m1x2
+#define FFT_VLUXSEG2         __riscv_vluxseg2ei32_v_f32m1x2
+#define FFT_VGET             __riscv_vget_v_f32m1x2_f32m1
+#define FFT_VCREATE          __riscv_vcreate_v_f32m1x2
+#define FFT_VFADD            __riscv_vfadd_vv_f32m1
+#define FFT_VFSUB            __riscv_vfsub_vv_f32m1
+#define FFT_VFMUL            __riscv_vfmul_vv_f32m1
+#define FFT_VFMUL_VF         __riscv_vfmul_vf_f32m1
+#define FFT_VFNEG            __riscv_vfneg_v_f32m1
+#define FFT_VFNEG_MU         __riscv_vfneg_v_f32m1_mu
+#define FFT_VSLIDEUP         __riscv_vslideup_vx_f32m1
+#define FFT_VSLIDEUP_MU      __riscv_vslideup_vx_f32m1_mu
+#define FFT_VSLIDEDOWN_MU    __riscv_vslidedown_vx_f32m1_mu
+#define FFT_VLE_IDX          __riscv_vle32_v_u32m1
+#define FFT_VSUXEI_IDX       __riscv_vsuxei32_v_u32m1
+#define FFT_VID              __riscv_vid_v_u32m1
+#define FFT_VAND_IDX         __riscv_vand_vx_u32m1
+#define FFT_VSLL_IDX         __riscv_vsll_vx_u32m1
+#define FFT_VMSNE_IDX        __riscv_vmsne_vx_u32m1_b32
+#define FFT_VMSLTU_IDX       __riscv_vmsltu_vx_u32m1_b32
+#define FFT_VMNOT            __riscv_vmnot_m_b32
+#define FFT_VERIFY_TOL       vverifyFloatTol
+#define FFT_VINIT_FILL       vinit_fill_f32
+#define FFT_VINIT_AFFINE     vinit_affine_stride_f32
+#else
+typedef double         fft_t;
+typedef vfloat64m1_t   vfft_t;
+typedef vfloat64m1x2_t vfft2_t;
+typedef vuint64m1_t    vfft_idx_t;
+typedef vbool64_t      vfft_mask_t;
+typedef uint64_t       fft_idx_t;
+#define FFT_SEW              "e64"
+#define FFT_VPU_SECTION      ".bss.vpu64"
+#define FFT_VSETVL           __riscv_vsetvl_e64m1
+#define FFT_VSETVLMAX        __riscv_vsetvlmax_e64m1
+#define FFT_VLE              __riscv_vle64_v_f64m1
+#define FFT_VSE              __riscv_vse64_v_f64m1
+#define FFT_VLSE             __riscv_vlse64_v_f64m1
+#define FFT_VLUXEI           __riscv_vluxei64_v_f64m1
+#define FFT_VLSEG2           __riscv_vlseg2e64_v_f64m1x2
+#define FFT_VSSEG2           __riscv_vsseg2e64_v_f64m1x2
+#define FFT_VLUXSEG2         __riscv_vluxseg2ei64_v_f64m1x2
+#define FFT_VGET             __riscv_vget_v_f64m1x2_f64m1
+#define FFT_VCREATE          __riscv_vcreate_v_f64m1x2
+#define FFT_VFADD            __riscv_vfadd_vv_f64m1
+#define FFT_VFSUB            __riscv_vfsub_vv_f64m1
+#define FFT_VFMUL            __riscv_vfmul_vv_f64m1
+#define FFT_VFMUL_VF         __riscv_vfmul_vf_f64m1
+#define FFT_VFNEG            __riscv_vfneg_v_f64m1
+#define FFT_VFNEG_MU         __riscv_vfneg_v_f64m1_mu
+#define FFT_VSLIDEUP         __riscv_vslideup_vx_f64m1
+#define FFT_VSLIDEUP_MU      __riscv_vslideup_vx_f64m1_mu
+#define FFT_VSLIDEDOWN_MU    __riscv_vslidedown_vx_f64m1_mu
+#define FFT_VLE_IDX          __riscv_vle64_v_u64m1
+#define FFT_VSUXEI_IDX       __riscv_vsuxei64_v_u64m1
+#define FFT_VID              __riscv_vid_v_u64m1
+#define FFT_VAND_IDX         __riscv_vand_vx_u64m1
+#define FFT_VSLL_IDX         __riscv_vsll_vx_u64m1
+#define FFT_VMSNE_IDX        __riscv_vmsne_vx_u64m1_b64
+#define FFT_VMSLTU_IDX       __riscv_vmsltu_vx_u64m1_b64
+#define FFT_VMNOT            __riscv_vmnot_m_b64
+#define FFT_VERIFY_TOL       vverifyDoubleTol
+#define FFT_VINIT_FILL       vinit_fill_f64
+#define FFT_VINIT_AFFINE     vinit_affine_stride_f64
+#endif
+
+// Trace marker (custom-0 opcode 0x0b, funct3=3; see zamlet_mark in zamlet_custom.h).
+// Broadcasts a Marker KInstr to every kamlet, which logs a "marker" event on its
+// kinstr-exec span and discards the instruction. Used to delimit kernel phases in
+// span traces.
 //
 // FFT_MARK(id)  — compile-time constant id (imm field, 12 bits).
 // FFT_MARK_V(id) — runtime integer id (register form).
-#define FFT_MARK(id) __asm__ volatile(".insn i 0x0b, 3, x0, x0, %0" :: "i"(id))
-#define FFT_MARK_V(id) do { \
-    uint64_t _fft_mark_id = (id); \
-    __asm__ volatile(".insn i 0x0b, 3, x0, %0, 0" :: "r"(_fft_mark_id)); \
-} while (0)
+#define FFT_MARK(id)   ZAMLET_MARK_IMM(id)
+#define FFT_MARK_V(id) zamlet_mark(id)
 
 // Marker IDs for FFT kernel phases. Each phase is delimited by one marker
 // at its start; the phase ends when the next start-marker is admitted.
@@ -81,8 +290,22 @@
 // span analysis can be separated.
 #define FFT_MARK_ITER_START_BASE    900
 
-// Compile-time upper bound on VLMAX(e64,m1). Override via -DMAX_VLMAX=. The
-// actual vl is queried at runtime with vsetvli and capped to N/2.
+// Compile-time upper bound on VLMAX(e64,m1), or VLMAX(e32,m1) with FFT_F32.
+// Override via -DMAX_VLMAX=. The actual vl is queried at runtime with vsetvli
+// and capped to N/2. A kernel built for one geometry (ZAMLET_GEOMETRY_HEADER)
+// takes its exact VLMAX, so the per-stage tables are no larger than that
+// geometry needs.
+#ifdef ZAMLET_GEOMETRY_HEADER
+#include ZAMLET_GEOMETRY_HEADER
+#ifdef MAX_VLMAX
+#error "MAX_VLMAX comes from ZAMLET_GEOMETRY_HEADER; do not also pass -DMAX_VLMAX"
+#endif
+#if FFT_F32
+#define MAX_VLMAX ZAMLET_VLMAX_E32M1
+#else
+#define MAX_VLMAX ZAMLET_VLMAX_E64M1
+#endif
+#endif
 #ifndef MAX_VLMAX
 #define MAX_VLMAX 64
 #endif
@@ -91,6 +314,21 @@
 #define MAX_R      8
 #define MAX_LOG2R  3
 
+// Butterfly radix for Regimes B and C. 2 runs every stage as radix-2 pairs
+// (rb_pair). 4 fuses the first two stages of each Regime B chunk and of each
+// Regime C pass into one radix-4 unit (rb_quad): 3 complex multiplies per
+// 4 registers instead of 4, and the upper stage of the fused pair only needs
+// the a < 2^s half of its base_tw scalars. Odd leftovers stay radix-2.
+#ifndef REGIME_BC_RADIX
+#define REGIME_BC_RADIX 2
+#endif
+#if REGIME_BC_RADIX != 2 && REGIME_BC_RADIX != 4
+#error "REGIME_BC_RADIX must be 2 or 4"
+#endif
+#if FFT_PIPELINED && REGIME_BC_RADIX == 4
+#error "FFT_PIPELINED has no vregs left for the radix-4 core's temporaries"
+#endif
+
 // Number of Regime C passes. Regime C always runs at R = 8 (super-chunk of 8
 // registers), so each pass covers log2(8) = 3 FFT stages at pair-distances
 // ≥ chunk_size = 8·vl. log2(chunk_size) = log2(vl) + 3, so remaining stages
@@ -106,29 +344,106 @@
 #define REGIME_C_MAX_SCALARS \
     (REGIME_C_N_PASSES == 0 ? 1 : (1 << (3 * REGIME_C_N_PASSES + 2)))
 
-void compute_indices(size_t n, size_t vl, uint32_t* read_idx, uint32_t* write_idx,
-                     int reverse_bits);
+// On-the-fly twiddles. The default keeps one vl-length table per Regime A
+// stage and per Regime C sub-stage, O(log2N·vl) of VPU memory in total.
+// FFT_OTF_TWIDDLES=1 keeps O(vl) instead:
+//   - Regime A: stage s is derived from stage s+1 by an elementwise complex
+//     square, negating lanes with bit s of the lane index set
+//     (ω_4d^(2m) = ω_2d^m, and ω_2d^(d+q) = -ω_2d^q). Each squaring doubles
+//     the relative error, so the chain restarts from an exactly built anchor
+//     every FFT_OTF_RESEED stages: at most FFT_OTF_RESEED-1 squarings, i.e.
+//     an error bound of 2^(FFT_OTF_RESEED-1) ulp on top of the anchor's.
+//   - Regime C: each pass rebuilds its seeds from seed_block with
+//     build_seed_v (O(log2 vl) ops per seed, once per pass).
+//   - Regime B keeps its MAX_LOG2R seed vectors, already O(vl).
+// Pair with a --k 1 header so seed_block shrinks to log2N scalars per plane.
+#ifndef FFT_OTF_RESEED
+#define FFT_OTF_RESEED 4
+#endif
+#if FFT_OTF_RESEED < 1
+#error "FFT_OTF_RESEED must be at least 1"
+#endif
+#define MAX_LOG2_VLMAX \
+    (MAX_VLMAX >= 1024 ? 10 : MAX_VLMAX >= 512 ? 9 : MAX_VLMAX >= 256 ? 8 : \
+     MAX_VLMAX >= 128 ? 7 : MAX_VLMAX >= 64 ? 6 : MAX_VLMAX >= 32 ? 5 : \
+     MAX_VLMAX >= 16 ? 4 : MAX_VLMAX >= 8 ? 3 : MAX_VLMAX >= 4 ? 2 : 1)
+#define RA_N_ANCHORS ((MAX_LOG2_VLMAX + FFT_OTF_RESEED - 1) / FFT_OTF_RESEED)
+
+void compute_indices64(size_t n, size_t vl, uint64_t* read_idx, uint64_t* write_idx,
+                       int reverse_bits);
 void bitreverse_reorder64(size_t n, const int64_t* src, int64_t* dst,
                           const uint64_t* read_idx, const uint64_t* write_idx);
 
-// Bitreverse indices (filled in at startup by compute_indices).
-uint32_t br_read_idx32[N]  __attribute__((section(".data.vpu32")));
-uint32_t br_write_idx32[N] __attribute__((section(".data.vpu32")));
-uint64_t br_read_idx[N]    __attribute__((section(".data.vpu64")));
-uint64_t br_write_idx[N]   __attribute__((section(".data.vpu64")));
+// Bitreverse indices, filled in at startup by compute_indices64. A header
+// generated with --br-vl defines br_read_idx, br_write_idx and br_gather_idx
+// with their values for e32 vl = TWIDDLE_BR_VL instead (see init_bitreverse).
+#ifndef TWIDDLE_BR_VL
+uint64_t br_read_idx[N]    __attribute__((section(".bss.vpu64")));
+uint64_t br_write_idx[N]   __attribute__((section(".bss.vpu64")));
+// Fused-load gather offsets: data[j] takes tmp[br_gather_idx[j] / 8]. Built
+// from br_read_idx/br_write_idx by init_gather_idx().
+uint64_t br_gather_idx[N]  __attribute__((section(".bss.vpu64")));
+#endif
 
-// Working data and scratch. Stages ping-pong between these two buffers.
-double data_re[N * N_FFTS] __attribute__((section(".data.vpu64")));
-double data_im[N * N_FFTS] __attribute__((section(".data.vpu64")));
-double tmp_re[N]           __attribute__((section(".data.vpu64")));
-double tmp_im[N]           __attribute__((section(".data.vpu64")));
+// Working data and scratch. Stages ping-pong between these two buffers. Every
+// one of the N_FFTS iterations reuses them from offset 0.
+#if FFT_INTERLEAVED
+// Element k is the pair (x[2k], x[2k + 1]) = (re, im).
+fft_t data_c[2 * N] __attribute__((section(FFT_VPU_SECTION)));
+fft_t tmp_c[2 * N]  __attribute__((section(FFT_VPU_SECTION)));
+#else
+fft_t data_re[N] __attribute__((section(FFT_VPU_SECTION)));
+fft_t data_im[N] __attribute__((section(FFT_VPU_SECTION)));
+fft_t tmp_re[N]  __attribute__((section(FFT_VPU_SECTION)));
+fft_t tmp_im[N]  __attribute__((section(FFT_VPU_SECTION)));
+#endif
+
+#if FFT_CONV
+// Convolution result, written by the second transform of each iteration.
+fft_t conv_out_re[N]      __attribute__((section(FFT_VPU_SECTION)));
+fft_t conv_out_im[N]      __attribute__((section(FFT_VPU_SECTION)));
+#endif
+
+// Buffers for one transform. Chunk loads gather from fft_src (fused) or read
+// fft_buf (unfused); chunk stores and Regime C passes work in place on fft_buf.
+#if FFT_INTERLEAVED
+static const fft_t* fft_src_c = tmp_c;
+static fft_t*       fft_buf_c = data_c;
+#else
+static const fft_t* fft_src_re = tmp_re;
+static const fft_t* fft_src_im = tmp_im;
+static fft_t*       fft_buf_re = data_re;
+static fft_t*       fft_buf_im = data_im;
+#endif
+
+// Epilogue applied by out_store on the transform's final pass, in order:
+// multiply by epi_mul (if non-NULL), conjugate (if epi_conj), scale by
+// epi_scale.
+static const fft_t* epi_mul_re = NULL;
+static const fft_t* epi_mul_im = NULL;
+static int           epi_conj   = 0;
+static fft_t        epi_scale  = 1.0;
+
+#if FFT_REAL
+// Half spectrum of the real input: bins 0..N of the TWIDDLE_REAL_N-point DFT.
+fft_t rfft_re[N + 1]      __attribute__((section(FFT_VPU_SECTION)));
+fft_t rfft_im[N + 1]      __attribute__((section(FFT_VPU_SECTION)));
+#endif
 
+#if FFT_OTF_TWIDDLES
+// Regime A anchors. ra_anchor[i] is the stage-a twiddle vector (see W below)
+// for a = log2_vl - 1 - i·FFT_OTF_RESEED. ra_otf_twiddle derives the stages
+// between anchors in registers.
+static fft_t ra_anchor_re[RA_N_ANCHORS][MAX_VLMAX] __attribute__((section(FFT_VPU_SECTION)));
+static fft_t ra_anchor_im[RA_N_ANCHORS][MAX_VLMAX] __attribute__((section(FFT_VPU_SECTION)));
+#else
 // Regime A tables. W_re/im[s] is the vl-length stage-s twiddle vector for
 // s ∈ [0, log2_vl). Built by tile-replicating the length-d core
 // [1, ω, ..., ω^(d-1)] (d = 2^s, ω = omega[log2N - s - 1]) to length vl.
 // First dim bounded by TWIDDLE_LOG2N (upper bound on any sensible log2_vl).
-static double W_re[TWIDDLE_LOG2N][MAX_VLMAX] __attribute__((section(".data.vpu64")));
-static double W_im[TWIDDLE_LOG2N][MAX_VLMAX] __attribute__((section(".data.vpu64")));
+static fft_t W_re[TWIDDLE_LOG2N][MAX_VLMAX] __attribute__((section(FFT_VPU_SECTION)));
+static fft_t W_im[TWIDDLE_LOG2N][MAX_VLMAX] __attribute__((section(FFT_VPU_SECTION)));
+#endif
 
 // Regime B tables. For stage s ∈ [0, log2(R)), pair-distance d_s = vl · 2^s.
 // seed[s] is a vl-length vector [1, ω_s, ω_s², ..., ω_s^(vl-1)] with
@@ -136,18 +451,22 @@ static double W_im[TWIDDLE_LOG2N][MAX_VLMAX] __attribute__((section(".data.vpu64
 // p ∈ [0, 2^s) — the per-pair scalar applied via vec-scalar multiply.
 // First dim bounded by MAX_LOG2R = 3 (R ≤ 8); second dim of base_tw
 // bounded by MAX_R/2 = 4 (peak scalar count at stage log2_r-1).
-static double seed_re[MAX_LOG2R][MAX_VLMAX] __attribute__((section(".data.vpu64")));
-static double seed_im[MAX_LOG2R][MAX_VLMAX] __attribute__((section(".data.vpu64")));
-static double base_tw_re[MAX_LOG2R][MAX_R / 2];
-static double base_tw_im[MAX_LOG2R][MAX_R / 2];
+static fft_t seed_re[MAX_LOG2R][MAX_VLMAX] __attribute__((section(FFT_VPU_SECTION)));
+static fft_t seed_im[MAX_LOG2R][MAX_VLMAX] __attribute__((section(FFT_VPU_SECTION)));
+static fft_t base_tw_re[MAX_LOG2R][MAX_R / 2];
+static fft_t base_tw_im[MAX_LOG2R][MAX_R / 2];
 
 // Regime C tables. One (seed, base_tw) pair per (pass P, sub-stage s_rel).
 // P_dim is max(1, REGIME_C_N_PASSES) so the arrays are valid when P_max = 0.
+// With FFT_OTF_TWIDDLES the seeds are rebuilt in registers at the start of
+// each pass (c_seed_v) and only the scalar base_tw tables stay resident.
 #define C_P_DIM (REGIME_C_N_PASSES == 0 ? 1 : REGIME_C_N_PASSES)
-static double c_seed_re[C_P_DIM][3][MAX_VLMAX] __attribute__((section(".data.vpu64")));
-static double c_seed_im[C_P_DIM][3][MAX_VLMAX] __attribute__((section(".data.vpu64")));
-static double c_base_tw_re[C_P_DIM][3][REGIME_C_MAX_SCALARS];
-static double c_base_tw_im[C_P_DIM][3][REGIME_C_MAX_SCALARS];
+#if !FFT_OTF_TWIDDLES
+static fft_t c_seed_re[C_P_DIM][3][MAX_VLMAX] __attribute__((section(FFT_VPU_SECTION)));
+static fft_t c_seed_im[C_P_DIM][3][MAX_VLMAX] __attribute__((section(FFT_VPU_SECTION)));
+#endif
+static fft_t c_base_tw_re[C_P_DIM][3][REGIME_C_MAX_SCALARS];
+static fft_t c_base_tw_im[C_P_DIM][3][REGIME_C_MAX_SCALARS];
 
 // Runtime parameters filled by init_tables().
 static int    log2_n;       // log2(N); always equals TWIDDLE_LOG2N.
@@ -162,60 +481,67 @@ static int    n_regime_c;   // Actual number of Regime C passes (≤ REGIME_C_N_
 // Extend a length-cur vector V holding [ω^0, ..., ω^(cur-1)] to length 2·cur
 // by scalar-multiply + slideup. ω = omega[j] is the generator of V.
 // Used by build_seed and build_regime_a_seed.
-static inline void double_seed(vfloat64m1_t* V_re, vfloat64m1_t* V_im,
+static inline void double_seed(vfft_t* V_re, vfft_t* V_im,
                                int j, size_t cur) {
     // ω^cur = omega[j]^(2^log2(cur)) = omega[j + log2(cur)], since
     // omega[m] = ω_N^(2^m).
     int log2_cur = 0;
     for (size_t c = cur; c > 1; c >>= 1) log2_cur++;
-    double s_re = omega_re[j + log2_cur];
-    double s_im = omega_im[j + log2_cur];
-
-    size_t vl = __riscv_vsetvl_e64m1(cur);
-    vfloat64m1_t t_re = __riscv_vfsub_vv_f64m1(
-        __riscv_vfmul_vf_f64m1(*V_re, s_re, vl),
-        __riscv_vfmul_vf_f64m1(*V_im, s_im, vl), vl);
-    vfloat64m1_t t_im = __riscv_vfadd_vv_f64m1(
-        __riscv_vfmul_vf_f64m1(*V_re, s_im, vl),
-        __riscv_vfmul_vf_f64m1(*V_im, s_re, vl), vl);
-
-    vl = __riscv_vsetvl_e64m1(cur * 2);
-    *V_re = __riscv_vslideup_vx_f64m1(*V_re, t_re, cur, vl);
-    *V_im = __riscv_vslideup_vx_f64m1(*V_im, t_im, cur, vl);
+    fft_t s_re = omega_re[j + log2_cur];
+    fft_t s_im = omega_im[j + log2_cur];
+
+    size_t vl = FFT_VSETVL(cur);
+    vfft_t t_re = FFT_VFSUB(
+        FFT_VFMUL_VF(*V_re, s_re, vl),
+        FFT_VFMUL_VF(*V_im, s_im, vl), vl);
+    vfft_t t_im = FFT_VFADD(
+        FFT_VFMUL_VF(*V_re, s_im, vl),
+        FFT_VFMUL_VF(*V_im, s_re, vl), vl);
+
+    vl = FFT_VSETVL(cur * 2);
+    *V_re = FFT_VSLIDEUP(*V_re, t_re, cur, vl);
+    *V_im = FFT_VSLIDEUP(*V_im, t_im, cur, vl);
 }
 
 // Load seed_block[j] (a geometric progression of ratio omega[j]) and extend
-// to `len` by scalar-multiply + slideup doublings. Writes the length-`len`
-// result to dest_re/im. `len` must be a power of 2 ≥ 1.
-static inline void build_seed(double* dest_re, double* dest_im,
-                              int j, size_t len) {
+// to `len` by scalar-multiply + slideup doublings, leaving the length-`len`
+// result in registers. `len` must be a power of 2 ≥ 1.
+static inline void build_seed_v(vfft_t* V_re, vfft_t* V_im,
+                                int j, size_t len) {
     size_t cur = (len < SEED_BLOCK_K) ? len : SEED_BLOCK_K;
-    size_t vl = __riscv_vsetvl_e64m1(cur);
-    vfloat64m1_t V_re = __riscv_vle64_v_f64m1(&seed_block_re[j][0], vl);
-    vfloat64m1_t V_im = __riscv_vle64_v_f64m1(&seed_block_im[j][0], vl);
+    size_t vl = FFT_VSETVL(cur);
+    *V_re = FFT_VLE(&seed_block_re[j][0], vl);
+    *V_im = FFT_VLE(&seed_block_im[j][0], vl);
 
     while (cur < len) {
-        double_seed(&V_re, &V_im, j, cur);
+        double_seed(V_re, V_im, j, cur);
         cur *= 2;
     }
+}
+
+// build_seed_v, then store the length-`len` result to dest_re/im.
+static inline void build_seed(fft_t* dest_re, fft_t* dest_im,
+                              int j, size_t len) {
+    vfft_t V_re, V_im;
+    build_seed_v(&V_re, &V_im, j, len);
 
-    vl = __riscv_vsetvl_e64m1(len);
-    __riscv_vse64_v_f64m1(dest_re, V_re, vl);
-    __riscv_vse64_v_f64m1(dest_im, V_im, vl);
+    size_t vl = FFT_VSETVL(len);
+    FFT_VSE(dest_re, V_re, vl);
+    FFT_VSE(dest_im, V_im, vl);
 }
 
 // Build Regime A stage-s twiddle: length-d core [1, ω, ..., ω^(d-1)] with
 // ω = omega[log2N - s - 1], tile-replicated to length vl_val. d = 2^s.
-static inline void build_regime_a_seed(double* dest_re, double* dest_im,
+static inline void build_regime_a_seed(fft_t* dest_re, fft_t* dest_im,
                                        int s, size_t vl_val) {
     size_t d = (size_t)1 << s;
     int j = TWIDDLE_LOG2N - s - 1;
 
     // Load and (if needed) extend up to length d.
     size_t cur = (d < SEED_BLOCK_K) ? d : SEED_BLOCK_K;
-    size_t vl = __riscv_vsetvl_e64m1(cur);
-    vfloat64m1_t V_re = __riscv_vle64_v_f64m1(&seed_block_re[j][0], vl);
-    vfloat64m1_t V_im = __riscv_vle64_v_f64m1(&seed_block_im[j][0], vl);
+    size_t vl = FFT_VSETVL(cur);
+    vfft_t V_re = FFT_VLE(&seed_block_re[j][0], vl);
+    vfft_t V_im = FFT_VLE(&seed_block_im[j][0], vl);
     while (cur < d) {
         double_seed(&V_re, &V_im, j, cur);
         cur *= 2;
@@ -225,20 +551,20 @@ static inline void build_regime_a_seed(double* dest_re, double* dest_im,
     // self-slideup doublings: vslideup(V, V, cur, 2·cur) copies the low cur
     // lanes up to [cur, 2·cur), producing two tiled copies.
     while (cur < vl_val) {
-        vl = __riscv_vsetvl_e64m1(cur * 2);
-        V_re = __riscv_vslideup_vx_f64m1(V_re, V_re, cur, vl);
-        V_im = __riscv_vslideup_vx_f64m1(V_im, V_im, cur, vl);
+        vl = FFT_VSETVL(cur * 2);
+        V_re = FFT_VSLIDEUP(V_re, V_re, cur, vl);
+        V_im = FFT_VSLIDEUP(V_im, V_im, cur, vl);
         cur *= 2;
     }
 
-    vl = __riscv_vsetvl_e64m1(vl_val);
-    __riscv_vse64_v_f64m1(dest_re, V_re, vl);
-    __riscv_vse64_v_f64m1(dest_im, V_im, vl);
+    vl = FFT_VSETVL(vl_val);
+    FFT_VSE(dest_re, V_re, vl);
+    FFT_VSE(dest_im, V_im, vl);
 }
 
 // Fill base_tw[s][p] = ratio^p for p ∈ [0, n). Iterative complex multiply.
-static inline void fill_base_tw(double* tw_re, double* tw_im,
-                                double ratio_re, double ratio_im, int n) {
+static inline void fill_base_tw(fft_t* tw_re, fft_t* tw_im,
+                                fft_t ratio_re, fft_t ratio_im, int n) {
     double a_re = 1.0, a_im = 0.0;
     for (int p = 0; p < n; p++) {
         tw_re[p] = a_re;
@@ -267,81 +593,205 @@ static inline void fill_base_tw(double* tw_re, double* tw_im,
 // Phase A: build H0 and H1 from the input pair (Va, Vb).
 // H0 = low ? Va : slideup(Vb, d)  -> slideup_mu seeded with Va, write where ~low.
 // H1 = low ? slidedown(Va, d) : Vb -> slidedown_mu seeded with Vb, write where low.
-static inline void ra_phase_a(vfloat64m1_t Va_re, vfloat64m1_t Va_im,
-                              vfloat64m1_t Vb_re, vfloat64m1_t Vb_im,
-                              vfloat64m1_t* H0_re, vfloat64m1_t* H0_im,
-                              vfloat64m1_t* H1_re, vfloat64m1_t* H1_im,
-                              size_t d, vbool64_t low_mask, vbool64_t high_mask,
+static inline void ra_phase_a(vfft_t Va_re, vfft_t Va_im,
+                              vfft_t Vb_re, vfft_t Vb_im,
+                              vfft_t* H0_re, vfft_t* H0_im,
+                              vfft_t* H1_re, vfft_t* H1_im,
+                              size_t d, vfft_mask_t low_mask, vfft_mask_t high_mask,
                               size_t vl) {
-    *H0_re = __riscv_vslideup_vx_f64m1_mu(high_mask, Va_re, Vb_re, d, vl);
-    *H0_im = __riscv_vslideup_vx_f64m1_mu(high_mask, Va_im, Vb_im, d, vl);
-    *H1_re = __riscv_vslidedown_vx_f64m1_mu(low_mask, Vb_re, Va_re, d, vl);
-    *H1_im = __riscv_vslidedown_vx_f64m1_mu(low_mask, Vb_im, Va_im, d, vl);
+    *H0_re = FFT_VSLIDEUP_MU(high_mask, Va_re, Vb_re, d, vl);
+    *H0_im = FFT_VSLIDEUP_MU(high_mask, Va_im, Vb_im, d, vl);
+    *H1_re = FFT_VSLIDEDOWN_MU(low_mask, Vb_re, Va_re, d, vl);
+    *H1_im = FFT_VSLIDEDOWN_MU(low_mask, Vb_im, Va_im, d, vl);
 }
 
 // Arithmetic middle: tmp = tw · H1 (complex); H0p = H0 + tmp; H1p = H0 − tmp.
-static inline void ra_arith(vfloat64m1_t tw_re, vfloat64m1_t tw_im,
-                            vfloat64m1_t H0_re, vfloat64m1_t H0_im,
-                            vfloat64m1_t H1_re, vfloat64m1_t H1_im,
-                            vfloat64m1_t* H0p_re, vfloat64m1_t* H0p_im,
-                            vfloat64m1_t* H1p_re, vfloat64m1_t* H1p_im,
+static inline void ra_arith(vfft_t tw_re, vfft_t tw_im,
+                            vfft_t H0_re, vfft_t H0_im,
+                            vfft_t H1_re, vfft_t H1_im,
+                            vfft_t* H0p_re, vfft_t* H0p_im,
+                            vfft_t* H1p_re, vfft_t* H1p_im,
                             size_t vl) {
-    vfloat64m1_t tmp_re = __riscv_vfsub_vv_f64m1(
-        __riscv_vfmul_vv_f64m1(tw_re, H1_re, vl),
-        __riscv_vfmul_vv_f64m1(tw_im, H1_im, vl), vl);
-    vfloat64m1_t tmp_im = __riscv_vfadd_vv_f64m1(
-        __riscv_vfmul_vv_f64m1(tw_re, H1_im, vl),
-        __riscv_vfmul_vv_f64m1(tw_im, H1_re, vl), vl);
-    *H0p_re = __riscv_vfadd_vv_f64m1(H0_re, tmp_re, vl);
-    *H0p_im = __riscv_vfadd_vv_f64m1(H0_im, tmp_im, vl);
-    *H1p_re = __riscv_vfsub_vv_f64m1(H0_re, tmp_re, vl);
-    *H1p_im = __riscv_vfsub_vv_f64m1(H0_im, tmp_im, vl);
+    vfft_t tmp_re = FFT_VFSUB(
+        FFT_VFMUL(tw_re, H1_re, vl),
+        FFT_VFMUL(tw_im, H1_im, vl), vl);
+    vfft_t tmp_im = FFT_VFADD(
+        FFT_VFMUL(tw_re, H1_im, vl),
+        FFT_VFMUL(tw_im, H1_re, vl), vl);
+    *H0p_re = FFT_VFADD(H0_re, tmp_re, vl);
+    *H0p_im = FFT_VFADD(H0_im, tmp_im, vl);
+    *H1p_re = FFT_VFSUB(H0_re, tmp_re, vl);
+    *H1p_im = FFT_VFSUB(H0_im, tmp_im, vl);
 }
 
 // Phase D: pack (H0p, H1p) back into the caller's A, B register pair.
 // A = low ? H0p : slideup(H1p, d)  -> slideup_mu seeded with H0p, write where ~low.
 // B = low ? slidedown(H0p, d) : H1p -> slidedown_mu seeded with H1p, write where low.
-static inline void ra_phase_d(vfloat64m1_t H0p_re, vfloat64m1_t H0p_im,
-                              vfloat64m1_t H1p_re, vfloat64m1_t H1p_im,
-                              vfloat64m1_t* A_re, vfloat64m1_t* A_im,
-                              vfloat64m1_t* B_re, vfloat64m1_t* B_im,
-                              size_t d, vbool64_t low_mask, vbool64_t high_mask,
+static inline void ra_phase_d(vfft_t H0p_re, vfft_t H0p_im,
+                              vfft_t H1p_re, vfft_t H1p_im,
+                              vfft_t* A_re, vfft_t* A_im,
+                              vfft_t* B_re, vfft_t* B_im,
+                              size_t d, vfft_mask_t low_mask, vfft_mask_t high_mask,
                               size_t vl) {
-    *A_re = __riscv_vslideup_vx_f64m1_mu(high_mask, H0p_re, H1p_re, d, vl);
-    *A_im = __riscv_vslideup_vx_f64m1_mu(high_mask, H0p_im, H1p_im, d, vl);
-    *B_re = __riscv_vslidedown_vx_f64m1_mu(low_mask, H1p_re, H0p_re, d, vl);
-    *B_im = __riscv_vslidedown_vx_f64m1_mu(low_mask, H1p_im, H0p_im, d, vl);
+    *A_re = FFT_VSLIDEUP_MU(high_mask, H0p_re, H1p_re, d, vl);
+    *A_im = FFT_VSLIDEUP_MU(high_mask, H0p_im, H1p_im, d, vl);
+    *B_re = FFT_VSLIDEDOWN_MU(low_mask, H1p_re, H0p_re, d, vl);
+    *B_im = FFT_VSLIDEDOWN_MU(low_mask, H1p_im, H0p_im, d, vl);
 }
 
 // Regime B (and Regime C sub-stage) butterfly body for one register pair.
 // W = (b_re + i·b_im) · (seed_re + i·seed_im); tmp = W · B;
 // A' = A + tmp; B' = A − tmp. Caller loads seed vectors once per stage.
-static inline void rb_pair(vfloat64m1_t* A_re, vfloat64m1_t* A_im,
-                           vfloat64m1_t* B_re, vfloat64m1_t* B_im,
-                           double b_re, double b_im,
-                           vfloat64m1_t seed_re_v, vfloat64m1_t seed_im_v,
+static inline void rb_pair(vfft_t* A_re, vfft_t* A_im,
+                           vfft_t* B_re, vfft_t* B_im,
+                           fft_t b_re, fft_t b_im,
+                           vfft_t seed_re_v, vfft_t seed_im_v,
                            size_t vl) {
-    vfloat64m1_t Va_re = *A_re, Va_im = *A_im;
-    vfloat64m1_t Vb_re = *B_re, Vb_im = *B_im;
-
-    vfloat64m1_t W_re = __riscv_vfsub_vv_f64m1(
-        __riscv_vfmul_vf_f64m1(seed_re_v, b_re, vl),
-        __riscv_vfmul_vf_f64m1(seed_im_v, b_im, vl), vl);
-    vfloat64m1_t W_im = __riscv_vfadd_vv_f64m1(
-        __riscv_vfmul_vf_f64m1(seed_im_v, b_re, vl),
-        __riscv_vfmul_vf_f64m1(seed_re_v, b_im, vl), vl);
-
-    vfloat64m1_t tmp_re = __riscv_vfsub_vv_f64m1(
-        __riscv_vfmul_vv_f64m1(W_re, Vb_re, vl),
-        __riscv_vfmul_vv_f64m1(W_im, Vb_im, vl), vl);
-    vfloat64m1_t tmp_im = __riscv_vfadd_vv_f64m1(
-        __riscv_vfmul_vv_f64m1(W_re, Vb_im, vl),
-        __riscv_vfmul_vv_f64m1(W_im, Vb_re, vl), vl);
-
-    *A_re = __riscv_vfadd_vv_f64m1(Va_re, tmp_re, vl);
-    *A_im = __riscv_vfadd_vv_f64m1(Va_im, tmp_im, vl);
-    *B_re = __riscv_vfsub_vv_f64m1(Va_re, tmp_re, vl);
-    *B_im = __riscv_vfsub_vv_f64m1(Va_im, tmp_im, vl);
+    vfft_t Va_re = *A_re, Va_im = *A_im;
+    vfft_t Vb_re = *B_re, Vb_im = *B_im;
+
+    vfft_t W_re = FFT_VFSUB(
+        FFT_VFMUL_VF(seed_re_v, b_re, vl),
+        FFT_VFMUL_VF(seed_im_v, b_im, vl), vl);
+    vfft_t W_im = FFT_VFADD(
+        FFT_VFMUL_VF(seed_im_v, b_re, vl),
+        FFT_VFMUL_VF(seed_re_v, b_im, vl), vl);
+
+    vfft_t tmp_re = FFT_VFSUB(
+        FFT_VFMUL(W_re, Vb_re, vl),
+        FFT_VFMUL(W_im, Vb_im, vl), vl);
+    vfft_t tmp_im = FFT_VFADD(
+        FFT_VFMUL(W_re, Vb_im, vl),
+        FFT_VFMUL(W_im, Vb_re, vl), vl);
+
+    *A_re = FFT_VFADD(Va_re, tmp_re, vl);
+    *A_im = FFT_VFADD(Va_im, tmp_im, vl);
+    *B_re = FFT_VFSUB(Va_re, tmp_re, vl);
+    *B_im = FFT_VFSUB(Va_im, tmp_im, vl);
+}
+
+// Radix-4 unit fusing stages s (pairs (x0,x1), (x2,x3)) and s+1 (pairs
+// (x0,x2), (x1,x3)) at pair position a. With t = stage-(s+1) twiddle at a
+// and w = t² the stage-s twiddle at a, the stage-(s+1) twiddle at a + 2^s is
+// ω_4·t = −i·t, giving
+//   b = w·x1, c = t·x2, e = t·w·x3
+//   x0' = (x0 + b) + (c + e)        x2' = (x0 + b) − (c + e)
+//   x1' = (x0 − b) − i·(c − e)      x3' = (x0 − b) + i·(c − e)
+// w and t are built as base_tw scalar · seed vector, like rb_pair's W.
+static inline void cmul_vf(vfft_t a_re, vfft_t a_im, fft_t b_re, fft_t b_im,
+                           vfft_t* r_re, vfft_t* r_im, size_t vl) {
+    *r_re = FFT_VFSUB(
+        FFT_VFMUL_VF(a_re, b_re, vl),
+        FFT_VFMUL_VF(a_im, b_im, vl), vl);
+    *r_im = FFT_VFADD(
+        FFT_VFMUL_VF(a_im, b_re, vl),
+        FFT_VFMUL_VF(a_re, b_im, vl), vl);
+}
+
+static inline void cmul_vv(vfft_t a_re, vfft_t a_im,
+                           vfft_t b_re, vfft_t b_im,
+                           vfft_t* r_re, vfft_t* r_im, size_t vl) {
+    *r_re = FFT_VFSUB(
+        FFT_VFMUL(a_re, b_re, vl),
+        FFT_VFMUL(a_im, b_im, vl), vl);
+    *r_im = FFT_VFADD(
+        FFT_VFMUL(a_re, b_im, vl),
+        FFT_VFMUL(a_im, b_re, vl), vl);
+}
+
+static inline void rb_quad(vfft_t* X0_re, vfft_t* X0_im,
+                           vfft_t* X1_re, vfft_t* X1_im,
+                           vfft_t* X2_re, vfft_t* X2_im,
+                           vfft_t* X3_re, vfft_t* X3_im,
+                           fft_t bw_re, fft_t bw_im,
+                           vfft_t seed_w_re, vfft_t seed_w_im,
+                           fft_t bt_re, fft_t bt_im,
+                           vfft_t seed_t_re, vfft_t seed_t_im,
+                           size_t vl) {
+    vfft_t w_re, w_im, t_re, t_im, t3_re, t3_im;
+    cmul_vf(seed_w_re, seed_w_im, bw_re, bw_im, &w_re, &w_im, vl);
+    cmul_vf(seed_t_re, seed_t_im, bt_re, bt_im, &t_re, &t_im, vl);
+    cmul_vv(t_re, t_im, w_re, w_im, &t3_re, &t3_im, vl);
+
+    vfft_t b_re, b_im, c_re, c_im, e_re, e_im;
+    cmul_vv(w_re, w_im, *X1_re, *X1_im, &b_re, &b_im, vl);
+    cmul_vv(t_re, t_im, *X2_re, *X2_im, &c_re, &c_im, vl);
+    cmul_vv(t3_re, t3_im, *X3_re, *X3_im, &e_re, &e_im, vl);
+
+    vfft_t abp_re = FFT_VFADD(*X0_re, b_re, vl);
+    vfft_t abp_im = FFT_VFADD(*X0_im, b_im, vl);
+    vfft_t abm_re = FFT_VFSUB(*X0_re, b_re, vl);
+    vfft_t abm_im = FFT_VFSUB(*X0_im, b_im, vl);
+    vfft_t cep_re = FFT_VFADD(c_re, e_re, vl);
+    vfft_t cep_im = FFT_VFADD(c_im, e_im, vl);
+    vfft_t cem_re = FFT_VFSUB(c_re, e_re, vl);
+    vfft_t cem_im = FFT_VFSUB(c_im, e_im, vl);
+
+    *X0_re = FFT_VFADD(abp_re, cep_re, vl);
+    *X0_im = FFT_VFADD(abp_im, cep_im, vl);
+    *X2_re = FFT_VFSUB(abp_re, cep_re, vl);
+    *X2_im = FFT_VFSUB(abp_im, cep_im, vl);
+    *X1_re = FFT_VFADD(abm_re, cem_im, vl);
+    *X1_im = FFT_VFSUB(abm_im, cem_re, vl);
+    *X3_re = FFT_VFSUB(abm_re, cem_im, vl);
+    *X3_im = FFT_VFADD(abm_im, cem_re, vl);
+}
+
+// Load one vl-length complex register from fft_buf at element offset `off`.
+static inline void buf_load(size_t off, size_t vl,
+                            vfft_t* V_re, vfft_t* V_im) {
+#if FFT_INTERLEAVED
+    vfft2_t V = FFT_VLSEG2(&fft_buf_c[2 * off], vl);
+    *V_re = FFT_VGET(V, 0);
+    *V_im = FFT_VGET(V, 1);
+#else
+    *V_re = FFT_VLE(&fft_buf_re[off], vl);
+    *V_im = FFT_VLE(&fft_buf_im[off], vl);
+#endif
+}
+
+// Store one vl-length complex register to fft_buf at element offset `off`.
+static inline void buf_store(size_t off, size_t vl,
+                             vfft_t V_re, vfft_t V_im) {
+#if FFT_INTERLEAVED
+    FFT_VSSEG2(&fft_buf_c[2 * off],
+                                FFT_VCREATE(V_re, V_im), vl);
+#else
+    FFT_VSE(&fft_buf_re[off], V_re, vl);
+    FFT_VSE(&fft_buf_im[off], V_im, vl);
+#endif
+}
+
+// Store one vl-length complex register to fft_buf at offset `off`. `last` is
+// set on the transform's final pass, where the epilogue is applied first.
+static inline void out_store(size_t off, size_t vl,
+                             vfft_t V_re, vfft_t V_im, int last) {
+    if (last) {
+        if (epi_mul_re != NULL) {
+            vfft_t H_re = FFT_VLE(&epi_mul_re[off], vl);
+            vfft_t H_im = FFT_VLE(&epi_mul_im[off], vl);
+            cmul_vv(V_re, V_im, H_re, H_im, &V_re, &V_im, vl);
+        }
+        if (epi_conj) {
+            V_im = FFT_VFNEG(V_im, vl);
+        }
+        if (epi_scale != 1.0) {
+            V_re = FFT_VFMUL_VF(V_re, epi_scale, vl);
+            V_im = FFT_VFMUL_VF(V_im, epi_scale, vl);
+        }
+    }
+    buf_store(off, vl, V_re, V_im);
+}
+
+// Regime C seed vector for (pass P, sub-stage s_rel).
+static inline void c_seed_v(int P, int s_rel, size_t vl,
+                            vfft_t* re, vfft_t* im) {
+#if FFT_OTF_TWIDDLES
+    build_seed_v(re, im, log2_n - log2_vl - 4 - 3 * P - s_rel, vl);
+#else
+    *re = FFT_VLE(&c_seed_re[P][s_rel][0], vl);
+    *im = FFT_VLE(&c_seed_im[P][s_rel][0], vl);
+#endif
 }
 
 // Regime C pass at super_chunk_size = 2 (partial final, 1 sub-stage).
@@ -349,70 +799,77 @@ static inline void rb_pair(vfloat64m1_t* A_re, vfloat64m1_t* A_im,
 // k_c ∈ {0, 1}, runs sub-stage s_rel=0, stores back.
 static void regime_c_pass_R2(int P) {
     size_t vl = vl_val;
+    int last = (P == n_regime_c - 1);
     size_t chunk_size = vl * (size_t)MAX_R;
     size_t D_P = chunk_size << (3 * P);
     size_t chunk_group_span = (size_t)2 * D_P;
     int base_tw_stride = 1 << (3 * (P + 1));
 
-    vfloat64m1_t seed_re_v = __riscv_vle64_v_f64m1(&c_seed_re[P][0][0], vl);
-    vfloat64m1_t seed_im_v = __riscv_vle64_v_f64m1(&c_seed_im[P][0][0], vl);
+    vfft_t seed_re_v, seed_im_v;
+    c_seed_v(P, 0, vl, &seed_re_v, &seed_im_v);
 
     for (size_t G = 0; G < (size_t)N; G += chunk_group_span) {
-        for (int r_pos = 0; r_pos < MAX_R; r_pos++) {
+        for (int r_pos = 0; r_pos < base_tw_stride; r_pos++) {
             size_t off0 = G + (size_t)0 * D_P + (size_t)r_pos * vl;
             size_t off1 = G + (size_t)1 * D_P + (size_t)r_pos * vl;
-            vfloat64m1_t V0_re = __riscv_vle64_v_f64m1(&data_re[off0], vl);
-            vfloat64m1_t V0_im = __riscv_vle64_v_f64m1(&data_im[off0], vl);
-            vfloat64m1_t V1_re = __riscv_vle64_v_f64m1(&data_re[off1], vl);
-            vfloat64m1_t V1_im = __riscv_vle64_v_f64m1(&data_im[off1], vl);
+            vfft_t V0_re, V0_im;
+            buf_load(off0, vl, &V0_re, &V0_im);
+            vfft_t V1_re, V1_im;
+            buf_load(off1, vl, &V1_re, &V1_im);
 
             // s_rel=0: 1 pair (V0, V1), a=0.
-            double b0_re = c_base_tw_re[P][0][r_pos];
-            double b0_im = c_base_tw_im[P][0][r_pos];
+            fft_t b0_re = c_base_tw_re[P][0][r_pos];
+            fft_t b0_im = c_base_tw_im[P][0][r_pos];
             rb_pair(&V0_re, &V0_im, &V1_re, &V1_im,
                     b0_re, b0_im, seed_re_v, seed_im_v, vl);
 
-            __riscv_vse64_v_f64m1(&data_re[off0], V0_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off0], V0_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off1], V1_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off1], V1_im, vl);
+            out_store(off0, vl, V0_re, V0_im, last);
+            out_store(off1, vl, V1_re, V1_im, last);
         }
     }
-    (void)base_tw_stride;
 }
 
 // Regime C pass at super_chunk_size = 4 (2 sub-stages).
 static void regime_c_pass_R4(int P) {
     size_t vl = vl_val;
+    int last = (P == n_regime_c - 1);
     size_t chunk_size = vl * (size_t)MAX_R;
     size_t D_P = chunk_size << (3 * P);
     size_t chunk_group_span = (size_t)4 * D_P;
     int base_tw_stride = 1 << (3 * (P + 1));
 
-    vfloat64m1_t seed_re_0 = __riscv_vle64_v_f64m1(&c_seed_re[P][0][0], vl);
-    vfloat64m1_t seed_im_0 = __riscv_vle64_v_f64m1(&c_seed_im[P][0][0], vl);
-    vfloat64m1_t seed_re_1 = __riscv_vle64_v_f64m1(&c_seed_re[P][1][0], vl);
-    vfloat64m1_t seed_im_1 = __riscv_vle64_v_f64m1(&c_seed_im[P][1][0], vl);
+    vfft_t seed_re_0, seed_im_0;
+    c_seed_v(P, 0, vl, &seed_re_0, &seed_im_0);
+    vfft_t seed_re_1, seed_im_1;
+    c_seed_v(P, 1, vl, &seed_re_1, &seed_im_1);
 
     for (size_t G = 0; G < (size_t)N; G += chunk_group_span) {
-        for (int r_pos = 0; r_pos < MAX_R; r_pos++) {
+        for (int r_pos = 0; r_pos < base_tw_stride; r_pos++) {
             size_t off0 = G + (size_t)0 * D_P + (size_t)r_pos * vl;
             size_t off1 = G + (size_t)1 * D_P + (size_t)r_pos * vl;
             size_t off2 = G + (size_t)2 * D_P + (size_t)r_pos * vl;
             size_t off3 = G + (size_t)3 * D_P + (size_t)r_pos * vl;
-            vfloat64m1_t V0_re = __riscv_vle64_v_f64m1(&data_re[off0], vl);
-            vfloat64m1_t V0_im = __riscv_vle64_v_f64m1(&data_im[off0], vl);
-            vfloat64m1_t V1_re = __riscv_vle64_v_f64m1(&data_re[off1], vl);
-            vfloat64m1_t V1_im = __riscv_vle64_v_f64m1(&data_im[off1], vl);
-            vfloat64m1_t V2_re = __riscv_vle64_v_f64m1(&data_re[off2], vl);
-            vfloat64m1_t V2_im = __riscv_vle64_v_f64m1(&data_im[off2], vl);
-            vfloat64m1_t V3_re = __riscv_vle64_v_f64m1(&data_re[off3], vl);
-            vfloat64m1_t V3_im = __riscv_vle64_v_f64m1(&data_im[off3], vl);
-
+            vfft_t V0_re, V0_im;
+            buf_load(off0, vl, &V0_re, &V0_im);
+            vfft_t V1_re, V1_im;
+            buf_load(off1, vl, &V1_re, &V1_im);
+            vfft_t V2_re, V2_im;
+            buf_load(off2, vl, &V2_re, &V2_im);
+            vfft_t V3_re, V3_im;
+            buf_load(off3, vl, &V3_re, &V3_im);
+
+#if REGIME_BC_RADIX == 4
+            // s_rel=0,1 fused: one radix-4 unit (V0,V1,V2,V3), a=0.
+            rb_quad(&V0_re, &V0_im, &V1_re, &V1_im, &V2_re, &V2_im, &V3_re, &V3_im,
+                    c_base_tw_re[P][0][r_pos], c_base_tw_im[P][0][r_pos],
+                    seed_re_0, seed_im_0,
+                    c_base_tw_re[P][1][r_pos], c_base_tw_im[P][1][r_pos],
+                    seed_re_1, seed_im_1, vl);
+#else
             // s_rel=0: d_regs=1, pairs (V0,V1), (V2,V3); a=0 for both.
             {
-                double b0_re = c_base_tw_re[P][0][r_pos];
-                double b0_im = c_base_tw_im[P][0][r_pos];
+                fft_t b0_re = c_base_tw_re[P][0][r_pos];
+                fft_t b0_im = c_base_tw_im[P][0][r_pos];
                 rb_pair(&V0_re, &V0_im, &V1_re, &V1_im,
                         b0_re, b0_im, seed_re_0, seed_im_0, vl);
                 rb_pair(&V2_re, &V2_im, &V3_re, &V3_im,
@@ -420,45 +877,123 @@ static void regime_c_pass_R4(int P) {
             }
             // s_rel=1: d_regs=2, 1 group, pairs (V0,V2) a=0, (V1,V3) a=1.
             {
-                double b0_re = c_base_tw_re[P][1][0 * base_tw_stride + r_pos];
-                double b0_im = c_base_tw_im[P][1][0 * base_tw_stride + r_pos];
-                double b1_re = c_base_tw_re[P][1][1 * base_tw_stride + r_pos];
-                double b1_im = c_base_tw_im[P][1][1 * base_tw_stride + r_pos];
+                fft_t b0_re = c_base_tw_re[P][1][0 * base_tw_stride + r_pos];
+                fft_t b0_im = c_base_tw_im[P][1][0 * base_tw_stride + r_pos];
+                fft_t b1_re = c_base_tw_re[P][1][1 * base_tw_stride + r_pos];
+                fft_t b1_im = c_base_tw_im[P][1][1 * base_tw_stride + r_pos];
                 rb_pair(&V0_re, &V0_im, &V2_re, &V2_im,
                         b0_re, b0_im, seed_re_1, seed_im_1, vl);
                 rb_pair(&V1_re, &V1_im, &V3_re, &V3_im,
                         b1_re, b1_im, seed_re_1, seed_im_1, vl);
             }
+#endif
 
-            __riscv_vse64_v_f64m1(&data_re[off0], V0_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off0], V0_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off1], V1_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off1], V1_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off2], V2_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off2], V2_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off3], V3_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off3], V3_im, vl);
+            out_store(off0, vl, V0_re, V0_im, last);
+            out_store(off1, vl, V1_re, V1_im, last);
+            out_store(off2, vl, V2_re, V2_im, last);
+            out_store(off3, vl, V3_re, V3_im, last);
         }
     }
 }
 
+// Regime C butterflies of one 8-register super-chunk at position r_pos within
+// its chunk group: sub-stages s_rel = 0, 1, 2 of pass P.
+static inline void c8_butterflies(int P, int r_pos, int base_tw_stride,
+                                  vfft_t seed_re_0, vfft_t seed_im_0,
+                                  vfft_t seed_re_1, vfft_t seed_im_1,
+                                  vfft_t seed_re_2, vfft_t seed_im_2,
+                                  vfft_t* V0_re, vfft_t* V0_im,
+                                  vfft_t* V1_re, vfft_t* V1_im,
+                                  vfft_t* V2_re, vfft_t* V2_im,
+                                  vfft_t* V3_re, vfft_t* V3_im,
+                                  vfft_t* V4_re, vfft_t* V4_im,
+                                  vfft_t* V5_re, vfft_t* V5_im,
+                                  vfft_t* V6_re, vfft_t* V6_im,
+                                  vfft_t* V7_re, vfft_t* V7_im,
+                                  size_t vl) {
+#if REGIME_BC_RADIX == 4
+    // s_rel=0,1 fused: radix-4 units (0,1,2,3), (4,5,6,7); a=0.
+    {
+        fft_t bw_re = c_base_tw_re[P][0][r_pos];
+        fft_t bw_im = c_base_tw_im[P][0][r_pos];
+        fft_t bt_re = c_base_tw_re[P][1][r_pos];
+        fft_t bt_im = c_base_tw_im[P][1][r_pos];
+        rb_quad(V0_re, V0_im, V1_re, V1_im, V2_re, V2_im, V3_re, V3_im,
+                bw_re, bw_im, seed_re_0, seed_im_0,
+                bt_re, bt_im, seed_re_1, seed_im_1, vl);
+        rb_quad(V4_re, V4_im, V5_re, V5_im, V6_re, V6_im, V7_re, V7_im,
+                bw_re, bw_im, seed_re_0, seed_im_0,
+                bt_re, bt_im, seed_re_1, seed_im_1, vl);
+    }
+#else
+    // s_rel=0: d_regs=1, 4 groups; pairs (0,1),(2,3),(4,5),(6,7); a=0.
+    {
+        fft_t b0_re = c_base_tw_re[P][0][r_pos];
+        fft_t b0_im = c_base_tw_im[P][0][r_pos];
+        rb_pair(V0_re, V0_im, V1_re, V1_im,
+                b0_re, b0_im, seed_re_0, seed_im_0, vl);
+        rb_pair(V2_re, V2_im, V3_re, V3_im,
+                b0_re, b0_im, seed_re_0, seed_im_0, vl);
+        rb_pair(V4_re, V4_im, V5_re, V5_im,
+                b0_re, b0_im, seed_re_0, seed_im_0, vl);
+        rb_pair(V6_re, V6_im, V7_re, V7_im,
+                b0_re, b0_im, seed_re_0, seed_im_0, vl);
+    }
+    // s_rel=1: d_regs=2, 2 groups; pairs (0,2)a=0,(1,3)a=1,(4,6)a=0,(5,7)a=1.
+    {
+        fft_t b0_re = c_base_tw_re[P][1][0 * base_tw_stride + r_pos];
+        fft_t b0_im = c_base_tw_im[P][1][0 * base_tw_stride + r_pos];
+        fft_t b1_re = c_base_tw_re[P][1][1 * base_tw_stride + r_pos];
+        fft_t b1_im = c_base_tw_im[P][1][1 * base_tw_stride + r_pos];
+        rb_pair(V0_re, V0_im, V2_re, V2_im,
+                b0_re, b0_im, seed_re_1, seed_im_1, vl);
+        rb_pair(V1_re, V1_im, V3_re, V3_im,
+                b1_re, b1_im, seed_re_1, seed_im_1, vl);
+        rb_pair(V4_re, V4_im, V6_re, V6_im,
+                b0_re, b0_im, seed_re_1, seed_im_1, vl);
+        rb_pair(V5_re, V5_im, V7_re, V7_im,
+                b1_re, b1_im, seed_re_1, seed_im_1, vl);
+    }
+#endif
+    // s_rel=2: d_regs=4, 1 group; pairs (0,4)a=0,(1,5)a=1,(2,6)a=2,(3,7)a=3.
+    {
+        fft_t b0_re = c_base_tw_re[P][2][0 * base_tw_stride + r_pos];
+        fft_t b0_im = c_base_tw_im[P][2][0 * base_tw_stride + r_pos];
+        fft_t b1_re = c_base_tw_re[P][2][1 * base_tw_stride + r_pos];
+        fft_t b1_im = c_base_tw_im[P][2][1 * base_tw_stride + r_pos];
+        fft_t b2_re = c_base_tw_re[P][2][2 * base_tw_stride + r_pos];
+        fft_t b2_im = c_base_tw_im[P][2][2 * base_tw_stride + r_pos];
+        fft_t b3_re = c_base_tw_re[P][2][3 * base_tw_stride + r_pos];
+        fft_t b3_im = c_base_tw_im[P][2][3 * base_tw_stride + r_pos];
+        rb_pair(V0_re, V0_im, V4_re, V4_im,
+                b0_re, b0_im, seed_re_2, seed_im_2, vl);
+        rb_pair(V1_re, V1_im, V5_re, V5_im,
+                b1_re, b1_im, seed_re_2, seed_im_2, vl);
+        rb_pair(V2_re, V2_im, V6_re, V6_im,
+                b2_re, b2_im, seed_re_2, seed_im_2, vl);
+        rb_pair(V3_re, V3_im, V7_re, V7_im,
+                b3_re, b3_im, seed_re_2, seed_im_2, vl);
+    }
+}
+
 // Regime C pass at super_chunk_size = 8 (full, 3 sub-stages).
 static void regime_c_pass_R8(int P) {
     size_t vl = vl_val;
+    int last = (P == n_regime_c - 1);
     size_t chunk_size = vl * (size_t)MAX_R;
     size_t D_P = chunk_size << (3 * P);
     size_t chunk_group_span = (size_t)8 * D_P;
     int base_tw_stride = 1 << (3 * (P + 1));
 
-    vfloat64m1_t seed_re_0 = __riscv_vle64_v_f64m1(&c_seed_re[P][0][0], vl);
-    vfloat64m1_t seed_im_0 = __riscv_vle64_v_f64m1(&c_seed_im[P][0][0], vl);
-    vfloat64m1_t seed_re_1 = __riscv_vle64_v_f64m1(&c_seed_re[P][1][0], vl);
-    vfloat64m1_t seed_im_1 = __riscv_vle64_v_f64m1(&c_seed_im[P][1][0], vl);
-    vfloat64m1_t seed_re_2 = __riscv_vle64_v_f64m1(&c_seed_re[P][2][0], vl);
-    vfloat64m1_t seed_im_2 = __riscv_vle64_v_f64m1(&c_seed_im[P][2][0], vl);
+    vfft_t seed_re_0, seed_im_0;
+    c_seed_v(P, 0, vl, &seed_re_0, &seed_im_0);
+    vfft_t seed_re_1, seed_im_1;
+    c_seed_v(P, 1, vl, &seed_re_1, &seed_im_1);
+    vfft_t seed_re_2, seed_im_2;
+    c_seed_v(P, 2, vl, &seed_re_2, &seed_im_2);
 
     for (size_t G = 0; G < (size_t)N; G += chunk_group_span) {
-        for (int r_pos = 0; r_pos < MAX_R; r_pos++) {
+        for (int r_pos = 0; r_pos < base_tw_stride; r_pos++) {
             size_t off0 = G + (size_t)0 * D_P + (size_t)r_pos * vl;
             size_t off1 = G + (size_t)1 * D_P + (size_t)r_pos * vl;
             size_t off2 = G + (size_t)2 * D_P + (size_t)r_pos * vl;
@@ -467,90 +1002,123 @@ static void regime_c_pass_R8(int P) {
             size_t off5 = G + (size_t)5 * D_P + (size_t)r_pos * vl;
             size_t off6 = G + (size_t)6 * D_P + (size_t)r_pos * vl;
             size_t off7 = G + (size_t)7 * D_P + (size_t)r_pos * vl;
-            vfloat64m1_t V0_re = __riscv_vle64_v_f64m1(&data_re[off0], vl);
-            vfloat64m1_t V0_im = __riscv_vle64_v_f64m1(&data_im[off0], vl);
-            vfloat64m1_t V1_re = __riscv_vle64_v_f64m1(&data_re[off1], vl);
-            vfloat64m1_t V1_im = __riscv_vle64_v_f64m1(&data_im[off1], vl);
-            vfloat64m1_t V2_re = __riscv_vle64_v_f64m1(&data_re[off2], vl);
-            vfloat64m1_t V2_im = __riscv_vle64_v_f64m1(&data_im[off2], vl);
-            vfloat64m1_t V3_re = __riscv_vle64_v_f64m1(&data_re[off3], vl);
-            vfloat64m1_t V3_im = __riscv_vle64_v_f64m1(&data_im[off3], vl);
-            vfloat64m1_t V4_re = __riscv_vle64_v_f64m1(&data_re[off4], vl);
-            vfloat64m1_t V4_im = __riscv_vle64_v_f64m1(&data_im[off4], vl);
-            vfloat64m1_t V5_re = __riscv_vle64_v_f64m1(&data_re[off5], vl);
-            vfloat64m1_t V5_im = __riscv_vle64_v_f64m1(&data_im[off5], vl);
-            vfloat64m1_t V6_re = __riscv_vle64_v_f64m1(&data_re[off6], vl);
-            vfloat64m1_t V6_im = __riscv_vle64_v_f64m1(&data_im[off6], vl);
-            vfloat64m1_t V7_re = __riscv_vle64_v_f64m1(&data_re[off7], vl);
-            vfloat64m1_t V7_im = __riscv_vle64_v_f64m1(&data_im[off7], vl);
-
-            // s_rel=0: d_regs=1, 4 groups; pairs (0,1),(2,3),(4,5),(6,7); a=0.
-            {
-                double b0_re = c_base_tw_re[P][0][r_pos];
-                double b0_im = c_base_tw_im[P][0][r_pos];
-                rb_pair(&V0_re, &V0_im, &V1_re, &V1_im,
-                        b0_re, b0_im, seed_re_0, seed_im_0, vl);
-                rb_pair(&V2_re, &V2_im, &V3_re, &V3_im,
-                        b0_re, b0_im, seed_re_0, seed_im_0, vl);
-                rb_pair(&V4_re, &V4_im, &V5_re, &V5_im,
-                        b0_re, b0_im, seed_re_0, seed_im_0, vl);
-                rb_pair(&V6_re, &V6_im, &V7_re, &V7_im,
-                        b0_re, b0_im, seed_re_0, seed_im_0, vl);
-            }
-            // s_rel=1: d_regs=2, 2 groups; pairs (0,2)a=0,(1,3)a=1,(4,6)a=0,(5,7)a=1.
-            {
-                double b0_re = c_base_tw_re[P][1][0 * base_tw_stride + r_pos];
-                double b0_im = c_base_tw_im[P][1][0 * base_tw_stride + r_pos];
-                double b1_re = c_base_tw_re[P][1][1 * base_tw_stride + r_pos];
-                double b1_im = c_base_tw_im[P][1][1 * base_tw_stride + r_pos];
-                rb_pair(&V0_re, &V0_im, &V2_re, &V2_im,
-                        b0_re, b0_im, seed_re_1, seed_im_1, vl);
-                rb_pair(&V1_re, &V1_im, &V3_re, &V3_im,
-                        b1_re, b1_im, seed_re_1, seed_im_1, vl);
-                rb_pair(&V4_re, &V4_im, &V6_re, &V6_im,
-                        b0_re, b0_im, seed_re_1, seed_im_1, vl);
-                rb_pair(&V5_re, &V5_im, &V7_re, &V7_im,
-                        b1_re, b1_im, seed_re_1, seed_im_1, vl);
-            }
-            // s_rel=2: d_regs=4, 1 group; pairs (0,4)a=0,(1,5)a=1,(2,6)a=2,(3,7)a=3.
-            {
-                double b0_re = c_base_tw_re[P][2][0 * base_tw_stride + r_pos];
-                double b0_im = c_base_tw_im[P][2][0 * base_tw_stride + r_pos];
-                double b1_re = c_base_tw_re[P][2][1 * base_tw_stride + r_pos];
-                double b1_im = c_base_tw_im[P][2][1 * base_tw_stride + r_pos];
-                double b2_re = c_base_tw_re[P][2][2 * base_tw_stride + r_pos];
-                double b2_im = c_base_tw_im[P][2][2 * base_tw_stride + r_pos];
-                double b3_re = c_base_tw_re[P][2][3 * base_tw_stride + r_pos];
-                double b3_im = c_base_tw_im[P][2][3 * base_tw_stride + r_pos];
-                rb_pair(&V0_re, &V0_im, &V4_re, &V4_im,
-                        b0_re, b0_im, seed_re_2, seed_im_2, vl);
-                rb_pair(&V1_re, &V1_im, &V5_re, &V5_im,
-                        b1_re, b1_im, seed_re_2, seed_im_2, vl);
-                rb_pair(&V2_re, &V2_im, &V6_re, &V6_im,
-                        b2_re, b2_im, seed_re_2, seed_im_2, vl);
-                rb_pair(&V3_re, &V3_im, &V7_re, &V7_im,
-                        b3_re, b3_im, seed_re_2, seed_im_2, vl);
-            }
+            vfft_t V0_re, V0_im;
+            buf_load(off0, vl, &V0_re, &V0_im);
+            vfft_t V1_re, V1_im;
+            buf_load(off1, vl, &V1_re, &V1_im);
+            vfft_t V2_re, V2_im;
+            buf_load(off2, vl, &V2_re, &V2_im);
+            vfft_t V3_re, V3_im;
+            buf_load(off3, vl, &V3_re, &V3_im);
+            vfft_t V4_re, V4_im;
+            buf_load(off4, vl, &V4_re, &V4_im);
+            vfft_t V5_re, V5_im;
+            buf_load(off5, vl, &V5_re, &V5_im);
+            vfft_t V6_re, V6_im;
+            buf_load(off6, vl, &V6_re, &V6_im);
+            vfft_t V7_re, V7_im;
+            buf_load(off7, vl, &V7_re, &V7_im);
+
+            c8_butterflies(P, r_pos, base_tw_stride,
+                           seed_re_0, seed_im_0, seed_re_1, seed_im_1, seed_re_2, seed_im_2,
+                           &V0_re, &V0_im, &V1_re, &V1_im, &V2_re, &V2_im, &V3_re, &V3_im,
+                           &V4_re, &V4_im, &V5_re, &V5_im, &V6_re, &V6_im, &V7_re, &V7_im, vl);
+            out_store(off0, vl, V0_re, V0_im, last);
+            out_store(off1, vl, V1_re, V1_im, last);
+            out_store(off2, vl, V2_re, V2_im, last);
+            out_store(off3, vl, V3_re, V3_im, last);
+            out_store(off4, vl, V4_re, V4_im, last);
+            out_store(off5, vl, V5_re, V5_im, last);
+            out_store(off6, vl, V6_re, V6_im, last);
+            out_store(off7, vl, V7_re, V7_im, last);
+        }
+    }
+}
 
-            __riscv_vse64_v_f64m1(&data_re[off0], V0_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off0], V0_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off1], V1_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off1], V1_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off2], V2_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off2], V2_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off3], V3_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off3], V3_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off4], V4_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off4], V4_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off5], V5_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off5], V5_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off6], V6_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off6], V6_im, vl);
-            __riscv_vse64_v_f64m1(&data_re[off7], V7_re, vl);
-            __riscv_vse64_v_f64m1(&data_im[off7], V7_im, vl);
+#if FFT_PIPELINED
+// regime_c_pass_R8 with the super-chunk loop software-pipelined. Super-chunks
+// are visited in the same (G, r_pos) order, but the loads of the next one's
+// registers 0 and 1 are issued before this one's butterflies and stores, and
+// those of registers 2..7 right after the stores, ahead of the butterflies that need
+// them, so the loads no longer wait behind the previous super-chunk's stores.
+// Only registers 0 and 1 are prefetched. At m1, the 16 vregs in use, the 6 seed
+// vectors, the 4 prefetched vregs and rb_pair's 5 temporaries (W_re, W_im,
+// tmp_re and the two products of tmp_im) come to 31 of the 32, so the loop does
+// not spill. Prefetching registers 0..3 would need 35.
+static void regime_c_pass_R8_pipelined(int P) {
+    size_t vl = vl_val;
+    int last = (P == n_regime_c - 1);
+    size_t chunk_size = vl * (size_t)MAX_R;
+    size_t D_P = chunk_size << (3 * P);
+    size_t chunk_group_span = (size_t)8 * D_P;
+    int base_tw_stride = 1 << (3 * (P + 1));
+    size_t n_super = (size_t)N / chunk_group_span * (size_t)base_tw_stride;
+
+    vfft_t seed_re_0, seed_im_0;
+    c_seed_v(P, 0, vl, &seed_re_0, &seed_im_0);
+    vfft_t seed_re_1, seed_im_1;
+    c_seed_v(P, 1, vl, &seed_re_1, &seed_im_1);
+    vfft_t seed_re_2, seed_im_2;
+    c_seed_v(P, 2, vl, &seed_re_2, &seed_im_2);
+
+    vfft_t V0_re, V0_im;
+    vfft_t V1_re, V1_im;
+    vfft_t V2_re, V2_im;
+    vfft_t V3_re, V3_im;
+    vfft_t V4_re, V4_im;
+    vfft_t V5_re, V5_im;
+    vfft_t V6_re, V6_im;
+    vfft_t V7_re, V7_im;
+    buf_load(0 * D_P, vl, &V0_re, &V0_im);
+    buf_load(1 * D_P, vl, &V1_re, &V1_im);
+    buf_load(2 * D_P, vl, &V2_re, &V2_im);
+    buf_load(3 * D_P, vl, &V3_re, &V3_im);
+    buf_load(4 * D_P, vl, &V4_re, &V4_im);
+    buf_load(5 * D_P, vl, &V5_re, &V5_im);
+    buf_load(6 * D_P, vl, &V6_re, &V6_im);
+    buf_load(7 * D_P, vl, &V7_re, &V7_im);
+
+    for (size_t k = 0; k < n_super; k++) {
+        int r_pos = (int)(k % (size_t)base_tw_stride);
+        size_t base = k / (size_t)base_tw_stride * chunk_group_span + (size_t)r_pos * vl;
+        size_t next = (k + 1) / (size_t)base_tw_stride * chunk_group_span +
+                      (k + 1) % (size_t)base_tw_stride * vl;
+        int more = (k + 1 < n_super);
+        vfft_t N0_re, N0_im, N1_re, N1_im;
+        if (more) {
+            buf_load(next + 0 * D_P, vl, &N0_re, &N0_im);
+            buf_load(next + 1 * D_P, vl, &N1_re, &N1_im);
+        }
+
+        c8_butterflies(P, r_pos, base_tw_stride,
+                       seed_re_0, seed_im_0, seed_re_1, seed_im_1, seed_re_2, seed_im_2,
+                       &V0_re, &V0_im, &V1_re, &V1_im, &V2_re, &V2_im, &V3_re, &V3_im,
+                       &V4_re, &V4_im, &V5_re, &V5_im, &V6_re, &V6_im, &V7_re, &V7_im, vl);
+
+        out_store(base + 0 * D_P, vl, V0_re, V0_im, last);
+        out_store(base + 1 * D_P, vl, V1_re, V1_im, last);
+        out_store(base + 2 * D_P, vl, V2_re, V2_im, last);
+        out_store(base + 3 * D_P, vl, V3_re, V3_im, last);
+        out_store(base + 4 * D_P, vl, V4_re, V4_im, last);
+        out_store(base + 5 * D_P, vl, V5_re, V5_im, last);
+        out_store(base + 6 * D_P, vl, V6_re, V6_im, last);
+        out_store(base + 7 * D_P, vl, V7_re, V7_im, last);
+
+        if (more) {
+            V0_re = N0_re;
+            V0_im = N0_im;
+            V1_re = N1_re;
+            V1_im = N1_im;
+            buf_load(next + 2 * D_P, vl, &V2_re, &V2_im);
+            buf_load(next + 3 * D_P, vl, &V3_re, &V3_im);
+            buf_load(next + 4 * D_P, vl, &V4_re, &V4_im);
+            buf_load(next + 5 * D_P, vl, &V5_re, &V5_im);
+            buf_load(next + 6 * D_P, vl, &V6_re, &V6_im);
+            buf_load(next + 7 * D_P, vl, &V7_re, &V7_im);
         }
     }
 }
+#endif
 
 // Dispatching wrapper. n_sub_stages is implicit in super_chunk_size
 // (super_chunk_size = 2^n_sub_stages), so the specialized passes don't need it.
@@ -559,7 +1127,11 @@ static void regime_c_pass(int P, int super_chunk_size, int n_sub_stages) {
     switch (super_chunk_size) {
         case 2: regime_c_pass_R2(P); break;
         case 4: regime_c_pass_R4(P); break;
+#if FFT_PIPELINED
+        case 8: regime_c_pass_R8_pipelined(P); break;
+#else
         case 8: regime_c_pass_R8(P); break;
+#endif
         default: __builtin_unreachable();
     }
 }
@@ -567,13 +1139,22 @@ static void regime_c_pass(int P, int super_chunk_size, int n_sub_stages) {
 static void init_tables(void) {
     log2_n = TWIDDLE_LOG2N;
 
-    // Query hardware VLMAX at e64,m1 (AVL > 2·VLMAX forces vl = VLMAX), then
+    // Query hardware VLMAX at the element width, m1 (AVL > 2·VLMAX forces vl = VLMAX), then
     // cap to N/2: the chunk structure needs at least one register pair per
     // butterfly, i.e. 2·vl elements of data.
-    size_t hw_vlmax = __riscv_vsetvl_e64m1((size_t)1 << 30);
+#ifdef ZAMLET_GEOMETRY_HEADER
+    size_t hw_vlmax = MAX_VLMAX;
+    if (FFT_VSETVLMAX() != hw_vlmax) {
+        printf("FAIL: built for %s (VLMAX %d) but hardware VLMAX is %zu\n",
+               ZAMLET_GEOMETRY_NAME, MAX_VLMAX, FFT_VSETVLMAX());
+        exit(1);
+    }
+#else
+    size_t hw_vlmax = FFT_VSETVL((size_t)1 << 30);
+#endif
     vl_val = hw_vlmax < (size_t)(N / 2) ? hw_vlmax : (size_t)(N / 2);
     // Re-issue vsetvli so subsequent ops use the capped length.
-    (void)__riscv_vsetvl_e64m1(vl_val);
+    (void)FFT_VSETVL(vl_val);
 
     log2_vl = 0;
     for (size_t v = vl_val; v > 1; v >>= 1) log2_vl++;
@@ -584,10 +1165,19 @@ static void init_tables(void) {
     log2_r = 0;
     for (int r = r_val; r > 1; r >>= 1) log2_r++;
 
+#if FFT_OTF_TWIDDLES
+    // Regime A: anchors at stages log2_vl - 1, log2_vl - 1 - FFT_OTF_RESEED, ...
+    for (int i = 0; i < RA_N_ANCHORS; i++) {
+        int a = log2_vl - 1 - i * FFT_OTF_RESEED;
+        if (a < 0) break;
+        build_regime_a_seed(&ra_anchor_re[i][0], &ra_anchor_im[i][0], a, vl_val);
+    }
+#else
     // Regime A: per-stage vl-length twiddle vector W[s], s ∈ [0, log2_vl).
     for (int s = 0; s < log2_vl; s++) {
         build_regime_a_seed(&W_re[s][0], &W_im[s][0], s, vl_val);
     }
+#endif
 
     // Regime B: per-stage seed[s] and base_tw[s][p] for s ∈ [0, log2_r).
     // seed ratio ω_s = omega[log2N - log2_vl - s - 1]; per-pair scalar
@@ -598,8 +1188,13 @@ static void init_tables(void) {
         build_seed(&seed_re[s][0], &seed_im[s][0], j_seed, vl_val);
 
         int j_base = log2_n - s - 1;
+        int n_p = 1 << s;
+#if REGIME_BC_RADIX == 4
+        // Stage 1 is the upper half of the fused radix-4 unit: a = 0 only.
+        if (s == 1) n_p = 1;
+#endif
         fill_base_tw(&base_tw_re[s][0], &base_tw_im[s][0],
-                     omega_re[j_base], omega_im[j_base], 1 << s);
+                     omega_re[j_base], omega_im[j_base], n_p);
     }
 
     // Regime C: fires only when R = 8 and chunk_size = 8·vl < N. Count passes
@@ -613,57 +1208,142 @@ static void init_tables(void) {
         for (int s_rel = 0; s_rel < 3; s_rel++) {
             int j_seed = log2_n - log2_vl - 4 - 3 * P - s_rel;
             if (j_seed < 0) break;  // partial final pass — fewer sub-stages.
+#if !FFT_OTF_TWIDDLES
             build_seed(&c_seed_re[P][s_rel][0], &c_seed_im[P][s_rel][0],
                        j_seed, vl_val);
+#endif
 
             // c_base_tw[P][s_rel][p_lin] = ω_s^(p_lin · vl), where
             // ω_s = omega[j_seed]. Step = ω_s^vl = omega[j_seed + log2_vl].
             // Count: D_P · 2^{s_rel} / vl = 8^(P+1) · 2^{s_rel}.
             int j_base = j_seed + log2_vl;
             int n_p = 1 << (3 * (P + 1) + s_rel);
+#if REGIME_BC_RADIX == 4
+            // s_rel = 1 is the upper half of the fused radix-4 unit, which
+            // only reads the a = 0 block of base_tw_stride scalars.
+            if (s_rel == 1) n_p >>= 1;
+#endif
             fill_base_tw(&c_base_tw_re[P][s_rel][0], &c_base_tw_im[P][s_rel][0],
                          omega_re[j_base], omega_im[j_base], n_p);
         }
     }
 }
 
+#if FFT_OTF_TWIDDLES
+// Regime A stage-s twiddle from the nearest anchor at or above s. idx is
+// vid(vl).
+static inline void ra_otf_twiddle(int s, size_t vl, vfft_idx_t idx,
+                                  vfft_t* re, vfft_t* im) {
+    int i = (log2_vl - 1 - s) / FFT_OTF_RESEED;
+    int a = log2_vl - 1 - i * FFT_OTF_RESEED;
+    vfft_t V_re = FFT_VLE(&ra_anchor_re[i][0], vl);
+    vfft_t V_im = FFT_VLE(&ra_anchor_im[i][0], vl);
+    for (int t = a - 1; t >= s; t--) {
+        vfft_t sq_re = FFT_VFSUB(
+            FFT_VFMUL(V_re, V_re, vl),
+            FFT_VFMUL(V_im, V_im, vl), vl);
+        vfft_t sq_im = FFT_VFMUL_VF(
+            FFT_VFMUL(V_re, V_im, vl), 2.0, vl);
+        vfft_idx_t bit = FFT_VAND_IDX(idx, (fft_idx_t)1 << t, vl);
+        vfft_mask_t neg = FFT_VMSNE_IDX(bit, 0, vl);
+        V_re = FFT_VFNEG_MU(neg, sq_re, sq_re, vl);
+        V_im = FFT_VFNEG_MU(neg, sq_im, sq_im, vl);
+    }
+    *re = V_re;
+    *im = V_im;
+}
+#endif
+
 // Helper: build Regime A per-stage (d, low_mask, high_mask, tw) setup.
 // high_mask is the bitwise inverse of low_mask, used by the _mu-form slides
 // to fuse the old slide+vmerge pairs in ra_phase_a / ra_phase_d.
 static inline void ra_setup(int s, size_t vl,
                             size_t* d_out,
-                            vbool64_t* low_mask_out, vbool64_t* high_mask_out,
-                            vfloat64m1_t* tw_re_out, vfloat64m1_t* tw_im_out) {
+                            vfft_mask_t* low_mask_out, vfft_mask_t* high_mask_out,
+                            vfft_t* tw_re_out, vfft_t* tw_im_out) {
     *d_out = (size_t)1 << s;
-    vuint64m1_t idx = __riscv_vid_v_u64m1(vl);
-    vuint64m1_t idx_mod = __riscv_vand_vx_u64m1(idx, (uint64_t)(2 * *d_out - 1), vl);
-    *low_mask_out = __riscv_vmsltu_vx_u64m1_b64(idx_mod, (uint64_t)*d_out, vl);
-    *high_mask_out = __riscv_vmnot_m_b64(*low_mask_out, vl);
-    *tw_re_out = __riscv_vle64_v_f64m1(&W_re[s][0], vl);
-    *tw_im_out = __riscv_vle64_v_f64m1(&W_im[s][0], vl);
+    vfft_idx_t idx = FFT_VID(vl);
+    vfft_idx_t idx_mod = FFT_VAND_IDX(idx, (fft_idx_t)(2 * *d_out - 1), vl);
+    *low_mask_out = FFT_VMSLTU_IDX(idx_mod, (fft_idx_t)*d_out, vl);
+    *high_mask_out = FFT_VMNOT(*low_mask_out, vl);
+#if FFT_OTF_TWIDDLES
+    ra_otf_twiddle(s, vl, idx, tw_re_out, tw_im_out);
+#else
+    *tw_re_out = FFT_VLE(&W_re[s][0], vl);
+    *tw_im_out = FFT_VLE(&W_im[s][0], vl);
+#endif
+}
+
+// Smallest index bound covering byte offsets [0, N·8), or [0, N·16) for the
+// pair gathers of the interleaved layout.
+static inline unsigned br_index_bound_bits(void) {
+    return 64 - __builtin_clzl((unsigned long)(N * sizeof(fft_t)) - 1UL) + FFT_INTERLEAVED;
+}
+
+#if !(defined(TWIDDLE_BR_VL) && FFT_FUSED_BITREVERSE)
+// br_gather_idx[write_idx[i] / 8] = read_idx[i]: one scatter of the read
+// offsets to their destination slots. The writes form a permutation, so they
+// share a writeset.
+static void init_gather_idx(void) {
+    zamlet_set_index_bound(br_index_bound_bits());
+    zamlet_begin_writeset();
+    for (size_t i = 0; i < (size_t)N; ) {
+        size_t vl = FFT_VSETVL((size_t)N - i);
+        vfft_idx_t ri = FFT_VLE_IDX(&br_read_idx[i], vl);
+        vfft_idx_t wi = FFT_VLE_IDX(&br_write_idx[i], vl);
+        FFT_VSUXEI_IDX(br_gather_idx, wi, ri, vl);
+        i += vl;
+    }
+    zamlet_end_writeset();
+    zamlet_set_index_bound(0);
+}
+#endif
+
+// Load one vl-length complex register of a chunk starting at data offset
+// `off`. In the fused mode the element for buf[off + lane] is gathered from
+// fft_src at its bit-reversed position; the caller holds the index bound. The
+// re and im gathers share one index vector. Interleaved pairs are 16 bytes,
+// so their offsets are the split-array ones doubled.
+static inline void chunk_load(size_t off, size_t vl,
+                              vfft_t* V_re, vfft_t* V_im) {
+#if FFT_FUSED_BITREVERSE
+    vfft_idx_t idx = FFT_VLE_IDX(&br_gather_idx[off], vl);
+#if FFT_INTERLEAVED
+    vfft2_t V = FFT_VLUXSEG2(
+        fft_src_c, FFT_VSLL_IDX(idx, 1, vl), vl);
+    *V_re = FFT_VGET(V, 0);
+    *V_im = FFT_VGET(V, 1);
+#else
+    *V_re = FFT_VLUXEI(fft_src_re, idx, vl);
+    *V_im = FFT_VLUXEI(fft_src_im, idx, vl);
+#endif
+#else
+    buf_load(off, vl, V_re, V_im);
+#endif
 }
 
 // Run one radix-(2·vl) chunk (R=2). log2_vl Regime A stages, 1 Regime B stage.
 static inline void run_chunk_R2(size_t chunk_base) {
     size_t vl = vl_val;
+    int last = (n_regime_c == 0);
 
-    vfloat64m1_t V0_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 0 * vl], vl);
-    vfloat64m1_t V0_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 0 * vl], vl);
-    vfloat64m1_t V1_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 1 * vl], vl);
-    vfloat64m1_t V1_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 1 * vl], vl);
+    vfft_t V0_re, V0_im;
+    chunk_load(chunk_base + 0 * vl, vl, &V0_re, &V0_im);
+    vfft_t V1_re, V1_im;
+    chunk_load(chunk_base + 1 * vl, vl, &V1_re, &V1_im);
 
     for (int s = 0; s < log2_vl; s++) {
         size_t d;
-        vbool64_t low_mask, high_mask;
-        vfloat64m1_t tw_re, tw_im;
+        vfft_mask_t low_mask, high_mask;
+        vfft_t tw_re, tw_im;
         ra_setup(s, vl, &d, &low_mask, &high_mask, &tw_re, &tw_im);
 
-        vfloat64m1_t p0_H0_re, p0_H0_im, p0_H1_re, p0_H1_im;
+        vfft_t p0_H0_re, p0_H0_im, p0_H1_re, p0_H1_im;
         ra_phase_a(V0_re, V0_im, V1_re, V1_im,
                    &p0_H0_re, &p0_H0_im, &p0_H1_re, &p0_H1_im,
                    d, low_mask, high_mask, vl);
 
-        vfloat64m1_t p0_H0p_re, p0_H0p_im, p0_H1p_re, p0_H1p_im;
+        vfft_t p0_H0p_re, p0_H0p_im, p0_H1p_re, p0_H1p_im;
         ra_arith(tw_re, tw_im, p0_H0_re, p0_H0_im, p0_H1_re, p0_H1_im,
                  &p0_H0p_re, &p0_H0p_im, &p0_H1p_re, &p0_H1p_im, vl);
 
@@ -674,48 +1354,47 @@ static inline void run_chunk_R2(size_t chunk_base) {
 
     // Regime B s=0: pair (V0, V1), a=0.
     {
-        vfloat64m1_t seed_re_v = __riscv_vle64_v_f64m1(&seed_re[0][0], vl);
-        vfloat64m1_t seed_im_v = __riscv_vle64_v_f64m1(&seed_im[0][0], vl);
-        double b0_re = base_tw_re[0][0];
-        double b0_im = base_tw_im[0][0];
+        vfft_t seed_re_v = FFT_VLE(&seed_re[0][0], vl);
+        vfft_t seed_im_v = FFT_VLE(&seed_im[0][0], vl);
+        fft_t b0_re = base_tw_re[0][0];
+        fft_t b0_im = base_tw_im[0][0];
         rb_pair(&V0_re, &V0_im, &V1_re, &V1_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
     }
 
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 0 * vl], V0_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 0 * vl], V0_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 1 * vl], V1_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 1 * vl], V1_im, vl);
+    out_store(chunk_base + 0 * vl, vl, V0_re, V0_im, last);
+    out_store(chunk_base + 1 * vl, vl, V1_re, V1_im, last);
 }
 
 // Run one radix-(4·vl) chunk (R=4). log2_vl Regime A stages, 2 Regime B stages.
 static inline void run_chunk_R4(size_t chunk_base) {
     size_t vl = vl_val;
+    int last = (n_regime_c == 0);
 
     FFT_MARK(FFT_MARK_CHUNK_LOAD_START);
-    vfloat64m1_t V0_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 0 * vl], vl);
-    vfloat64m1_t V0_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 0 * vl], vl);
-    vfloat64m1_t V1_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 1 * vl], vl);
-    vfloat64m1_t V1_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 1 * vl], vl);
-    vfloat64m1_t V2_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 2 * vl], vl);
-    vfloat64m1_t V2_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 2 * vl], vl);
-    vfloat64m1_t V3_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 3 * vl], vl);
-    vfloat64m1_t V3_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 3 * vl], vl);
+    vfft_t V0_re, V0_im;
+    chunk_load(chunk_base + 0 * vl, vl, &V0_re, &V0_im);
+    vfft_t V1_re, V1_im;
+    chunk_load(chunk_base + 1 * vl, vl, &V1_re, &V1_im);
+    vfft_t V2_re, V2_im;
+    chunk_load(chunk_base + 2 * vl, vl, &V2_re, &V2_im);
+    vfft_t V3_re, V3_im;
+    chunk_load(chunk_base + 3 * vl, vl, &V3_re, &V3_im);
 
     for (int s = 0; s < log2_vl; s++) {
         FFT_MARK_V(FFT_MARK_RA_STAGE_START(0) + s);
         size_t d;
-        vbool64_t low_mask, high_mask;
-        vfloat64m1_t tw_re, tw_im;
+        vfft_mask_t low_mask, high_mask;
+        vfft_t tw_re, tw_im;
         ra_setup(s, vl, &d, &low_mask, &high_mask, &tw_re, &tw_im);
 
         // Phase A, arith, and phase D are written as three opaque inline-asm
         // blocks so LLVM cannot interleave arith with the slide-heavy phases.
         // Within each block we control the instruction order exactly.
-        vfloat64m1_t p0_H0_re, p0_H0_im, p0_H1_re, p0_H1_im;
-        vfloat64m1_t p1_H0_re, p1_H0_im, p1_H1_re, p1_H1_im;
+        vfft_t p0_H0_re, p0_H0_im, p0_H1_re, p0_H1_im;
+        vfft_t p1_H0_re, p1_H0_im, p1_H1_re, p1_H1_im;
         __asm__ volatile (
-            "vsetvli zero, %[vl], e64, m1, ta, mu\n\t"
+            "vsetvli zero, %[vl], " FFT_SEW ", m1, ta, mu\n\t"
             "vmv1r.v v0, %[highm]\n\t"
             "vmv.v.v %[p0H0re], %[V0re]\n\t"
             "vslideup.vx %[p0H0re], %[V1re], %[d], v0.t\n\t"
@@ -747,11 +1426,11 @@ static inline void run_chunk_R4(size_t chunk_base) {
             : "v0"
         );
 
-        vfloat64m1_t p0_H0p_re, p0_H0p_im, p0_H1p_re, p0_H1p_im;
-        vfloat64m1_t p1_H0p_re, p1_H0p_im, p1_H1p_re, p1_H1p_im;
-        vfloat64m1_t t_a, t_b, t_c;
+        vfft_t p0_H0p_re, p0_H0p_im, p0_H1p_re, p0_H1p_im;
+        vfft_t p1_H0p_re, p1_H0p_im, p1_H1p_re, p1_H1p_im;
+        vfft_t t_a, t_b, t_c;
         __asm__ volatile (
-            "vsetvli zero, %[vl], e64, m1, ta, ma\n\t"
+            "vsetvli zero, %[vl], " FFT_SEW ", m1, ta, ma\n\t"
             "vfmul.vv %[ta], %[twre], %[p0H1re]\n\t"
             "vfmul.vv %[tb], %[twim], %[p0H1im]\n\t"
             "vfsub.vv %[ta], %[ta], %[tb]\n\t"
@@ -787,7 +1466,7 @@ static inline void run_chunk_R4(size_t chunk_base) {
         (void)t_a; (void)t_b; (void)t_c;
 
         __asm__ volatile (
-            "vsetvli zero, %[vl], e64, m1, ta, mu\n\t"
+            "vsetvli zero, %[vl], " FFT_SEW ", m1, ta, mu\n\t"
             "vmv1r.v v0, %[highm]\n\t"
             "vmv.v.v %[V0re], %[p0H0pre]\n\t"
             "vslideup.vx %[V0re], %[p0H1pre], %[d], v0.t\n\t"
@@ -820,13 +1499,26 @@ static inline void run_chunk_R4(size_t chunk_base) {
         );
     }
 
+#if REGIME_BC_RADIX == 4
+    // Regime B s=0,1 fused: radix-4 unit (V0,V1,V2,V3), a=0.
+    FFT_MARK(FFT_MARK_RB_STAGE_START(0));
+    {
+        vfft_t seed_w_re = FFT_VLE(&seed_re[0][0], vl);
+        vfft_t seed_w_im = FFT_VLE(&seed_im[0][0], vl);
+        vfft_t seed_t_re = FFT_VLE(&seed_re[1][0], vl);
+        vfft_t seed_t_im = FFT_VLE(&seed_im[1][0], vl);
+        rb_quad(&V0_re, &V0_im, &V1_re, &V1_im, &V2_re, &V2_im, &V3_re, &V3_im,
+                base_tw_re[0][0], base_tw_im[0][0], seed_w_re, seed_w_im,
+                base_tw_re[1][0], base_tw_im[1][0], seed_t_re, seed_t_im, vl);
+    }
+#else
     // Regime B s=0: pairs (V0,V1), (V2,V3); a=0 both.
     FFT_MARK(FFT_MARK_RB_STAGE_START(0));
     {
-        vfloat64m1_t seed_re_v = __riscv_vle64_v_f64m1(&seed_re[0][0], vl);
-        vfloat64m1_t seed_im_v = __riscv_vle64_v_f64m1(&seed_im[0][0], vl);
-        double b0_re = base_tw_re[0][0];
-        double b0_im = base_tw_im[0][0];
+        vfft_t seed_re_v = FFT_VLE(&seed_re[0][0], vl);
+        vfft_t seed_im_v = FFT_VLE(&seed_im[0][0], vl);
+        fft_t b0_re = base_tw_re[0][0];
+        fft_t b0_im = base_tw_im[0][0];
         rb_pair(&V0_re, &V0_im, &V1_re, &V1_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
         rb_pair(&V2_re, &V2_im, &V3_re, &V3_im,
@@ -835,83 +1527,68 @@ static inline void run_chunk_R4(size_t chunk_base) {
     // Regime B s=1: pairs (V0,V2) a=0, (V1,V3) a=1.
     FFT_MARK(FFT_MARK_RB_STAGE_START(1));
     {
-        vfloat64m1_t seed_re_v = __riscv_vle64_v_f64m1(&seed_re[1][0], vl);
-        vfloat64m1_t seed_im_v = __riscv_vle64_v_f64m1(&seed_im[1][0], vl);
-        double b0_re = base_tw_re[1][0];
-        double b0_im = base_tw_im[1][0];
-        double b1_re = base_tw_re[1][1];
-        double b1_im = base_tw_im[1][1];
+        vfft_t seed_re_v = FFT_VLE(&seed_re[1][0], vl);
+        vfft_t seed_im_v = FFT_VLE(&seed_im[1][0], vl);
+        fft_t b0_re = base_tw_re[1][0];
+        fft_t b0_im = base_tw_im[1][0];
+        fft_t b1_re = base_tw_re[1][1];
+        fft_t b1_im = base_tw_im[1][1];
         rb_pair(&V0_re, &V0_im, &V2_re, &V2_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
         rb_pair(&V1_re, &V1_im, &V3_re, &V3_im,
                 b1_re, b1_im, seed_re_v, seed_im_v, vl);
     }
+#endif
 
     FFT_MARK(FFT_MARK_CHUNK_STORE_START);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 0 * vl], V0_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 0 * vl], V0_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 1 * vl], V1_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 1 * vl], V1_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 2 * vl], V2_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 2 * vl], V2_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 3 * vl], V3_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 3 * vl], V3_im, vl);
+    out_store(chunk_base + 0 * vl, vl, V0_re, V0_im, last);
+    out_store(chunk_base + 1 * vl, vl, V1_re, V1_im, last);
+    out_store(chunk_base + 2 * vl, vl, V2_re, V2_im, last);
+    out_store(chunk_base + 3 * vl, vl, V3_re, V3_im, last);
     FFT_MARK(FFT_MARK_CHUNK_END);
 }
 
-// Run one radix-(8·vl) chunk (R=8). log2_vl Regime A stages, 3 Regime B stages.
-static inline void run_chunk_R8(size_t chunk_base) {
-    size_t vl = vl_val;
-
-    FFT_MARK(FFT_MARK_CHUNK_LOAD_START);
-    vfloat64m1_t V0_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 0 * vl], vl);
-    vfloat64m1_t V0_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 0 * vl], vl);
-    vfloat64m1_t V1_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 1 * vl], vl);
-    vfloat64m1_t V1_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 1 * vl], vl);
-    vfloat64m1_t V2_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 2 * vl], vl);
-    vfloat64m1_t V2_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 2 * vl], vl);
-    vfloat64m1_t V3_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 3 * vl], vl);
-    vfloat64m1_t V3_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 3 * vl], vl);
-    vfloat64m1_t V4_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 4 * vl], vl);
-    vfloat64m1_t V4_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 4 * vl], vl);
-    vfloat64m1_t V5_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 5 * vl], vl);
-    vfloat64m1_t V5_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 5 * vl], vl);
-    vfloat64m1_t V6_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 6 * vl], vl);
-    vfloat64m1_t V6_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 6 * vl], vl);
-    vfloat64m1_t V7_re = __riscv_vle64_v_f64m1(&data_re[chunk_base + 7 * vl], vl);
-    vfloat64m1_t V7_im = __riscv_vle64_v_f64m1(&data_im[chunk_base + 7 * vl], vl);
-
+// Regime A stages of an R=8 chunk held in V0..V7.
+static inline void chunk_r8_regime_a(vfft_t* V0_re, vfft_t* V0_im,
+                                     vfft_t* V1_re, vfft_t* V1_im,
+                                     vfft_t* V2_re, vfft_t* V2_im,
+                                     vfft_t* V3_re, vfft_t* V3_im,
+                                     vfft_t* V4_re, vfft_t* V4_im,
+                                     vfft_t* V5_re, vfft_t* V5_im,
+                                     vfft_t* V6_re, vfft_t* V6_im,
+                                     vfft_t* V7_re, vfft_t* V7_im,
+                                     size_t vl) {
     for (int s = 0; s < log2_vl; s++) {
         FFT_MARK_V(FFT_MARK_RA_STAGE_START(0) + s);
         size_t d;
-        vbool64_t low_mask, high_mask;
-        vfloat64m1_t tw_re, tw_im;
+        vfft_mask_t low_mask, high_mask;
+        vfft_t tw_re, tw_im;
         ra_setup(s, vl, &d, &low_mask, &high_mask, &tw_re, &tw_im);
 
         // Phase A for all four pairs — slide-heavy, interleaved so the RS can
         // overlap cross-jamlet slide traffic.
-        vfloat64m1_t p0_H0_re, p0_H0_im, p0_H1_re, p0_H1_im;
-        vfloat64m1_t p1_H0_re, p1_H0_im, p1_H1_re, p1_H1_im;
-        vfloat64m1_t p2_H0_re, p2_H0_im, p2_H1_re, p2_H1_im;
-        vfloat64m1_t p3_H0_re, p3_H0_im, p3_H1_re, p3_H1_im;
-        ra_phase_a(V0_re, V0_im, V1_re, V1_im,
+        vfft_t p0_H0_re, p0_H0_im, p0_H1_re, p0_H1_im;
+        vfft_t p1_H0_re, p1_H0_im, p1_H1_re, p1_H1_im;
+        vfft_t p2_H0_re, p2_H0_im, p2_H1_re, p2_H1_im;
+        vfft_t p3_H0_re, p3_H0_im, p3_H1_re, p3_H1_im;
+        ra_phase_a(*V0_re, *V0_im, *V1_re, *V1_im,
                    &p0_H0_re, &p0_H0_im, &p0_H1_re, &p0_H1_im,
                    d, low_mask, high_mask, vl);
-        ra_phase_a(V2_re, V2_im, V3_re, V3_im,
+        ra_phase_a(*V2_re, *V2_im, *V3_re, *V3_im,
                    &p1_H0_re, &p1_H0_im, &p1_H1_re, &p1_H1_im,
                    d, low_mask, high_mask, vl);
-        ra_phase_a(V4_re, V4_im, V5_re, V5_im,
+        ra_phase_a(*V4_re, *V4_im, *V5_re, *V5_im,
                    &p2_H0_re, &p2_H0_im, &p2_H1_re, &p2_H1_im,
                    d, low_mask, high_mask, vl);
-        ra_phase_a(V6_re, V6_im, V7_re, V7_im,
+        ra_phase_a(*V6_re, *V6_im, *V7_re, *V7_im,
                    &p3_H0_re, &p3_H0_im, &p3_H1_re, &p3_H1_im,
                    d, low_mask, high_mask, vl);
 
         // Arithmetic middle for all four pairs.
-        vfloat64m1_t p0_H0p_re, p0_H0p_im, p0_H1p_re, p0_H1p_im;
-        vfloat64m1_t p1_H0p_re, p1_H0p_im, p1_H1p_re, p1_H1p_im;
-        vfloat64m1_t p2_H0p_re, p2_H0p_im, p2_H1p_re, p2_H1p_im;
-        vfloat64m1_t p3_H0p_re, p3_H0p_im, p3_H1p_re, p3_H1p_im;
+        vfft_t p0_H0p_re, p0_H0p_im, p0_H1p_re, p0_H1p_im;
+        vfft_t p1_H0p_re, p1_H0p_im, p1_H1p_re, p1_H1p_im;
+        vfft_t p2_H0p_re, p2_H0p_im, p2_H1p_re, p2_H1p_im;
+        vfft_t p3_H0p_re, p3_H0p_im, p3_H1p_re, p3_H1p_im;
         ra_arith(tw_re, tw_im, p0_H0_re, p0_H0_im, p0_H1_re, p0_H1_im,
                  &p0_H0p_re, &p0_H0p_im, &p0_H1p_re, &p0_H1p_im, vl);
         ra_arith(tw_re, tw_im, p1_H0_re, p1_H0_im, p1_H1_re, p1_H1_im,
@@ -923,93 +1600,144 @@ static inline void run_chunk_R8(size_t chunk_base) {
 
         // Phase D for all four pairs — slide-heavy again, also interleaved.
         ra_phase_d(p0_H0p_re, p0_H0p_im, p0_H1p_re, p0_H1p_im,
-                   &V0_re, &V0_im, &V1_re, &V1_im,
+                   V0_re, V0_im, V1_re, V1_im,
                    d, low_mask, high_mask, vl);
         ra_phase_d(p1_H0p_re, p1_H0p_im, p1_H1p_re, p1_H1p_im,
-                   &V2_re, &V2_im, &V3_re, &V3_im,
+                   V2_re, V2_im, V3_re, V3_im,
                    d, low_mask, high_mask, vl);
         ra_phase_d(p2_H0p_re, p2_H0p_im, p2_H1p_re, p2_H1p_im,
-                   &V4_re, &V4_im, &V5_re, &V5_im,
+                   V4_re, V4_im, V5_re, V5_im,
                    d, low_mask, high_mask, vl);
         ra_phase_d(p3_H0p_re, p3_H0p_im, p3_H1p_re, p3_H1p_im,
-                   &V6_re, &V6_im, &V7_re, &V7_im,
+                   V6_re, V6_im, V7_re, V7_im,
                    d, low_mask, high_mask, vl);
     }
+}
 
+// Regime B stages of an R=8 chunk held in V0..V7.
+static inline void chunk_r8_regime_b(vfft_t* V0_re, vfft_t* V0_im,
+                                     vfft_t* V1_re, vfft_t* V1_im,
+                                     vfft_t* V2_re, vfft_t* V2_im,
+                                     vfft_t* V3_re, vfft_t* V3_im,
+                                     vfft_t* V4_re, vfft_t* V4_im,
+                                     vfft_t* V5_re, vfft_t* V5_im,
+                                     vfft_t* V6_re, vfft_t* V6_im,
+                                     vfft_t* V7_re, vfft_t* V7_im,
+                                     size_t vl) {
+#if REGIME_BC_RADIX == 4
+    // Regime B s=0,1 fused: radix-4 units (0,1,2,3), (4,5,6,7); a=0.
+    FFT_MARK(FFT_MARK_RB_STAGE_START(0));
+    {
+        vfft_t seed_w_re = FFT_VLE(&seed_re[0][0], vl);
+        vfft_t seed_w_im = FFT_VLE(&seed_im[0][0], vl);
+        vfft_t seed_t_re = FFT_VLE(&seed_re[1][0], vl);
+        vfft_t seed_t_im = FFT_VLE(&seed_im[1][0], vl);
+        fft_t bw_re = base_tw_re[0][0];
+        fft_t bw_im = base_tw_im[0][0];
+        fft_t bt_re = base_tw_re[1][0];
+        fft_t bt_im = base_tw_im[1][0];
+        rb_quad(V0_re, V0_im, V1_re, V1_im, V2_re, V2_im, V3_re, V3_im,
+                bw_re, bw_im, seed_w_re, seed_w_im, bt_re, bt_im, seed_t_re, seed_t_im, vl);
+        rb_quad(V4_re, V4_im, V5_re, V5_im, V6_re, V6_im, V7_re, V7_im,
+                bw_re, bw_im, seed_w_re, seed_w_im, bt_re, bt_im, seed_t_re, seed_t_im, vl);
+    }
+#else
     // Regime B s=0: pairs (0,1),(2,3),(4,5),(6,7); a=0 all.
     FFT_MARK(FFT_MARK_RB_STAGE_START(0));
     {
-        vfloat64m1_t seed_re_v = __riscv_vle64_v_f64m1(&seed_re[0][0], vl);
-        vfloat64m1_t seed_im_v = __riscv_vle64_v_f64m1(&seed_im[0][0], vl);
-        double b0_re = base_tw_re[0][0];
-        double b0_im = base_tw_im[0][0];
-        rb_pair(&V0_re, &V0_im, &V1_re, &V1_im,
+        vfft_t seed_re_v = FFT_VLE(&seed_re[0][0], vl);
+        vfft_t seed_im_v = FFT_VLE(&seed_im[0][0], vl);
+        fft_t b0_re = base_tw_re[0][0];
+        fft_t b0_im = base_tw_im[0][0];
+        rb_pair(V0_re, V0_im, V1_re, V1_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
-        rb_pair(&V2_re, &V2_im, &V3_re, &V3_im,
+        rb_pair(V2_re, V2_im, V3_re, V3_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
-        rb_pair(&V4_re, &V4_im, &V5_re, &V5_im,
+        rb_pair(V4_re, V4_im, V5_re, V5_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
-        rb_pair(&V6_re, &V6_im, &V7_re, &V7_im,
+        rb_pair(V6_re, V6_im, V7_re, V7_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
     }
     // Regime B s=1: pairs (0,2)a=0,(1,3)a=1,(4,6)a=0,(5,7)a=1.
     FFT_MARK(FFT_MARK_RB_STAGE_START(1));
     {
-        vfloat64m1_t seed_re_v = __riscv_vle64_v_f64m1(&seed_re[1][0], vl);
-        vfloat64m1_t seed_im_v = __riscv_vle64_v_f64m1(&seed_im[1][0], vl);
-        double b0_re = base_tw_re[1][0];
-        double b0_im = base_tw_im[1][0];
-        double b1_re = base_tw_re[1][1];
-        double b1_im = base_tw_im[1][1];
-        rb_pair(&V0_re, &V0_im, &V2_re, &V2_im,
+        vfft_t seed_re_v = FFT_VLE(&seed_re[1][0], vl);
+        vfft_t seed_im_v = FFT_VLE(&seed_im[1][0], vl);
+        fft_t b0_re = base_tw_re[1][0];
+        fft_t b0_im = base_tw_im[1][0];
+        fft_t b1_re = base_tw_re[1][1];
+        fft_t b1_im = base_tw_im[1][1];
+        rb_pair(V0_re, V0_im, V2_re, V2_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
-        rb_pair(&V1_re, &V1_im, &V3_re, &V3_im,
+        rb_pair(V1_re, V1_im, V3_re, V3_im,
                 b1_re, b1_im, seed_re_v, seed_im_v, vl);
-        rb_pair(&V4_re, &V4_im, &V6_re, &V6_im,
+        rb_pair(V4_re, V4_im, V6_re, V6_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
-        rb_pair(&V5_re, &V5_im, &V7_re, &V7_im,
+        rb_pair(V5_re, V5_im, V7_re, V7_im,
                 b1_re, b1_im, seed_re_v, seed_im_v, vl);
     }
+#endif
     // Regime B s=2: pairs (0,4)a=0,(1,5)a=1,(2,6)a=2,(3,7)a=3.
     FFT_MARK(FFT_MARK_RB_STAGE_START(2));
     {
-        vfloat64m1_t seed_re_v = __riscv_vle64_v_f64m1(&seed_re[2][0], vl);
-        vfloat64m1_t seed_im_v = __riscv_vle64_v_f64m1(&seed_im[2][0], vl);
-        double b0_re = base_tw_re[2][0];
-        double b0_im = base_tw_im[2][0];
-        double b1_re = base_tw_re[2][1];
-        double b1_im = base_tw_im[2][1];
-        double b2_re = base_tw_re[2][2];
-        double b2_im = base_tw_im[2][2];
-        double b3_re = base_tw_re[2][3];
-        double b3_im = base_tw_im[2][3];
-        rb_pair(&V0_re, &V0_im, &V4_re, &V4_im,
+        vfft_t seed_re_v = FFT_VLE(&seed_re[2][0], vl);
+        vfft_t seed_im_v = FFT_VLE(&seed_im[2][0], vl);
+        fft_t b0_re = base_tw_re[2][0];
+        fft_t b0_im = base_tw_im[2][0];
+        fft_t b1_re = base_tw_re[2][1];
+        fft_t b1_im = base_tw_im[2][1];
+        fft_t b2_re = base_tw_re[2][2];
+        fft_t b2_im = base_tw_im[2][2];
+        fft_t b3_re = base_tw_re[2][3];
+        fft_t b3_im = base_tw_im[2][3];
+        rb_pair(V0_re, V0_im, V4_re, V4_im,
                 b0_re, b0_im, seed_re_v, seed_im_v, vl);
-        rb_pair(&V1_re, &V1_im, &V5_re, &V5_im,
+        rb_pair(V1_re, V1_im, V5_re, V5_im,
                 b1_re, b1_im, seed_re_v, seed_im_v, vl);
-        rb_pair(&V2_re, &V2_im, &V6_re, &V6_im,
+        rb_pair(V2_re, V2_im, V6_re, V6_im,
                 b2_re, b2_im, seed_re_v, seed_im_v, vl);
-        rb_pair(&V3_re, &V3_im, &V7_re, &V7_im,
+        rb_pair(V3_re, V3_im, V7_re, V7_im,
                 b3_re, b3_im, seed_re_v, seed_im_v, vl);
     }
+}
+
+// Run one radix-(8·vl) chunk (R=8). log2_vl Regime A stages, 3 Regime B stages.
+static inline void run_chunk_R8(size_t chunk_base) {
+    size_t vl = vl_val;
+    int last = (n_regime_c == 0);
+
+    FFT_MARK(FFT_MARK_CHUNK_LOAD_START);
+    vfft_t V0_re, V0_im;
+    chunk_load(chunk_base + 0 * vl, vl, &V0_re, &V0_im);
+    vfft_t V1_re, V1_im;
+    chunk_load(chunk_base + 1 * vl, vl, &V1_re, &V1_im);
+    vfft_t V2_re, V2_im;
+    chunk_load(chunk_base + 2 * vl, vl, &V2_re, &V2_im);
+    vfft_t V3_re, V3_im;
+    chunk_load(chunk_base + 3 * vl, vl, &V3_re, &V3_im);
+    vfft_t V4_re, V4_im;
+    chunk_load(chunk_base + 4 * vl, vl, &V4_re, &V4_im);
+    vfft_t V5_re, V5_im;
+    chunk_load(chunk_base + 5 * vl, vl, &V5_re, &V5_im);
+    vfft_t V6_re, V6_im;
+    chunk_load(chunk_base + 6 * vl, vl, &V6_re, &V6_im);
+    vfft_t V7_re, V7_im;
+    chunk_load(chunk_base + 7 * vl, vl, &V7_re, &V7_im);
+
+    chunk_r8_regime_a(&V0_re, &V0_im, &V1_re, &V1_im, &V2_re, &V2_im, &V3_re, &V3_im,
+                      &V4_re, &V4_im, &V5_re, &V5_im, &V6_re, &V6_im, &V7_re, &V7_im, vl);
+    chunk_r8_regime_b(&V0_re, &V0_im, &V1_re, &V1_im, &V2_re, &V2_im, &V3_re, &V3_im,
+                      &V4_re, &V4_im, &V5_re, &V5_im, &V6_re, &V6_im, &V7_re, &V7_im, vl);
 
     FFT_MARK(FFT_MARK_CHUNK_STORE_START);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 0 * vl], V0_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 0 * vl], V0_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 1 * vl], V1_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 1 * vl], V1_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 2 * vl], V2_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 2 * vl], V2_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 3 * vl], V3_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 3 * vl], V3_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 4 * vl], V4_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 4 * vl], V4_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 5 * vl], V5_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 5 * vl], V5_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 6 * vl], V6_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 6 * vl], V6_im, vl);
-    __riscv_vse64_v_f64m1(&data_re[chunk_base + 7 * vl], V7_re, vl);
-    __riscv_vse64_v_f64m1(&data_im[chunk_base + 7 * vl], V7_im, vl);
+    out_store(chunk_base + 0 * vl, vl, V0_re, V0_im, last);
+    out_store(chunk_base + 1 * vl, vl, V1_re, V1_im, last);
+    out_store(chunk_base + 2 * vl, vl, V2_re, V2_im, last);
+    out_store(chunk_base + 3 * vl, vl, V3_re, V3_im, last);
+    out_store(chunk_base + 4 * vl, vl, V4_re, V4_im, last);
+    out_store(chunk_base + 5 * vl, vl, V5_re, V5_im, last);
+    out_store(chunk_base + 6 * vl, vl, V6_re, V6_im, last);
+    out_store(chunk_base + 7 * vl, vl, V7_re, V7_im, last);
     FFT_MARK(FFT_MARK_CHUNK_END);
 }
 
@@ -1023,79 +1751,317 @@ static inline void run_chunk(size_t chunk_base) {
     }
 }
 
-int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+#if FFT_PIPELINED
+// The R=8 chunk pass with the chunk loop software-pipelined, on the pattern of
+// regime_c_pass_R8_pipelined: the loads of the next chunk's registers 0 and 1
+// are issued after this chunk's Regime A stages, ahead of its Regime B stages
+// and stores, and those of registers 2..7 right after the stores. Regime B has
+// 2 seed vectors live per stage, so the 16 vregs in use, the 4 prefetched and
+// rb_pair's 5 temporaries come to 27 of the 32. The prefetch waits for Regime A
+// because its slide temporaries leave no room for more vregs.
+static void run_chunks_R8_pipelined(void) {
+    size_t vl = vl_val;
+    int last = (n_regime_c == 0);
+    size_t chunk_size = vl * (size_t)MAX_R;
 
-    // Input: x[i] = i + 0j, matching the expected[] table in the generated
-    // twiddles header. Populate tmp_re/im so bitreverse_reorder64 can write
-    // the bit-reversed layout directly into data_re/im.
-    for (size_t i = 0; i < (size_t)N; i++) {
-        tmp_re[i] = (double)i;
-        tmp_im[i] = 0.0;
+    FFT_MARK(FFT_MARK_CHUNK_LOAD_START);
+    vfft_t V0_re, V0_im;
+    vfft_t V1_re, V1_im;
+    vfft_t V2_re, V2_im;
+    vfft_t V3_re, V3_im;
+    vfft_t V4_re, V4_im;
+    vfft_t V5_re, V5_im;
+    vfft_t V6_re, V6_im;
+    vfft_t V7_re, V7_im;
+    chunk_load(0 * vl, vl, &V0_re, &V0_im);
+    chunk_load(1 * vl, vl, &V1_re, &V1_im);
+    chunk_load(2 * vl, vl, &V2_re, &V2_im);
+    chunk_load(3 * vl, vl, &V3_re, &V3_im);
+    chunk_load(4 * vl, vl, &V4_re, &V4_im);
+    chunk_load(5 * vl, vl, &V5_re, &V5_im);
+    chunk_load(6 * vl, vl, &V6_re, &V6_im);
+    chunk_load(7 * vl, vl, &V7_re, &V7_im);
+
+    for (size_t cb = 0; cb < (size_t)N; cb += chunk_size) {
+        size_t next = cb + chunk_size;
+        int more = (next < (size_t)N);
+        chunk_r8_regime_a(&V0_re, &V0_im, &V1_re, &V1_im, &V2_re, &V2_im, &V3_re, &V3_im,
+                          &V4_re, &V4_im, &V5_re, &V5_im, &V6_re, &V6_im, &V7_re, &V7_im, vl);
+        vfft_t N0_re, N0_im, N1_re, N1_im;
+        if (more) {
+            FFT_MARK(FFT_MARK_CHUNK_LOAD_START);
+            chunk_load(next + 0 * vl, vl, &N0_re, &N0_im);
+            chunk_load(next + 1 * vl, vl, &N1_re, &N1_im);
+        }
+        chunk_r8_regime_b(&V0_re, &V0_im, &V1_re, &V1_im, &V2_re, &V2_im, &V3_re, &V3_im,
+                          &V4_re, &V4_im, &V5_re, &V5_im, &V6_re, &V6_im, &V7_re, &V7_im, vl);
+
+        FFT_MARK(FFT_MARK_CHUNK_STORE_START);
+        out_store(cb + 0 * vl, vl, V0_re, V0_im, last);
+        out_store(cb + 1 * vl, vl, V1_re, V1_im, last);
+        out_store(cb + 2 * vl, vl, V2_re, V2_im, last);
+        out_store(cb + 3 * vl, vl, V3_re, V3_im, last);
+        out_store(cb + 4 * vl, vl, V4_re, V4_im, last);
+        out_store(cb + 5 * vl, vl, V5_re, V5_im, last);
+        out_store(cb + 6 * vl, vl, V6_re, V6_im, last);
+        out_store(cb + 7 * vl, vl, V7_re, V7_im, last);
+        if (more) {
+            V0_re = N0_re;
+            V0_im = N0_im;
+            V1_re = N1_re;
+            V1_im = N1_im;
+            chunk_load(next + 2 * vl, vl, &V2_re, &V2_im);
+            chunk_load(next + 3 * vl, vl, &V3_re, &V3_im);
+            chunk_load(next + 4 * vl, vl, &V4_re, &V4_im);
+            chunk_load(next + 5 * vl, vl, &V5_re, &V5_im);
+            chunk_load(next + 6 * vl, vl, &V6_re, &V6_im);
+            chunk_load(next + 7 * vl, vl, &V7_re, &V7_im);
+        }
+        FFT_MARK(FFT_MARK_CHUNK_END);
     }
+}
+#endif
 
-    // Bit-reverse indices. compute_indices emits 32-bit element indices at
-    // the current e32 vl; widen + byte-scale (<<3 for e64) to 64-bit byte
-    // offsets for bitreverse_reorder64.
+// The chunk pass: run_chunk on every chunk of fft_buf, or with FFT_PIPELINED
+// and R = 8 the software-pipelined loop.
+static void chunk_pass(void) {
+    size_t chunk_size = (size_t)r_val * vl_val;
+#if FFT_PIPELINED
+    if (r_val == MAX_R) {
+        run_chunks_R8_pipelined();
+        return;
+    }
+#endif
+    for (size_t cb = 0; cb < (size_t)N; cb += chunk_size) {
+        run_chunk(cb);
+    }
+}
+
+#if FFT_REAL
+// Split the packed N-point spectrum Z into the real-input spectrum X:
+//   A = Z[k], Bc = conj(Z[N-k]), W = ω_{2N}^k
+//   X[k] = ½(A + Bc) − ½·i·W·(A − Bc)       for k ∈ [1, N)
+//   X[0] = Re Z[0] + Im Z[0],  X[N] = Re Z[0] − Im Z[0].
+// Z[N-k] for a vl-block of k is a stride −8 vlse64 starting at Z[N-k].
+static void rfft_postprocess(void) {
+    const ptrdiff_t rev_stride = -(ptrdiff_t)sizeof(fft_t);
+    for (size_t k = 1; k < (size_t)N; ) {
+        size_t vl = FFT_VSETVL((size_t)N - k);
+        vfft_t A_re = FFT_VLE(&data_re[k], vl);
+        vfft_t A_im = FFT_VLE(&data_im[k], vl);
+        vfft_t B_re = FFT_VLSE(&data_re[N - k], rev_stride, vl);
+        vfft_t B_im = FFT_VLSE(&data_im[N - k], rev_stride, vl);
+        vfft_t W_re = FFT_VLE(&rfft_tw_re[k], vl);
+        vfft_t W_im = FFT_VLE(&rfft_tw_im[k], vl);
+
+        // S = A + conj(B), D = A − conj(B).
+        vfft_t S_re = FFT_VFADD(A_re, B_re, vl);
+        vfft_t S_im = FFT_VFSUB(A_im, B_im, vl);
+        vfft_t D_re = FFT_VFSUB(A_re, B_re, vl);
+        vfft_t D_im = FFT_VFADD(A_im, B_im, vl);
+        // P = W·D; X = ½(S − i·P) = ½(S_re + P_im, S_im − P_re).
+        vfft_t P_re = FFT_VFSUB(
+            FFT_VFMUL(W_re, D_re, vl),
+            FFT_VFMUL(W_im, D_im, vl), vl);
+        vfft_t P_im = FFT_VFADD(
+            FFT_VFMUL(W_re, D_im, vl),
+            FFT_VFMUL(W_im, D_re, vl), vl);
+        vfft_t X_re = FFT_VFMUL_VF(
+            FFT_VFADD(S_re, P_im, vl), 0.5, vl);
+        vfft_t X_im = FFT_VFMUL_VF(
+            FFT_VFSUB(S_im, P_re, vl), 0.5, vl);
+
+        FFT_VSE(&rfft_re[k], X_re, vl);
+        FFT_VSE(&rfft_im[k], X_im, vl);
+        k += vl;
+    }
+    fft_t z0_re = data_re[0];
+    fft_t z0_im = data_im[0];
+    rfft_re[0] = z0_re + z0_im;
+    rfft_im[0] = 0.0;
+    rfft_re[N] = z0_re - z0_im;
+    rfft_im[N] = 0.0;
+}
+#endif
+
+#if FFT_CONV
+// Point the next run_fft at its source/working buffers and epilogue.
+static void set_transform(const fft_t* src_re, const fft_t* src_im,
+                          fft_t* buf_re, fft_t* buf_im,
+                          const fft_t* mul_re, const fft_t* mul_im,
+                          int conj, fft_t scale) {
+    fft_src_re = src_re;
+    fft_src_im = src_im;
+    fft_buf_re = buf_re;
+    fft_buf_im = buf_im;
+    epi_mul_re = mul_re;
+    epi_mul_im = mul_im;
+    epi_conj = conj;
+    epi_scale = scale;
+}
+#endif
+
+// One forward transform of fft_src into fft_buf (fused), or of the
+// bit-reversed tmp copied into data (unfused): chunk pass then Regime C.
+static void run_fft(void) {
+#if FFT_FUSED_BITREVERSE
+    // Chunk loads gather from fft_src in bit-reversed order and the stores
+    // write fft_buf, so each iteration starts from the same input.
+    zamlet_set_index_bound(br_index_bound_bits());
+    chunk_pass();
+    zamlet_set_index_bound(0);
+#else
+    // Bit-reverse tmp → data. After this, data holds the reordered input;
+    // FFT runs in-place on data_re/im. Repeated each iter so every FFT
+    // runs on the same starting data.
+    bitreverse_reorder64(N, (const int64_t*)tmp_re, (int64_t*)data_re,
+                         br_read_idx, br_write_idx);
+    bitreverse_reorder64(N, (const int64_t*)tmp_im, (int64_t*)data_im,
+                         br_read_idx, br_write_idx);
+
+    chunk_pass();
+#endif
+
+    for (int P = 0; P < n_regime_c; P++) {
+        int remaining = log2_n - log2_vl - 3 - 3 * P;
+        int n_sub = (remaining < 3) ? remaining : 3;
+        int super_chunk = 1 << n_sub;
+        regime_c_pass(P, super_chunk, n_sub);
+    }
+}
+
+// Bit-reverse index setup. compute_indices64 emits the 64-bit byte offsets
+// for bitreverse_reorder64 and the fused gather table directly, blocked for
+// the current e32 vl.
+//
+// With prebuilt tables (TWIDDLE_BR_VL) the fused path has nothing to do:
+// br_gather_idx does not depend on vl. The unfused path keeps the header's
+// read/write tables when the hardware e32 vl matches TWIDDLE_BR_VL and
+// rebuilds them otherwise, since compute_indices64 orders each vl-length
+// block for that vl.
+static void init_bitreverse(void) {
+#if defined(TWIDDLE_BR_VL) && FFT_FUSED_BITREVERSE
+    return;
+#else
     size_t vl_e32;
     asm volatile ("vsetvli %0, %1, e32, m1, ta, ma" : "=r"(vl_e32) : "r"(N));
+#ifdef TWIDDLE_BR_VL
+    if (vl_e32 == TWIDDLE_BR_VL) return;
+#endif
     int n_bits = 0;
     for (size_t v = N; v > 1; v >>= 1) n_bits++;
-    compute_indices(N, vl_e32, br_read_idx32, br_write_idx32, n_bits);
-    for (size_t i = 0; i < (size_t)N; i++) {
-        br_read_idx[i]  = ((uint64_t)br_read_idx32[i])  << 3;
-        br_write_idx[i] = ((uint64_t)br_write_idx32[i]) << 3;
-    }
+    compute_indices64(N, vl_e32, br_read_idx, br_write_idx, n_bits);
+#if FFT_FUSED_BITREVERSE
+    init_gather_idx();
+#endif
+#endif
+}
 
+// Absolute error bound for the checked bins. The f32 peak comes from the header
+// so the check never scans expected[] on the scalar core.
+static double check_tol(void) {
+#if FFT_F32
+    return FFT_F32_TOL * TWIDDLE_EXPECTED_PEAK;
+#else
+    return TOL;
+#endif
+}
+
+// 1 + the first of the n bins whose re or im part (every step'th element of
+// re/im) is more than tol from expected, or 0 if all match. Both compares run
+// on the VPU (FFT_VERIFY_TOL); the im scan stops at the first bad re bin.
+static int first_bad_bin(size_t n, const fft_t* re, const fft_t* im, long step,
+                         double tol) {
+    int bad = FFT_VERIFY_TOL((int)n, re, step, expected_re, (fft_t)tol);
+    int bad_im = FFT_VERIFY_TOL(bad ? bad - 1 : (int)n, im, step, expected_im, (fft_t)tol);
+    return bad_im ? bad_im : bad;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    // Input: x[i] = i + 0j, matching the expected[] table in the generated
+    // twiddles header. tmp_re/im (tmp_c) holds it in natural order; the first
+    // chunk pass (fused) or bitreverse_reorder64 moves it bit-reversed into data.
+#if FFT_REAL
+    // Real input x[n] = n for n ∈ [0, 2N), packed two samples per element.
+    FFT_VINIT_AFFINE(tmp_re, 1, N, 2, 0);
+    FFT_VINIT_AFFINE(tmp_im, 1, N, 2, 1);
+#elif FFT_INTERLEAVED
+    FFT_VINIT_FILL(tmp_c, 2 * N, 0);
+    FFT_VINIT_AFFINE(tmp_c, 2, N, 1, 0);
+#else
+    FFT_VINIT_AFFINE(tmp_re, 1, N, 1, 0);
+    FFT_VINIT_FILL(tmp_im, N, 0);
+#endif
+
+    init_bitreverse();
     init_tables();
 
     printf("Running FFT-%d (vl=%zu, R=%d) x%d\n", N, vl_val, r_val, N_FFTS);
 
-    size_t chunk_size = (size_t)r_val * vl_val;
+#if FFT_INVERSE
+    epi_scale = 1.0 / (double)N;
+#endif
 
     unsigned long cycles1, cycles2;
     cycles1 = read_csr(mcycle);
+    bench_begin("fft");
 
     for (int iter = 0; iter < N_FFTS; iter++) {
         FFT_MARK_V(FFT_MARK_ITER_START_BASE + iter);
-
-        // Bit-reverse tmp → data. After this, data holds the reordered input;
-        // FFT runs in-place on data_re/im. Repeated each iter so every FFT
-        // runs on the same starting data.
-        bitreverse_reorder64(N, (const int64_t*)tmp_re, (int64_t*)data_re,
-                             br_read_idx, br_write_idx);
-        bitreverse_reorder64(N, (const int64_t*)tmp_im, (int64_t*)data_im,
-                             br_read_idx, br_write_idx);
-
-        for (size_t cb = 0; cb < (size_t)N; cb += chunk_size) {
-            run_chunk(cb);
-        }
-
-        for (int P = 0; P < n_regime_c; P++) {
-            int remaining = log2_n - log2_vl - 3 - 3 * P;
-            int n_sub = (remaining < 3) ? remaining : 3;
-            int super_chunk = 1 << n_sub;
-            regime_c_pass(P, super_chunk, n_sub);
-        }
+#if FFT_CONV
+        set_transform(tmp_re, tmp_im, data_re, data_im, conv_h_re, conv_h_im, 1, 1.0);
+        run_fft();
+        set_transform(data_re, data_im, conv_out_re, conv_out_im, NULL, NULL, 1,
+                      1.0 / (double)N);
+        run_fft();
+#else
+        run_fft();
+#endif
+#if FFT_REAL
+        rfft_postprocess();
+#endif
     }
 
     asm volatile("fence");
+    bench_end();
     cycles2 = read_csr(mcycle);
 
     printf("Cycles: %lu\n", cycles2 - cycles1);
 
-    for (size_t i = 0; i < (size_t)N; i++) {
-        double err_re = data_re[i] - expected_re[i];
-        double err_im = data_im[i] - expected_im[i];
-        if (err_re < 0) err_re = -err_re;
-        if (err_im < 0) err_im = -err_im;
-        if (err_re > TOL || err_im > TOL) {
-            printf("FAIL [%zu]: got (%f, %f), expected (%f, %f)\n",
-                   i, data_re[i], data_im[i], expected_re[i], expected_im[i]);
-            return 1;
-        }
+#if FFT_REAL
+    int bad = first_bad_bin((size_t)N + 1, rfft_re, rfft_im, 1, check_tol());
+    if (bad) {
+        size_t i = bad - 1;
+        printf("FAIL [%zu]: got (%f, %f), expected (%f, %f)\n",
+               i, rfft_re[i], rfft_im[i], expected_re[i], expected_im[i]);
+        return 1;
     }
+#else
+#if FFT_CONV
+    const fft_t* res_re = conv_out_re;
+    const fft_t* res_im = conv_out_im;
+    const size_t res_step = 1;
+#elif FFT_INTERLEAVED
+    const fft_t* res_re = &data_c[0];
+    const fft_t* res_im = &data_c[1];
+    const size_t res_step = 2;
+#else
+    const fft_t* res_re = data_re;
+    const fft_t* res_im = data_im;
+    const size_t res_step = 1;
+#endif
+    int bad = first_bad_bin((size_t)N, res_re, res_im, res_step, check_tol());
+    if (bad) {
+        size_t i = bad - 1;
+        printf("FAIL [%zu]: got (%f, %f), expected (%f, %f)\n",
+               i, res_re[res_step * i], res_im[res_step * i], expected_re[i],
+               expected_im[i]);
+        return 1;
+    }
+#endif
 
     printf("PASSED\n");
     return 0;
@@ -0,0 +1,232 @@
+/*
+ * Gather/scatter microbenchmark: every LMUL in {1, 2, 4, 8} × element width in {32, 64}
+ * × permutation of n = 2^gs_log2_n elements, as a gather pass dst[i] = src[p(i)]
+ * (vluxei, then a unit-stride store) and a scatter pass dst[p(i)] = src[i] (a
+ * unit-stride load, then vsuxei), each timed in its own bench region and reported in
+ * elements per cycle. Indices have the element width, as in bitreverse_reorder64.
+ *
+ * The permutations, on element indices i < n:
+ *   identity    p(i) = i
+ *   bitreverse  p(i) = i with its gs_log2_n bits reversed (the FFT reorder)
+ *   random      a fixed pseudo-random bijection: two rounds of an odd multiply mod n
+ *               followed by x ^= x >> s
+ *   transpose   i = r·C + c of an R × C row-major matrix maps to c·R + r, where
+ *               R = 2^(gs_log2_n / 2)
+ * All are built with vector ops from vid, so the index tables are written at vector
+ * store bandwidth.
+ *
+ * Like bitreverse_reorder64, every pass runs under an index bound covering the array,
+ * and each scatter under one writeset because a permutation never writes an element
+ * twice. src holds i at i, so the gather result must equal p(i) and the scatter
+ * result, gathered back through the same indices, must equal i; both checks are
+ * vector compares. gs_ew (32 or 64, 0 for both) and gs_log2_n are set with
+ * SYMBOL_VALUES.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "zamlet_custom.h"
+
+#define GS_MAX_LOG2_N 12
+
+// Element width to sweep, 32, 64 or 0 for both; kernel_test overrides these through
+// symbol_values.
+volatile int32_t gs_ew = 0;
+volatile int32_t gs_log2_n = 7;
+
+enum { PERM_IDENTITY, PERM_BITREVERSE, PERM_RANDOM, PERM_TRANSPOSE, N_PERMS };
+static const char* const perm_names[N_PERMS] = {
+    "identity", "bitreverse", "random", "transpose",
+};
+static const unsigned lmuls[] = {1, 2, 4, 8};
+
+static char region[48];
+
+/*
+ * GS_DEFINE(EW) defines, for element width EW: the index table builder, the gather and
+ * scatter passes at each LMUL, their checks and the sweep over LMUL and permutation.
+ */
+#define GS_PASSES(EW, LM)                                                                \
+static void gather_e##EW##LM(size_t n, const uint##EW##_t* src, uint##EW##_t* dst,       \
+                             const uint##EW##_t* idx) {                                  \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##LM(n - i);                                     \
+        vuint##EW##LM##_t vi = __riscv_vle##EW##_v_u##EW##LM(&idx[i], vl);               \
+        __riscv_vse##EW##_v_u##EW##LM(                                                   \
+            &dst[i], __riscv_vluxei##EW##_v_u##EW##LM(src, vi, vl), vl);                 \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+static void scatter_e##EW##LM(size_t n, const uint##EW##_t* src, uint##EW##_t* dst,      \
+                              const uint##EW##_t* idx) {                                 \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##LM(n - i);                                     \
+        vuint##EW##LM##_t vi = __riscv_vle##EW##_v_u##EW##LM(&idx[i], vl);               \
+        __riscv_vsuxei##EW##_v_u##EW##LM(                                                \
+            dst, vi, __riscv_vle##EW##_v_u##EW##LM(&src[i], vl), vl);                    \
+        i += vl;                                                                         \
+    }                                                                                    \
+}
+
+#define GS_DEFINE(EW, MB)                                                                \
+GS_PASSES(EW, m1)                                                                        \
+GS_PASSES(EW, m2)                                                                        \
+GS_PASSES(EW, m4)                                                                        \
+GS_PASSES(EW, m8)                                                                        \
+                                                                                         \
+typedef void (*pass_e##EW##_fn)(size_t, const uint##EW##_t*, uint##EW##_t*,              \
+                                const uint##EW##_t*);                                    \
+static const pass_e##EW##_fn gathers_e##EW[] = {                                         \
+    gather_e##EW##m1, gather_e##EW##m2, gather_e##EW##m4, gather_e##EW##m8,              \
+};                                                                                       \
+static const pass_e##EW##_fn scatters_e##EW[] = {                                        \
+    scatter_e##EW##m1, scatter_e##EW##m2, scatter_e##EW##m4, scatter_e##EW##m8,          \
+};                                                                                       \
+                                                                                         \
+/* idx[i] = p(i) · EW / 8, the byte offset of element p(i), for i < 2^lg. */             \
+static void make_indices_e##EW(int perm, int lg, uint##EW##_t* idx) {                    \
+    size_t n = (size_t)1 << lg;                                                          \
+    uint##EW##_t mask = n - 1;                                                           \
+    int rows_lg = lg / 2;                                                                \
+    int cols_lg = lg - rows_lg;                                                          \
+    int shift = lg / 2 + 1;                                                              \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vuint##EW##m4_t v = __riscv_vadd_vx_u##EW##m4(__riscv_vid_v_u##EW##m4(vl), i, vl); \
+        vuint##EW##m4_t p = v;                                                           \
+        if (perm == PERM_BITREVERSE) {                                                   \
+            p = __riscv_vmv_v_x_u##EW##m4(0, vl);                                        \
+            for (int b = 0; b < lg; b++) {                                               \
+                vuint##EW##m4_t bit = __riscv_vand_vx_u##EW##m4(                         \
+                    __riscv_vsrl_vx_u##EW##m4(v, b, vl), 1, vl);                         \
+                p = __riscv_vor_vv_u##EW##m4(                                            \
+                    p, __riscv_vsll_vx_u##EW##m4(bit, lg - 1 - b, vl), vl);              \
+            }                                                                            \
+        } else if (perm == PERM_RANDOM) {                                                \
+            static const uint32_t mult[2] = {0x9e3779b1u, 0x85ebca6bu};                  \
+            for (int round = 0; round < 2; round++) {                                    \
+                p = __riscv_vand_vx_u##EW##m4(                                           \
+                    __riscv_vmul_vx_u##EW##m4(p, mult[round], vl), mask, vl);            \
+                p = __riscv_vxor_vv_u##EW##m4(                                           \
+                    p, __riscv_vsrl_vx_u##EW##m4(p, shift, vl), vl);                     \
+            }                                                                            \
+        } else if (perm == PERM_TRANSPOSE) {                                             \
+            vuint##EW##m4_t r = __riscv_vsrl_vx_u##EW##m4(v, cols_lg, vl);               \
+            vuint##EW##m4_t c = __riscv_vand_vx_u##EW##m4(                               \
+                v, ((uint##EW##_t)1 << cols_lg) - 1, vl);                                \
+            p = __riscv_vor_vv_u##EW##m4(                                                \
+                __riscv_vsll_vx_u##EW##m4(c, rows_lg, vl), r, vl);                       \
+        }                                                                                \
+        __riscv_vse##EW##_v_u##EW##m4(                                                   \
+            &idx[i], __riscv_vsll_vx_u##EW##m4(p, EW == 64 ? 3 : 2, vl), vl);            \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+/* x[i] = i, or all ones with poison set. */                                             \
+static void fill_e##EW(size_t n, uint##EW##_t* x, int poison) {                          \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vuint##EW##m4_t v = poison ? __riscv_vmv_v_x_u##EW##m4(-1, vl)                   \
+            : __riscv_vadd_vx_u##EW##m4(__riscv_vid_v_u##EW##m4(vl), i, vl);             \
+        __riscv_vse##EW##_v_u##EW##m4(&x[i], v, vl);                                     \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+/*                                                                                       \
+ * Number of i < n where the pass result is wrong: dst[i] != p(i) after a gather, or     \
+ * dst[p(i)] != i after a scatter.                                                       \
+ */                                                                                      \
+static size_t mismatches_e##EW(size_t n, const uint##EW##_t* dst,                        \
+                               const uint##EW##_t* idx, int scatter) {                   \
+    size_t bad = 0;                                                                      \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vuint##EW##m4_t vi = __riscv_vle##EW##_v_u##EW##m4(&idx[i], vl);                 \
+        vuint##EW##m4_t got, want;                                                       \
+        if (scatter) {                                                                   \
+            got = __riscv_vluxei##EW##_v_u##EW##m4(dst, vi, vl);                         \
+            want = __riscv_vadd_vx_u##EW##m4(__riscv_vid_v_u##EW##m4(vl), i, vl);        \
+        } else {                                                                         \
+            got = __riscv_vle##EW##_v_u##EW##m4(&dst[i], vl);                            \
+            want = __riscv_vsrl_vx_u##EW##m4(vi, EW == 64 ? 3 : 2, vl);                  \
+        }                                                                                \
+        bad += __riscv_vcpop_m_b##MB(__riscv_vmsne_vv_u##EW##m4_b##MB(got, want, vl), vl); \
+        i += vl;                                                                         \
+    }                                                                                    \
+    return bad;                                                                          \
+}                                                                                        \
+                                                                                         \
+static int run_pass_e##EW(const char* kind, unsigned lmul, int perm, size_t n,           \
+                          pass_e##EW##_fn fn, const uint##EW##_t* src,                   \
+                          uint##EW##_t* dst, const uint##EW##_t* idx, int scatter) {     \
+    fill_e##EW(n, dst, 1);                                                               \
+    sprintf(region, "%s_e%d_m%u_%s", kind, EW, lmul, perm_names[perm]);                  \
+    zamlet_begin_index_bound(n * sizeof(uint##EW##_t));                                  \
+    if (scatter)                                                                         \
+        zamlet_begin_writeset();                                                         \
+    unsigned long start = bench_timed_begin(region);                                     \
+    fn(n, src, dst, idx);                                                                \
+    unsigned long cycles = bench_timed_end(start);                                       \
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " elements/cycle)\n", region, cycles,       \
+           BENCH_RATE(n, cycles));                                                       \
+    if (scatter)                                                                         \
+        zamlet_end_writeset();                                                           \
+    size_t bad = mismatches_e##EW(n, dst, idx, scatter);                                 \
+    zamlet_end_index_bound();                                                            \
+    if (bad) {                                                                           \
+        printf("FAIL %s: %zu of %zu elements wrong\n", region, bad, n);                  \
+        return 1;                                                                        \
+    }                                                                                    \
+    return 0;                                                                            \
+}                                                                                        \
+                                                                                         \
+static int sweep_e##EW(int lg) {                                                         \
+    size_t n = (size_t)1 << lg;                                                          \
+    uint##EW##_t* src = vpu_alloc_ew(n * sizeof(uint##EW##_t), EW);                      \
+    uint##EW##_t* dst = vpu_alloc_ew(n * sizeof(uint##EW##_t), EW);                      \
+    uint##EW##_t* idx = vpu_alloc_ew(n * sizeof(uint##EW##_t), EW);                      \
+    fill_e##EW(n, src, 0);                                                               \
+    for (int perm = 0; perm < N_PERMS; perm++) {                                         \
+        make_indices_e##EW(perm, lg, idx);                                               \
+        for (int l = 0; l < 4; l++) {                                                    \
+            if (run_pass_e##EW("gather", lmuls[l], perm, n, gathers_e##EW[l], src, dst,  \
+                               idx, 0))                                                  \
+                return 1;                                                                \
+            if (run_pass_e##EW("scatter", lmuls[l], perm, n, scatters_e##EW[l], src,     \
+                               dst, idx, 1))                                             \
+                return 1;                                                                \
+        }                                                                                \
+    }                                                                                    \
+    return 0;                                                                            \
+}
+
+GS_DEFINE(32, 8)
+GS_DEFINE(64, 16)
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int ew = gs_ew;
+    int lg = gs_log2_n;
+    printf("gather/scatter n = %d, ew = %d\n", 1 << lg, ew);
+    if (lg < 1 || lg > GS_MAX_LOG2_N || (ew != 0 && ew != 32 && ew != 64)) {
+        printf("FAIL need 1 <= gs_log2_n <= %d and gs_ew in {0, 32, 64}\n", GS_MAX_LOG2_N);
+        return 1;
+    }
+
+    if ((ew == 0 || ew == 32) && sweep_e32(lg))
+        return 1;
+    if ((ew == 0 || ew == 64) && sweep_e64(lg))
+        return 1;
+
+    printf("PASSED\n");
+    return 0;
+}
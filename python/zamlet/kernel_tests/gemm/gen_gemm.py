@@ -0,0 +1,55 @@
+"""Generate a GEMM dataset header for C = A · B.
+
+Usage:
+    python gen_gemm.py M N K [--double] [--seed S] > gemm_data.h
+
+Declares:
+    #define GEMM_M M
+    #define GEMM_N N
+    #define GEMM_K K
+    #define GEMM_DOUBLE 0|1
+    T gemm_a[M * K];                                    // row-major, scalar memory
+    T gemm_b[K * N] __attribute__((section(".data.vpuE")));   // row-major
+    T gemm_expected[M * N] __attribute__((section(".data.vpuE")));
+
+T is float (E = 32) or double with --double (E = 64). A is read one element at a time
+by the scalar core, so it stays in scalar memory; B and the expected result are read
+with vector loads. Inputs are small integers so every product and partial sum is exact
+in either precision.
+"""
+import argparse
+import random
+
+from gen_header import emit
+
+parser = argparse.ArgumentParser()
+parser.add_argument("M", type=int)
+parser.add_argument("N", type=int)
+parser.add_argument("K", type=int)
+parser.add_argument("--double", action="store_true", help="emit double instead of float")
+parser.add_argument("--seed", type=int, default=0)
+args = parser.parse_args()
+
+rng = random.Random(args.seed)
+m, n, k = args.M, args.N, args.K
+a = [rng.randint(-4, 4) for _ in range(m * k)]
+b = [rng.randint(-4, 4) for _ in range(k * n)]
+c = [sum(a[i * k + p] * b[p * n + j] for p in range(k)) for i in range(m) for j in range(n)]
+
+ctype = "double" if args.double else "float"
+ew = 64 if args.double else 32
+
+
+def literal(v):
+    return f"{float(v):.1f}"
+
+
+print(f"// Generated by gen_gemm.py {m} {n} {k}{' --double' if args.double else ''}")
+print(f"#define GEMM_M {m}")
+print(f"#define GEMM_N {n}")
+print(f"#define GEMM_K {k}")
+print(f"#define GEMM_DOUBLE {int(args.double)}")
+print()
+emit(ctype, "gemm_a", a, None, literal)
+emit(ctype, "gemm_b", b, f".data.vpu{ew}", literal)
+emit(ctype, "gemm_expected", c, f".data.vpu{ew}", literal)
@@ -0,0 +1,147 @@
+/*
+ * Tiled GEMM: C[M][N] = A[M][K] · B[K][N], all row-major.
+ *
+ * The N axis is split into column panels of one vector each (vl = VLMAX at
+ * e{32,64}m4). For each panel:
+ *   1. Pack. The K x vl slice of B is copied row by row into a contiguous
+ *      vpu_alloc_ew buffer, so the micro-kernel streams it with unit-stride
+ *      loads of exactly vl elements.
+ *   2. Micro-kernel. GEMM_MR rows of C are held in GEMM_MR accumulators.
+ *      Each step p loads one packed B row and issues GEMM_MR vfmacc.vf with
+ *      the scalars A[i + r][p]: a rank-1 (outer-product) update of the tile.
+ *      Left-over rows (M not a multiple of GEMM_MR) use a one-row kernel.
+ * C is written once per tile, so the accumulators never round-trip memory.
+ *
+ * Register use at m4: GEMM_MR = 4 accumulators plus one B row is 20 of the
+ * 32 vector registers.
+ *
+ * GEMM_HEADER (gen_gemm.py M N K [--double]) supplies the sizes, A in scalar
+ * memory, and B and the expected C in VPU memory. GEMM_DOUBLE selects DGEMM.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include GEMM_HEADER
+
+#define GEMM_MR 4
+
+#if GEMM_DOUBLE
+typedef double gemm_t;
+typedef vfloat64m4_t gemm_vt;
+#define GEMM_EW              64
+#define GEMM_NAME            "dgemm"
+#define GEMM_VSETVL(n)       __riscv_vsetvl_e64m4(n)
+#define GEMM_VSETVLMAX()     __riscv_vsetvlmax_e64m4()
+#define GEMM_VLE(p, vl)      __riscv_vle64_v_f64m4(p, vl)
+#define GEMM_VSE(p, v, vl)   __riscv_vse64_v_f64m4(p, v, vl)
+#define GEMM_ZERO(vl)        __riscv_vfmv_v_f_f64m4(0.0, vl)
+#define GEMM_FMACC(acc, a, b, vl) __riscv_vfmacc_vf_f64m4(acc, a, b, vl)
+#else
+typedef float gemm_t;
+typedef vfloat32m4_t gemm_vt;
+#define GEMM_EW              32
+#define GEMM_NAME            "sgemm"
+#define GEMM_VSETVL(n)       __riscv_vsetvl_e32m4(n)
+#define GEMM_VSETVLMAX()     __riscv_vsetvlmax_e32m4()
+#define GEMM_VLE(p, vl)      __riscv_vle32_v_f32m4(p, vl)
+#define GEMM_VSE(p, v, vl)   __riscv_vse32_v_f32m4(p, v, vl)
+#define GEMM_ZERO(vl)        __riscv_vfmv_v_f_f32m4(0.0f, vl)
+#define GEMM_FMACC(acc, a, b, vl) __riscv_vfmacc_vf_f32m4(acc, a, b, vl)
+#endif
+
+// Copy columns [j0, j0 + vl) of B into pack[p · vl + t].
+static void pack_panel(const gemm_t* b, gemm_t* pack, size_t k, size_t n, size_t j0,
+                       size_t vl) {
+    for (size_t p = 0; p < k; p++) {
+        GEMM_VSE(&pack[p * vl], GEMM_VLE(&b[p * n + j0], vl), vl);
+    }
+}
+
+// C[i0 .. i0+GEMM_MR)[j0 .. j0+vl) = A[i0 .. i0+GEMM_MR) · panel.
+static void micro_mr(const gemm_t* a, const gemm_t* pack, gemm_t* c, size_t k, size_t n,
+                     size_t i0, size_t j0, size_t vl) {
+    const gemm_t* a0 = &a[i0 * k];
+    const gemm_t* a1 = a0 + k;
+    const gemm_t* a2 = a1 + k;
+    const gemm_t* a3 = a2 + k;
+    gemm_vt acc0 = GEMM_ZERO(vl);
+    gemm_vt acc1 = GEMM_ZERO(vl);
+    gemm_vt acc2 = GEMM_ZERO(vl);
+    gemm_vt acc3 = GEMM_ZERO(vl);
+    for (size_t p = 0; p < k; p++) {
+        gemm_vt bp = GEMM_VLE(&pack[p * vl], vl);
+        acc0 = GEMM_FMACC(acc0, a0[p], bp, vl);
+        acc1 = GEMM_FMACC(acc1, a1[p], bp, vl);
+        acc2 = GEMM_FMACC(acc2, a2[p], bp, vl);
+        acc3 = GEMM_FMACC(acc3, a3[p], bp, vl);
+    }
+    gemm_t* c0 = &c[i0 * n + j0];
+    GEMM_VSE(c0, acc0, vl);
+    GEMM_VSE(c0 + n, acc1, vl);
+    GEMM_VSE(c0 + 2 * n, acc2, vl);
+    GEMM_VSE(c0 + 3 * n, acc3, vl);
+}
+
+static void micro_1(const gemm_t* a, const gemm_t* pack, gemm_t* c, size_t k, size_t n,
+                    size_t i, size_t j0, size_t vl) {
+    const gemm_t* ai = &a[i * k];
+    gemm_vt acc = GEMM_ZERO(vl);
+    for (size_t p = 0; p < k; p++) {
+        acc = GEMM_FMACC(acc, ai[p], GEMM_VLE(&pack[p * vl], vl), vl);
+    }
+    GEMM_VSE(&c[i * n + j0], acc, vl);
+}
+
+// pack must hold k · GEMM_VSETVLMAX() elements.
+void vec_gemm(size_t m, size_t n, size_t k, const gemm_t* a, const gemm_t* b, gemm_t* c,
+              gemm_t* pack) {
+    for (size_t j0 = 0; j0 < n; ) {
+        size_t vl = GEMM_VSETVL(n - j0);
+        pack_panel(b, pack, k, n, j0, vl);
+        size_t i0 = 0;
+        for (; i0 + GEMM_MR <= m; i0 += GEMM_MR) {
+            micro_mr(a, pack, c, k, n, i0, j0, vl);
+        }
+        for (; i0 < m; i0++) {
+            micro_1(a, pack, c, k, n, i0, j0, vl);
+        }
+        j0 += vl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    gemm_t* c = vpu_alloc_ew(GEMM_M * GEMM_N * sizeof(gemm_t), GEMM_EW);
+    gemm_t* pack = vpu_alloc_ew(GEMM_K * GEMM_VSETVLMAX() * sizeof(gemm_t), GEMM_EW);
+
+    printf("%s M,N,K = %d,%d,%d (panel vl=%zu)\n", GEMM_NAME, GEMM_M, GEMM_N, GEMM_K,
+           GEMM_VSETVLMAX());
+
+#if PREALLOCATE
+    vec_gemm(GEMM_M, GEMM_N, GEMM_K, gemm_a, gemm_b, c, pack);
+#endif
+
+    unsigned long start = bench_timed_begin(GEMM_NAME);
+    vec_gemm(GEMM_M, GEMM_N, GEMM_K, gemm_a, gemm_b, c, pack);
+    unsigned long cycles = bench_timed_end(start);
+
+    unsigned long flops = 2UL * GEMM_M * GEMM_N * GEMM_K;
+    printf("Cycles: %lu (" BENCH_RATE_FMT " flop/cycle)\n", cycles, BENCH_RATE(flops, cycles));
+
+    for (size_t i = 0; i < (size_t)(GEMM_M * GEMM_N); i++) {
+        if (c[i] != gemm_expected[i]) {
+            printf("FAIL [%zu][%zu]: got %ld, expected %ld\n", i / GEMM_N, i % GEMM_N,
+                   (long)c[i], (long)gemm_expected[i]);
+            return 1;
+        }
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,69 @@
+"""Generate a C header describing one geometry from zamlet.geometries.
+
+Usage:
+    gen_geometry_header GEOMETRY > geometry.h
+
+riscv_kernel(geometry = ...) runs this and passes the header to the kernel as
+ZAMLET_GEOMETRY_HEADER, so a kernel built for one geometry can size its tables and
+unroll its loops with compile-time constants instead of querying vl at runtime:
+
+    #define ZAMLET_GEOMETRY_NAME "k2x1_j1x1"
+    #define ZAMLET_K_COLS, ZAMLET_K_ROWS, ZAMLET_J_COLS, ZAMLET_J_ROWS
+    #define ZAMLET_J_IN_K    jamlets per kamlet
+    #define ZAMLET_K_IN_L    kamlets in the lamlet
+    #define ZAMLET_J_IN_L    jamlets in the lamlet (lanes, one word each)
+    #define ZAMLET_VLEN      bits per vector register
+    #define ZAMLET_VLMAX(sew, lmul), ZAMLET_VLMAX_E{8,16,32,64}M1
+    #define ZAMLET_CACHE_LINE_BYTES, ZAMLET_JAMLET_SRAM_BYTES, ZAMLET_CACHE_BYTES
+    #define ZAMLET_PAGE_BYTES
+"""
+import argparse
+
+from zamlet.geometries import GEOMETRIES
+
+
+def header(name: str) -> str:
+    p = GEOMETRIES[name]
+    vlen = p.maxvl_bytes * 8
+    defines = [
+        ("ZAMLET_GEOMETRY_NAME", f'"{name}"'),
+        ("ZAMLET_K_COLS", p.k_cols),
+        ("ZAMLET_K_ROWS", p.k_rows),
+        ("ZAMLET_J_COLS", p.j_cols),
+        ("ZAMLET_J_ROWS", p.j_rows),
+        ("ZAMLET_J_IN_K", p.j_in_k),
+        ("ZAMLET_K_IN_L", p.k_in_l),
+        ("ZAMLET_J_IN_L", p.j_in_l),
+        ("ZAMLET_WORD_BYTES", p.word_bytes),
+        ("ZAMLET_VLEN", vlen),
+        ("ZAMLET_VLENB", vlen // 8),
+        ("ZAMLET_VLMAX(sew, lmul)", f"({vlen} * (lmul) / (sew))"),
+    ]
+    defines += [(f"ZAMLET_VLMAX_E{sew}M1", vlen // sew) for sew in (8, 16, 32, 64)]
+    defines += [
+        ("ZAMLET_CACHE_LINE_BYTES", p.cache_line_bytes),
+        ("ZAMLET_JAMLET_SRAM_BYTES", p.jamlet_sram_bytes),
+        ("ZAMLET_CACHE_BYTES", p.jamlet_sram_bytes * p.j_in_l),
+        ("ZAMLET_PAGE_BYTES", p.page_bytes),
+    ]
+    width = max(len(k) for k, _ in defines)
+    lines = [
+        f"// Generated by gen_geometry_header.py {name}",
+        "#ifndef ZAMLET_GEOMETRY_H",
+        "#define ZAMLET_GEOMETRY_H",
+        "",
+    ]
+    lines += [f"#define {k:<{width}} {v}" for k, v in defines]
+    lines += ["", "#endif", ""]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("geometry", choices=sorted(GEOMETRIES))
+    args = parser.parse_args()
+    print(header(args.geometry), end="")
+
+
+if __name__ == "__main__":
+    main()
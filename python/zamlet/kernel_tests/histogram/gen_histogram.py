@@ -0,0 +1,48 @@
+"""Generate a histogram dataset header.
+
+Usage:
+    python gen_histogram.py N BINS [--dist uniform|skewed] [--seed S] > hist_data.h
+
+Declares:
+    #define HIST_N N
+    #define HIST_BINS BINS
+    uint32_t hist_x[N] __attribute__((section(".data.vpu32")));         // bins in [0, BINS)
+    uint32_t hist_expected[BINS] __attribute__((section(".data.vpu32")));
+
+BINS must be a power of two. "uniform" draws every bin with equal probability. "skewed"
+draws bin b with probability proportional to 2^-b, so most elements of a vector land
+in the same few bins and collide.
+"""
+import argparse
+import random
+
+from gen_header import emit
+
+parser = argparse.ArgumentParser()
+parser.add_argument("N", type=int)
+parser.add_argument("BINS", type=int)
+parser.add_argument("--dist", choices=["uniform", "skewed"], default="uniform")
+parser.add_argument("--seed", type=int, default=0)
+args = parser.parse_args()
+n, bins = args.N, args.BINS
+assert bins >= 2 and bins & (bins - 1) == 0, "BINS must be a power of two"
+
+rng = random.Random(args.seed)
+if args.dist == "uniform":
+    x = [rng.randrange(bins) for _ in range(n)]
+else:
+    weights = [2.0 ** -b for b in range(bins)]
+    x = rng.choices(range(bins), weights=weights, k=n)
+expected = [0] * bins
+for v in x:
+    expected[v] += 1
+
+
+print(f"// Generated by gen_histogram.py {n} {bins} --dist {args.dist} --seed {args.seed}")
+print("#include <stdint.h>")
+print()
+print(f"#define HIST_N {n}")
+print(f"#define HIST_BINS {bins}")
+print()
+emit("uint32_t", "hist_x", x, ".data.vpu32")
+emit("uint32_t", "hist_expected", expected, ".data.vpu32")
@@ -0,0 +1,160 @@
+/*
+ * Histogram of HIST_N bin indices into HIST_BINS counters, where the elements of one
+ * vector may hit the same bin. A plain gather, add and scatter on the histogram would
+ * lose updates, and a writeset cannot cover it. Two ways around the conflicts:
+ *
+ * hist_privatized gives each lane l of a vl = VLMAX(e32,m1) register its own
+ * sub-histogram, hist_priv[b · vl + l]. A strip of vl elements then updates vl
+ * distinct counters with one gather, add and scatter. A final merge sums the vl
+ * sub-histograms with one strided load per lane across all bins. The per-lane bins
+ * cost HIST_BINS · vl words, and the merge costs vl loads however few elements there are.
+ *
+ * hist_sorted sorts each strip in registers (an LSD radix sort over the bin bits: one
+ * pair of vcompress.vm per bit), so equal bins sit in runs. Comparing each element with
+ * its neighbour marks the run ends. vcompress.vm packs the end positions and their bins,
+ * and the run lengths are the differences of consecutive end positions. The packed bins
+ * are distinct, so the gather, add and scatter of the run lengths goes straight into
+ * the shared histogram. The cost is log2(HIST_BINS) sort steps per strip, and each
+ * strip issues as many updates as it has distinct bins.
+ *
+ * HIST_HEADER (gen_histogram.py N BINS) supplies the bin indices and the expected
+ * counts.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "zamlet_custom.h"
+#include HIST_HEADER
+
+#if HIST_BINS < 2 || (HIST_BINS & (HIST_BINS - 1)) != 0
+#error "HIST_BINS must be a power of two"
+#endif
+
+// Compile-time upper bound on VLMAX(e32,m1), for the per-lane sub-histograms. The
+// default covers k2x2_j2x2, the widest of SMALL_GEOMETRY_NAMES.
+#ifndef HIST_MAX_VLMAX
+#define HIST_MAX_VLMAX 32
+#endif
+
+static uint32_t hist_priv[HIST_BINS * HIST_MAX_VLMAX]
+    __attribute__((section(".data.vpu32"), aligned(64)));
+
+static void fill_zero(uint32_t* x, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m4(n - i);
+        __riscv_vse32_v_u32m4(&x[i], __riscv_vmv_v_x_u32m4(0, vl), vl);
+        i += vl;
+    }
+}
+
+void hist_privatized(size_t n, const uint32_t* x, uint32_t* hist) {
+    size_t vlmax = __riscv_vsetvlmax_e32m1();
+    fill_zero(hist_priv, HIST_BINS * vlmax);
+
+    vuint32m1_t lane_off = __riscv_vsll_vx_u32m1(__riscv_vid_v_u32m1(vlmax), 2, vlmax);
+    zamlet_begin_index_bound(HIST_BINS * vlmax * sizeof(uint32_t));
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m1(n - i);
+        vuint32m1_t b = __riscv_vle32_v_u32m1(&x[i], vl);
+        // (b · vlmax + lane) · 4
+        vuint32m1_t off = __riscv_vmacc_vx_u32m1(lane_off, (uint32_t)(vlmax * 4), b, vl);
+        vuint32m1_t c = __riscv_vluxei32_v_u32m1(hist_priv, off, vl);
+        __riscv_vsuxei32_v_u32m1(hist_priv, off, __riscv_vadd_vx_u32m1(c, 1, vl), vl);
+        i += vl;
+    }
+    zamlet_end_index_bound();
+
+    // hist[b] = sum over lanes l of hist_priv[b · vlmax + l]
+    ptrdiff_t stride = (ptrdiff_t)(vlmax * sizeof(uint32_t));
+    for (size_t b = 0; b < HIST_BINS; ) {
+        size_t vl = __riscv_vsetvl_e32m4(HIST_BINS - b);
+        vuint32m4_t acc = __riscv_vmv_v_x_u32m4(0, vl);
+        for (size_t l = 0; l < vlmax; l++) {
+            vuint32m4_t v = __riscv_vlse32_v_u32m4(&hist_priv[b * vlmax + l], stride, vl);
+            acc = __riscv_vadd_vv_u32m4(acc, v, vl);
+        }
+        __riscv_vse32_v_u32m4(&hist[b], acc, vl);
+        b += vl;
+    }
+}
+
+void hist_sorted(size_t n, const uint32_t* x, uint32_t* hist) {
+    fill_zero(hist, HIST_BINS);
+
+    zamlet_begin_index_bound(HIST_BINS * sizeof(uint32_t));
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m1(n - i);
+        vuint32m1_t s = __riscv_vle32_v_u32m1(&x[i], vl);
+        // Stable partition on each bin bit, lowest first.
+        for (uint32_t bit = 1; bit < HIST_BINS; bit <<= 1) {
+            vbool32_t one = __riscv_vmsne_vx_u32m1_b32(__riscv_vand_vx_u32m1(s, bit, vl), 0, vl);
+            vbool32_t zero = __riscv_vmnot_m_b32(one, vl);
+            size_t n_zero = __riscv_vcpop_m_b32(zero, vl);
+            vuint32m1_t lo = __riscv_vcompress_vm_u32m1(s, zero, vl);
+            vuint32m1_t hi = __riscv_vcompress_vm_u32m1(s, one, vl);
+            s = __riscv_vslideup_vx_u32m1(lo, hi, n_zero, vl);
+        }
+        // A run ends where the next element differs; HIST_BINS is never a bin.
+        vuint32m1_t next = __riscv_vslide1down_vx_u32m1(s, HIST_BINS, vl);
+        vbool32_t end = __riscv_vmsne_vv_u32m1_b32(s, next, vl);
+        size_t n_runs = __riscv_vcpop_m_b32(end, vl);
+        vuint32m1_t end_pos = __riscv_vcompress_vm_u32m1(__riscv_vid_v_u32m1(vl), end, vl);
+        vuint32m1_t bins = __riscv_vcompress_vm_u32m1(s, end, vl);
+        // Run length = end - previous end, with the previous end of the first run at -1.
+        vuint32m1_t prev = __riscv_vslide1up_vx_u32m1(end_pos, (uint32_t)-1, n_runs);
+        vuint32m1_t len = __riscv_vsub_vv_u32m1(end_pos, prev, n_runs);
+        vuint32m1_t off = __riscv_vsll_vx_u32m1(bins, 2, n_runs);
+        vuint32m1_t c = __riscv_vluxei32_v_u32m1(hist, off, n_runs);
+        __riscv_vsuxei32_v_u32m1(hist, off, __riscv_vadd_vv_u32m1(c, len, n_runs), n_runs);
+        i += vl;
+    }
+    zamlet_end_index_bound();
+}
+
+typedef void (*hist_fn)(size_t, const uint32_t*, uint32_t*);
+
+static int run_hist(const char* name, hist_fn fn, uint32_t* hist) {
+    unsigned long start = bench_timed_begin(name);
+    fn(HIST_N, hist_x, hist);
+    unsigned long cycles = bench_timed_end(start);
+
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " cycles/element)\n", name, cycles,
+           BENCH_RATE(cycles, HIST_N));
+
+    size_t bad = bench_mismatches32(hist, hist_expected, HIST_BINS);
+    if (bad) {
+        printf("FAIL %s: %zu of %d bins wrong\n", name, bad, HIST_BINS);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    size_t vlmax = __riscv_vsetvlmax_e32m1();
+    if (vlmax > HIST_MAX_VLMAX) {
+        printf("FAIL: VLMAX %zu exceeds HIST_MAX_VLMAX %d\n", vlmax, HIST_MAX_VLMAX);
+        return 1;
+    }
+    uint32_t* hist = vpu_alloc_ew(HIST_BINS * sizeof(uint32_t), 32);
+
+    printf("histogram n = %d, bins = %d, vl = %zu\n", HIST_N, HIST_BINS, vlmax);
+
+#if PREALLOCATE
+    hist_privatized(HIST_N, hist_x, hist);
+#endif
+
+    if (run_hist("hist_privatized", hist_privatized, hist))
+        return 1;
+    if (run_hist("hist_sorted", hist_sorted, hist))
+        return 1;
+
+    printf("PASSED\n");
+    return 0;
+}
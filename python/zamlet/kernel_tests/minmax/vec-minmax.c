@@ -0,0 +1,142 @@
+/*
+ * Checks and times the vminmax library (common/vminmax.h) on minmax_n elements of i32,
+ * i64, f32 and f64, with src[i] = (37 i mod 101) - 50. Once n passes 101 the min and the
+ * max repeat, so the arg functions must return the first of them. The expected results
+ * come from the same formula on the scalar core, which never reads VPU memory.
+ *
+ * max_<S> and argmax_<S> are timed in their own bench regions. argmax_strips_f32 is the
+ * form vminmax replaces: a vfredmax, vmfeq and vfirst per strip, so every strip waits on
+ * a reduction across the kamlets, where vminmax_argmax_f32 waits on two in all.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "vminmax.h"
+
+// One 32-bit and one 64-bit array, well inside their 256 KiB heaps.
+#define MINMAX_MAX_N 4096
+
+// Elements per array; kernel_test overrides it through symbol_values.
+volatile int32_t minmax_n = 256;
+
+static int64_t pattern(size_t i) {
+    return (int64_t)(i * 37 % 101) - 50;
+}
+
+// Index of the first min (best < 0) or max (best > 0) of the pattern over n elements.
+static size_t pattern_arg(size_t n, int best) {
+    size_t arg = 0;
+    for (size_t i = 1; i < n; i++)
+        if (best > 0 ? pattern(i) > pattern(arg) : pattern(i) < pattern(arg))
+            arg = i;
+    return arg;
+}
+
+/*
+ * MINMAX_CHECK_DEFINE(S, T, EW) defines int run_S(T* src, size_t n), which fills src
+ * with the pattern and returns nonzero on a wrong result. The pattern is built at
+ * e<EW> in integers and converted to T by MINMAX_FROM_INT_S.
+ */
+#define MINMAX_CHECK_DEFINE(S, T, EW)                                                    \
+static void fill_##S(T* x, size_t n) {                                                   \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vuint##EW##m4_t idx = __riscv_vadd_vx_u##EW##m4(__riscv_vid_v_u##EW##m4(vl), i, vl); \
+        vuint##EW##m4_t r = __riscv_vremu_vx_u##EW##m4(                                  \
+            __riscv_vmul_vx_u##EW##m4(idx, 37, vl), 101, vl);                            \
+        vint##EW##m4_t v = __riscv_vsub_vx_i##EW##m4(                                    \
+            __riscv_vreinterpret_v_u##EW##m4_i##EW##m4(r), 50, vl);                      \
+        __riscv_vse##EW##_v_##S##m4(&x[i], MINMAX_FROM_INT_##S(v, vl), vl);              \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+static int run_##S(T* src, size_t n) {                                                   \
+    fill_##S(src, n);                                                                    \
+    size_t want_argmin = pattern_arg(n, -1);                                             \
+    size_t want_argmax = pattern_arg(n, 1);                                              \
+                                                                                         \
+    unsigned long start = bench_timed_begin("max_" #S);                                  \
+    T max = vminmax_max_##S(src, n);                                                     \
+    unsigned long max_cycles = bench_timed_end(start);                                   \
+    start = bench_timed_begin("argmax_" #S);                                             \
+    size_t argmax = vminmax_argmax_##S(src, n);                                          \
+    unsigned long argmax_cycles = bench_timed_end(start);                                \
+    T min = vminmax_min_##S(src, n);                                                     \
+    size_t argmin = vminmax_argmin_##S(src, n);                                          \
+                                                                                         \
+    if (min != (T)pattern(want_argmin) || max != (T)pattern(want_argmax) ||              \
+            argmin != want_argmin || argmax != want_argmax) {                            \
+        printf("FAIL " #S ": min %ld at %zu, max %ld at %zu; expected %ld at %zu, "      \
+               "%ld at %zu\n", (long)min, argmin, (long)max, argmax,                     \
+               (long)pattern(want_argmin), want_argmin, (long)pattern(want_argmax),      \
+               want_argmax);                                                             \
+        return 1;                                                                        \
+    }                                                                                    \
+    printf(#S ": max %lu cycles, argmax %lu cycles\n", max_cycles, argmax_cycles);       \
+    return 0;                                                                            \
+}
+
+#define MINMAX_FROM_INT_i32(v, vl) (v)
+#define MINMAX_FROM_INT_i64(v, vl) (v)
+#define MINMAX_FROM_INT_f32(v, vl) __riscv_vfcvt_f_x_v_f32m4(v, vl)
+#define MINMAX_FROM_INT_f64(v, vl) __riscv_vfcvt_f_x_v_f64m4(v, vl)
+
+MINMAX_CHECK_DEFINE(i32, int32_t, 32)
+MINMAX_CHECK_DEFINE(i64, int64_t, 64)
+MINMAX_CHECK_DEFINE(f32, float, 32)
+MINMAX_CHECK_DEFINE(f64, double, 64)
+
+// Argmax with a reduction per strip: the running max lives on the scalar core.
+static size_t argmax_strips_f32(const float* src, size_t n) {
+    float best = 0.0f;
+    size_t arg = 0;
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m4(n - i);
+        vfloat32m4_t v = __riscv_vle32_v_f32m4(&src[i], vl);
+        vfloat32m1_t seed = __riscv_vlmul_trunc_v_f32m4_f32m1(v);
+        float max = __riscv_vfmv_f_s_f32m1_f32(__riscv_vfredmax_vs_f32m4_f32m1(v, seed, vl));
+        if (i == 0 || max > best) {
+            best = max;
+            arg = i + __riscv_vfirst_m_b8(__riscv_vmfeq_vf_f32m4_b8(v, max, vl), vl);
+        }
+        i += vl;
+    }
+    return arg;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int32_t n_sym = minmax_n;
+    if (n_sym <= 0 || n_sym > MINMAX_MAX_N) {
+        printf("FAIL minmax_n = %d, must be in [1, %d]\n", (int)n_sym, (int)MINMAX_MAX_N);
+        return 1;
+    }
+    size_t n = (size_t)n_sym;
+    printf("vminmax n = %zu\n", n);
+
+    // i64 and f64 share the 64-bit array, i32 and f32 the 32-bit one.
+    void* a32 = vpu_alloc_ew(n * sizeof(uint32_t), 32);
+    void* a64 = vpu_alloc_ew(n * sizeof(uint64_t), 64);
+
+    if (run_i32(a32, n) || run_i64(a64, n) || run_f64(a64, n) || run_f32(a32, n))
+        return 1;
+
+    // a32 still holds the f32 pattern.
+    unsigned long start = bench_timed_begin("argmax_strips_f32");
+    size_t arg = argmax_strips_f32(a32, n);
+    unsigned long cycles = bench_timed_end(start);
+    if (arg != pattern_arg(n, 1)) {
+        printf("FAIL argmax_strips_f32: %zu, expected %zu\n", arg, pattern_arg(n, 1));
+        return 1;
+    }
+    printf("argmax_strips_f32: %lu cycles\n", cycles);
+
+    printf("PASSED\n");
+    return 0;
+}
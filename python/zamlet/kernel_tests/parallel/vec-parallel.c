@@ -0,0 +1,262 @@
+/*
+ * parallel_for (parallel.h) demo: daxpy (y = a · x + y over par_n elements) and a
+ * column-major gemv (y = A · x, A par_rows x par_cols), each hart driving its slice of
+ * the elements or rows through the VPU. thread_entry runs on all nc harts crt.S starts;
+ * hart 0 sets up, times each kernel between barriers and checks the result.
+ *
+ * Each kernel is reported for the nc harts in cycles and elements (daxpy) or
+ * multiply-adds (gemv) per cycle, the figure that shows whether throughput scales with
+ * the hart count when the kernel is built with different NHARTS. It is then run with the
+ * work dealt into p = 2, 4, ... par_split slices that hart 0 drives back to back, and
+ * reported as a multiple of the one-slice run: the cost of the partition itself (a
+ * short last strip per slice, and for gemv the scalar loads of x repeated per slice),
+ * which a multi-hart speedup has to beat.
+ *
+ * Slices are rounded to the e64m8 VLMAX. The inputs are small integers, so the results
+ * are exact and are checked against closed forms with vector compares, so the scalar
+ * core never reads VPU memory. par_n, par_rows, par_cols and par_split are set with
+ * SYMBOL_VALUES.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "parallel.h"
+
+#define PAR_MAX_N 4096
+#define PAR_MAX_COLS 256
+#define PAR_MAX_SPLIT 16
+#define PAR_A 3.0
+
+// kernel_test overrides these through symbol_values.
+volatile int32_t par_n = 1024;
+volatile int32_t par_rows = 64;
+volatile int32_t par_cols = 32;
+volatile int32_t par_split = 4;
+
+typedef struct {
+    size_t n, rows, cols;
+    double* x;
+    double* y;
+    double* mat;
+    double* y_mv;
+    double x_mv[PAR_MAX_COLS];  // read by the scalar core
+} par_data;
+
+static par_data data;
+static int status;
+
+static void daxpy_slice(size_t begin, size_t end, void* arg) {
+    par_data* d = arg;
+    for (size_t i = begin; i < end; ) {
+        size_t vl = __riscv_vsetvl_e64m8(end - i);
+        vfloat64m8_t v_x = __riscv_vle64_v_f64m8(&d->x[i], vl);
+        vfloat64m8_t v_y = __riscv_vle64_v_f64m8(&d->y[i], vl);
+        __riscv_vse64_v_f64m8(&d->y[i], __riscv_vfmacc_vf_f64m8(v_y, PAR_A, v_x, vl), vl);
+        i += vl;
+    }
+}
+
+// Rows [begin, end) of y_mv = mat · x_mv, mat column-major.
+static void gemv_slice(size_t begin, size_t end, void* arg) {
+    par_data* d = arg;
+    for (size_t i = begin; i < end; ) {
+        size_t vl = __riscv_vsetvl_e64m8(end - i);
+        vfloat64m8_t acc = __riscv_vfmv_v_f_f64m8(0.0, vl);
+        for (size_t j = 0; j < d->cols; j++) {
+            vfloat64m8_t v_a = __riscv_vle64_v_f64m8(&d->mat[j * d->rows + i], vl);
+            acc = __riscv_vfmacc_vf_f64m8(acc, d->x_mv[j], v_a, vl);
+        }
+        __riscv_vse64_v_f64m8(&d->y_mv[i], acc, vl);
+        i += vl;
+    }
+}
+
+// p[i] = scale · (i & mask) + bias for i in [0, n).
+static void fill_pattern(double* p, size_t n, unsigned mask, double scale, double bias) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        vuint64m8_t k = __riscv_vand_vx_u64m8(
+            __riscv_vadd_vx_u64m8(__riscv_vid_v_u64m8(vl), i, vl), mask, vl);
+        vfloat64m8_t v = __riscv_vfcvt_f_xu_v_f64m8(k, vl);
+        __riscv_vse64_v_f64m8(&p[i], __riscv_vfadd_vf_f64m8(
+            __riscv_vfmul_vf_f64m8(v, scale, vl), bias, vl), vl);
+        i += vl;
+    }
+}
+
+// Elements of p[0, n) that differ from scale · (i & mask) + bias.
+static size_t mismatches(const double* p, size_t n, unsigned mask, double scale,
+                         double bias) {
+    size_t bad = 0;
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        vuint64m8_t k = __riscv_vand_vx_u64m8(
+            __riscv_vadd_vx_u64m8(__riscv_vid_v_u64m8(vl), i, vl), mask, vl);
+        vfloat64m8_t want = __riscv_vfadd_vf_f64m8(
+            __riscv_vfmul_vf_f64m8(__riscv_vfcvt_f_xu_v_f64m8(k, vl), scale, vl), bias, vl);
+        vbool8_t ne = __riscv_vmfne_vv_f64m8_b8(__riscv_vle64_v_f64m8(&p[i], vl), want, vl);
+        bad += __riscv_vcpop_m_b8(ne, vl);
+        i += vl;
+    }
+    return bad;
+}
+
+// x[i] = i & 63 and y = 1 before each daxpy, so y[i] = 3 · (i & 63) + 1 after it.
+static void daxpy_reset(par_data* d) {
+    fill_pattern(d->y, d->n, 0, 0.0, 1.0);
+}
+
+static size_t daxpy_check(par_data* d) {
+    return mismatches(d->y, d->n, 63, PAR_A, 1.0);
+}
+
+// mat[j][i] = (i & 15) + (j & 7) and x_mv[j] = 1 + (j & 1), so
+// y_mv[i] = (i & 15) · sum_j x_mv[j] + sum_j (j & 7) · x_mv[j].
+static size_t gemv_check(par_data* d) {
+    double sx = 0.0, sjx = 0.0;
+    for (size_t j = 0; j < d->cols; j++) {
+        sx += d->x_mv[j];
+        sjx += (double)(j & 7) * d->x_mv[j];
+    }
+    return mismatches(d->y_mv, d->rows, 15, sx, sjx);
+}
+
+static void gemv_reset(par_data* d) {
+    fill_pattern(d->y_mv, d->rows, 0, 0.0, -1.0);
+}
+
+typedef struct {
+    const char* name;
+    parallel_fn fn;
+    void (*reset)(par_data*);
+    size_t (*check)(par_data*);
+    size_t (*work)(par_data*);  // elements or multiply-adds per run
+    size_t (*items)(par_data*);  // the range parallel_for splits
+} par_kernel;
+
+static size_t daxpy_work(par_data* d) { return d->n; }
+static size_t gemv_work(par_data* d) { return d->rows * d->cols; }
+static size_t daxpy_items(par_data* d) { return d->n; }
+static size_t gemv_items(par_data* d) { return d->rows; }
+
+static const par_kernel kernels[] = {
+    {"daxpy", daxpy_slice, daxpy_reset, daxpy_check, daxpy_work, daxpy_items},
+    {"gemv", gemv_slice, gemv_reset, gemv_check, gemv_work, gemv_items},
+};
+
+static char region[32];
+
+// Hart 0 only: the kernel dealt into p slices, driven back to back, in cycles, or 0 if
+// the result is wrong.
+static unsigned long run_split(const par_kernel* k, size_t p, size_t grain) {
+    size_t items = k->items(&data);
+    k->reset(&data);
+    sprintf(region, "%s_split%zu", k->name, p);
+    unsigned long start = bench_timed_begin(region);
+    for (size_t c = 0; c < p; c++) {
+        size_t begin, end;
+        parallel_slice(c, p, items, grain, &begin, &end);
+        if (begin < end)
+            k->fn(begin, end, &data);
+    }
+    unsigned long cycles = bench_timed_end(start);
+    size_t bad = k->check(&data);
+    if (bad) {
+        printf("FAIL %s: %zu elements wrong\n", region, bad);
+        return 0;
+    }
+    return cycles;
+}
+
+static void setup(void) {
+    data.n = par_n;
+    data.rows = par_rows;
+    data.cols = par_cols;
+    data.x = vpu_alloc_ew(data.n * sizeof(double), 64);
+    data.y = vpu_alloc_ew(data.n * sizeof(double), 64);
+    data.mat = vpu_alloc_ew(data.rows * data.cols * sizeof(double), 64);
+    data.y_mv = vpu_alloc_ew(data.rows * sizeof(double), 64);
+    fill_pattern(data.x, data.n, 63, 1.0, 0.0);
+    for (size_t j = 0; j < data.cols; j++) {
+        fill_pattern(&data.mat[j * data.rows], data.rows, 15, 1.0, (double)(j & 7));
+        data.x_mv[j] = 1.0 + (double)(j & 1);
+    }
+}
+
+void thread_entry(int cid, int nc) {
+    size_t grain = __riscv_vsetvlmax_e64m8();
+    size_t split = par_split;
+    if (cid == 0) {
+        printf("parallel %d harts, daxpy n = %d, gemv %d x %d, split up to %zu\n", nc,
+               (int)par_n, (int)par_rows, (int)par_cols, split);
+        if (par_n <= 0 || par_n > PAR_MAX_N || par_rows <= 0 || par_cols <= 0 ||
+            par_cols > PAR_MAX_COLS || par_rows * par_cols > PAR_MAX_N || split == 0 ||
+            split > PAR_MAX_SPLIT) {
+            printf("FAIL need 0 < par_n <= %d, 0 < par_cols <= %d, "
+                   "par_rows * par_cols <= %d and 0 < par_split <= %d\n", PAR_MAX_N,
+                   PAR_MAX_COLS, PAR_MAX_N, PAR_MAX_SPLIT);
+            status = 1;
+        } else {
+            setup();
+        }
+    }
+    parallel_barrier(nc);
+    // status is only set by hart 0 before the barrier here; after it, failures are
+    // recorded and the harts keep going so they all reach the same barriers.
+    int run = !status;
+
+    for (size_t kk = 0; run && kk < sizeof(kernels) / sizeof(kernels[0]); kk++) {
+        const par_kernel* k = &kernels[kk];
+        unsigned long start = 0;
+        if (cid == 0) {
+            k->reset(&data);
+            sprintf(region, "%s_harts%d", k->name, nc);
+        }
+        parallel_barrier(nc);
+        if (cid == 0)
+            start = bench_timed_begin(region);
+        parallel_for(cid, nc, k->items(&data), grain, k->fn, &data);
+        if (cid != 0)
+            continue;
+        unsigned long cycles = bench_timed_end(start);
+        size_t bad = k->check(&data);
+        if (bad) {
+            printf("FAIL %s: %zu elements wrong\n", region, bad);
+            status = 1;
+            continue;
+        }
+        printf("%s: %lu cycles, " BENCH_RATE_FMT " per cycle\n", region, cycles,
+               BENCH_RATE(k->work(&data), cycles));
+
+        unsigned long one = run_split(k, 1, grain);
+        for (size_t p = 2; p <= split && one; p *= 2) {
+            unsigned long c = run_split(k, p, grain);
+            if (!c) {
+                one = 0;
+                break;
+            }
+            printf("%s: %lu cycles (" BENCH_RATE_FMT "x one slice)\n", region, c,
+                   BENCH_RATE(c, one));
+        }
+        if (!one)
+            status = 1;
+    }
+
+    parallel_barrier(nc);
+    // Only hart 0 goes on to main, which reports the result.
+    while (cid != 0)
+        ;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    if (status)
+        return 1;
+    printf("PASSED\n");
+    return 0;
+}
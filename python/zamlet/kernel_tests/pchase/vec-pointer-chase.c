@@ -0,0 +1,188 @@
+/*
+ * Scalar load latency from VPU memory, measured with a dependent pointer chase in the style
+ * of lmbench's lat_mem_rd. Every element of a chase array holds the address of the element
+ * CHASE_STEP further on, modulo chase_n, so following it from any start visits all chase_n
+ * elements before coming back. Each ld waits for the one before it, and chase_steps of
+ * them in bench region chase_vpu give the round trip of a scalar load through the kamlets.
+ * The same chase over an array in scalar memory, chase_scalar, is the control.
+ *
+ * chase_vpu_x<k> splits the chase_steps loads across k chases that start chase_n / k
+ * elements apart. The chases do not depend on each other, so the loads of one overlap
+ * with those of the others for as long as the lamlet has room for outstanding scalar
+ * reads, and cycles per load stops dropping once k passes that number.
+ *
+ * Both arrays are filled by scalar stores and warmed by one untimed lap, which must come
+ * back to its start. Each timed chase must end on the element CHASE_STEP * its loads past
+ * its start.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include "util.h"
+#include "bench_check.h"
+
+#define CHASE_MAX_N 4096
+// Nine words, so consecutive loads land on different words and cache lines.
+#define CHASE_STEP 9
+
+// kernel_test overrides these through symbol_values.
+volatile int32_t chase_n = 256;
+volatile int32_t chase_steps = 512;
+
+static uint64_t chase_vpu[CHASE_MAX_N] __attribute__((section(".data.vpu64")));
+static uint64_t chase_scalar[CHASE_MAX_N];
+
+static void link_chase(uint64_t* a, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        a[i] = (uint64_t)(uintptr_t)&a[(i + CHASE_STEP) % n];
+}
+
+#define CHASE_LOAD(p) p = (uint64_t*)(uintptr_t)*(p)
+
+static uint64_t* chase_x1(uint64_t* p, long steps) {
+    for (long s = 0; s < steps; s++)
+        CHASE_LOAD(p);
+    return p;
+}
+
+// The chases stay in registers, so their loads are independent instructions.
+static void chase_x2(uint64_t** p, long steps) {
+    uint64_t* p0 = p[0];
+    uint64_t* p1 = p[1];
+    for (long s = 0; s < steps; s++) {
+        CHASE_LOAD(p0);
+        CHASE_LOAD(p1);
+    }
+    p[0] = p0;
+    p[1] = p1;
+}
+
+static void chase_x4(uint64_t** p, long steps) {
+    uint64_t* p0 = p[0];
+    uint64_t* p1 = p[1];
+    uint64_t* p2 = p[2];
+    uint64_t* p3 = p[3];
+    for (long s = 0; s < steps; s++) {
+        CHASE_LOAD(p0);
+        CHASE_LOAD(p1);
+        CHASE_LOAD(p2);
+        CHASE_LOAD(p3);
+    }
+    p[0] = p0;
+    p[1] = p1;
+    p[2] = p2;
+    p[3] = p3;
+}
+
+static void chase_x8(uint64_t** p, long steps) {
+    uint64_t* p0 = p[0];
+    uint64_t* p1 = p[1];
+    uint64_t* p2 = p[2];
+    uint64_t* p3 = p[3];
+    uint64_t* p4 = p[4];
+    uint64_t* p5 = p[5];
+    uint64_t* p6 = p[6];
+    uint64_t* p7 = p[7];
+    for (long s = 0; s < steps; s++) {
+        CHASE_LOAD(p0);
+        CHASE_LOAD(p1);
+        CHASE_LOAD(p2);
+        CHASE_LOAD(p3);
+        CHASE_LOAD(p4);
+        CHASE_LOAD(p5);
+        CHASE_LOAD(p6);
+        CHASE_LOAD(p7);
+    }
+    p[0] = p0;
+    p[1] = p1;
+    p[2] = p2;
+    p[3] = p3;
+    p[4] = p4;
+    p[5] = p5;
+    p[6] = p6;
+    p[7] = p7;
+}
+
+#define MAX_CHASES 8
+
+static char region[32];
+
+// Runs k chases of steps / k loads each over a in its own bench region, sets *cycles_out
+// to the cycles taken and returns 1 if a chase ends on the wrong element.
+static int timed_chase(const char* name, uint64_t* a, size_t n, int k, long steps,
+                       unsigned long* cycles_out) {
+    uint64_t* p[MAX_CHASES];
+    for (int j = 0; j < k; j++)
+        p[j] = &a[j * (n / k)];
+    long per_chase = steps / k;
+
+    if (k == 1)
+        sprintf(region, "%s", name);
+    else
+        sprintf(region, "%s_x%d", name, k);
+    unsigned long start = bench_timed_begin(region);
+    if (k == 1)
+        p[0] = chase_x1(p[0], per_chase);
+    else if (k == 2)
+        chase_x2(p, per_chase);
+    else if (k == 4)
+        chase_x4(p, per_chase);
+    else
+        chase_x8(p, per_chase);
+    unsigned long cycles = bench_timed_end(start);
+
+    for (int j = 0; j < k; j++) {
+        size_t want = (j * (n / k) + (size_t)per_chase * CHASE_STEP) % n;
+        if (p[j] != &a[want]) {
+            printf("FAIL %s chase %d ended on element %ld, expected %zu\n", region, j,
+                   (long)(p[j] - a), want);
+            return 1;
+        }
+    }
+    unsigned long loads = (unsigned long)per_chase * k;
+    printf("%s: %lu loads, %lu cycles (" BENCH_RATE_FMT " cycles/load)\n", region, loads,
+           cycles, BENCH_RATE(cycles, loads));
+    *cycles_out = cycles;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int32_t n_sym = chase_n;
+    int32_t steps = chase_steps;
+    if (n_sym < MAX_CHASES || n_sym > CHASE_MAX_N || (n_sym & (n_sym - 1)) != 0) {
+        printf("FAIL chase_n = %d, must be a power of two in [%d, %d]\n", (int)n_sym,
+               MAX_CHASES, CHASE_MAX_N);
+        return 1;
+    }
+    if (steps < MAX_CHASES || steps % MAX_CHASES != 0) {
+        printf("FAIL chase_steps = %d, must be a positive multiple of %d\n", (int)steps,
+               MAX_CHASES);
+        return 1;
+    }
+    size_t n = (size_t)n_sym;
+    printf("pointer chase n = %zu (%zu bytes), %d loads, step %d words\n", n,
+           n * sizeof(uint64_t), (int)steps, CHASE_STEP);
+
+    link_chase(chase_scalar, n);
+    link_chase(chase_vpu, n);
+    if (chase_x1(chase_scalar, n) != chase_scalar || chase_x1(chase_vpu, n) != chase_vpu) {
+        printf("FAIL a lap of the chase did not come back to its start\n");
+        return 1;
+    }
+
+    unsigned long latency, cycles;
+    if (timed_chase("chase_scalar", chase_scalar, n, 1, steps, &cycles) ||
+        timed_chase("chase_vpu", chase_vpu, n, 1, steps, &latency))
+        return 1;
+    for (int k = 2; k <= MAX_CHASES; k *= 2) {
+        if (timed_chase("chase_vpu", chase_vpu, n, k, steps, &cycles))
+            return 1;
+        printf("chase_vpu_x%d: " BENCH_RATE_FMT " times as fast as one chase\n", k,
+               BENCH_RATE(latency, cycles));
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
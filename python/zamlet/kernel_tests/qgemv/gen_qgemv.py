@@ -0,0 +1,49 @@
+"""Generate an int8 GEMV dataset header for y = diag(scale) · (W · x).
+
+Usage:
+    python gen_qgemv.py M N [--seed S] > qgemv_data.h
+
+Declares:
+    #define QGEMV_M M
+    #define QGEMV_N N
+    int8_t  qgemv_w[N * M] __attribute__((section(".data.vpu8")));   // w[j · M + i] = W[i][j]
+    int32_t qgemv_x[N];                                              // scalar memory
+    float   qgemv_scale[M] __attribute__((section(".data.vpu32")));
+    float   qgemv_expected[M] __attribute__((section(".data.vpu32")));
+
+W is stored input-major (column j of W is contiguous) so the kernel streams it with
+unit-stride loads along the output axis. x is read one element per column by the scalar
+core, so it stays in scalar memory. Scales are powers of two and every row sum is below
+2^24, so the f32 results are exact.
+"""
+import argparse
+import random
+
+from gen_header import emit
+
+parser = argparse.ArgumentParser()
+parser.add_argument("M", type=int)
+parser.add_argument("N", type=int)
+parser.add_argument("--seed", type=int, default=0)
+args = parser.parse_args()
+
+rng = random.Random(args.seed)
+m, n = args.M, args.N
+w = [[rng.randint(-128, 127) for _ in range(n)] for _ in range(m)]
+x = [rng.randint(-64, 64) for _ in range(n)]
+scale = [2.0 ** -rng.randint(0, 10) for _ in range(m)]
+acc = [sum(w[i][j] * x[j] for j in range(n)) for i in range(m)]
+assert all(abs(a) < 2 ** 24 for a in acc), "row sums must be exact in f32"
+expected = [acc[i] * scale[i] for i in range(m)]
+
+
+print(f"// Generated by gen_qgemv.py {m} {n}")
+print("#include <stdint.h>")
+print()
+print(f"#define QGEMV_M {m}")
+print(f"#define QGEMV_N {n}")
+print()
+emit("int8_t", "qgemv_w", [w[i][j] for j in range(n) for i in range(m)], ".data.vpu8")
+emit("int32_t", "qgemv_x", x)
+emit("float", "qgemv_scale", scale, ".data.vpu32", lambda v: f"{v!r}f")
+emit("float", "qgemv_expected", expected, ".data.vpu32", lambda v: f"{v!r}f")
@@ -0,0 +1,107 @@
+/*
+ * Quantized GEMV: y[i] = scale[i] · sum_j W[i][j] · x[j], with int8 weights, int32
+ * activations, int32 accumulation and a per-row f32 dequantization scale.
+ *
+ * W is stored input-major (w[j · M + i] = W[i][j]), so the kernel runs in the same axpy
+ * form as vec_sgemv_rvv: each strip of vl outputs lives in int32 accumulators for all N
+ * columns while column j of W is streamed in with a unit-stride e8 load, sign-extended
+ * with vsext.vf4 and accumulated with vmacc.vx against the scalar x[j]. There is no
+ * reduction; W is read exactly once, at one byte per weight. Columns are taken two at a
+ * time into two accumulators to keep two independent vmacc chains in flight, which at
+ * e32m4 uses 18 of the 32 vector registers. At the end of a strip the accumulators are
+ * added, converted to f32 and multiplied by the strip of scales.
+ *
+ * QGEMV_HEADER (gen_qgemv.py M N) supplies the sizes, W and the scales and expected y
+ * in VPU memory, and x in scalar memory.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include QGEMV_HEADER
+
+void vec_qgemv(size_t m, size_t n, const int8_t* w, const int32_t* x, const float* scale,
+               float* y) {
+    for (size_t i = 0; i < m; ) {
+        size_t vl = __riscv_vsetvl_e32m4(m - i);
+        vint32m4_t acc0 = __riscv_vmv_v_x_i32m4(0, vl);
+        vint32m4_t acc1 = __riscv_vmv_v_x_i32m4(0, vl);
+        const int8_t* col = &w[i];
+        size_t j = 0;
+        for (; j + 1 < n; j += 2) {
+            vint32m4_t w0 = __riscv_vsext_vf4_i32m4(__riscv_vle8_v_i8m1(col, vl), vl);
+            vint32m4_t w1 = __riscv_vsext_vf4_i32m4(__riscv_vle8_v_i8m1(col + m, vl), vl);
+            acc0 = __riscv_vmacc_vx_i32m4(acc0, x[j], w0, vl);
+            acc1 = __riscv_vmacc_vx_i32m4(acc1, x[j + 1], w1, vl);
+            col += 2 * m;
+        }
+        if (j < n) {
+            vint32m4_t w0 = __riscv_vsext_vf4_i32m4(__riscv_vle8_v_i8m1(col, vl), vl);
+            acc0 = __riscv_vmacc_vx_i32m4(acc0, x[j], w0, vl);
+        }
+        acc0 = __riscv_vadd_vv_i32m4(acc0, acc1, vl);
+        vfloat32m4_t out = __riscv_vfcvt_f_x_v_f32m4(acc0, vl);
+        out = __riscv_vfmul_vv_f32m4(out, __riscv_vle32_v_f32m4(&scale[i], vl), vl);
+        __riscv_vse32_v_f32m4(&y[i], out, vl);
+        i += vl;
+    }
+}
+
+// Scalar reference with the same contract.
+void qgemv_scalar(size_t m, size_t n, const int8_t* w, const int32_t* x, const float* scale,
+                  float* y) {
+    for (size_t i = 0; i < m; i++) {
+        int32_t acc = 0;
+        for (size_t j = 0; j < n; j++) {
+            acc += w[j * m + i] * x[j];
+        }
+        y[i] = (float)acc * scale[i];
+    }
+}
+
+typedef void (*qgemv_fn)(size_t, size_t, const int8_t*, const int32_t*, const float*,
+                         float*);
+
+static int run_qgemv(const char* name, qgemv_fn fn, float* y) {
+    for (size_t i = 0; i < QGEMV_M; i++)
+        y[i] = 0.0f;
+    unsigned long start = bench_timed_begin(name);
+    fn(QGEMV_M, QGEMV_N, qgemv_w, qgemv_x, qgemv_scale, y);
+    unsigned long cycles = bench_timed_end(start);
+
+    unsigned long bytes = (unsigned long)QGEMV_M * QGEMV_N;
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " weight bytes/cycle)\n", name, cycles,
+           BENCH_RATE(bytes, cycles));
+
+    for (size_t i = 0; i < QGEMV_M; i++) {
+        if (y[i] != qgemv_expected[i]) {
+            printf("FAIL %s [%zu]: got %f, expected %f\n", name, i, y[i], qgemv_expected[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    float* y = vpu_alloc_ew(QGEMV_M * sizeof(float), 32);
+
+    printf("qgemv M,N = %d,%d\n", QGEMV_M, QGEMV_N);
+
+#if PREALLOCATE
+    vec_qgemv(QGEMV_M, QGEMV_N, qgemv_w, qgemv_x, qgemv_scale, y);
+#endif
+
+    if (run_qgemv("qgemv_scalar", qgemv_scalar, y))
+        return 1;
+    if (run_qgemv("qgemv_rvv", vec_qgemv, y))
+        return 1;
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -6,6 +6,14 @@ Reads configuration from environment variables set by the kernel_test macro:
   MAX_CYCLES: maximum simulation cycles (default 100000)
   EXPECTED_FAILURE: "1" if the kernel should fail, "0" otherwise
   SYMBOL_VALUES: JSON dict of symbol name -> int value to inject (optional)
+  CYCLE_BUDGETS: JSON dict of bench region name -> maximum cycles (optional, set by
+    kernel_bench). The test fails if a budgeted region is never recorded or if any
+    record of it takes more cycles than its budget.
+  EXPECTED_OVER_BUDGET: "1" if some budgeted region should be missing or over budget
+
+Records from the kernel's bench_begin/bench_end regions are written as JSON to
+BENCH_JSON if set, otherwise to bench.json in TEST_UNDECLARED_OUTPUTS_DIR when Bazel
+provides it.
 """
 import asyncio
 import json
@@ -18,6 +26,39 @@ from zamlet.runner import Clock
 from zamlet.oamlet.run_oamlet import main as run_lamlet_main
 
 
+def write_bench_json(binary, geometry_name, exit_code, records):
+    path = os.environ.get("BENCH_JSON")
+    if path is None:
+        outputs_dir = os.environ.get("TEST_UNDECLARED_OUTPUTS_DIR")
+        if outputs_dir is None or not records:
+            return
+        path = os.path.join(outputs_dir, "bench.json")
+    result = {
+        "kernel": os.path.basename(binary),
+        "geometry": geometry_name,
+        "exit_code": exit_code,
+        "regions": records,
+    }
+    with open(path, "w") as f:
+        json.dump(result, f, indent=2)
+
+
+def check_cycle_budgets(records, budgets):
+    """Print each budgeted region's cycles and return the regions over budget."""
+    failures = []
+    for region, budget in sorted(budgets.items()):
+        assert budget > 0, f"{region}: budget must be positive, got {budget}"
+        cycles = [r["cycles"] for r in records if r["name"] == region]
+        if not cycles:
+            failures.append(f"{region}: no bench record")
+            continue
+        worst = max(cycles)
+        print(f"{region}: {worst} cycles (budget {budget}, {100 * worst // budget}%)")
+        if worst > budget:
+            failures.append(f"{region}: {worst} cycles exceeds budget {budget}")
+    return failures
+
+
 def main():
     log_level = os.environ.get("LOG_LEVEL", "WARNING")
     logging.basicConfig(level=getattr(logging, log_level), stream=sys.stderr)
@@ -27,16 +68,27 @@ def main():
     expected_failure = os.environ.get("EXPECTED_FAILURE", "0") == "1"
     symbol_values_str = os.environ.get("SYMBOL_VALUES")
     symbol_values = json.loads(symbol_values_str) if symbol_values_str else None
+    cycle_budgets_str = os.environ.get("CYCLE_BUDGETS")
+    cycle_budgets = json.loads(cycle_budgets_str) if cycle_budgets_str else {}
+    expected_over_budget = os.environ.get("EXPECTED_OVER_BUDGET", "0") == "1"
 
     clock = Clock(max_cycles=max_cycles)
-    exit_code, _monitor = asyncio.run(
+    exit_code, monitor = asyncio.run(
         run_lamlet_main(clock, binary, geometry, symbol_values=symbol_values))
 
+    write_bench_json(binary, os.environ["GEOMETRY"], exit_code, monitor.bench_records)
+
     if expected_failure:
         assert exit_code != 0, f"Kernel {binary} should have failed but returned 0"
     else:
         assert exit_code == 0, f"Kernel {binary} failed with exit code {exit_code}"
 
+    failures = check_cycle_budgets(monitor.bench_records, cycle_budgets)
+    if expected_over_budget:
+        assert failures, f"Kernel {binary} should have exceeded a cycle budget"
+    else:
+        assert not failures, f"Kernel {binary} over cycle budget: " + "; ".join(failures)
+
 
 if __name__ == "__main__":
     main()
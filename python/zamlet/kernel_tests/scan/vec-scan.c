@@ -0,0 +1,144 @@
+/*
+ * Checks and times the vscan library (common/vscan.h) on scan_n elements of u32, u64
+ * and f64, with src[i] = i mod 7 + 1 so the f64 sums stay exact.
+ *
+ * For each type the one-pass and block scans run inclusive and exclusive. The results
+ * are checked with vector compares, so the scalar core never reads VPU memory:
+ *
+ *   incl[i] == excl[i] + src[i]   and   excl[0] == 0,   excl[i + 1] == incl[i]
+ *
+ * which together pin incl to the prefix sums of src. The block results must equal
+ * the one-pass ones, and every returned total must equal the scalar sum.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "vscan.h"
+
+// Five arrays of 8-byte elements in the 256 KiB heap.
+#define SCAN_MAX_N 4096
+
+// Elements per array; kernel_test overrides it through symbol_values.
+volatile int32_t scan_n = 64;
+
+/*
+ * SCAN_CHECK_DEFINE(S, T, EW, TY, SC, CMP, B) defines
+ *   int run_S(T* src, T* incl, T* excl, T* b_incl, T* b_excl, T* sums, size_t n)
+ * where SC is the scalar operand letter (x / f), CMP the not-equal compare stem
+ * (vmsne / vmfne) and B the mask ratio of e<EW>m4 (8 / 16). It returns nonzero on a
+ * mismatch.
+ */
+#define SCAN_CHECK_DEFINE(S, T, EW, TY, SC, CMP, B)                                      \
+static void fill_##S(T* x, size_t n) {                                                   \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        vuint##EW##m4_t idx = __riscv_vadd_vx_u##EW##m4(__riscv_vid_v_u##EW##m4(vl), i, vl); \
+        vuint##EW##m4_t v = __riscv_vadd_vx_u##EW##m4(                                   \
+            __riscv_vremu_vx_u##EW##m4(idx, 7, vl), 1, vl);                              \
+        __riscv_vse##EW##_v_##S##m4(&x[i], SCAN_FROM_UINT_##S(v, vl), vl);               \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+/* Number of i < n with a[i] != b[i] + c[i], or a[i] != b[i] when c is NULL. */          \
+static size_t mismatches_##S(const T* a, const T* b, const T* c, size_t n) {             \
+    size_t bad = 0;                                                                      \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m4(n - i);                                     \
+        v##TY##EW##m4_t want = __riscv_vle##EW##_v_##S##m4(&b[i], vl);                   \
+        if (c)                                                                           \
+            want = SCAN_ADD_##S(want, __riscv_vle##EW##_v_##S##m4(&c[i], vl), vl);       \
+        vbool##B##_t ne = __riscv_##CMP##_vv_##S##m4_b##B(                               \
+            __riscv_vle##EW##_v_##S##m4(&a[i], vl), want, vl);                           \
+        bad += __riscv_vcpop_m_b##B(ne, vl);                                             \
+        i += vl;                                                                         \
+    }                                                                                    \
+    return bad;                                                                          \
+}                                                                                        \
+                                                                                         \
+static int run_##S(T* src, T* incl, T* excl, T* b_incl, T* b_excl, T* sums, size_t n) {  \
+    T want = 0;                                                                          \
+    for (size_t i = 0; i < n; i++)                                                       \
+        want += (T)(i % 7 + 1);                                                          \
+    fill_##S(src, n);                                                                    \
+                                                                                         \
+    T total[4];                                                                          \
+    unsigned long start = bench_timed_begin("vscan_" #S);                                \
+    total[0] = vscan_inclusive_##S(src, incl, n);                                        \
+    total[1] = vscan_exclusive_##S(src, excl, n);                                        \
+    unsigned long one_pass = bench_timed_end(start);                                     \
+    start = bench_timed_begin("vscan_block_" #S);                                        \
+    total[2] = vscan_block_inclusive_##S(src, b_incl, n, sums);                          \
+    total[3] = vscan_block_exclusive_##S(src, b_excl, n, sums);                          \
+    unsigned long block = bench_timed_end(start);                                        \
+    printf("vscan_" #S ": %lu cycles, block: %lu cycles (" BENCH_RATE_FMT ", "           \
+           BENCH_RATE_FMT " cycles/element/scan)\n", one_pass, block,                    \
+           BENCH_RATE(one_pass, 2 * n), BENCH_RATE(block, 2 * n));                       \
+                                                                                         \
+    int bad_total = 0;                                                                   \
+    for (int k = 0; k < 4; k++)                                                          \
+        bad_total |= total[k] != want;                                                   \
+    size_t vl = __riscv_vsetvl_e##EW##m1(1);                                             \
+    vbool##EW##_t first = __riscv_##CMP##_v##SC##_##S##m1_b##EW(                         \
+        __riscv_vle##EW##_v_##S##m1(excl, vl), 0, vl);                                   \
+    size_t bad = __riscv_vcpop_m_b##EW(first, vl);                                       \
+    bad += mismatches_##S(incl, excl, src, n);                                           \
+    bad += mismatches_##S(&excl[1], incl, NULL, n - 1);                                  \
+    bad += mismatches_##S(b_incl, incl, NULL, n);                                        \
+    bad += mismatches_##S(b_excl, excl, NULL, n);                                        \
+    if (bad_total || bad) {                                                              \
+        printf("FAIL vscan_" #S ": %zu elements wrong, totals %s\n", bad,                \
+               bad_total ? "wrong" : "right");                                           \
+        return 1;                                                                        \
+    }                                                                                    \
+    return 0;                                                                            \
+}
+
+#define SCAN_FROM_UINT_u32(v, vl) (v)
+#define SCAN_FROM_UINT_u64(v, vl) (v)
+#define SCAN_FROM_UINT_f64(v, vl) __riscv_vfcvt_f_xu_v_f64m4(v, vl)
+#define SCAN_ADD_u32 __riscv_vadd_vv_u32m4
+#define SCAN_ADD_u64 __riscv_vadd_vv_u64m4
+#define SCAN_ADD_f64 __riscv_vfadd_vv_f64m4
+
+SCAN_CHECK_DEFINE(u32, uint32_t, 32, uint, x, vmsne, 8)
+SCAN_CHECK_DEFINE(u64, uint64_t, 64, uint, x, vmsne, 16)
+SCAN_CHECK_DEFINE(f64, double, 64, float, f, vmfne, 16)
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int32_t n_sym = scan_n;
+    if (n_sym <= 0 || n_sym > SCAN_MAX_N) {
+        printf("FAIL scan_n = %d, must be in [1, %d]\n", (int)n_sym, (int)SCAN_MAX_N);
+        return 1;
+    }
+    size_t n = (size_t)n_sym;
+
+    printf("vscan n = %zu, %d strips per block\n", n, VSCAN_BLOCK_STRIPS);
+
+    // u64 and f64 reuse the 64-bit arrays.
+    void* a[5];
+    void* b[5];
+    for (int k = 0; k < 5; k++) {
+        a[k] = vpu_alloc_ew(n * sizeof(uint32_t), 32);
+        b[k] = vpu_alloc_ew(n * sizeof(uint64_t), 64);
+    }
+    uint32_t* sums32 = vpu_alloc_ew(vscan_block_sums_len(n, 32) * sizeof(uint32_t), 32);
+    uint64_t* sums64 = vpu_alloc_ew(vscan_block_sums_len(n, 64) * sizeof(uint64_t), 64);
+
+    if (run_u32(a[0], a[1], a[2], a[3], a[4], sums32, n))
+        return 1;
+    if (run_u64(b[0], b[1], b[2], b[3], b[4], sums64, n))
+        return 1;
+    if (run_f64(b[0], b[1], b[2], b[3], b[4], (double*)sums64, n))
+        return 1;
+
+    printf("PASSED\n");
+    return 0;
+}
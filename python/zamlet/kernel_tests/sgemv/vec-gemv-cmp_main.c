@@ -0,0 +1,91 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// GEMV row-wise vs column-wise benchmark
+//--------------------------------------------------------------------------
+//
+// Runs gemv_rowwise and gemv_colwise (common/ara/gemv.c) on an sgemv dataset
+// widened to double. The dataset computes c[j] = sum_i x[i] * A[i][j], which
+// is dest = A^T · x with m_row = N_DIM and v_len = M_DIM. A as stored is A^T
+// in column-major order, so the column-wise kernel uses it directly; the
+// row-wise kernel gets a transposed copy. GEMV_DATASET selects the dataset.
+
+#include <string.h>
+#include <stdio.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench.h"
+#include "ara/gemv.h"
+
+//--------------------------------------------------------------------------
+// Input/Reference Data
+
+#include GEMV_DATASET
+
+// Read by the scalar core in gemv_colwise
+static double vector_s[M_DIM];
+
+//--------------------------------------------------------------------------
+// Main
+
+typedef void (*gemv_fn)(const unsigned long int, const unsigned long int,
+                        double *, double *, double *);
+
+static int run_gemv(const char* name, gemv_fn fn, double* matrix, double* vector,
+                    double* dest)
+{
+  for (int i = 0; i < N_DIM; i++)
+    dest[i] = 0.0;
+  unsigned long cycles = read_csr(mcycle);
+  bench_begin(name);
+  fn(N_DIM, M_DIM, matrix, vector, dest);
+  bench_end();
+  cycles = read_csr(mcycle) - cycles;
+  printf("%s: %lu cycles\n", name, cycles);
+  for (int i = 0; i < N_DIM; i++) {
+    if (dest[i] != (double)verify_data[i]) {
+      printf("FAIL %s [%d]: got %f, expected %f\n", name, i, dest[i],
+             (double)verify_data[i]);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int main( int argc, char* argv[] )
+{
+  double* matrix_rm = vpu_alloc_ew(M_DIM * N_DIM * sizeof(double), 64);
+  double* matrix_cm = vpu_alloc_ew(M_DIM * N_DIM * sizeof(double), 64);
+  double* vector_v = vpu_alloc_ew(M_DIM * sizeof(double), 64);
+  double* dest = vpu_alloc_ew(N_DIM * sizeof(double), 64);
+
+  // Widen each row of A once: unit-stride into the column-major copy and
+  // strided (one column) into the row-major copy.
+  for (int i = 0; i < M_DIM; i++) {
+    for (int j = 0; j < N_DIM; ) {
+      size_t vl = __riscv_vsetvl_e32m4(N_DIM - j);
+      vfloat64m8_t row = __riscv_vfwcvt_f_f_v_f64m8(
+          __riscv_vle32_v_f32m4(&input_data_A[i * N_DIM + j], vl), vl);
+      __riscv_vse64_v_f64m8(&matrix_cm[i * N_DIM + j], row, vl);
+      __riscv_vsse64_v_f64m8(&matrix_rm[j * M_DIM + i], M_DIM * sizeof(double), row, vl);
+      j += vl;
+    }
+  }
+  for (int i = 0; i < M_DIM; i++) {
+    vector_s[i] = input_data_x[i];
+    vector_v[i] = input_data_x[i];
+  }
+
+  printf("gemv m_row,v_len = %d,%d (gemv selects %s)\n", N_DIM, M_DIM,
+         gemv_use_colwise(N_DIM, M_DIM) ? "colwise" : "rowwise");
+#if PREALLOCATE
+  gemv_rowwise(N_DIM, M_DIM, matrix_rm, vector_v, dest);
+  gemv_colwise(N_DIM, M_DIM, matrix_cm, vector_s, dest);
+#endif
+
+  int err = run_gemv("gemv_rowwise", gemv_rowwise, matrix_rm, vector_v, dest);
+  if (err)
+    return err;
+  return run_gemv("gemv_colwise", gemv_colwise, matrix_cm, vector_s, dest);
+}
@@ -0,0 +1,88 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// gemv() and gemv_layout() test
+//--------------------------------------------------------------------------
+//
+// Lays a row-major matrix out with gemv_layout() and multiplies it with gemv()
+// (common/ara/gemv.c) for one tall shape, which gemv() runs column-wise, and
+// one wide shape, which it runs row-wise. The tall shape has a margin block of
+// rows and the wide one rows longer than a slice. Entries are small integers
+// so every summation order gives the exact result.
+
+#include <stdio.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "ara/gemv.h"
+
+#define TALL_ROWS 40
+#define TALL_COLS 24
+#define WIDE_ROWS 8
+#define WIDE_COLS 160
+
+static double src_value(unsigned long i, unsigned long j) {
+  return (double)((int)((i * 3 + j * 5) % 7) - 3);
+}
+
+static double vector_value(unsigned long j) {
+  return (double)((int)(j % 5) - 2);
+}
+
+static int run_shape(const char* name, unsigned long m_row, unsigned long v_len,
+                     int want_colwise)
+{
+  double* src = vpu_alloc_ew(m_row * v_len * sizeof(double), 64);
+  double* matrix = vpu_alloc_ew(m_row * v_len * sizeof(double), 64);
+  double* vector = vpu_alloc_ew(v_len * sizeof(double), 64);
+  double* dest = vpu_alloc_ew(m_row * sizeof(double), 64);
+
+  for (unsigned long i = 0; i < m_row; i++)
+    for (unsigned long j = 0; j < v_len; j++)
+      src[i * v_len + j] = src_value(i, j);
+  for (unsigned long j = 0; j < v_len; j++)
+    vector[j] = vector_value(j);
+  for (unsigned long i = 0; i < m_row; i++)
+    dest[i] = -1.0;
+
+  int colwise = gemv_use_colwise(m_row, v_len);
+  printf("%s: %lu x %lu, gemv selects %s\n", name, m_row, v_len,
+         colwise ? "colwise" : "rowwise");
+  if (colwise != want_colwise) {
+    printf("FAIL %s: expected %s\n", name, want_colwise ? "colwise" : "rowwise");
+    return 1;
+  }
+
+  gemv_layout(m_row, v_len, src, matrix);
+  for (unsigned long i = 0; i < m_row; i++) {
+    for (unsigned long j = 0; j < v_len; j++) {
+      unsigned long at = colwise ? j * m_row + i : i * v_len + j;
+      if (matrix[at] != src_value(i, j)) {
+        printf("FAIL %s: layout [%lu][%lu] at %lu is %f, expected %f\n", name, i, j, at,
+               matrix[at], src_value(i, j));
+        return 1;
+      }
+    }
+  }
+
+  gemv(m_row, v_len, matrix, vector, dest);
+  for (unsigned long i = 0; i < m_row; i++) {
+    double golden = 0.0;
+    for (unsigned long j = 0; j < v_len; j++)
+      golden += src_value(i, j) * vector_value(j);
+    if (dest[i] != golden) {
+      printf("FAIL %s: dest[%lu] is %f, expected %f\n", name, i, dest[i], golden);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int main( int argc, char* argv[] )
+{
+  if (run_shape("gemv_tall", TALL_ROWS, TALL_COLS, 1))
+    return 1;
+  if (run_shape("gemv_wide", WIDE_ROWS, WIDE_COLS, 0))
+    return 1;
+  printf("PASSED\n");
+  return 0;
+}
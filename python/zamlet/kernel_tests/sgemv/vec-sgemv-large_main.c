@@ -10,6 +10,8 @@
 #include <stdio.h>
 #include "util.h"
 #include "vpu_alloc.h"
+#include "bench.h"
+#include "zamlet_custom.h"
 
 //--------------------------------------------------------------------------
 // Input/Reference Data
@@ -19,7 +21,22 @@
 //--------------------------------------------------------------------------
 // Main
 
-void *vec_sgemv (size_t, size_t, const float*, const float*, float*);
+void vec_sgemv (size_t, size_t, const float*, const float*, float*);
+void vec_sgemv_rvv (size_t, size_t, const float*, const float*, float*);
+
+typedef void (*sgemv_fn)(size_t, size_t, const float*, const float*, float*);
+
+static int run_sgemv(const char* name, sgemv_fn fn, float* results_data)
+{
+  memset(results_data, 0, N_DIM * sizeof(float));
+  unsigned long cycles = read_csr(mcycle);
+  bench_begin(name);
+  fn(M_DIM, N_DIM, input_data_x, input_data_A, results_data);
+  bench_end();
+  cycles = read_csr(mcycle) - cycles;
+  printf("%s: %lu cycles\n", name, cycles);
+  return vverifyFloat( N_DIM, results_data, verify_data );
+}
 
 int main( int argc, char* argv[] )
 {
@@ -28,16 +45,21 @@ int main( int argc, char* argv[] )
 
   printf("sgemv M,N = %ld,%ld\n", M_DIM, N_DIM);
 #if PREALLOCATE
-  // If needed we preallocate everything in the caches
-  vec_sgemv(M_DIM, N_DIM, input_data_x, input_data_A, results_data);
-  memset(results_data, 0, N_DIM * sizeof(float));
+  // If needed we preallocate everything in the caches. A prefetch replaces the warm-up
+  // runs; input_data_x is in scalar memory, which it skips.
+  zamlet_prefetch(input_data_A, sizeof(input_data_A));
+  zamlet_prefetch(verify_data, sizeof(verify_data));
 #endif
 
   // Do the sgemv
+  // Scalar reference, then the intrinsics version
+  int err = run_sgemv("sgemv_scalar", vec_sgemv, results_data);
+  if (err)
+    return err;
   setStats(1);
-  vec_sgemv(M_DIM, N_DIM, input_data_x, input_data_A, results_data);
+  err = run_sgemv("sgemv_rvv", vec_sgemv_rvv, results_data);
   setStats(0);
 
   // Check the results
-  return verifyFloat( N_DIM, results_data, verify_data );
+  return err;
 }
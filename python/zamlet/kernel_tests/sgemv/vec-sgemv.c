@@ -1,5 +1,7 @@
 #include <stddef.h>
+#include <riscv_vector.h>
 
+// Scalar reference: c[j] += sum_i v[i] * mat[i][j]. c is reloaded and stored for every row.
 void vec_sgemv(size_t m, size_t n, const float* v, const float* mat, float* c) {
     for (size_t i = 0; i < m; i++) {
         float vi = v[i];
@@ -8,3 +10,31 @@ void vec_sgemv(size_t m, size_t n, const float* v, const float* mat, float* c) {
         }
     }
 }
+
+// Same contract with RVV intrinsics. Each strip of c lives in an e32m8 accumulator for all
+// m rows while the matching strip of each mat row is streamed in with a unit-stride load,
+// so c is loaded and stored once per strip. Rows are taken two at a time into two m8
+// accumulators to keep two independent vfmacc chains in flight.
+void vec_sgemv_rvv(size_t m, size_t n, const float* v, const float* mat, float* c) {
+    for (size_t j = 0; j < n; ) {
+        size_t vl = __riscv_vsetvl_e32m8(n - j);
+        vfloat32m8_t acc0 = __riscv_vle32_v_f32m8(&c[j], vl);
+        vfloat32m8_t acc1 = __riscv_vfmv_v_f_f32m8(0.0f, vl);
+        const float* row = &mat[j];
+        size_t i = 0;
+        for (; i + 1 < m; i += 2) {
+            vfloat32m8_t a0 = __riscv_vle32_v_f32m8(row, vl);
+            vfloat32m8_t a1 = __riscv_vle32_v_f32m8(row + n, vl);
+            acc0 = __riscv_vfmacc_vf_f32m8(acc0, v[i], a0, vl);
+            acc1 = __riscv_vfmacc_vf_f32m8(acc1, v[i + 1], a1, vl);
+            row += 2 * n;
+        }
+        if (i < m) {
+            vfloat32m8_t a0 = __riscv_vle32_v_f32m8(row, vl);
+            acc0 = __riscv_vfmacc_vf_f32m8(acc0, v[i], a0, vl);
+        }
+        acc0 = __riscv_vfadd_vv_f32m8(acc0, acc1, vl);
+        __riscv_vse32_v_f32m8(&c[j], acc0, vl);
+        j += vl;
+    }
+}
@@ -10,6 +10,11 @@
 #include <stdio.h>
 #include "util.h"
 #include "vpu_alloc.h"
+#include "zamlet_custom.h"
+
+// Phase markers for analysis/phase_profile.py.
+#define MARK_KERNEL 1
+#define MARK_VERIFY 2
 
 //--------------------------------------------------------------------------
 // Input/Reference Data
@@ -35,9 +40,11 @@ int main( int argc, char* argv[] )
 
   // Do the sgemv
   setStats(1);
+  ZAMLET_MARK_IMM(MARK_KERNEL);
   vec_sgemv(M_DIM, N_DIM, input_data_x, input_data_A, results_data);
   setStats(0);
 
+  ZAMLET_MARK_IMM(MARK_VERIFY);
   // Check the results
-  return verifyFloat( N_DIM, results_data, verify_data );
+  return vverifyFloat( N_DIM, results_data, verify_data );
 }
@@ -0,0 +1,51 @@
+"""Generate a softmax dataset header: y[r][:] = softmax(x[r][:]) for each row r.
+
+Usage:
+    python gen_softmax.py ROWS COLS [--seed S] > softmax_data.h
+
+Declares:
+    #define SOFTMAX_ROWS ROWS
+    #define SOFTMAX_COLS COLS
+    float softmax_x[ROWS * COLS] __attribute__((section(".data.vpu32")));
+    float softmax_expected[ROWS * COLS] __attribute__((section(".data.vpu32")));
+
+Inputs are uniform in [-8, 8] with a per-row offset, so rows exercise different maxima.
+Inputs are rounded to float before the expected values are computed in double precision.
+"""
+import argparse
+import math
+import random
+
+from gen_header import emit, f32
+
+parser = argparse.ArgumentParser()
+parser.add_argument("ROWS", type=int)
+parser.add_argument("COLS", type=int)
+parser.add_argument("--seed", type=int, default=0)
+args = parser.parse_args()
+
+
+rng = random.Random(args.seed)
+rows, cols = args.ROWS, args.COLS
+x = []
+expected = []
+for r in range(rows):
+    offset = rng.uniform(-20.0, 20.0)
+    row = [f32(offset + rng.uniform(-8.0, 8.0)) for _ in range(cols)]
+    top = max(row)
+    e = [math.exp(v - top) for v in row]
+    total = sum(e)
+    x.extend(row)
+    expected.extend(v / total for v in e)
+
+
+def float_literal(v):
+    return f"{v:.9e}f"
+
+
+print(f"// Generated by gen_softmax.py {rows} {cols}")
+print(f"#define SOFTMAX_ROWS {rows}")
+print(f"#define SOFTMAX_COLS {cols}")
+print()
+emit("float", "softmax_x", x, ".data.vpu32", float_literal, 8)
+emit("float", "softmax_expected", expected, ".data.vpu32", float_literal, 8)
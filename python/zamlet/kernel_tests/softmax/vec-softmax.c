@@ -0,0 +1,154 @@
+/*
+ * Row softmax y = exp(x - max(x)) / sum(exp(x - max(x))) in f32, using __exp_f32m2 from
+ * common/ara/exp.h.
+ *
+ * softmax_4pass is the textbook form: a max pass, an exp pass writing y, a sum pass over
+ * y and a scale pass rewriting y, so x is read twice and y is read twice and written
+ * twice.
+ *
+ * softmax_2pass fuses this into two streaming passes. Pass 1 keeps a per-lane running
+ * max m and a per-lane running sum s of exp(x - m): when a strip raises m, s is first
+ * rescaled by exp(m_old - m_new). At the end the lanes are combined into the row max M
+ * and the row sum S = sum_l s_l · exp(m_l - M). Pass 2 writes y = exp(x - M) · (1 / S).
+ * x is read twice and y written once, at the cost of two exps per element in pass 1.
+ *
+ * Lanes past the end of a short row keep m = SOFTMAX_NEG_BIG and s = 0 (the strip
+ * updates are tail undisturbed), so they add nothing when the lanes are combined.
+ *
+ * SOFTMAX_HEADER (gen_softmax.py ROWS COLS) supplies x and the expected y.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "math.h"
+#include "ara/exp.h"
+#include SOFTMAX_HEADER
+
+// exp.h defines __exp_f32m2 as a C99 inline definition; this declaration makes this
+// translation unit emit the external definition, for calls that are not inlined.
+extern vfloat32m2_t __exp_f32m2(vfloat32m2_t x, size_t gvl);
+
+// Finite, so m_old - m_new never produces inf - inf.
+#define SOFTMAX_NEG_BIG (-3.0e38f)
+
+static float reduce_max(vfloat32m2_t v, size_t vl) {
+    vfloat32m1_t init = __riscv_vfmv_s_f_f32m1(SOFTMAX_NEG_BIG, 1);
+    return __riscv_vfmv_f_s_f32m1_f32(__riscv_vfredmax_vs_f32m2_f32m1(v, init, vl));
+}
+
+static float reduce_sum(vfloat32m2_t v, size_t vl) {
+    vfloat32m1_t init = __riscv_vfmv_s_f_f32m1(0.0f, 1);
+    return __riscv_vfmv_f_s_f32m1_f32(__riscv_vfredusum_vs_f32m2_f32m1(v, init, vl));
+}
+
+// y[i] = exp(x[i] - mx) · inv
+static void exp_scale(const float* x, float* y, size_t n, float mx, float inv) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m2(n - i);
+        vfloat32m2_t v = __riscv_vle32_v_f32m2(&x[i], vl);
+        vfloat32m2_t e = __exp_f32m2(__riscv_vfsub_vf_f32m2(v, mx, vl), vl);
+        __riscv_vse32_v_f32m2(&y[i], __riscv_vfmul_vf_f32m2(e, inv, vl), vl);
+        i += vl;
+    }
+}
+
+void softmax_2pass(const float* x, float* y, size_t n) {
+    size_t vlmax = __riscv_vsetvlmax_e32m2();
+    vfloat32m2_t m = __riscv_vfmv_v_f_f32m2(SOFTMAX_NEG_BIG, vlmax);
+    vfloat32m2_t s = __riscv_vfmv_v_f_f32m2(0.0f, vlmax);
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m2(n - i);
+        vfloat32m2_t v = __riscv_vle32_v_f32m2(&x[i], vl);
+        vfloat32m2_t m_new = __riscv_vfmax_vv_f32m2_tu(m, m, v, vl);
+        vfloat32m2_t rescale = __exp_f32m2(__riscv_vfsub_vv_f32m2(m, m_new, vl), vl);
+        vfloat32m2_t e = __exp_f32m2(__riscv_vfsub_vv_f32m2(v, m_new, vl), vl);
+        // s = s · rescale + e
+        s = __riscv_vfmadd_vv_f32m2_tu(s, rescale, e, vl);
+        m = m_new;
+        i += vl;
+    }
+
+    float mx = reduce_max(m, vlmax);
+    vfloat32m2_t w = __exp_f32m2(__riscv_vfsub_vf_f32m2(m, mx, vlmax), vlmax);
+    float sum = reduce_sum(__riscv_vfmul_vv_f32m2(w, s, vlmax), vlmax);
+
+    exp_scale(x, y, n, mx, 1.0f / sum);
+}
+
+void softmax_4pass(const float* x, float* y, size_t n) {
+    size_t vlmax = __riscv_vsetvlmax_e32m2();
+
+    vfloat32m2_t m = __riscv_vfmv_v_f_f32m2(SOFTMAX_NEG_BIG, vlmax);
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m2(n - i);
+        m = __riscv_vfmax_vv_f32m2_tu(m, m, __riscv_vle32_v_f32m2(&x[i], vl), vl);
+        i += vl;
+    }
+    float mx = reduce_max(m, vlmax);
+
+    exp_scale(x, y, n, mx, 1.0f);
+
+    vfloat32m2_t s = __riscv_vfmv_v_f_f32m2(0.0f, vlmax);
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m2(n - i);
+        s = __riscv_vfadd_vv_f32m2_tu(s, s, __riscv_vle32_v_f32m2(&y[i], vl), vl);
+        i += vl;
+    }
+    float inv = 1.0f / reduce_sum(s, vlmax);
+
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m2(n - i);
+        vfloat32m2_t v = __riscv_vle32_v_f32m2(&y[i], vl);
+        __riscv_vse32_v_f32m2(&y[i], __riscv_vfmul_vf_f32m2(v, inv, vl), vl);
+        i += vl;
+    }
+}
+
+typedef void (*softmax_fn)(const float*, float*, size_t);
+
+static int run_softmax(const char* name, softmax_fn fn, float* y) {
+    bench_poison32(y, SOFTMAX_ROWS * SOFTMAX_COLS);
+    unsigned long start = bench_timed_begin(name);
+    for (size_t r = 0; r < SOFTMAX_ROWS; r++)
+        fn(&softmax_x[r * SOFTMAX_COLS], &y[r * SOFTMAX_COLS], SOFTMAX_COLS);
+    unsigned long cycles = bench_timed_end(start);
+
+    unsigned long elems = (unsigned long)SOFTMAX_ROWS * SOFTMAX_COLS;
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " elements/cycle)\n", name, cycles,
+           BENCH_RATE(elems, cycles));
+
+    for (size_t i = 0; i < (size_t)(SOFTMAX_ROWS * SOFTMAX_COLS); i++) {
+        float want = softmax_expected[i];
+        if (!(fabsf(y[i] - want) <= 1e-5f * want + 1e-10f)) {
+            printf("FAIL %s [%zu][%zu]: got %e, expected %e\n", name, i / SOFTMAX_COLS,
+                   i % SOFTMAX_COLS, y[i], want);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    float* y = vpu_alloc_ew(SOFTMAX_ROWS * SOFTMAX_COLS * sizeof(float), 32);
+
+    printf("softmax rows,cols = %d,%d\n", SOFTMAX_ROWS, SOFTMAX_COLS);
+
+#if PREALLOCATE
+    softmax_2pass(softmax_x, y, SOFTMAX_COLS);
+#endif
+
+    if (run_softmax("softmax_4pass", softmax_4pass, y))
+        return 1;
+    if (run_softmax("softmax_2pass", softmax_2pass, y))
+        return 1;
+
+    printf("PASSED\n");
+    return 0;
+}
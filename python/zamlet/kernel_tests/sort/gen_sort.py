@@ -0,0 +1,47 @@
+"""Generate a key/value sort dataset header.
+
+Usage:
+    python gen_sort.py N [--key-bits B] [--seed S] > sort_data.h
+
+Declares:
+    #define SORT_N N
+    uint32_t sort_keys[N] __attribute__((section(".data.vpu32")));
+    uint32_t sort_vals[N] __attribute__((section(".data.vpu32")));
+    uint32_t sort_expected_keys[N] __attribute__((section(".data.vpu32")));
+    uint32_t sort_expected_vals[N] __attribute__((section(".data.vpu32")));
+
+Keys are uniform in [0, 2^B) and value i is the original index of key i, so with a
+small B the expected values also check that the sort is stable.
+"""
+import argparse
+import random
+
+from gen_header import emit
+
+parser = argparse.ArgumentParser()
+parser.add_argument("N", type=int)
+parser.add_argument("--key-bits", type=int, default=32)
+parser.add_argument("--seed", type=int, default=0)
+args = parser.parse_args()
+assert 1 <= args.key_bits <= 32
+
+rng = random.Random(args.seed)
+n = args.N
+keys = [rng.getrandbits(args.key_bits) for _ in range(n)]
+vals = list(range(n))
+order = sorted(range(n), key=lambda i: keys[i])
+
+
+def emit_u32(name, values):
+    emit("uint32_t", name, values, ".data.vpu32", lambda v: f"0x{v:08x}u", 8)
+
+
+print(f"// Generated by gen_sort.py {n} --key-bits {args.key_bits} --seed {args.seed}")
+print("#include <stdint.h>")
+print()
+print(f"#define SORT_N {n}")
+print()
+emit_u32("sort_keys", keys)
+emit_u32("sort_vals", vals)
+emit_u32("sort_expected_keys", [keys[i] for i in order])
+emit_u32("sort_expected_vals", order)
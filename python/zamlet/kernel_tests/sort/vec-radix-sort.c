@@ -0,0 +1,161 @@
+/*
+ * LSD radix sort of 32-bit keys with 32-bit values, RADIX_BITS bits per pass.
+ *
+ * Lane l of a vl = VLMAX(e32,m1) register owns the block of elements
+ * [l · B, (l + 1) · B) with B = ceil(n / vl), and step j of a pass handles element
+ * l · B + j in every lane with one strided load. Each lane keeps its own count per
+ * digit, in counts[d · vl + l], so the indexed accesses of a step never share an
+ * address. A pass has three phases:
+ *
+ *   histogram  counts[d][l]++ for every element, as a gather, add and scatter. The
+ *              count before the increment is the element's rank among the earlier
+ *              elements of its lane with the same digit; it is saved in ranks[j][l].
+ *   scan       exclusive prefix sum over counts in (digit, lane) order, turning the
+ *              counts into the first output position of each (digit, lane).
+ *   scatter    dst[counts[d][l] + ranks[j][l]] = src[l · B + j] for keys and values.
+ *
+ * Lane blocks are in element order and ranks increase with j, so each pass is stable.
+ * The scatter destinations are a permutation of [0, n) and the phase only reads
+ * counts, so it runs under one writeset, like bitreverse_reorder64. The histogram
+ * phase rewrites counts from step to step and stays outside it. Both indexed phases
+ * run under zamlet_begin_index_bound.
+ *
+ * SORT_HEADER (gen_sort.py N) supplies the keys, values and the stably sorted result.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "zamlet_custom.h"
+#include "vscan.h"
+#include SORT_HEADER
+
+#ifndef RADIX_BITS
+#define RADIX_BITS 4
+#endif
+#if 32 % RADIX_BITS != 0 || (32 / RADIX_BITS) % 2 != 0
+#error "RADIX_BITS must give an even number of passes over 32-bit keys"
+#endif
+#define RADIX_BUCKETS (1u << RADIX_BITS)
+#define RADIX_PASSES (32 / RADIX_BITS)
+
+// Byte offsets of counts[d][lane] for each lane's digit of k.
+static inline vuint32m1_t count_offsets(vuint32m1_t k, vuint32m1_t lane, unsigned shift,
+                                        size_t vl) {
+    vuint32m1_t d = __riscv_vand_vx_u32m1(__riscv_vsrl_vx_u32m1(k, shift, vl),
+                                          RADIX_BUCKETS - 1, vl);
+    // d · vl + lane
+    vuint32m1_t idx = __riscv_vmacc_vx_u32m1(lane, (uint32_t)vl, d, vl);
+    return __riscv_vsll_vx_u32m1(idx, 2, vl);
+}
+
+static void fill_zero(uint32_t* x, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e32m4(n - i);
+        __riscv_vse32_v_u32m4(&x[i], __riscv_vmv_v_x_u32m4(0, vl), vl);
+        i += vl;
+    }
+}
+
+static void radix_pass(size_t n, size_t block, unsigned shift,
+                       const uint32_t* src_k, const uint32_t* src_v,
+                       uint32_t* dst_k, uint32_t* dst_v, uint32_t* counts, uint32_t* ranks) {
+    size_t vl = __riscv_vsetvlmax_e32m1();
+    ptrdiff_t stride = (ptrdiff_t)(block * sizeof(uint32_t));
+    vuint32m1_t lane = __riscv_vid_v_u32m1(vl);
+    // Index of each lane's first element.
+    vuint32m1_t first = __riscv_vmul_vx_u32m1(lane, (uint32_t)block, vl);
+    size_t counts_bytes = RADIX_BUCKETS * vl * sizeof(uint32_t);
+
+    fill_zero(counts, RADIX_BUCKETS * vl);
+
+    zamlet_begin_index_bound(counts_bytes);
+    for (size_t j = 0; j < block; j++) {
+        vbool32_t m = __riscv_vmsltu_vx_u32m1_b32(
+            __riscv_vadd_vx_u32m1(first, (uint32_t)j, vl), (uint32_t)n, vl);
+        vuint32m1_t k = __riscv_vlse32_v_u32m1_m(m, &src_k[j], stride, vl);
+        vuint32m1_t off = count_offsets(k, lane, shift, vl);
+        vuint32m1_t c = __riscv_vluxei32_v_u32m1_m(m, counts, off, vl);
+        __riscv_vse32_v_u32m1_m(m, &ranks[j * vl], c, vl);
+        __riscv_vsuxei32_v_u32m1_m(m, counts, off, __riscv_vadd_vx_u32m1(c, 1, vl), vl);
+    }
+    zamlet_end_index_bound();
+
+    vscan_exclusive_u32(counts, counts, RADIX_BUCKETS * vl);
+
+    size_t data_bytes = n * sizeof(uint32_t);
+    zamlet_begin_index_bound(data_bytes > counts_bytes ? data_bytes : counts_bytes);
+    zamlet_begin_writeset();
+    for (size_t j = 0; j < block; j++) {
+        vbool32_t m = __riscv_vmsltu_vx_u32m1_b32(
+            __riscv_vadd_vx_u32m1(first, (uint32_t)j, vl), (uint32_t)n, vl);
+        vuint32m1_t k = __riscv_vlse32_v_u32m1_m(m, &src_k[j], stride, vl);
+        vuint32m1_t v = __riscv_vlse32_v_u32m1_m(m, &src_v[j], stride, vl);
+        vuint32m1_t off = count_offsets(k, lane, shift, vl);
+        vuint32m1_t pos = __riscv_vadd_vv_u32m1(
+            __riscv_vluxei32_v_u32m1_m(m, counts, off, vl),
+            __riscv_vle32_v_u32m1_m(m, &ranks[j * vl], vl), vl);
+        pos = __riscv_vsll_vx_u32m1(pos, 2, vl);
+        __riscv_vsuxei32_v_u32m1_m(m, dst_k, pos, k, vl);
+        __riscv_vsuxei32_v_u32m1_m(m, dst_v, pos, v, vl);
+    }
+    zamlet_end_writeset();
+    zamlet_end_index_bound();
+}
+
+// Scratch needed by radix_sort_u32, in uint32_t elements.
+static size_t counts_len(void) {
+    return RADIX_BUCKETS * __riscv_vsetvlmax_e32m1();
+}
+
+static size_t ranks_len(size_t n) {
+    size_t vl = __riscv_vsetvlmax_e32m1();
+    return (n + vl - 1) / vl * vl;
+}
+
+// Sorts keys[0, n) and carries vals along. tmp_k and tmp_v hold n elements each,
+// counts counts_len() and ranks ranks_len(n). The result ends up back in keys and vals.
+void radix_sort_u32(size_t n, uint32_t* keys, uint32_t* vals, uint32_t* tmp_k,
+                    uint32_t* tmp_v, uint32_t* counts, uint32_t* ranks) {
+    if (n == 0)
+        return;
+    size_t vl = __riscv_vsetvlmax_e32m1();
+    size_t block = (n + vl - 1) / vl;
+    for (unsigned p = 0; p < RADIX_PASSES; p += 2) {
+        radix_pass(n, block, p * RADIX_BITS, keys, vals, tmp_k, tmp_v, counts, ranks);
+        radix_pass(n, block, (p + 1) * RADIX_BITS, tmp_k, tmp_v, keys, vals, counts, ranks);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    uint32_t* tmp_k = vpu_alloc_ew(SORT_N * sizeof(uint32_t), 32);
+    uint32_t* tmp_v = vpu_alloc_ew(SORT_N * sizeof(uint32_t), 32);
+    uint32_t* counts = vpu_alloc_ew(counts_len() * sizeof(uint32_t), 32);
+    uint32_t* ranks = vpu_alloc_ew(ranks_len(SORT_N) * sizeof(uint32_t), 32);
+
+    printf("radix sort n = %d, %d bits per pass, vl = %zu\n", SORT_N, RADIX_BITS,
+           __riscv_vsetvlmax_e32m1());
+
+    unsigned long start = bench_timed_begin("radix_sort");
+    radix_sort_u32(SORT_N, sort_keys, sort_vals, tmp_k, tmp_v, counts, ranks);
+    unsigned long cycles = bench_timed_end(start);
+
+    printf("radix_sort: %lu cycles (" BENCH_RATE_FMT " keys/cycle)\n", cycles,
+           BENCH_RATE(SORT_N, cycles));
+
+    size_t bad_k = bench_mismatches32(sort_keys, sort_expected_keys, SORT_N);
+    size_t bad_v = bench_mismatches32(sort_vals, sort_expected_vals, SORT_N);
+    if (bad_k || bad_v) {
+        printf("FAIL mismatches: keys %zu, vals %zu\n", bad_k, bad_v);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
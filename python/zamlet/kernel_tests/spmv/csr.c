@@ -0,0 +1,30 @@
+#include <riscv_vector.h>
+#include "zamlet_custom.h"
+#include "csr.h"
+
+void spmv_csr_bounded(int32_t n_rows, int32_t n_cols, const int32_t* prow,
+                      const int32_t* index, const double* data, const double* x, double* y) {
+    zamlet_begin_index_bound((unsigned long)n_cols * sizeof(double));
+    for (int32_t r = 0; r < n_rows; r++) {
+        size_t len = (size_t)(prow[r + 1] - prow[r]);
+        const double* val = &data[prow[r]];
+        const uint32_t* col = (const uint32_t*)&index[prow[r]];
+        size_t vlmax = __riscv_vsetvl_e64m8(len);
+        vfloat64m8_t acc = __riscv_vfmv_v_f_f64m8(0.0, vlmax);
+        while (len) {
+            size_t vl = __riscv_vsetvl_e64m8(len);
+            vuint32m4_t offs = __riscv_vle32_v_u32m4(col, vl);
+            vfloat64m8_t v = __riscv_vle64_v_f64m8(val, vl);
+            vfloat64m8_t xv = __riscv_vluxei32_v_f64m8(x, offs, vl);
+            // Tail-undisturbed so a short last strip keeps the earlier partial sums.
+            acc = __riscv_vfmacc_vv_f64m8_tu(acc, v, xv, vl);
+            len -= vl;
+            val += vl;
+            col += vl;
+        }
+        vfloat64m1_t zero = __riscv_vfmv_v_f_f64m1(0.0, 1);
+        vfloat64m1_t sum = __riscv_vfredusum_vs_f64m8_f64m1(acc, zero, vlmax);
+        y[r] = vlmax ? __riscv_vfmv_f_s_f64m1_f64(sum) : 0.0;
+    }
+    zamlet_end_index_bound();
+}
@@ -0,0 +1,18 @@
+/*
+ * CSR spmv with index-bounded gathers.
+ *
+ * Same matrix layout as spmv_csr_idx32 (common/ara/spmv.c): row pointers,
+ * column indices as byte offsets into x, and values. The whole row loop runs
+ * under an index bound of n_cols · 8 bytes (zamlet_begin_index_bound), so the
+ * lamlet pre-checks the pages of x once instead of fault-checking every
+ * gathered element, and the gathers are unordered vluxei32.
+ */
+#ifndef CSR_H
+#define CSR_H
+
+#include <stdint.h>
+
+void spmv_csr_bounded(int32_t n_rows, int32_t n_cols, const int32_t* prow,
+                      const int32_t* index, const double* data, const double* x, double* y);
+
+#endif
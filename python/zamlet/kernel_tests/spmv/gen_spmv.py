@@ -0,0 +1,70 @@
+"""Generate a CSR sparse matrix-vector dataset header for y = A · x.
+
+Usage:
+    python gen_spmv.py ROWS COLS [--min-nnz A] [--max-nnz B] [--seed S] > spmv_data.h
+
+Declares:
+    #define SPMV_ROWS    ROWS
+    #define SPMV_COLS    COLS
+    #define SPMV_NNZ     <total non-zeros>
+    #define SPMV_MAX_NNZ <longest row>
+    int32_t spmv_prow[ROWS + 1];                         // row pointers, scalar memory
+    int32_t spmv_index[NNZ]  (.data.vpu32)               // column byte offsets (col · 8)
+    double  spmv_data[NNZ]   (.data.vpu64)
+    double  spmv_x[COLS]     (.data.vpu64)
+    double  spmv_expected[ROWS] (.data.vpu64)
+
+Column indices are byte offsets, the layout spmv_csr_idx32 (common/ara/spmv.c) and the
+SELL kernel's indexed loads take directly. Row lengths are drawn uniformly from
+[min-nnz, max-nnz], so neighbouring rows differ in length and SELL-C-sigma sorting has
+something to do. Values are small integers so every sum is exact.
+"""
+import argparse
+import random
+
+from gen_header import emit
+
+parser = argparse.ArgumentParser()
+parser.add_argument("ROWS", type=int)
+parser.add_argument("COLS", type=int)
+parser.add_argument("--min-nnz", type=int, default=5)
+parser.add_argument("--max-nnz", type=int, default=30)
+parser.add_argument("--seed", type=int, default=0)
+args = parser.parse_args()
+
+rng = random.Random(args.seed)
+rows, cols = args.ROWS, args.COLS
+max_nnz = min(args.max_nnz, cols)
+min_nnz = min(args.min_nnz, max_nnz)
+
+prow = [0]
+index = []
+data = []
+for _ in range(rows):
+    row_cols = sorted(rng.sample(range(cols), rng.randint(min_nnz, max_nnz)))
+    index.extend(row_cols)
+    data.extend(rng.choice([-3, -2, -1, 1, 2, 3]) for _ in row_cols)
+    prow.append(len(index))
+x = [rng.randint(-4, 4) for _ in range(cols)]
+expected = [sum(data[p] * x[index[p]] for p in range(prow[r], prow[r + 1]))
+            for r in range(rows)]
+
+
+def as_double(v):
+    return f"{float(v):.1f}"
+
+
+print(f"// Generated by gen_spmv.py {rows} {cols} --min-nnz {min_nnz} --max-nnz {max_nnz}"
+      f" --seed {args.seed}")
+print("#include <stdint.h>")
+print()
+print(f"#define SPMV_ROWS    {rows}")
+print(f"#define SPMV_COLS    {cols}")
+print(f"#define SPMV_NNZ     {len(index)}")
+print(f"#define SPMV_MAX_NNZ {max(prow[r + 1] - prow[r] for r in range(rows))}")
+print()
+emit("int32_t", "spmv_prow", prow)
+emit("int32_t", "spmv_index", [c * 8 for c in index], ".data.vpu32")
+emit("double", "spmv_data", data, ".data.vpu64", as_double)
+emit("double", "spmv_x", x, ".data.vpu64", as_double)
+emit("double", "spmv_expected", expected, ".data.vpu64", as_double)
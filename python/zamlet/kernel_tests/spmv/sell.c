@@ -0,0 +1,104 @@
+#include <stdlib.h>
+#include <riscv_vector.h>
+#include "vpu_alloc.h"
+#include "zamlet_custom.h"
+#include "sell.h"
+
+static inline int32_t row_len(const int32_t* prow, int32_t r) {
+    return prow[r + 1] - prow[r];
+}
+
+int32_t sell_from_csr(int32_t n_rows, int32_t n_cols, const int32_t* prow, const int32_t* index,
+                      const double* data, int32_t c, int32_t sigma, int32_t* order,
+                      sell_matrix_t* out) {
+    if (c <= 0 || sigma <= 0)
+        exit(6);
+    for (int32_t r = 0; r < n_rows; r++)
+        order[r] = r;
+
+    // Stable insertion sort by descending length inside each sigma window.
+    for (int32_t w = 0; w < n_rows; w += sigma) {
+        int32_t end = w + sigma < n_rows ? w + sigma : n_rows;
+        for (int32_t i = w + 1; i < end; i++) {
+            int32_t r = order[i];
+            int32_t j = i;
+            while (j > w && row_len(prow, order[j - 1]) < row_len(prow, r)) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = r;
+        }
+    }
+
+    int32_t n_slices = (n_rows + c - 1) / c;
+    int32_t total = 0;
+    for (int32_t s = 0; s < n_slices; s++) {
+        int32_t r0 = s * c;
+        int32_t h = n_rows - r0 < c ? n_rows - r0 : c;
+        int32_t width = 0;
+        for (int32_t i = r0; i < r0 + h; i++) {
+            int32_t len = row_len(prow, order[i]);
+            if (len > width)
+                width = len;
+        }
+        out->ptr[s] = total;
+        out->width[s] = width;
+        total += width * h;
+    }
+    out->ptr[n_slices] = total;
+
+    out->n_rows = n_rows;
+    out->n_cols = n_cols;
+    out->c = c;
+    out->n_slices = n_slices;
+    out->val = vpu_alloc_ew((size_t)(total ? total : 1) * sizeof(double), 64);
+    out->col = vpu_alloc_ew((size_t)(total ? total : 1) * sizeof(uint32_t), 32);
+    out->row_off = vpu_alloc_ew((size_t)n_rows * sizeof(uint32_t), 32);
+
+    int32_t padding = 0;
+    for (int32_t s = 0; s < n_slices; s++) {
+        int32_t r0 = s * c;
+        int32_t h = n_rows - r0 < c ? n_rows - r0 : c;
+        for (int32_t i = 0; i < h; i++) {
+            int32_t r = order[r0 + i];
+            int32_t len = row_len(prow, r);
+            out->row_off[r0 + i] = (uint32_t)r * sizeof(double);
+            for (int32_t k = 0; k < out->width[s]; k++) {
+                int32_t dst = out->ptr[s] + k * h + i;
+                if (k < len) {
+                    out->val[dst] = data[prow[r] + k];
+                    out->col[dst] = (uint32_t)index[prow[r] + k];
+                } else {
+                    out->val[dst] = 0.0;
+                    out->col[dst] = 0;
+                    padding++;
+                }
+            }
+        }
+    }
+    return padding;
+}
+
+void spmv_sell(const sell_matrix_t* a, const double* x, double* y) {
+    int32_t span = a->n_rows > a->n_cols ? a->n_rows : a->n_cols;
+    zamlet_begin_index_bound((unsigned long)span * sizeof(double));
+    for (int32_t s = 0; s < a->n_slices; s++) {
+        int32_t r0 = s * a->c;
+        size_t h = (size_t)(a->n_rows - r0 < a->c ? a->n_rows - r0 : a->c);
+        size_t vl = __riscv_vsetvl_e64m4(h);
+        const double* val = &a->val[a->ptr[s]];
+        const uint32_t* col = &a->col[a->ptr[s]];
+        vfloat64m4_t acc = __riscv_vfmv_v_f_f64m4(0.0, vl);
+        for (int32_t k = 0; k < a->width[s]; k++) {
+            vuint32m2_t offs = __riscv_vle32_v_u32m2(col, vl);
+            vfloat64m4_t v = __riscv_vle64_v_f64m4(val, vl);
+            vfloat64m4_t xv = __riscv_vluxei32_v_f64m4(x, offs, vl);
+            acc = __riscv_vfmacc_vv_f64m4(acc, v, xv, vl);
+            val += h;
+            col += h;
+        }
+        vuint32m2_t yoffs = __riscv_vle32_v_u32m2(&a->row_off[r0], vl);
+        __riscv_vsuxei32_v_f64m4(y, yoffs, acc, vl);
+    }
+    zamlet_end_index_bound();
+}
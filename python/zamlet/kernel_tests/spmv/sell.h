@@ -0,0 +1,49 @@
+/*
+ * SELL-C-sigma sparse matrix format and spmv kernel.
+ *
+ * Rows are sorted by length (longest first) inside windows of sigma rows,
+ * then cut into slices of C consecutive sorted rows. Slice s is stored
+ * column-major and padded to its longest row, width[s]:
+ *   val[ptr[s] + k · h + r], col[ptr[s] + k · h + r]   r < h, k < width[s]
+ * where h = min(C, n_rows - s · C). Padding has val 0 and col 0.
+ * row_off[i] is the y byte offset of sorted row i, used to scatter results
+ * back into original row order.
+ *
+ * With C equal to the hardware vl, spmv_sell processes one slice per
+ * vector: each of the width[s] steps is a unit-stride load of values and
+ * column offsets, one gather of x and one vfmacc.vv across C rows. sigma = 1
+ * is plain sliced ELLPACK; sigma = n_rows sorts globally, which minimizes
+ * padding. The gathers from x and the scatter into y run under one index
+ * bound of max(n_rows, n_cols) · 8 bytes.
+ */
+#ifndef SELL_H
+#define SELL_H
+
+#include <stdint.h>
+
+typedef struct {
+    int32_t   n_rows;
+    int32_t   n_cols;
+    int32_t   c;          // Slice height.
+    int32_t   n_slices;
+    int32_t*  ptr;        // n_slices + 1 entries, scalar memory.
+    int32_t*  width;      // n_slices entries, scalar memory.
+    double*   val;        // ptr[n_slices] entries, VPU memory (e64).
+    uint32_t* col;        // ptr[n_slices] column byte offsets, VPU memory (e32).
+    uint32_t* row_off;    // n_rows y byte offsets, VPU memory (e32).
+} sell_matrix_t;
+
+/*
+ * Build `out` from a CSR matrix whose column indices are byte offsets.
+ * out->ptr and out->width must point at caller storage of at least
+ * n_rows + 1 entries; order must hold n_rows entries. val, col and row_off
+ * come from vpu_alloc_ew. Returns the number of padding entries.
+ */
+int32_t sell_from_csr(int32_t n_rows, int32_t n_cols, const int32_t* prow, const int32_t* index,
+                      const double* data, int32_t c, int32_t sigma, int32_t* order,
+                      sell_matrix_t* out);
+
+// y = A · x. Requires A->c <= VLMAX at e64m4.
+void spmv_sell(const sell_matrix_t* a, const double* x, double* y);
+
+#endif
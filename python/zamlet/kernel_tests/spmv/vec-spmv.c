@@ -0,0 +1,95 @@
+/*
+ * Sparse matrix-vector product y = A · x: CSR baselines against SELL-C-sigma.
+ *
+ * spmv_csr_idx32 (common/ara/spmv.c) vectorizes along each row, so vl is the
+ * row length and every row pays a vsetvli and a reduction. spmv_csr_bounded
+ * (csr.c) is the same loop under an index bound on x. spmv_sell
+ * (sell.c) vectorizes across the C rows of a slice, with C set to VLMAX at
+ * e64m4 so every lane is busy for the widest rows of each slice.
+ *
+ * SPMV_HEADER (gen_spmv.py) supplies the CSR matrix, x and the expected y.
+ * SPMV_SIGMA is the sorting window; the CSR -> SELL conversion runs untimed.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "ara/spmv.h"
+#include "csr.h"
+#include "sell.h"
+#include SPMV_HEADER
+
+#ifndef SPMV_SIGMA
+#define SPMV_SIGMA 1
+#endif
+
+static int32_t sell_ptr[SPMV_ROWS + 1];
+static int32_t sell_width[SPMV_ROWS + 1];
+static int32_t sell_order[SPMV_ROWS];
+
+static int check(const char* name, const double* y) {
+    for (int32_t r = 0; r < SPMV_ROWS; r++) {
+        if (y[r] != spmv_expected[r]) {
+            printf("FAIL %s [%d]: got %ld, expected %ld\n", name, r, (long)y[r],
+                   (long)spmv_expected[r]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void clear(double* y) {
+    for (int32_t r = 0; r < SPMV_ROWS; r++)
+        y[r] = 0.0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    double* y = vpu_alloc_ew(SPMV_ROWS * sizeof(double), 64);
+    int32_t c = (int32_t)__riscv_vsetvlmax_e64m4();
+
+    sell_matrix_t a = {.ptr = sell_ptr, .width = sell_width};
+    int32_t padding = sell_from_csr(SPMV_ROWS, SPMV_COLS, spmv_prow, spmv_index, spmv_data,
+                                    c, SPMV_SIGMA, sell_order, &a);
+    int32_t stored = a.ptr[a.n_slices];
+    printf("spmv %dx%d nnz=%d: SELL-%d-%d, %d slices, %d stored, %d padding\n",
+           SPMV_ROWS, SPMV_COLS, SPMV_NNZ, c, SPMV_SIGMA, a.n_slices, stored, padding);
+
+#if PREALLOCATE
+    spmv_csr_idx32(SPMV_ROWS, spmv_prow, spmv_index, spmv_data, spmv_x, y);
+    spmv_csr_bounded(SPMV_ROWS, SPMV_COLS, spmv_prow, spmv_index, spmv_data, spmv_x, y);
+    spmv_sell(&a, spmv_x, y);
+#endif
+
+    clear(y);
+    unsigned long start = bench_timed_begin("spmv_csr");
+    spmv_csr_idx32(SPMV_ROWS, spmv_prow, spmv_index, spmv_data, spmv_x, y);
+    unsigned long cycles = bench_timed_end(start);
+    printf("spmv_csr: %lu cycles\n", cycles);
+    if (check("csr", y))
+        return 1;
+
+    clear(y);
+    start = bench_timed_begin("spmv_csr_bounded");
+    spmv_csr_bounded(SPMV_ROWS, SPMV_COLS, spmv_prow, spmv_index, spmv_data, spmv_x, y);
+    cycles = bench_timed_end(start);
+    printf("spmv_csr_bounded: %lu cycles\n", cycles);
+    if (check("csr_bounded", y))
+        return 1;
+
+    clear(y);
+    start = bench_timed_begin("spmv_sell");
+    spmv_sell(&a, spmv_x, y);
+    cycles = bench_timed_end(start);
+    printf("spmv_sell: %lu cycles\n", cycles);
+    if (check("sell", y))
+        return 1;
+
+    printf("PASSED\n");
+    return 0;
+}
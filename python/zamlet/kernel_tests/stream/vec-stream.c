@@ -0,0 +1,144 @@
+/*
+ * STREAM-style memory bandwidth kernels over f64 arrays a, b and c of stream_n elements:
+ *
+ *   copy   c = a            16 bytes per element
+ *   scale  b = q · c        16 bytes per element
+ *   add    c = a + b        24 bytes per element
+ *   triad  a = b + q · c    24 bytes per element
+ *
+ * Each kernel is a single strip-mined e64m8 pass in the form of axpy_intrinsics
+ * (daxpy/vec-daxpy_main.c), timed in its own bench region and reported in bytes per
+ * cycle. stream_n is set with SYMBOL_VALUES, so one binary covers arrays that fit in the
+ * VPU cache (jamlet_sram_bytes per jamlet, 1 KiB on the default params) and arrays many
+ * times larger. The three arrays come from the 64-bit vpu_alloc_ew heap, which bounds
+ * stream_n at STREAM_MAX_N.
+ *
+ * Starting from a = 1, b = 2, c = 0 one pass of each kernel leaves a = 15, b = 3, c = 4,
+ * all exact, and the arrays are checked with vector compares so the scalar core never
+ * reads VPU memory.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+
+// 3 · 80 KiB in the 256 KiB heap, leaving room for vpu_alloc_ew to round each array up to
+// a whole vector register.
+#define STREAM_MAX_N 10240
+
+// Elements per array; kernel_test overrides it through symbol_values.
+volatile int32_t stream_n = 64;
+
+void stream_copy(double* c, const double* a, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        __riscv_vse64_v_f64m8(&c[i], __riscv_vle64_v_f64m8(&a[i], vl), vl);
+        i += vl;
+    }
+}
+
+void stream_scale(double* b, const double* c, double q, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        vfloat64m8_t v_c = __riscv_vle64_v_f64m8(&c[i], vl);
+        __riscv_vse64_v_f64m8(&b[i], __riscv_vfmul_vf_f64m8(v_c, q, vl), vl);
+        i += vl;
+    }
+}
+
+void stream_add(double* c, const double* a, const double* b, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        vfloat64m8_t v_a = __riscv_vle64_v_f64m8(&a[i], vl);
+        vfloat64m8_t v_b = __riscv_vle64_v_f64m8(&b[i], vl);
+        __riscv_vse64_v_f64m8(&c[i], __riscv_vfadd_vv_f64m8(v_a, v_b, vl), vl);
+        i += vl;
+    }
+}
+
+void stream_triad(double* a, const double* b, const double* c, double q, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        vfloat64m8_t v_b = __riscv_vle64_v_f64m8(&b[i], vl);
+        vfloat64m8_t v_c = __riscv_vle64_v_f64m8(&c[i], vl);
+        __riscv_vse64_v_f64m8(&a[i], __riscv_vfmacc_vf_f64m8(v_b, q, v_c, vl), vl);
+        i += vl;
+    }
+}
+
+static void fill(double* x, double value, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        __riscv_vse64_v_f64m8(&x[i], __riscv_vfmv_v_f_f64m8(value, vl), vl);
+        i += vl;
+    }
+}
+
+// Number of elements of x that differ from value.
+static size_t count_mismatches(const double* x, double value, size_t n) {
+    size_t bad = 0;
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e64m8(n - i);
+        vbool8_t ne = __riscv_vmfne_vf_f64m8_b8(__riscv_vle64_v_f64m8(&x[i], vl), value, vl);
+        bad += __riscv_vcpop_m_b8(ne, vl);
+        i += vl;
+    }
+    return bad;
+}
+
+static void report(const char* name, unsigned long cycles, unsigned long bytes) {
+    printf("%s: %lu bytes, %lu cycles (" BENCH_RATE_FMT " bytes/cycle)\n", name, bytes, cycles,
+           BENCH_RATE(bytes, cycles));
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int32_t n_sym = stream_n;
+    if (n_sym <= 0 || n_sym > STREAM_MAX_N) {
+        printf("FAIL stream_n = %d, must be in [1, %d]\n", (int)n_sym, (int)STREAM_MAX_N);
+        return 1;
+    }
+    size_t n = (size_t)n_sym;
+    const double q = 3.0;
+
+    double* a = vpu_alloc_ew(n * sizeof(double), 64);
+    double* b = vpu_alloc_ew(n * sizeof(double), 64);
+    double* c = vpu_alloc_ew(n * sizeof(double), 64);
+    fill(a, 1.0, n);
+    fill(b, 2.0, n);
+    fill(c, 0.0, n);
+
+    printf("stream n = %zu (%zu bytes per array)\n", n, n * sizeof(double));
+
+    unsigned long start = bench_timed_begin("stream_copy");
+    stream_copy(c, a, n);
+    report("stream_copy", bench_timed_end(start), 2 * n * sizeof(double));
+
+    start = bench_timed_begin("stream_scale");
+    stream_scale(b, c, q, n);
+    report("stream_scale", bench_timed_end(start), 2 * n * sizeof(double));
+
+    start = bench_timed_begin("stream_add");
+    stream_add(c, a, b, n);
+    report("stream_add", bench_timed_end(start), 3 * n * sizeof(double));
+
+    start = bench_timed_begin("stream_triad");
+    stream_triad(a, b, c, q, n);
+    report("stream_triad", bench_timed_end(start), 3 * n * sizeof(double));
+
+    size_t bad_a = count_mismatches(a, 15.0, n);
+    size_t bad_b = count_mismatches(b, 3.0, n);
+    size_t bad_c = count_mismatches(c, 4.0, n);
+    if (bad_a || bad_b || bad_c) {
+        printf("FAIL mismatches: a %zu, b %zu, c %zu\n", bad_a, bad_b, bad_c);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,284 @@
+/*
+ * Transpose of a TRANSPOSE_M x TRANSPOSE_N row-major matrix a of TRANSPOSE_EW-bit
+ * elements into the TRANSPOSE_N x TRANSPOSE_M matrix b, b[j][i] = a[i][j], four ways.
+ * Each walks a in transpose_block x transpose_block tiles, row of tiles by row of
+ * tiles, so one tile of a and of b is live at a time, and within a tile:
+ *
+ *   strided   one vlse per column strip of a (stride N elements) and a unit-stride vse
+ *             into the matching row of b.
+ *   segload   vlsseg4 reads a strip of four adjacent columns at once, one segment per
+ *             row, and four vse write the four rows of b. Leftover columns take the
+ *             strided path.
+ *   segstore  four vle read a strip of four adjacent rows, and vssseg4 writes them as
+ *             one segment per column of b (stride M elements). Leftover rows take a
+ *             vle and a vsse into the column of b.
+ *   scatter   a unit-stride vle per row strip of a and a vsuxei into the column of b
+ *             (offsets i · M, in bytes). The scatters of different rows never share an
+ *             element, so they all run under one writeset.
+ *
+ * The model issues a segment access as nf strided accesses, one per field
+ * (Oamlet.vsegload and vsegstore), so here the segment variants differ from the
+ * strided one only in instruction count. Their relative cycles are an artifact of
+ * that decomposition, not a measure of segment accesses on hardware.
+ *
+ * a[i][j] = i · N + j, truncated to the element width, and every result is checked
+ * with vector compares against that formula.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+#include "zamlet_custom.h"
+
+#ifndef TRANSPOSE_M
+#define TRANSPOSE_M 64
+#endif
+#ifndef TRANSPOSE_N
+#define TRANSPOSE_N 64
+#endif
+#ifndef TRANSPOSE_EW
+#define TRANSPOSE_EW 32
+#endif
+
+// Tile side in elements; may be overridden with symbol_values.
+volatile int32_t transpose_block = 16;
+
+static size_t block_end(size_t start, size_t block, size_t limit) {
+    return start + block < limit ? start + block : limit;
+}
+
+// Runs STMT over the transpose_block tiles of an m x n matrix with rows [i0, i1) and
+// columns [j0, j1) in scope.
+#define TRANSPOSE_TILES(STMT)                                                            \
+    do {                                                                                 \
+        size_t block = transpose_block;                                                  \
+        for (size_t i0 = 0; i0 < m; i0 += block) {                                       \
+            size_t i1 = block_end(i0, block, m);                                         \
+            for (size_t j0 = 0; j0 < n; j0 += block) {                                   \
+                size_t j1 = block_end(j0, block, n);                                     \
+                STMT;                                                                    \
+            }                                                                            \
+        }                                                                                \
+    } while (0)
+
+// transpose_<V>_<S>, the tiled driver of tile_<V>_<S>.
+#define TRANSPOSE_TILED(S, T, V)                                                         \
+void transpose_##V##_##S(const T* a, T* b, size_t m, size_t n) {                         \
+    TRANSPOSE_TILES(tile_##V##_##S(a, b, m, n, i0, i1, j0, j1));                         \
+}
+
+/*
+ * TRANSPOSE_DEFINE(S, T, EW, B, IEW, IL) defines the four transposes and their
+ * helpers for element type T, where S is the intrinsic type suffix, B the mask ratio
+ * of e<EW>m1 and IEW/IL the width and LMUL of the scatter offsets, which have as many
+ * elements as an e<EW>m1 register. The tile_* functions transpose rows [i0, i1) and
+ * columns [j0, j1) of a.
+ */
+#define TRANSPOSE_DEFINE(S, T, EW, B, IEW, IL)                                           \
+static void column_strided_##S(const T* a, T* b, size_t m, size_t n, size_t j,           \
+                               size_t i0, size_t i1) {                                   \
+    for (size_t i = i0; i < i1; ) {                                                      \
+        size_t vl = __riscv_vsetvl_e##EW##m1(i1 - i);                                    \
+        vuint##EW##m1_t v = __riscv_vlse##EW##_v_##S##m1(&a[i * n + j], n * sizeof(T), vl); \
+        __riscv_vse##EW##_v_##S##m1(&b[j * m + i], v, vl);                               \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+static void row_strided_##S(const T* a, T* b, size_t m, size_t n, size_t i,              \
+                            size_t j0, size_t j1) {                                      \
+    for (size_t j = j0; j < j1; ) {                                                      \
+        size_t vl = __riscv_vsetvl_e##EW##m1(j1 - j);                                    \
+        vuint##EW##m1_t v = __riscv_vle##EW##_v_##S##m1(&a[i * n + j], vl);              \
+        __riscv_vsse##EW##_v_##S##m1(&b[j * m + i], m * sizeof(T), v, vl);               \
+        j += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+static void tile_strided_##S(const T* a, T* b, size_t m, size_t n, size_t i0, size_t i1, \
+                             size_t j0, size_t j1) {                                     \
+    for (size_t j = j0; j < j1; j++)                                                     \
+        column_strided_##S(a, b, m, n, j, i0, i1);                                       \
+}                                                                                        \
+                                                                                         \
+static void tile_segload_##S(const T* a, T* b, size_t m, size_t n, size_t i0, size_t i1, \
+                             size_t j0, size_t j1) {                                     \
+    size_t j = j0;                                                                       \
+    for (; j + 4 <= j1; j += 4) {                                                        \
+        for (size_t i = i0; i < i1; ) {                                                  \
+            size_t vl = __riscv_vsetvl_e##EW##m1(i1 - i);                                \
+            vuint##EW##m1x4_t s = __riscv_vlsseg4e##EW##_v_##S##m1x4(                    \
+                &a[i * n + j], n * sizeof(T), vl);                                       \
+            __riscv_vse##EW##_v_##S##m1(&b[j * m + i],                                   \
+                                      __riscv_vget_v_##S##m1x4_##S##m1(s, 0), vl);       \
+            __riscv_vse##EW##_v_##S##m1(&b[(j + 1) * m + i],                             \
+                                      __riscv_vget_v_##S##m1x4_##S##m1(s, 1), vl);       \
+            __riscv_vse##EW##_v_##S##m1(&b[(j + 2) * m + i],                             \
+                                      __riscv_vget_v_##S##m1x4_##S##m1(s, 2), vl);       \
+            __riscv_vse##EW##_v_##S##m1(&b[(j + 3) * m + i],                             \
+                                      __riscv_vget_v_##S##m1x4_##S##m1(s, 3), vl);       \
+            i += vl;                                                                     \
+        }                                                                                \
+    }                                                                                    \
+    for (; j < j1; j++)                                                                  \
+        column_strided_##S(a, b, m, n, j, i0, i1);                                       \
+}                                                                                        \
+                                                                                         \
+static void tile_segstore_##S(const T* a, T* b, size_t m, size_t n, size_t i0,           \
+                              size_t i1, size_t j0, size_t j1) {                         \
+    size_t i = i0;                                                                       \
+    for (; i + 4 <= i1; i += 4) {                                                        \
+        for (size_t j = j0; j < j1; ) {                                                  \
+            size_t vl = __riscv_vsetvl_e##EW##m1(j1 - j);                                \
+            vuint##EW##m1x4_t s = __riscv_vcreate_v_##S##m1x4(                           \
+                __riscv_vle##EW##_v_##S##m1(&a[i * n + j], vl),                          \
+                __riscv_vle##EW##_v_##S##m1(&a[(i + 1) * n + j], vl),                    \
+                __riscv_vle##EW##_v_##S##m1(&a[(i + 2) * n + j], vl),                    \
+                __riscv_vle##EW##_v_##S##m1(&a[(i + 3) * n + j], vl));                   \
+            __riscv_vssseg4e##EW##_v_##S##m1x4(&b[j * m + i], m * sizeof(T), s, vl);     \
+            j += vl;                                                                     \
+        }                                                                                \
+    }                                                                                    \
+    for (; i < i1; i++)                                                                  \
+        row_strided_##S(a, b, m, n, i, j0, j1);                                          \
+}                                                                                        \
+                                                                                         \
+static void tile_scatter_##S(const T* a, T* b, size_t m, size_t n, size_t i0, size_t i1, \
+                             size_t j0, size_t j1) {                                     \
+    for (size_t i = i0; i < i1; i++) {                                                   \
+        for (size_t j = j0; j < j1; ) {                                                  \
+            size_t vl = __riscv_vsetvl_e##EW##m1(j1 - j);                                \
+            vuint##EW##m1_t v = __riscv_vle##EW##_v_##S##m1(&a[i * n + j], vl);          \
+            vuint##IEW##IL##_t off = __riscv_vmul_vx_u##IEW##IL(                         \
+                __riscv_vid_v_u##IEW##IL(vl), m * sizeof(T), vl);                        \
+            __riscv_vsuxei##IEW##_v_##S##m1(&b[j * m + i], off, v, vl);                  \
+            j += vl;                                                                     \
+        }                                                                                \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+TRANSPOSE_TILED(S, T, strided)                                                           \
+TRANSPOSE_TILED(S, T, segload)                                                           \
+TRANSPOSE_TILED(S, T, segstore)                                                          \
+                                                                                         \
+void transpose_scatter_##S(const T* a, T* b, size_t m, size_t n) {                       \
+    zamlet_begin_index_bound(m * n * sizeof(T));                                         \
+    zamlet_begin_writeset();                                                             \
+    TRANSPOSE_TILES(tile_scatter_##S(a, b, m, n, i0, i1, j0, j1));                       \
+    zamlet_end_writeset();                                                               \
+    zamlet_end_index_bound();                                                            \
+}                                                                                        \
+                                                                                         \
+static void fill_##S(T* x, size_t len, T value) {                                        \
+    for (size_t i = 0; i < len; ) {                                                      \
+        size_t vl = __riscv_vsetvl_e##EW##m1(len - i);                                   \
+        __riscv_vse##EW##_v_##S##m1(&x[i], __riscv_vmv_v_x_##S##m1(value, vl), vl);      \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+/* a[i][j] = i · n + j */                                                                \
+static void fill_source_##S(T* a, size_t len) {                                          \
+    for (size_t i = 0; i < len; ) {                                                      \
+        size_t vl = __riscv_vsetvl_e##EW##m1(len - i);                                   \
+        __riscv_vse##EW##_v_##S##m1(                                                     \
+            &a[i], __riscv_vadd_vx_##S##m1(__riscv_vid_v_##S##m1(vl), (T)i, vl), vl);    \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+/* Number of (j, i) with b[j][i] != i · n + j. */                                        \
+static size_t mismatches_##S(const T* b, size_t m, size_t n) {                           \
+    size_t bad = 0;                                                                      \
+    for (size_t j = 0; j < n; j++) {                                                     \
+        for (size_t i = 0; i < m; ) {                                                    \
+            size_t vl = __riscv_vsetvl_e##EW##m1(m - i);                                 \
+            vuint##EW##m1_t want = __riscv_vadd_vx_##S##m1(                              \
+                __riscv_vmul_vx_##S##m1(__riscv_vid_v_##S##m1(vl), (T)n, vl),            \
+                (T)(i * n + j), vl);                                                     \
+            vbool##B##_t ne = __riscv_vmsne_vv_##S##m1_b##B(                             \
+                __riscv_vle##EW##_v_##S##m1(&b[j * m + i], vl), want, vl);               \
+            bad += __riscv_vcpop_m_b##B(ne, vl);                                         \
+            i += vl;                                                                     \
+        }                                                                                \
+    }                                                                                    \
+    return bad;                                                                          \
+}
+
+#if TRANSPOSE_EW == 8
+TRANSPOSE_DEFINE(u8, uint8_t, 8, 8, 32, m4)
+#define TRANSPOSE_S u8
+typedef uint8_t elem_t;
+#elif TRANSPOSE_EW == 16
+TRANSPOSE_DEFINE(u16, uint16_t, 16, 16, 32, m2)
+#define TRANSPOSE_S u16
+typedef uint16_t elem_t;
+#elif TRANSPOSE_EW == 32
+TRANSPOSE_DEFINE(u32, uint32_t, 32, 32, 32, m1)
+#define TRANSPOSE_S u32
+typedef uint32_t elem_t;
+#elif TRANSPOSE_EW == 64
+TRANSPOSE_DEFINE(u64, uint64_t, 64, 64, 64, m1)
+#define TRANSPOSE_S u64
+typedef uint64_t elem_t;
+#else
+#error "TRANSPOSE_EW must be 8, 16, 32 or 64"
+#endif
+
+#define TRANSPOSE_CAT(a, b) a##_##b
+#define TRANSPOSE_FN(name, s) TRANSPOSE_CAT(name, s)
+
+typedef void (*transpose_fn)(const elem_t*, elem_t*, size_t, size_t);
+
+static int run_transpose(const char* name, transpose_fn fn, const elem_t* a, elem_t* b) {
+    size_t len = (size_t)TRANSPOSE_M * TRANSPOSE_N;
+    TRANSPOSE_FN(fill, TRANSPOSE_S)(b, len, (elem_t)-1);
+
+    unsigned long start = bench_timed_begin(name);
+    fn(a, b, TRANSPOSE_M, TRANSPOSE_N);
+    unsigned long cycles = bench_timed_end(start);
+
+    printf("%s: %lu cycles (" BENCH_RATE_FMT " cycles/element)\n", name, cycles,
+           BENCH_RATE(cycles, len));
+
+    size_t bad = TRANSPOSE_FN(mismatches, TRANSPOSE_S)(b, TRANSPOSE_M, TRANSPOSE_N);
+    if (bad) {
+        printf("FAIL %s: %lu of %lu elements wrong\n", name, (unsigned long)bad,
+               (unsigned long)len);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    size_t len = (size_t)TRANSPOSE_M * TRANSPOSE_N;
+    elem_t* a = vpu_alloc_ew(len * sizeof(elem_t), TRANSPOSE_EW);
+    elem_t* b = vpu_alloc_ew(len * sizeof(elem_t), TRANSPOSE_EW);
+    TRANSPOSE_FN(fill_source, TRANSPOSE_S)(a, len);
+
+    printf("transpose %d x %d, e%d, %d x %d tiles\n", TRANSPOSE_M, TRANSPOSE_N, TRANSPOSE_EW,
+           (int)transpose_block, (int)transpose_block);
+    if (transpose_block <= 0) {
+        printf("FAIL need transpose_block > 0\n");
+        return 1;
+    }
+
+    if (run_transpose("transpose_strided", TRANSPOSE_FN(transpose_strided, TRANSPOSE_S), a, b))
+        return 1;
+    if (run_transpose("transpose_segload", TRANSPOSE_FN(transpose_segload, TRANSPOSE_S), a, b))
+        return 1;
+    if (run_transpose("transpose_segstore", TRANSPOSE_FN(transpose_segstore, TRANSPOSE_S), a,
+                      b))
+        return 1;
+    if (run_transpose("transpose_scatter", TRANSPOSE_FN(transpose_scatter, TRANSPOSE_S), a, b))
+        return 1;
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
+#include "vinit.h"
 
 volatile uint8_t *vpu_mem = (volatile uint8_t *)0x90000000;
 
@@ -26,15 +27,11 @@ int main() {
     int errors = 0;
 
     // Initialize source data as bytes, then we'll read it as 64-bit elements
-    // Fill with a known pattern
-    for (int i = 0; i < (ARRAY_SIZE + 2) * 8 + SRC_BYTE_OFFSET; i++) {
-        vpu_mem[i] = (uint8_t)(i & 0xFF);
-    }
+    // Fill with a known pattern: byte i holds i & 0xFF
+    vinit_iota_u8((uint8_t *)vpu_mem, (ARRAY_SIZE + 2) * 8 + SRC_BYTE_OFFSET);
 
     // Clear destination area (starting at byte 256 to have separation)
-    for (int i = 0; i < (ARRAY_SIZE + 4) * 8 + DST_BYTE_OFFSET; i++) {
-        vpu_mem[256 + i] = 0;
-    }
+    vinit_fill_u8((uint8_t *)&vpu_mem[256], (ARRAY_SIZE + 4) * 8 + DST_BYTE_OFFSET, 0);
 
     // Pointers to base of source and destination regions
     uint8_t *src_base = (uint8_t *)&vpu_mem[0];
@@ -0,0 +1,213 @@
+/*
+ * Unaligned copy sweep: the cost of a unit-stride copy of ua_bytes bytes with
+ * misaligned source and destination, against the aligned copy, for element widths
+ * e8..e64 and byte offsets 1..VLMAX_BYTES - 1 in steps of ua_step. Each copy is one
+ * e<ew>m8 vle/vse loop, as in vec_load_store_unaligned (unaligned.S), timed in its own
+ * bench region. For each offset the modes are
+ *
+ *   src   source at the offset, destination aligned
+ *   dst   source aligned, destination at the offset
+ *   both  source and destination at the same offset
+ *   peel  as both, but the first bytes up to a vector-register boundary (and the
+ *         bytes after the last whole element) are copied with e8 first, so the main
+ *         loop runs aligned; this is the peel loop a kernel would add
+ *
+ * and each is reported in cycles and as a multiple of the aligned copy, with the worst
+ * and mean ratio per mode at the end of each width. Buffers come from the vpu_alloc_ew
+ * heap of the swept width, so the timed copy runs at the width the pages hold; the
+ * peel mode's e8 head and tail pay for touching them at e8.
+ *
+ * src holds byte b at byte b (mod 256) and dst is poisoned with 0xa5 before every
+ * copy. The copy is checked byte for byte, along with the guard bytes on either side of
+ * it, with e8 vector compares, so the scalar core never reads VPU memory. ua_ew (8, 16,
+ * 32, 64 or 0 for all), ua_bytes and ua_step are set with SYMBOL_VALUES.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench_check.h"
+
+#define UA_MAX_BYTES 4096
+#define UA_MAX_OFFSET (VLMAX_BYTES - 1)
+#define UA_POISON 0xa5
+
+// Copy length in bytes, a multiple of 8; kernel_test overrides these through
+// symbol_values.
+volatile int32_t ua_ew = 0;
+volatile int32_t ua_bytes = 256;
+volatile int32_t ua_step = 1;
+
+enum { MODE_SRC, MODE_DST, MODE_BOTH, MODE_PEEL, N_MODES };
+static const char* const mode_names[N_MODES] = {"src", "dst", "both", "peel"};
+
+typedef void (*copy_fn)(const uint8_t*, uint8_t*, size_t);
+typedef void (*fill_fn)(uint8_t*, size_t, int);
+
+/*
+ * UA_DEFINE(EW, LG) defines, for element width EW = 8 << LG, copy_eEW (bytes / (EW / 8)
+ * elements from src to dst) and fill_eEW (byte b of p = b mod 256, or UA_POISON with
+ * poison set), both over e<EW> elements at whatever alignment src and dst have.
+ */
+#define UA_DEFINE(EW, LG)                                                                \
+static void copy_e##EW(const uint8_t* src, uint8_t* dst, size_t bytes) {                 \
+    const uint##EW##_t* s = (const uint##EW##_t*)src;                                    \
+    uint##EW##_t* d = (uint##EW##_t*)dst;                                                \
+    size_t n = bytes >> LG;                                                              \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                     \
+        __riscv_vse##EW##_v_u##EW##m8(&d[i], __riscv_vle##EW##_v_u##EW##m8(&s[i], vl), vl); \
+        i += vl;                                                                         \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+static void fill_e##EW(uint8_t* p, size_t bytes, int poison) {                           \
+    uint##EW##_t* d = (uint##EW##_t*)p;                                                  \
+    uint##EW##_t ones = (uint##EW##_t)0x0101010101010101ull;                             \
+    uint##EW##_t ramp = (uint##EW##_t)0x0706050403020100ull;                             \
+    size_t n = bytes >> LG;                                                              \
+    for (size_t i = 0; i < n; ) {                                                        \
+        size_t vl = __riscv_vsetvl_e##EW##m8(n - i);                                     \
+        vuint##EW##m8_t v;                                                               \
+        if (poison) {                                                                    \
+            v = __riscv_vmv_v_x_u##EW##m8(ones * UA_POISON, vl);                         \
+        } else {                                                                         \
+            vuint##EW##m8_t k = __riscv_vadd_vx_u##EW##m8(__riscv_vid_v_u##EW##m8(vl), i, vl); \
+            vuint##EW##m8_t b = __riscv_vand_vx_u##EW##m8(                               \
+                __riscv_vsll_vx_u##EW##m8(k, LG, vl), 0xff, vl);                         \
+            v = __riscv_vadd_vx_u##EW##m8(__riscv_vmul_vx_u##EW##m8(b, ones, vl), ramp, vl); \
+        }                                                                                \
+        __riscv_vse##EW##_v_u##EW##m8(&d[i], v, vl);                                     \
+        i += vl;                                                                         \
+    }                                                                                    \
+}
+
+UA_DEFINE(8, 0)
+UA_DEFINE(16, 1)
+UA_DEFINE(32, 2)
+UA_DEFINE(64, 3)
+
+static const int widths[] = {8, 16, 32, 64};
+static const copy_fn copies[] = {copy_e8, copy_e16, copy_e32, copy_e64};
+static const fill_fn fills[] = {fill_e8, fill_e16, fill_e32, fill_e64};
+
+// Number of the n bytes at p that differ from UA_POISON, or with first >= 0 from the
+// ramp first, first + 1, ... (mod 256).
+static size_t mismatches(const uint8_t* p, size_t n, int first) {
+    size_t bad = 0;
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e8m8(n - i);
+        vuint8m8_t want = first < 0 ? __riscv_vmv_v_x_u8m8(UA_POISON, vl)
+            : __riscv_vadd_vx_u8m8(__riscv_vid_v_u8m8(vl), (uint8_t)(first + i), vl);
+        vbool1_t ne = __riscv_vmsne_vv_u8m8_b1(__riscv_vle8_v_u8m8(&p[i], vl), want, vl);
+        bad += __riscv_vcpop_m_b1(ne, vl);
+        i += vl;
+    }
+    return bad;
+}
+
+// The e8 head up to a vector-register boundary of dst, the main loop at width w from
+// there, and the e8 tail of bytes after the last whole element.
+static void peel_copy(int w, const uint8_t* src, uint8_t* dst, size_t bytes) {
+    size_t align = vpu_alloc_alignment();
+    size_t head = (align - (uintptr_t)dst % align) % align;
+    size_t eb = widths[w] / 8;
+    if (head > bytes)
+        head = bytes;
+    size_t body = (bytes - head) / eb * eb;
+    copy_e8(src, dst, head);
+    copies[w](src + head, dst + head, body);
+    copy_e8(src + head + body, dst + head + body, bytes - head - body);
+}
+
+static char region[32];
+
+// Copy bytes from src + soff to dst + doff and return the cycles it took, or 0 if the
+// copy or the guard bytes around it are wrong.
+static unsigned long run_copy(int w, int mode, const uint8_t* src, uint8_t* dst,
+                              size_t buf_bytes, size_t soff, size_t doff,
+                              size_t bytes) {
+    fills[w](dst, buf_bytes, 1);
+    unsigned long start = bench_timed_begin(region);
+    if (mode == MODE_PEEL)
+        peel_copy(w, src + soff, dst + doff, bytes);
+    else
+        copies[w](src + soff, dst + doff, bytes);
+    unsigned long cycles = bench_timed_end(start);
+    size_t bad = mismatches(dst, doff, -1) + mismatches(dst + doff, bytes, soff) +
+                 mismatches(dst + doff + bytes, buf_bytes - doff - bytes, -1);
+    if (bad) {
+        printf("FAIL %s: %zu bytes wrong\n", region, bad);
+        return 0;
+    }
+    return cycles;
+}
+
+static int sweep(int w, size_t bytes, size_t step) {
+    int ew = widths[w];
+    size_t buf_bytes = bytes + UA_MAX_OFFSET + 1;
+    uint8_t* src = vpu_alloc_ew(buf_bytes, ew);
+    uint8_t* dst = vpu_alloc_ew(buf_bytes, ew);
+    fills[w](src, buf_bytes, 0);
+
+    sprintf(region, "ua_e%d_aligned", ew);
+    unsigned long aligned = run_copy(w, MODE_SRC, src, dst, buf_bytes, 0, 0, bytes);
+    if (!aligned)
+        return 1;
+    printf("%s: %lu cycles\n", region, aligned);
+
+    unsigned long worst[N_MODES] = {0}, sum[N_MODES] = {0};
+    size_t worst_off[N_MODES] = {0}, n_offsets = 0;
+    for (size_t off = 1; off <= UA_MAX_OFFSET; off += step) {
+        n_offsets++;
+        for (int mode = 0; mode < N_MODES; mode++) {
+            size_t soff = mode == MODE_DST ? 0 : off;
+            size_t doff = mode == MODE_SRC ? 0 : off;
+            sprintf(region, "ua_e%d_%s_%zu", ew, mode_names[mode], off);
+            unsigned long cycles = run_copy(w, mode, src, dst, buf_bytes, soff, doff, bytes);
+            if (!cycles)
+                return 1;
+            unsigned long ratio = cycles * 100 / aligned;
+            printf("%s: %lu cycles (" BENCH_RATE_FMT "x aligned)\n", region, cycles,
+                   BENCH_RATE(ratio, 100));
+            sum[mode] += ratio;
+            if (ratio > worst[mode]) {
+                worst[mode] = ratio;
+                worst_off[mode] = off;
+            }
+        }
+    }
+    for (int mode = 0; mode < N_MODES && n_offsets; mode++) {
+        unsigned long mean = sum[mode] / n_offsets;
+        printf("e%d %s: worst " BENCH_RATE_FMT "x aligned at offset %zu, mean "
+               BENCH_RATE_FMT "x\n", ew, mode_names[mode], BENCH_RATE(worst[mode], 100),
+               worst_off[mode], BENCH_RATE(mean, 100));
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int ew = ua_ew;
+    size_t bytes = ua_bytes;
+    size_t step = ua_step;
+    printf("unaligned sweep %zu bytes, ew = %d, offset step %zu\n", bytes, ew, step);
+    if (bytes == 0 || bytes > UA_MAX_BYTES || bytes % 8 || step == 0 ||
+        (ew != 0 && ew != 8 && ew != 16 && ew != 32 && ew != 64)) {
+        printf("FAIL need 0 < ua_bytes <= %d, a multiple of 8, ua_step > 0 and ua_ew in "
+               "{0, 8, 16, 32, 64}\n", UA_MAX_BYTES);
+        return 1;
+    }
+
+    for (int w = 0; w < 4; w++) {
+        if ((ew == 0 || ew == widths[w]) && sweep(w, bytes, step))
+            return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
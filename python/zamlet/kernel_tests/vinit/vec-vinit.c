@@ -0,0 +1,183 @@
+/*
+ * Checks and times the vinit library (common/vinit.h) on vinit_n elements. Each fill runs
+ * once as the scalar loop it replaces, one store per element, and once through vinit, in
+ * bench regions scalar_<name> and vinit_<name>, into two buffers from the vpu_alloc_ew
+ * heap of its width. Both buffers are poisoned first, so the strided fill's gaps match
+ * too, and must then agree byte for byte. The compare is an e8 vmsne/vfirst loop, so the
+ * scalar core never reads VPU memory.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+#include "util.h"
+#include "vpu_alloc.h"
+#include "bench.h"
+#include "vinit.h"
+
+// Two buffers of 2 * VINIT_MAX_N 8-byte elements in the 256 KiB e64 heap.
+#define VINIT_MAX_N 4096
+#define VINIT_POISON 0xa5
+#define LFSR_SEED 0x0123456789abcdefull
+
+// Elements per fill; kernel_test overrides it through symbol_values.
+volatile int32_t vinit_n = 256;
+
+typedef void (*fill_fn)(void* dst, size_t n);
+
+static void scalar_iota_u8(void* dst, size_t n) {
+    uint8_t* d = dst;
+    for (size_t i = 0; i < n; i++)
+        d[i] = (uint8_t)i;
+}
+
+static void vector_iota_u8(void* dst, size_t n) {
+    vinit_iota_u8(dst, n);
+}
+
+static void scalar_affine_u32(void* dst, size_t n) {
+    uint32_t* d = dst;
+    for (size_t i = 0; i < n; i++)
+        d[i] = 3 * (uint32_t)i + 7;
+}
+
+static void vector_affine_u32(void* dst, size_t n) {
+    vinit_affine_u32(dst, n, 3, 7);
+}
+
+static void scalar_affine_f32(void* dst, size_t n) {
+    float* d = dst;
+    for (size_t i = 0; i < n; i++)
+        d[i] = 0.5f * (float)i - 2.0f;
+}
+
+static void vector_affine_f32(void* dst, size_t n) {
+    vinit_affine_f32(dst, n, 0.5f, -2.0f);
+}
+
+static void scalar_fill_f64(void* dst, size_t n) {
+    double* d = dst;
+    for (size_t i = 0; i < n; i++)
+        d[i] = 1.5;
+}
+
+static void vector_fill_f64(void* dst, size_t n) {
+    vinit_fill_f64(dst, n, 1.5);
+}
+
+static void scalar_affine_f64(void* dst, size_t n) {
+    double* d = dst;
+    for (size_t i = 0; i < n; i++)
+        d[i] = 0.25 * (double)i + 1.0;
+}
+
+static void vector_affine_f64(void* dst, size_t n) {
+    vinit_affine_f64(dst, n, 0.25, 1.0);
+}
+
+// The real parts of an interleaved complex array, as vec-fftN.c fills its input.
+static void scalar_stride2_f64(void* dst, size_t n) {
+    double* d = dst;
+    for (size_t i = 0; i < n; i++)
+        d[2 * i] = (double)i;
+}
+
+static void vector_stride2_f64(void* dst, size_t n) {
+    vinit_affine_stride_f64(dst, 2, n, 1.0, 0.0);
+}
+
+static void scalar_lfsr_u64(void* dst, size_t n) {
+    uint64_t* d = dst;
+    uint64_t x = LFSR_SEED;
+    for (size_t i = 0; i < n; i++) {
+        x = lfsr(x);
+        d[i] = x;
+    }
+}
+
+static void vector_lfsr_u64(void* dst, size_t n) {
+    vinit_lfsr_u64(dst, n, LFSR_SEED);
+}
+
+struct fill_case {
+    const char* name;
+    int lg;    // element width 8 << lg
+    int span;  // elements of dst covered per element filled
+    fill_fn scalar;
+    fill_fn vector;
+};
+
+static const struct fill_case cases[] = {
+    {"iota_u8", 0, 1, scalar_iota_u8, vector_iota_u8},
+    {"affine_u32", 2, 1, scalar_affine_u32, vector_affine_u32},
+    {"affine_f32", 2, 1, scalar_affine_f32, vector_affine_f32},
+    {"fill_f64", 3, 1, scalar_fill_f64, vector_fill_f64},
+    {"affine_f64", 3, 1, scalar_affine_f64, vector_affine_f64},
+    {"stride2_f64", 3, 2, scalar_stride2_f64, vector_stride2_f64},
+    {"lfsr_u64", 3, 1, scalar_lfsr_u64, vector_lfsr_u64},
+};
+#define N_CASES (sizeof(cases) / sizeof(cases[0]))
+
+// 1 + the first byte where a and b differ, or 0 if their n bytes match.
+static size_t first_difference(const uint8_t* a, const uint8_t* b, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        size_t vl = __riscv_vsetvl_e8m8(n - i);
+        vbool1_t ne = __riscv_vmsne_vv_u8m8_b1(__riscv_vle8_v_u8m8(&a[i], vl),
+                                               __riscv_vle8_v_u8m8(&b[i], vl), vl);
+        long first = __riscv_vfirst_m_b1(ne, vl);
+        if (first >= 0)
+            return i + first + 1;
+        i += vl;
+    }
+    return 0;
+}
+
+static char region[32];
+
+static unsigned long timed(const char* prefix, const char* name, fill_fn fn, void* dst,
+                           size_t n) {
+    sprintf(region, "%s_%s", prefix, name);
+    unsigned long cycles = read_csr(mcycle);
+    bench_begin(region);
+    fn(dst, n);
+    bench_end();
+    return read_csr(mcycle) - cycles;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    size_t n = vinit_n;
+    printf("vinit n = %zu\n", n);
+    if (n == 0 || n > VINIT_MAX_N) {
+        printf("FAIL need 0 < vinit_n <= %d\n", VINIT_MAX_N);
+        return 1;
+    }
+
+    // One pair of buffers per element width, shared by the fills of that width.
+    uint8_t* want[4];
+    uint8_t* got[4];
+    for (int lg = 0; lg < 4; lg++) {
+        want[lg] = vpu_alloc_ew((size_t)2 * VINIT_MAX_N << lg, 8 << lg);
+        got[lg] = vpu_alloc_ew((size_t)2 * VINIT_MAX_N << lg, 8 << lg);
+    }
+
+    for (size_t c = 0; c < N_CASES; c++) {
+        const struct fill_case* fc = &cases[c];
+        size_t bytes = n * fc->span << fc->lg;
+        vinit_fill_u8(want[fc->lg], bytes, VINIT_POISON);
+        vinit_fill_u8(got[fc->lg], bytes, VINIT_POISON);
+        unsigned long scalar = timed("scalar", fc->name, fc->scalar, want[fc->lg], n);
+        unsigned long vector = timed("vinit", fc->name, fc->vector, got[fc->lg], n);
+        size_t bad = first_difference(want[fc->lg], got[fc->lg], bytes);
+        if (bad) {
+            printf("FAIL %s: byte %zu differs\n", fc->name, bad - 1);
+            return 1;
+        }
+        printf("%s: scalar %lu cycles, vinit %lu cycles\n", fc->name, scalar, vector);
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
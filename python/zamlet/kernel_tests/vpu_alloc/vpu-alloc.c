@@ -0,0 +1,60 @@
+/*
+ * Checks the arena marks and scratch free lists of vpu_alloc (common/vpu_alloc.h). Only
+ * the returned addresses are compared, so the VPU memory behind them is never touched.
+ *
+ * - vpu_arena_reset rewinds the pool, so the next vpu_alloc returns the first block
+ *   allocated after the mark.
+ * - A freed scratch block is returned by the next request in its size class, and not by
+ *   a request in another class.
+ * - An arena reset keeps free-listed blocks below the mark and drops those above it, so
+ *   a scratch request never returns a block that a later vpu_alloc handed out again.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "vpu_alloc.h"
+
+static int check(int ok, const char* what) {
+    if (!ok)
+        printf("FAIL %s\n", what);
+    return !ok;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    int bad = 0;
+
+    vpu_arena_mark_t mark = vpu_arena_mark();
+    void* a = vpu_alloc(100);
+    void* b = vpu_alloc(200);
+    bad |= check(b != a, "vpu_alloc returned the same block twice");
+    vpu_arena_reset(mark);
+    bad |= check(vpu_arena_mark() == mark, "the reset did not rewind to the mark");
+    bad |= check(vpu_alloc(100) == a, "the first block after the reset moved");
+
+    // 100 and 120 bytes share the 128-byte class, 300 bytes is in the 512-byte class.
+    void* s = vpu_scratch_alloc(100);
+    vpu_scratch_free(s, 100);
+    bad |= check(vpu_scratch_alloc(300) != s, "a freed block went to another class");
+    bad |= check(vpu_scratch_alloc(120) == s, "a freed block was not reused");
+    bad |= check(vpu_scratch_alloc(100) != s, "a reused block was handed out twice");
+
+    // below is freed before the mark is taken, above after it.
+    void* below = vpu_scratch_alloc(64);
+    mark = vpu_arena_mark();
+    void* above = vpu_scratch_alloc(64);
+    vpu_scratch_free(below, 64);
+    vpu_scratch_free(above, 64);
+    vpu_arena_reset(mark);
+    void* big = vpu_alloc(4096);
+    bad |= check((uintptr_t)big <= (uintptr_t)above, "the reset did not release above");
+    void* reused = vpu_scratch_alloc(64);
+    bad |= check(reused != above, "the reset kept the block above");
+    bad |= check(reused == below, "the reset dropped the block below");
+
+    if (bad)
+        return 1;
+    printf("PASSED\n");
+    return 0;
+}
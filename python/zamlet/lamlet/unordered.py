@@ -400,6 +400,7 @@ async def _handle_full_elements_vpu(
             mask_reg=mask_reg,
             writeset_ident=writeset_ident,
             instr_ident=instr_ident,
+            nontemporal=lamlet.nontemporal_active,
         )
     else:
         kinstr = Load(
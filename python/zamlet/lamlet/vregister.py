@@ -9,6 +9,7 @@ import logging
 from typing import TYPE_CHECKING
 
 from zamlet.addresses import WordOrder
+from zamlet.transactions.reg_compress import RegCompress
 from zamlet.transactions.reg_gather import RegGather
 from zamlet.transactions.reg_slide import RegSlide, SlideDirection
 from zamlet.lamlet import ident_query
@@ -64,6 +65,48 @@ async def vrgather(lamlet: 'Oamlet', vd: int, vs2: int, vs1: int,
     return completion_sync_ident
 
 
+async def vcompress(lamlet: 'Oamlet', vd: int, vs2: int,
+                    src_indices: list[int], data_ew: int,
+                    word_order: WordOrder, vlmax: int, parent_span_id: int) -> int | None:
+    """
+    Execute vcompress.vm once the mask is known: vd[j] = vs2[src_indices[j]].
+
+    src_indices holds the positions of the set mask bits in increasing order, so
+    len(src_indices) elements of vd are written and the rest are tail. Processes
+    in chunks of j_in_l destination elements, each carrying its slice of the
+    indices.
+
+    Returns: completion_sync_ident of the last chunk (or None if no work).
+    """
+    j_in_l = lamlet.params.j_in_l
+    completion_sync_ident = None
+
+    for chunk_offset in range(0, len(src_indices), j_in_l):
+        chunk = tuple(src_indices[chunk_offset:chunk_offset + j_in_l])
+        instr_ident = await ident_query.get_instr_ident(lamlet)
+
+        kinstr = RegCompress(
+            vd=vd,
+            vs2=vs2,
+            start_index=chunk_offset,
+            n_elements=len(chunk),
+            data_ew=data_ew,
+            word_order=word_order,
+            vlmax=vlmax,
+            mask_reg=None,
+            instr_ident=instr_ident,
+            src_indices=chunk,
+        )
+        await lamlet.add_to_instruction_buffer(kinstr, parent_span_id)
+        kinstr_span_id = lamlet.monitor.get_kinstr_span_id(instr_ident)
+
+        completion_sync_ident = instr_ident
+        lamlet.monitor.create_sync_local_span(completion_sync_ident, 0, -1, kinstr_span_id)
+        lamlet.synchronizer.local_event(completion_sync_ident)
+
+    return completion_sync_ident
+
+
 async def vslide(lamlet: 'Oamlet', vd: int, vs2: int,
                  offset: int, direction: SlideDirection,
                  start_index: int, n_elements: int,
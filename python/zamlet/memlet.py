@@ -494,6 +494,15 @@ class Memlet:
                             send_type=SendType.SINGLE,
                             ident=ident,
                         )
+                        cache_slot = (p.sram_address * self.params.j_in_k
+                                      // self.params.cache_line_bytes)
+                        self.monitor.record_message_sent(
+                            self.monitor.get_cache_request_span_id(
+                                self.kamlet_coords[0], self.kamlet_coords[1], cache_slot),
+                            MessageType.WRITE_LINE_RESP.name,
+                            ident=ident, tag=None,
+                            src_x=resp_header.source_x, src_y=resp_header.source_y,
+                            dst_x=resp_header.target_x, dst_y=resp_header.target_y)
                         while not self.send_write_line_response_queue.can_append():
                             await self.clock.next_cycle
                         self.send_write_line_response_queue.append([resp_header])
@@ -14,6 +14,7 @@ from enum import Enum
 from typing import Dict, List, Any, Tuple
 
 from zamlet.message import Direction
+from zamlet.hpm import HpmCounters, HpmEvent
 
 logger = logging.getLogger(__name__)
 
@@ -166,6 +167,10 @@ class Monitor:
         self.clock = clock
         self.params = params
         self.enabled = enabled
+        # Architectural performance counters. Updated even when monitoring is disabled.
+        self.hpm = HpmCounters(clock)
+        # Records sent by the kernel's bench_end() (SYS_bench), in arrival order.
+        self.bench_records: List[Dict[str, Any]] = []
 
         # Span storage
         self.spans: Dict[int, Span] = {}
@@ -265,6 +270,8 @@ class Monitor:
             present: True if there's data waiting for this output
             moving: True if data moved through this output this cycle
         """
+        if present and not moving:
+            self.hpm.count(HpmEvent.NETWORK_STALL)
         if not self.enabled:
             return
         metrics = self._get_cycle_metrics()
@@ -301,6 +308,7 @@ class Monitor:
         self._get_cycle_metrics().instr_net_sent = True
 
     def record_instr_net_blocked(self) -> None:
+        self.hpm.count(HpmEvent.INSTR_NET_STALL)
         if not self.enabled:
             return
         self._get_cycle_metrics().instr_net_blocked = True
@@ -512,6 +520,7 @@ class Monitor:
 
     def record_kinstr_created(self, kinstr, parent_span_id: int) -> int:
         """Record a kinstr creation. Delegates to kinstr.create_span()."""
+        self.hpm.count(HpmEvent.KINSTR_DISPATCHED)
         span_id = kinstr.create_span(self, parent_span_id)
         # Store in lookup table if kinstr has an instr_ident
         if kinstr.instr_ident is not None:
@@ -951,6 +960,7 @@ class Monitor:
 
         parent_span_id: The witem span that triggered this cache request.
         """
+        self.hpm.count(HpmEvent.CACHE_MISS)
         if not self.enabled:
             return None
 
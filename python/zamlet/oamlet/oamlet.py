@@ -30,6 +30,7 @@ from zamlet.lamlet.lamlet_waiting_item import (
     LamletWaitingVrgatherBroadcast,
     LamletWaitingLoadIndexedElement, LamletWaitingStoreIndexedElement)
 from zamlet.monitor import CompletionType, SpanType
+from zamlet.hpm import HpmEvent
 from zamlet.params import ZamletParams
 from zamlet.message import (Header, MessageType, Direction, SendType, TaggedHeader,
                             WriteMemWordHeader, CHANNEL_MAPPING, IdentHeader,
@@ -67,6 +68,10 @@ from zamlet.lamlet import vregister
 
 logger = logging.getLogger(__name__)
 
+# HTIF syscall number used by bench_end() in kernel_tests/common/syscalls.c.
+SYS_BENCH = 0x5a01
+BENCH_NAME_MAX_BYTES = 64
+
 
 class Oamlet:
 
@@ -183,6 +188,8 @@ class Oamlet:
         # 0 = no bound (full 64-bit indices), N = mask indices to lower N bits
         self.index_bound_bits: int = 0
         self.active_writeset_ident: int | None = None
+        # Set between begin_nontemporal and end_nontemporal.
+        self.nontemporal_active = False
         self.next_instr_ident = 0
         # Track oldest active instr_ident for flow control (None = unknown/all free)
         self._oldest_active_ident: int | None = None
@@ -703,6 +710,44 @@ class Oamlet:
         )
         return future
 
+    async def read_mask_bits(self, vreg, n_bits):
+        """Read bits [0, n_bits) of mask register vreg into the lamlet.
+
+        Sends one ReadRegWord per jamlet and waits for all of them. Mask bit i
+        is bit i // j_in_l of the mask word held by the jamlet with vw index
+        i % j_in_l. Returns a list of n_bits bools.
+        """
+        ordering = self.vrf_ordering[vreg]
+        assert ordering.ew == 1
+        j_in_l = self.params.j_in_l
+        wb = self.params.word_bytes
+        assert n_bits <= j_in_l * wb * 8
+        futures = []
+        for vw_index in range(j_in_l):
+            k_index, j_in_k_index = addresses.vw_index_to_k_indices(
+                self.params, ordering.word_order, vw_index)
+            instr_ident = await ident_query.get_instr_ident(self)
+            future = self.clock.create_future()
+            witem = LamletWaitingReadRegElement(
+                future=future, instr_ident=instr_ident,
+                element_width=wb * 8, word_bytes=wb, element_byte_offset=0,
+            )
+            await self.add_witem(witem)
+            kinstr = kinstructions.ReadRegWord(
+                src=vreg,
+                j_in_k_index=j_in_k_index,
+                instr_ident=instr_ident,
+            )
+            await self.add_to_instruction_buffer(
+                kinstr, self._ident_query_span_id, k_index,
+            )
+            futures.append(future)
+        words = []
+        for future in futures:
+            await future
+            words.append(int.from_bytes(future.result(), byteorder='little', signed=False))
+        return [bool((words[i % j_in_l] >> (i // j_in_l)) & 1) for i in range(n_bits)]
+
     async def router_connections(self, channel):
         '''
         Move words between router buffers
@@ -1538,6 +1583,37 @@ class Oamlet:
         result = future.result()
         return result
 
+    async def _read_bench_record(self, record_addr: int, length: int) -> dict:
+        """Decode a bench_record_t (kernel_tests/common/syscalls.c) from memory."""
+        n_hpm = 4
+        assert length == 8 * (3 + 2 * n_hpm), f'Unexpected bench record length {length}'
+        raw = await self.get_memory_blocking(record_addr, length)
+        fields = [int.from_bytes(raw[i:i+8], byteorder='little') for i in range(0, length, 8)]
+        name_addr, cycles, instret = fields[0:3]
+        events = fields[3:3+n_hpm]
+        values = fields[3+n_hpm:3+2*n_hpm]
+
+        name_bytes = bytearray()
+        while len(name_bytes) < BENCH_NAME_MAX_BYTES:
+            b = (await self.get_memory_blocking(name_addr + len(name_bytes), 1))[0]
+            if b == 0:
+                break
+            name_bytes.append(b)
+
+        known_events = {e.value: e for e in HpmEvent if e != HpmEvent.NONE}
+        counters = {}
+        for event, value in zip(events, values):
+            if event in known_events:
+                counters[known_events[event].name.lower()] = value
+        record = {
+            'name': name_bytes.decode('utf-8', errors='replace'),
+            'cycles': cycles,
+            'instret': instret,
+            'counters': counters,
+        }
+        logger.info(f'BENCH: {record}')
+        return record
+
     async def handle_tohost(self, tohost_value):
         """Handle HTIF syscall via tohost write."""
         # Check if this is an exit code (LSB = 1)
@@ -1580,6 +1656,8 @@ class Oamlet:
             else:
                 logger.warning(f'Unsupported file descriptor: {fd}')
                 ret_value = -1
+        elif syscall_num == SYS_BENCH:
+            self.monitor.bench_records.append(await self._read_bench_record(arg0, arg1))
         else:
             logger.warning(f'Unsupported syscall: {syscall_num}')
             ret_value = -1
@@ -1726,37 +1804,127 @@ class Oamlet:
         return await unordered.vstore(self, vs, addr, ordering, n_elements, mask_reg, start_index,
                                       parent_span_id, stride_bytes)
 
+    async def vsegload(self, vd: int, addr: int, ordering: addresses.Ordering,
+                       n_elements: int, mask_reg: int | None, start_index: int, nf: int,
+                       parent_span_id: int, emul: int = 1,
+                       stride_bytes: int | None = None) -> addresses.VectorOpResult:
+        """Segment load, issued as one strided load per field.
+
+        Field f of segment i is read from addr + i * stride_bytes + f * ew / 8 into
+        element i of register group vd + f * emul. stride_bytes defaults to the
+        segment size (the unit-stride form). Returns the fault with the lowest
+        segment index, if any; fields may be loaded past it, as loads allow.
+        """
+        assert nf * emul <= 8, f'vsegload: nf={nf} * emul={emul} exceeds 8 registers'
+        element_bytes = ordering.ew // 8
+        if stride_bytes is None:
+            stride_bytes = nf * element_bytes
+        first_fault = addresses.VectorOpResult()
+        for field in range(nf):
+            result = await self.vload(
+                vd + field * emul, addr + field * element_bytes, ordering, n_elements,
+                mask_reg, start_index, parent_span_id, emul=emul, stride_bytes=stride_bytes)
+            if not result.success and (
+                    first_fault.success or result.element_index < first_fault.element_index):
+                first_fault = result
+        return first_fault
+
+    async def vsegstore(self, vs: int, addr: int, ordering: addresses.Ordering,
+                        n_elements: int, mask_reg: int | None, start_index: int, nf: int,
+                        parent_span_id: int, emul: int = 1,
+                        stride_bytes: int | None = None) -> addresses.VectorOpResult:
+        """Segment store, issued as one strided store per field.
+
+        The layout matches vsegload. The pages of every active segment are checked
+        before any field is stored, and the fields are then stored only for the
+        segments before the first faulting one, so the store stops precisely: no
+        byte of the faulting segment or of any later one is written.
+        """
+        assert nf * emul <= 8, f'vsegstore: nf={nf} * emul={emul} exceeds 8 registers'
+        element_bytes = ordering.ew // 8
+        if stride_bytes is None:
+            stride_bytes = nf * element_bytes
+        mask_bits = None
+        if mask_reg is not None:
+            mask_bits = await self.read_mask_bits(mask_reg, n_elements)
+        fault = self._first_segment_fault(
+            addr, n_elements, start_index, nf, element_bytes, stride_bytes, mask_bits)
+        if not fault.success:
+            n_elements = fault.element_index
+        if n_elements <= start_index:
+            return fault
+        for field in range(nf):
+            result = await self.vstore(
+                vs + field * emul, addr + field * element_bytes, ordering, n_elements,
+                mask_reg, start_index, parent_span_id, emul=emul, stride_bytes=stride_bytes)
+            assert result.success, f'vsegstore: field {field} faulted after the page check'
+        return fault
+
+    def _first_segment_fault(self, addr: int, n_elements: int, start_index: int, nf: int,
+                             element_bytes: int, stride_bytes: int,
+                             mask_bits: List[bool] | None) -> addresses.VectorOpResult:
+        """The store fault with the lowest active segment index in [start_index, n_elements).
+
+        mtval is the first byte of the segment that cannot be written.
+        """
+        for i in range(start_index, n_elements):
+            if mask_bits is not None and not mask_bits[i]:
+                continue
+            seg_addr = addr + i * stride_bytes
+            for byte_addr in (seg_addr, seg_addr + nf * element_bytes - 1):
+                g_addr = GlobalAddress(bit_addr=byte_addr * 8, params=self.params)
+                fault_type = self.tlb.check_access(g_addr, True)
+                if fault_type != addresses.TLBFaultType.NONE:
+                    if byte_addr != seg_addr:
+                        page_bytes = self.params.page_bytes
+                        byte_addr = (byte_addr // page_bytes) * page_bytes
+                    return addresses.VectorOpResult(
+                        fault_type=fault_type, element_index=i, fault_addr=byte_addr)
+        return addresses.VectorOpResult()
+
     async def vload_indexed_unordered(self, vd: int, base_addr: int, index_reg: int,
                                        index_ew: int, data_ew: int, n_elements: int,
                                        mask_reg: int | None, start_index: int,
                                        parent_span_id: int) -> addresses.VectorOpResult:
-        return await unordered.vload_indexed_unordered(self, vd, base_addr, index_reg, index_ew,
+        result = await unordered.vload_indexed_unordered(self, vd, base_addr, index_reg, index_ew,
                                                        data_ew, n_elements, mask_reg, start_index,
                                                        parent_span_id)
+        if not result.success:
+            self.monitor.hpm.count(HpmEvent.INDEXED_FAULT)
+        return result
 
     async def vstore_indexed_unordered(self, vs: int, base_addr: int, index_reg: int,
                                         index_ew: int, data_ew: int, n_elements: int,
                                         mask_reg: int | None, start_index: int,
                                         parent_span_id: int) -> addresses.VectorOpResult:
-        return await unordered.vstore_indexed_unordered(self, vs, base_addr, index_reg, index_ew,
+        result = await unordered.vstore_indexed_unordered(self, vs, base_addr, index_reg, index_ew,
                                                         data_ew, n_elements, mask_reg, start_index,
                                                         parent_span_id)
+        if not result.success:
+            self.monitor.hpm.count(HpmEvent.INDEXED_FAULT)
+        return result
 
     async def vload_indexed_ordered(self, vd: int, base_addr: int, index_reg: int,
                                     index_ew: int, data_ew: int, n_elements: int,
                                     mask_reg: int | None, start_index: int,
                                     parent_span_id: int) -> addresses.VectorOpResult:
-        return await ordered.vload_indexed_ordered(self, vd, base_addr, index_reg, index_ew,
+        result = await ordered.vload_indexed_ordered(self, vd, base_addr, index_reg, index_ew,
                                                    data_ew, n_elements, mask_reg, start_index,
                                                    parent_span_id)
+        if not result.success:
+            self.monitor.hpm.count(HpmEvent.INDEXED_FAULT)
+        return result
 
     async def vstore_indexed_ordered(self, vs: int, base_addr: int, index_reg: int,
                                      index_ew: int, data_ew: int, n_elements: int,
                                      mask_reg: int | None, start_index: int,
                                      parent_span_id: int) -> addresses.VectorOpResult:
-        return await ordered.vstore_indexed_ordered(self, vs, base_addr, index_reg, index_ew,
+        result = await ordered.vstore_indexed_ordered(self, vs, base_addr, index_reg, index_ew,
                                                     data_ew, n_elements, mask_reg, start_index,
                                                     parent_span_id)
+        if not result.success:
+            self.monitor.hpm.count(HpmEvent.INDEXED_FAULT)
+        return result
 
     async def vrgather(self, vd: int, vs2: int, vs1: int,
                        start_index: int, n_elements: int,
@@ -1768,6 +1936,13 @@ class Oamlet:
                                         index_ew, data_ew, word_order, vlmax,
                                         mask_reg, parent_span_id)
 
+    async def vcompress(self, vd: int, vs2: int, src_indices: list[int], data_ew: int,
+                        word_order: addresses.WordOrder, vlmax: int,
+                        parent_span_id: int) -> int | None:
+        """Execute vcompress.vm for known source indices. Returns sync_ident."""
+        return await vregister.vcompress(self, vd, vs2, src_indices, data_ew,
+                                         word_order, vlmax, parent_span_id)
+
     async def vslide(self, vd: int, vs2: int,
                      offset: int, direction: 'vregister.SlideDirection',
                      start_index: int, n_elements: int,
@@ -1844,6 +2019,7 @@ class Oamlet:
         except Exception:
             logger.error(f'Exception at pc={hex(self.pc)} instruction={inst_str}')
             raise
+        self.monitor.hpm.retire()
 
     async def run_instructions(self, disasm_trace=None):
         while not self.finished:
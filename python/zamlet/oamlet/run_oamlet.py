@@ -5,6 +5,7 @@ import struct
 
 from zamlet import disasm_trace
 from zamlet import program_info
+from zamlet.analysis import phase_profile
 from zamlet.oamlet import oamlet
 from zamlet.runner import Clock
 from zamlet.params import ZamletParams
@@ -35,6 +36,13 @@ def write_span_trees(lam):
     logger.info(f"Span trees written to {path}")
 
 
+def write_phase_profile(lam):
+    """Write the zamlet_mark phase table and timeline next to the span trees."""
+    out_dir = os.environ.get('TEST_UNDECLARED_OUTPUTS_DIR', '.')
+    if phase_profile.write_phase_profile(lam.monitor, out_dir):
+        logger.info(f"Phase profile written to {out_dir}/phases.txt")
+
+
 async def run(clock: Clock, filename, params: ZamletParams = None,
               word_order: WordOrder = WordOrder.STANDARD,
               symbol_values: dict = None):
@@ -74,14 +82,15 @@ async def run(clock: Clock, filename, params: ZamletParams = None,
         s.allocate_memory(GlobalAddress(bit_addr=page_start*8, params=params),
                           alloc_size, memory_type=memory_type)
 
-    # Allocate VPU memory pool (1MB as defined in vpu_alloc.c)
-    pool_size = 1024 * 1024
+    # Allocate VPU memory pool. Keep in sync with vpu_alloc.h: a 1MB general heap followed
+    # by four 256KB per-element-width heaps, [0x90000000, 0x90200000).
+    pool_size = 2 * 1024 * 1024
     s.allocate_memory(
         GlobalAddress(bit_addr=0x90000000*8, params=params),
         pool_size, memory_type=MemoryType.VPU)
 
     # Allocate VPU stack (at least 256KB, rounded up to page boundary; s11 starts at top).
-    # Keep in sync with `li s11, 0xA0040000` in crt.S — stack region is
+    # Keep in sync with VPU_STACK_BASE/VPU_STACK_END in vpu_alloc.h — stack region is
     # [0xA0000000, 0xA0040000).
     vpu_stack_size = (
         (256 * 1024 + params.page_bytes - 1) // params.page_bytes) * params.page_bytes
@@ -93,6 +102,9 @@ async def run(clock: Clock, filename, params: ZamletParams = None,
         address = section['address']
         data = section['contents']
         ew = section['ew']
+        if ew is not None and section['nobits']:
+            # .bss.vpuN: crt.S clears it with vector stores before main.
+            continue
         ordering = Ordering(word_order, ew) if ew is not None else None
         logger.info(
             f'[MEM_INIT] Section addr=0x{address:x} size={len(data)} ew={ew}')
@@ -157,6 +169,7 @@ async def run(clock: Clock, filename, params: ZamletParams = None,
             logger.info(f"run() exiting with clock.running=False, exit_code={s.exit_code}")
     finally:
         write_span_trees(s)
+        write_phase_profile(s)
     return exit_code, s.monitor
 
 
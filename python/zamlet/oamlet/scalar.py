@@ -6,6 +6,7 @@ from typing import List, Optional
 from zamlet.runner import Clock, Future
 from zamlet.params import ZamletParams
 from zamlet.monitor import Monitor
+from zamlet.hpm import HpmCounters
 from zamlet.register_file_slot import RegisterFileSlot
 from zamlet.synchronization import Synchronizer
 from zamlet.trap import CSR_MSTATUS, CSR_MTVEC, CSR_MEPC, CSR_MCAUSE, CSR_MTVAL
@@ -197,6 +198,9 @@ class ScalarState:
 
     def read_csr(self, csr_addr):
         """Read CSR, returns bytes of length word_bytes."""
+        if HpmCounters.handles(csr_addr):
+            value = self.monitor.hpm.read(csr_addr) & ((1 << (8 * self.params.word_bytes)) - 1)
+            return value.to_bytes(self.params.word_bytes, 'little')
         if csr_addr not in self.csr:
             return bytes(self.params.word_bytes)
         return self.csr[csr_addr]
@@ -204,6 +208,9 @@ class ScalarState:
     def write_csr(self, csr_addr, value):
         """Write CSR, value should be bytes."""
         assert isinstance(value, bytes), f"CSR value must be bytes, got {type(value)}"
+        if HpmCounters.handles(csr_addr):
+            self.monitor.hpm.write(csr_addr, int.from_bytes(value, 'little'))
+            return
         self.csr[csr_addr] = value
 
     def update(self):
@@ -28,6 +28,7 @@ def get_program_info(filename='vec-sgemv.riscv'):
                 'address': addr,
                 'contents': data,
                 'ew': ew,
+                'nobits': section['sh_type'] == 'SHT_NOBITS',
             })
 
         entry_point = elf['e_entry']
@@ -0,0 +1,102 @@
+"""
+Test the decode of bench_end records (SYS_bench, kernel_tests/common/syscalls.c).
+
+- A record's name, cycle and instret deltas and its selected counters are decoded, with
+  unselected or unknown events left out.
+- A name with no terminator within BENCH_NAME_MAX_BYTES is cut there.
+- handle_tohost appends the record to Monitor.bench_records and completes the syscall.
+"""
+
+import asyncio
+
+from zamlet.hpm import HpmEvent
+from zamlet.oamlet.oamlet import BENCH_NAME_MAX_BYTES, SYS_BENCH, Oamlet
+
+
+NAME_ADDR = 0x1000
+RECORD_ADDR = 0x2000
+MAGIC_ADDR = 0x3000
+FROMHOST_ADDR = 0x4000
+
+
+class FakeParams:
+
+    fromhost_addr = FROMHOST_ADDR
+
+
+class FakeMonitor:
+
+    def __init__(self):
+        self.bench_records = []
+
+
+class FakeOamlet:
+    """The memory and monitor the Oamlet bench record methods use, over a byte dict."""
+
+    _read_bench_record = Oamlet._read_bench_record
+
+    def __init__(self):
+        self.memory = {}
+        self.params = FakeParams()
+        self.monitor = FakeMonitor()
+
+    def store(self, addr: int, data: bytes):
+        for i, b in enumerate(data):
+            self.memory[addr + i] = b
+
+    async def get_memory_blocking(self, address: int, size: int):
+        return bytes(self.memory.get(address + i, 0) for i in range(size))
+
+    async def set_memory(self, address: int, data: bytes):
+        self.store(address, data)
+
+
+def store_record(oamlet, name: bytes, cycles: int, instret: int, events, values) -> int:
+    """Write name and a bench_record_t pointing at it; return the record length."""
+    oamlet.store(NAME_ADDR, name)
+    fields = [NAME_ADDR, cycles, instret] + list(events) + list(values)
+    oamlet.store(RECORD_ADDR, b''.join(f.to_bytes(8, 'little') for f in fields))
+    return 8 * len(fields)
+
+
+def test_decode_record():
+    oamlet = FakeOamlet()
+    events = [int(HpmEvent.CACHE_MISS), int(HpmEvent.NONE), 999,
+              int(HpmEvent.NETWORK_STALL)]
+    length = store_record(oamlet, b'daxpy\0', 1234, 567, events, [10, 20, 30, 40])
+    record = asyncio.run(oamlet._read_bench_record(RECORD_ADDR, length))
+    assert record == {
+        'name': 'daxpy',
+        'cycles': 1234,
+        'instret': 567,
+        'counters': {'cache_miss': 10, 'network_stall': 40},
+    }
+
+
+def test_name_clamped():
+    oamlet = FakeOamlet()
+    length = store_record(oamlet, b'a' * (BENCH_NAME_MAX_BYTES + 16), 1, 1, [0] * 4,
+                          [0] * 4)
+    record = asyncio.run(oamlet._read_bench_record(RECORD_ADDR, length))
+    assert record['name'] == 'a' * BENCH_NAME_MAX_BYTES
+
+
+def test_handle_tohost_appends_record():
+    oamlet = FakeOamlet()
+    length = store_record(oamlet, b'triad\0', 99, 12, [int(HpmEvent.CACHE_MISS), 0, 0, 0],
+                          [7, 0, 0, 0])
+    for i, v in enumerate([SYS_BENCH, RECORD_ADDR, length, 0]):
+        oamlet.store(MAGIC_ADDR + 8 * i, v.to_bytes(8, 'little'))
+
+    asyncio.run(Oamlet.handle_tohost(oamlet, MAGIC_ADDR))
+
+    assert oamlet.monitor.bench_records == [{
+        'name': 'triad',
+        'cycles': 99,
+        'instret': 12,
+        'counters': {'cache_miss': 7},
+    }]
+    ret = asyncio.run(oamlet.get_memory_blocking(MAGIC_ADDR, 8))
+    assert int.from_bytes(ret, 'little', signed=True) == 0
+    assert asyncio.run(oamlet.get_memory_blocking(FROMHOST_ADDR, 8)) == \
+        (1).to_bytes(8, 'little')
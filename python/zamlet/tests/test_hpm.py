@@ -0,0 +1,77 @@
+"""
+Test the machine counter CSRs backed by zamlet.hpm.
+
+- mcycle follows the clock and minstret counts retired instructions.
+- mhpmcounterN reports the event selected through mhpmeventN, starting from zero at
+  selection, and can be written to rebase it.
+- ScalarState routes counter CSRs through the monitor's HpmCounters.
+"""
+
+import pytest
+
+from zamlet.hpm import (
+    HpmCounters, HpmEvent, CSR_MCYCLE, CSR_MINSTRET, CSR_CYCLE, CSR_MHPMCOUNTER3,
+    CSR_HPMCOUNTER3, CSR_MHPMEVENT3,
+)
+from zamlet.monitor import Monitor
+from zamlet.oamlet.scalar import ScalarState
+from zamlet.params import ZamletParams
+
+
+class FakeClock:
+
+    def __init__(self):
+        self.cycle = 0
+
+
+def test_cycle_and_instret():
+    clock = FakeClock()
+    hpm = HpmCounters(clock)
+    clock.cycle = 123
+    hpm.retire()
+    hpm.retire()
+    assert hpm.read(CSR_MCYCLE) == 123
+    assert hpm.read(CSR_CYCLE) == 123
+    assert hpm.read(CSR_MINSTRET) == 2
+
+
+def test_event_selection():
+    hpm = HpmCounters(FakeClock())
+    hpm.count(HpmEvent.CACHE_MISS, 5)
+    assert hpm.read(CSR_MHPMCOUNTER3) == 0
+
+    hpm.write(CSR_MHPMEVENT3, int(HpmEvent.CACHE_MISS))
+    assert hpm.read(CSR_MHPMEVENT3) == int(HpmEvent.CACHE_MISS)
+    assert hpm.read(CSR_MHPMCOUNTER3) == 0
+    hpm.count(HpmEvent.CACHE_MISS, 3)
+    hpm.count(HpmEvent.NETWORK_STALL, 7)
+    assert hpm.read(CSR_MHPMCOUNTER3) == 3
+    assert hpm.read(CSR_HPMCOUNTER3) == 3
+
+    hpm.write(CSR_MHPMCOUNTER3, 100)
+    hpm.count(HpmEvent.CACHE_MISS)
+    assert hpm.read(CSR_MHPMCOUNTER3) == 101
+
+    hpm.write(CSR_MHPMEVENT3 + 1, 999)
+    assert hpm.read(CSR_MHPMEVENT3 + 1) == int(HpmEvent.NONE)
+
+
+def test_user_counters_read_only():
+    hpm = HpmCounters(FakeClock())
+    with pytest.raises(AssertionError):
+        hpm.write(CSR_CYCLE, 0)
+
+
+def test_scalar_csr_routing():
+    params = ZamletParams()
+    clock = FakeClock()
+    monitor = Monitor(clock, params, enabled=False)
+    scalar = ScalarState(clock, params, monitor)
+    word_bytes = params.word_bytes
+
+    scalar.write_csr(CSR_MHPMEVENT3, int(HpmEvent.KINSTR_DISPATCHED).to_bytes(
+        word_bytes, 'little'))
+    monitor.hpm.count(HpmEvent.KINSTR_DISPATCHED, 4)
+    clock.cycle = 42
+    assert int.from_bytes(scalar.read_csr(CSR_MHPMCOUNTER3), 'little') == 4
+    assert int.from_bytes(scalar.read_csr(CSR_MCYCLE), 'little') == 42
@@ -0,0 +1,161 @@
+"""
+Test the non-temporal store scope (custom-0, funct3=5 and 6).
+
+- A stream of unit-stride stores twice the size of the cache, issued in the scope, leaves a
+  resident half of the cache in place: each line it writes is written back and its slot
+  freed once the stream moves on. Only the newest stream lines stay cached.
+- The same stream outside the scope evicts the resident lines.
+- Either way the stream's data reaches memory.
+"""
+
+import logging
+from random import Random
+
+import pytest
+
+from zamlet.addresses import GlobalAddress, MemoryType, Ordering
+from zamlet.decode import decode_standard
+from zamlet.geometries import SMALL_GEOMETRIES
+from zamlet.instructions.custom import BeginNontemporal, EndNontemporal
+from zamlet.instructions.encode import encode_begin_nontemporal, encode_end_nontemporal
+from zamlet.monitor import CompletionType, SpanType
+from zamlet.params import ZamletParams
+from zamlet.tests.test_utils import run_test, set_vline_random_ew
+
+logger = logging.getLogger(__name__)
+
+
+SRC_ADDR = 0x20000000
+BASE_ADDR = 0x90000000
+LMUL = 8
+# Stream lines each kamlet may still hold at the end: the newest one, which the write-through
+# leaves for the stream's next stores, and the one the final read brings in.
+MAX_STREAM_LINES_LEFT = 2
+
+
+def allocate(lamlet, addr: int, n_bytes: int, memory_type: MemoryType):
+    g_addr = GlobalAddress(bit_addr=addr * 8, params=lamlet.params)
+    lamlet.allocate_memory(g_addr, n_bytes, memory_type=memory_type)
+
+
+def cached_lines(kamlet, lo: int, hi: int) -> int:
+    """Number of cache lines of kamlet memory [lo, hi) that `kamlet` holds."""
+    table = kamlet.cache_table
+    line_bytes = table.cache_line_bytes
+    return sum(1 for state in table.slot_states
+               if state.memory_loc is not None and lo <= state.memory_loc * line_bytes < hi)
+
+
+def k_range(lamlet, addr: int, n_bytes: int) -> tuple[int, int]:
+    """Kamlet-memory range holding the VPU range [addr, addr + n_bytes), which must sit
+    in consecutive VPU pages of one allocation."""
+    params = lamlet.params
+    vpu_addr = lamlet.tlb.pages[addr // params.page_bytes * params.page_bytes].physical_addr
+    vpu_addr += addr % params.page_bytes
+    lo = vpu_addr // params.vline_bytes * params.k_vline_bytes
+    return lo, lo + n_bytes // params.k_in_l
+
+
+async def stream_stores(clock, lamlet, dst: int, n_bytes: int, nontemporal: bool):
+    """Store v0..v7, loaded from scalar memory, over [dst, dst + n_bytes)."""
+    params = lamlet.params
+    span_id = lamlet.monitor.create_span(
+        span_type=SpanType.RISCV_INSTR, component="test",
+        completion_type=CompletionType.FIRE_AND_FORGET, mnemonic="test_stream")
+    ordering = Ordering(lamlet.word_order, 64)
+    n_elements = LMUL * params.vline_bytes // 8
+    lamlet.vl = n_elements
+    lamlet.set_vtype(64, LMUL)
+    await lamlet.vload(vd=0, addr=SRC_ADDR, ordering=ordering, n_elements=n_elements,
+                       start_index=0, mask_reg=None, parent_span_id=span_id)
+    lamlet.pc = 0
+    if nontemporal:
+        await BeginNontemporal().update_state(lamlet)
+    for offset in range(0, n_bytes, LMUL * params.vline_bytes):
+        await lamlet.vstore(vs=0, addr=dst + offset, ordering=ordering,
+                            n_elements=n_elements, start_index=0, mask_reg=None,
+                            parent_span_id=span_id)
+    if nontemporal:
+        await EndNontemporal().update_state(lamlet)
+    lamlet.monitor.finalize_children(span_id)
+
+
+async def run_stream(clock, lamlet, params, nontemporal: bool) -> int:
+    rnd = Random(3)
+    cache_bytes = lamlet.kamlets[0].cache_table.n_slots * params.cache_line_bytes
+    resident_bytes = params.k_in_l * cache_bytes // 2
+    stream_bytes = 2 * params.k_in_l * cache_bytes
+    resident = BASE_ADDR
+    stream = BASE_ADDR + resident_bytes
+    allocate(lamlet, resident, resident_bytes + stream_bytes, MemoryType.VPU)
+    set_vline_random_ew(lamlet, resident, resident_bytes + stream_bytes, rnd)
+    block_bytes = LMUL * params.vline_bytes
+    allocate(lamlet, SRC_ADDR, max(block_bytes, params.page_bytes),
+             MemoryType.SCALAR_IDEMPOTENT)
+    block = bytes(rnd.getrandbits(8) for _ in range(block_bytes))
+    await lamlet.set_memory(SRC_ADDR, block)
+
+    await lamlet.set_memory_existing_ew(
+        resident, bytes(rnd.getrandbits(8) for _ in range(resident_bytes)))
+    await lamlet.get_memory_blocking(resident, 1)
+    res_lo, res_hi = k_range(lamlet, resident, resident_bytes)
+    res_lines = resident_bytes // params.k_in_l // params.cache_line_bytes
+    for kamlet in lamlet.kamlets:
+        assert cached_lines(kamlet, res_lo, res_hi) == res_lines
+
+    await stream_stores(clock, lamlet, stream, stream_bytes, nontemporal)
+    # The read lands after the stores.
+    last = stream + stream_bytes - params.vline_bytes
+    got = await lamlet.get_memory_blocking(last, params.vline_bytes)
+    while any(len(k.cache_table.write_through_lines) > 1 or any(k.cache_table.cache_requests)
+              for k in lamlet.kamlets):
+        await clock.next_cycle
+
+    str_lo, str_hi = k_range(lamlet, stream, stream_bytes)
+    for kamlet in lamlet.kamlets:
+        kept = cached_lines(kamlet, res_lo, res_hi)
+        left = cached_lines(kamlet, str_lo, str_hi)
+        logger.info(f'kamlet {kamlet.k_index}: {kept}/{res_lines} resident lines kept, '
+                    f'{left} stream lines cached')
+        if nontemporal and (kept != res_lines or left > MAX_STREAM_LINES_LEFT):
+            logger.error(f'kamlet {kamlet.k_index}: the nontemporal stream kept {left} '
+                         f'lines and evicted {res_lines - kept} resident lines')
+            return 1
+        if not nontemporal and kept != 0:
+            logger.error(f'kamlet {kamlet.k_index}: {kept} resident lines survived the stream')
+            return 1
+
+    if got != block[-params.vline_bytes:]:
+        logger.error(f'last stream vline reads {got.hex()}')
+        return 1
+    got = await lamlet.get_memory_blocking(stream, block_bytes)
+    if got != block:
+        logger.error(f'first stream block reads {got.hex()}')
+        return 1
+    return 0
+
+
+def test_decode():
+    instr = decode_standard(encode_begin_nontemporal().to_bytes(4, 'little'))
+    assert isinstance(instr, BeginNontemporal)
+    instr = decode_standard(encode_end_nontemporal().to_bytes(4, 'little'))
+    assert isinstance(instr, EndNontemporal)
+
+
+@pytest.mark.parametrize("geometry", list(SMALL_GEOMETRIES))
+def test_nontemporal_stream_keeps_cache(geometry):
+    params = SMALL_GEOMETRIES[geometry]
+
+    async def body(clock, lamlet):
+        return await run_stream(clock, lamlet, params, nontemporal=True)
+
+    run_test(body, params, max_cycles=400000)
+
+
+def test_temporal_stream_evicts():
+    params = ZamletParams()
+
+    async def body(clock, lamlet):
+        return await run_stream(clock, lamlet, params, nontemporal=False)
+
+    run_test(body, params, max_cycles=400000)
@@ -0,0 +1,98 @@
+"""
+Test the zamlet_mark phase profiler (analysis/phase_profile.py).
+
+- Marker events are collected per kamlet in cycle order; other events are ignored.
+- On each kamlet a phase runs to the kamlet's next marker, or to the end of the run.
+- An instance costs its slowest kamlet, and the table orders marker ids by first start.
+- The Chrome trace has one track per kamlet and one complete event per phase.
+- main() prints the table and writes the trace for a dump_to_file() JSON.
+"""
+
+import json
+
+from zamlet.analysis.phase_profile import (
+    build_phases, chrome_trace, collect_markers, format_phase_table, main, phase_table,
+)
+
+
+def marker(cycle, marker_id):
+    return {'event': 'marker', 'cycle': cycle, 'details': {'marker_id': marker_id}}
+
+
+def span(component, events, created=0, completed=None):
+    return {'component': component, 'events': events, 'created_cycle': created,
+            'completed_cycle': completed}
+
+
+# Two kamlets run phase 1 (twice, the kamlets skewed) and phase 2 once. kamlet(1)'s
+# markers arrive out of order across spans, and an unrelated event sits among them.
+SPANS = {
+    0: span('kamlet(0,0)', [marker(10, 1), {'event': 'other', 'cycle': 12, 'details': {}},
+                            marker(30, 2), marker(50, 1)]),
+    1: span('kamlet(1,0)', [marker(60, 1)]),
+    2: span('kamlet(1,0)', [marker(14, 1), marker(40, 2)], completed=90),
+}
+END = 100
+
+
+def test_collect_markers():
+    markers = collect_markers(SPANS)
+    assert markers == {
+        'kamlet(0,0)': [(10, 1), (30, 2), (50, 1)],
+        'kamlet(1,0)': [(14, 1), (40, 2), (60, 1)],
+    }
+
+
+def test_build_phases():
+    phases = build_phases(collect_markers(SPANS), END)
+    got = {(p.component, p.instance): (p.marker_id, p.start, p.end) for p in phases}
+    assert got == {
+        ('kamlet(0,0)', 0): (1, 10, 30),
+        ('kamlet(0,0)', 1): (2, 30, 50),
+        ('kamlet(0,0)', 2): (1, 50, END),
+        ('kamlet(1,0)', 0): (1, 14, 40),
+        ('kamlet(1,0)', 1): (2, 40, 60),
+        ('kamlet(1,0)', 2): (1, 60, END),
+    }
+
+
+def test_phase_table():
+    rows = phase_table(build_phases(collect_markers(SPANS), END), {2: 'verify'})
+    # Phase 1: max(20, 26) + max(50, 40) = 76. Phase 2: max(20, 20) = 20.
+    assert [(r.marker_id, r.name, r.instances, r.cycles) for r in rows] == [
+        (1, '', 2, 76),
+        (2, 'verify', 1, 20),
+    ]
+    assert rows[0].mean == 38.0
+    assert abs(rows[0].share - 100.0 * 76 / 96) < 1e-9
+    table = format_phase_table(rows)
+    assert len(table.splitlines()) == 3
+    assert 'verify' in table.splitlines()[2]
+
+
+def test_chrome_trace():
+    trace = chrome_trace(build_phases(collect_markers(SPANS), END), {1: 'kernel'})
+    events = trace['traceEvents']
+    tracks = {e['tid']: e['args']['name'] for e in events if e['ph'] == 'M'}
+    assert tracks == {0: 'kamlet(0,0)', 1: 'kamlet(1,0)'}
+    phases = [e for e in events if e['ph'] == 'X']
+    assert len(phases) == 6
+    first = min(phases, key=lambda e: (e['tid'], e['ts']))
+    assert (first['name'], first['ts'], first['dur']) == ('kernel', 10, 20)
+
+
+def test_main(tmp_path, capsys):
+    dump = tmp_path / 'dump.json'
+    dump.write_text(json.dumps({'spans': {str(k): v for k, v in SPANS.items()}}))
+    trace = tmp_path / 'trace.json'
+    assert main([str(dump), '--trace', str(trace)]) == 0
+    lines = capsys.readouterr().out.splitlines()
+    # The run ends at the last cycle in the dump, kamlet(1,0)'s completion at 90.
+    assert lines[1].split()[:4] == ['1', '2', '66', '33.0']
+    assert len(json.loads(trace.read_text())['traceEvents']) == 8
+
+
+def test_main_without_markers(tmp_path):
+    dump = tmp_path / 'dump.json'
+    dump.write_text(json.dumps({'spans': {'0': span('kamlet(0,0)', [])}}))
+    assert main([str(dump)]) == 1
@@ -0,0 +1,195 @@
+"""
+Test the prefetch custom instruction (custom-0, funct3=4).
+
+- Every cache line of the VPU pages in the range is in each kamlet's cache once the
+  fills finish; scalar and unmapped pages in the range are skipped.
+- Lines that were already cached, including modified ones, keep their data.
+- A range larger than a kamlet's cache is cut to n_slots lines, and evicting a modified
+  line for a prefetch writes it back so a later prefetch reads it again.
+- A length past the end of memory is clamped to the lines a kamlet cache holds.
+"""
+
+import logging
+from random import Random
+
+import pytest
+
+from zamlet.addresses import GlobalAddress, KMAddr, MemoryType
+from zamlet.decode import decode_standard
+from zamlet.geometries import SMALL_GEOMETRIES
+from zamlet.instructions.custom import Prefetch, prefetch_k_ranges
+from zamlet.instructions.encode import encode_prefetch
+from zamlet.kamlet.cache_table import CacheState
+from zamlet.monitor import CompletionType, SpanType
+from zamlet.params import ZamletParams
+from zamlet.tests.test_utils import run_test, set_vline_random_ew
+
+logger = logging.getLogger(__name__)
+
+
+BASE_ADDR = 0x90000000
+# Scalar registers holding the prefetch address and length.
+ADDR_REG = 10
+BYTES_REG = 11
+
+
+async def issue_prefetch(clock, lamlet, addr: int, n_bytes: int):
+    """Run prefetch addr, n_bytes and wait until every kamlet has issued and received its
+    fills."""
+    span_id = lamlet.monitor.create_span(
+        span_type=SpanType.RISCV_INSTR, component="test",
+        completion_type=CompletionType.FIRE_AND_FORGET, mnemonic="test_prefetch")
+    lamlet.scalar.write_reg(ADDR_REG, addr.to_bytes(8, 'little'), span_id)
+    lamlet.scalar.write_reg(BYTES_REG, n_bytes.to_bytes(8, 'little'), span_id)
+    lamlet.monitor.finalize_children(span_id)
+    lamlet.pc = 0
+    await Prefetch(rs1=ADDR_REG, rs2=BYTES_REG).update_state(lamlet)
+    # The kinstrs reach the kamlets through the instruction buffer before they queue.
+    await lamlet.get_memory_blocking(addr, 1)
+    while any(k.cache_table.prefetch_lines or any(k.cache_table.cache_requests)
+              for k in lamlet.kamlets):
+        await clock.next_cycle
+
+
+def cached_state(lamlet, k_addr: int) -> CacheState | None:
+    """State of the line at kamlet address k_addr if every kamlet holds it in the same
+    state, otherwise None."""
+    states = set()
+    for kamlet in lamlet.kamlets:
+        table = kamlet.cache_table
+        k_maddr = KMAddr(k_index=kamlet.k_index, ordering=None, bit_addr=k_addr * 8,
+                         params=lamlet.params)
+        slot = table.addr_to_slot(k_maddr)
+        states.add(None if slot is None else table.slot_states[slot].state)
+    if len(states) != 1:
+        return None
+    return states.pop()
+
+
+def page_k_lines(lamlet, page_addr: int) -> list[int]:
+    """Kamlet addresses of the cache lines holding the VPU page at page_addr."""
+    params = lamlet.params
+    vpu_addr = lamlet.tlb.pages[page_addr].physical_addr
+    k_start = vpu_addr // params.vline_bytes * params.k_vline_bytes
+    k_bytes = params.page_bytes // params.k_in_l
+    return list(range(k_start, k_start + k_bytes, params.cache_line_bytes))
+
+
+def allocate(lamlet, page_addr: int, memory_type: MemoryType):
+    g_addr = GlobalAddress(bit_addr=page_addr * 8, params=lamlet.params)
+    lamlet.allocate_memory(g_addr, lamlet.params.page_bytes, memory_type=memory_type)
+
+
+def test_decode():
+    instr = decode_standard(encode_prefetch(rs1=ADDR_REG, rs2=BYTES_REG).to_bytes(4, 'little'))
+    assert isinstance(instr, Prefetch)
+    assert (instr.rs1, instr.rs2) == (ADDR_REG, BYTES_REG)
+
+
+@pytest.mark.parametrize("geometry", list(SMALL_GEOMETRIES))
+def test_prefetch_fills_vpu_pages(geometry):
+    """Pages VPU, scalar, unmapped, VPU. The first vline of page 0 is written first, so its
+    line is already modified when the prefetch arrives."""
+    params = SMALL_GEOMETRIES[geometry]
+    page_bytes = params.page_bytes
+
+    async def body(clock, lamlet):
+        rnd = Random(1)
+        pages = [BASE_ADDR + i * page_bytes for i in range(4)]
+        allocate(lamlet, pages[0], MemoryType.VPU)
+        allocate(lamlet, pages[1], MemoryType.SCALAR_IDEMPOTENT)
+        allocate(lamlet, pages[3], MemoryType.VPU)
+        set_vline_random_ew(lamlet, pages[0], page_bytes, rnd)
+        set_vline_random_ew(lamlet, pages[3], page_bytes, rnd)
+
+        written = bytes(rnd.getrandbits(8) for _ in range(params.vline_bytes))
+        await lamlet.set_memory_existing_ew(pages[0], written)
+        # The read lands after the writes, once the line holds them.
+        await lamlet.get_memory_blocking(pages[0], 1)
+        lines = page_k_lines(lamlet, pages[0]) + page_k_lines(lamlet, pages[3])
+        assert cached_state(lamlet, lines[0]) == CacheState.MODIFIED
+        assert cached_state(lamlet, lines[-1]) is None
+
+        await issue_prefetch(clock, lamlet, pages[0], 4 * page_bytes)
+
+        for k_addr in lines:
+            state = cached_state(lamlet, k_addr)
+            want = CacheState.MODIFIED if k_addr == lines[0] else CacheState.SHARED
+            if state != want:
+                logger.error(f'line at k_addr 0x{k_addr:x}: {state}, expected {want}')
+                return 1
+        got = await lamlet.get_memory_blocking(pages[0], params.vline_bytes)
+        if got != written:
+            logger.error(f'page 0 reads {got.hex()} after the prefetch')
+            return 1
+        return 0
+
+    run_test(body, params, max_cycles=200000)
+
+
+def test_prefetch_cut_to_cache():
+    """Page 0 has one modified line. A prefetch of twice the cache from page 1 on fills the
+    first n_slots lines of its range and evicts that line, and prefetching it again brings
+    back the written data."""
+    params = ZamletParams()
+    page_bytes = params.page_bytes
+
+    async def body(clock, lamlet):
+        rnd = Random(2)
+        n_slots = lamlet.kamlets[0].cache_table.n_slots
+        lines_per_page = page_bytes // params.k_in_l // params.cache_line_bytes
+        n_pages = 2 * n_slots // lines_per_page
+        pages = [BASE_ADDR + i * page_bytes for i in range(n_pages + 1)]
+        lines = []
+        for page_addr in pages:
+            allocate(lamlet, page_addr, MemoryType.VPU)
+            set_vline_random_ew(lamlet, page_addr, page_bytes, rnd)
+            lines.append(page_k_lines(lamlet, page_addr))
+
+        written = bytes(rnd.getrandbits(8) for _ in range(params.vline_bytes))
+        await lamlet.set_memory_existing_ew(pages[0], written)
+        await lamlet.get_memory_blocking(pages[0], 1)
+
+        await issue_prefetch(clock, lamlet, pages[1], n_pages * page_bytes)
+
+        range_lines = [k_addr for page_lines in lines[1:] for k_addr in page_lines]
+        cached = [cached_state(lamlet, k_addr) == CacheState.SHARED for k_addr in range_lines]
+        if cached != [True] * n_slots + [False] * (len(range_lines) - n_slots):
+            logger.error(f'cached lines after the prefetch: {cached}')
+            return 1
+        if cached_state(lamlet, lines[0][0]) is not None:
+            logger.error('the modified line of page 0 is still cached')
+            return 1
+
+        await issue_prefetch(clock, lamlet, pages[0], params.vline_bytes)
+        if cached_state(lamlet, lines[0][0]) != CacheState.SHARED:
+            logger.error('the line of page 0 was not prefetched back')
+            return 1
+        got = await lamlet.get_memory_blocking(pages[0], params.vline_bytes)
+        if got != written:
+            logger.error(f'page 0 reads {got.hex()}, wrote {written.hex()}')
+            return 1
+        return 0
+
+    run_test(body, params, max_cycles=200000)
+
+
+def test_prefetch_length_clamped():
+    """A prefetch of 2**64 - 1 bytes over mapped VPU pages covers one cache's worth of
+    kamlet lines, starting at the first line of the range."""
+    params = ZamletParams()
+    page_bytes = params.page_bytes
+
+    async def body(clock, lamlet):
+        cache_bytes = lamlet.kamlets[0].cache_table.n_slots * params.cache_line_bytes
+        n_pages = 2 * cache_bytes * params.k_in_l // page_bytes
+        for i in range(n_pages):
+            allocate(lamlet, BASE_ADDR + i * page_bytes, MemoryType.VPU)
+        ranges = prefetch_k_ranges(lamlet, BASE_ADDR, (1 << 64) - 1)
+        first = page_k_lines(lamlet, BASE_ADDR)[0]
+        if ranges[0][0] != first or sum(n for _, n in ranges) != cache_bytes:
+            logger.error(f'ranges {ranges}, expected {cache_bytes} bytes from 0x{first:x}')
+            return 1
+        return 0
+
+    run_test(body, params, max_cycles=10000)
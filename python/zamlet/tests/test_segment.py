@@ -0,0 +1,285 @@
+"""
+Test segment loads and stores: vlseg/vsseg (unit-stride), vlsseg/vssseg (strided) and
+vluxseg/vsuxseg (indexed).
+
+Segment i starts at rs1 + i * stride, where stride is nf * ew / 8 for the unit-stride
+form, and field f of it sits ew / 8 bytes after field f - 1. vlseg loads field f of
+every segment into register vd + f; vsseg stores register vs3 + f back there. The
+indexed form packs the segments like the unit-stride one but visits them in a random
+permutation: segment i starts at rs1 + vs2[i].
+
+Both directions run on a region of VPU memory holding random elements. A load is
+checked by storing each field register and comparing; a store is checked by reading
+the whole region back, so bytes between strided segments must be left unchanged.
+"""
+
+import asyncio
+import logging
+from random import Random
+
+import pytest
+
+from zamlet.runner import Clock
+from zamlet.params import ZamletParams
+from zamlet.addresses import GlobalAddress, MemoryType, Ordering
+from zamlet.geometries import SMALL_GEOMETRIES, scale_n_tests
+from zamlet.monitor import CompletionType, SpanType
+from zamlet.instructions.vector import VlsegV, VssegV, VIndexedLoad, VIndexedStore
+from zamlet.tests.test_utils import (
+    setup_lamlet, pack_elements, unpack_elements, dump_span_trees, setup_index_register,
+)
+
+logger = logging.getLogger(__name__)
+
+
+async def run_segment_test(
+    clock: Clock,
+    ew: int,
+    nf: int,
+    vl: int,
+    stride_elements: int | None,
+    is_store: bool,
+    params: ZamletParams,
+    seed: int,
+    indexed: bool = False,
+    dump_spans: bool = False,
+):
+    """Drive one segment load or store and verify it against the reference."""
+    assert not (indexed and stride_elements is not None)
+    lamlet = await setup_lamlet(clock, params)
+    try:
+        return await _run_inner(
+            lamlet, ew, nf, vl, stride_elements, is_store, indexed, params, seed)
+    finally:
+        if dump_spans:
+            dump_span_trees(lamlet.monitor)
+
+
+async def _read_elements(lamlet, base, n, ew):
+    element_bytes = ew // 8
+    values = []
+    for i in range(n):
+        future = await lamlet.get_memory(base + i * element_bytes, element_bytes)
+        await future
+        values.append(unpack_elements(future.result(), ew)[0])
+    return values
+
+
+async def _run_inner(lamlet, ew, nf, vl, stride_elements, is_store, indexed, params, seed):
+    rnd = Random(seed)
+    element_bytes = ew // 8
+    ordering = Ordering(lamlet.word_order, ew)
+    vlmax = params.vline_bytes * 8 // ew
+
+    # Strides are whole elements, so the region is an array of ew-bit elements.
+    seg_elements = nf if stride_elements is None else stride_elements
+    region_n = (vl - 1) * seg_elements + nf
+    region_bytes = region_n * element_bytes
+
+    order = list(range(vl))
+    if indexed:
+        rnd.shuffle(order)
+
+    def slot(i, f):
+        return order[i] * seg_elements + f
+
+    logger.info(
+        f"Test params: ew={ew} nf={nf} vl={vl} stride_elements={stride_elements} "
+        f"is_store={is_store} indexed={indexed} seed={seed}")
+
+    page_bytes = params.page_bytes
+    region_pages = (region_bytes + page_bytes - 1) // page_bytes
+    region_base = 0x90000000
+    fields_base = region_base + region_pages * page_bytes
+    fields_pages = (nf * vlmax * element_bytes + page_bytes - 1) // page_bytes
+    for i in range(region_pages + fields_pages):
+        lamlet.allocate_memory(
+            GlobalAddress(bit_addr=(region_base + i * page_bytes) * 8, params=params),
+            page_bytes, memory_type=MemoryType.VPU)
+
+    region = [rnd.getrandbits(ew) for _ in range(region_n)]
+    await lamlet.set_memory(region_base, pack_elements(region, ew), ordering=ordering)
+
+    lamlet.vl = vl
+    lamlet.set_vtype(ew, 1)
+    lamlet.vstart = 0
+    lamlet.pc = 0
+
+    data_reg = 8
+    index_reg = 24
+    rs1_reg = 10
+    rs2_reg = 11
+
+    span_id = lamlet.monitor.create_span(
+        span_type=SpanType.RISCV_INSTR, component="test",
+        completion_type=CompletionType.FIRE_AND_FORGET,
+        mnemonic="test_segment")
+
+    lamlet.scalar.write_reg(rs1_reg, region_base.to_bytes(8, byteorder='little'), span_id)
+    rs2 = None
+    if stride_elements is not None:
+        rs2 = rs2_reg
+        stride = stride_elements * element_bytes
+        lamlet.scalar.write_reg(rs2_reg, stride.to_bytes(8, byteorder='little'), span_id)
+    # Byte offsets of up to vlmax * 8 segments, with index EMUL = index_ew / ew >= 1.
+    index_ew = max(ew, 16)
+    if indexed:
+        offsets = [k * nf * element_bytes for k in order]
+        await setup_index_register(lamlet, index_reg, offsets, index_ew, region_base)
+
+    errors = []
+    if is_store:
+        fields = [[rnd.getrandbits(ew) for _ in range(vlmax)] for _ in range(nf)]
+        for f in range(nf):
+            addr = fields_base + f * vlmax * element_bytes
+            await lamlet.set_memory(addr, pack_elements(fields[f], ew), ordering=ordering)
+            await lamlet.vload(
+                vd=data_reg + f, addr=addr, ordering=ordering,
+                n_elements=vlmax, mask_reg=None, start_index=0,
+                parent_span_id=span_id, emul=1)
+        if indexed:
+            instr = VIndexedStore(vs3=data_reg, rs1=rs1_reg, vs2=index_reg, vm=1,
+                                  index_width=index_ew, ordered=False, nf=nf)
+        else:
+            instr = VssegV(vs3=data_reg, rs1=rs1_reg, vm=1, element_width=ew, nf=nf,
+                           rs2=rs2)
+        await instr.update_state(lamlet)
+
+        expected = list(region)
+        for i in range(vl):
+            for f in range(nf):
+                expected[slot(i, f)] = fields[f][i]
+        actual = await _read_elements(lamlet, region_base, region_n, ew)
+        for k in range(region_n):
+            if actual[k] != expected[k]:
+                errors.append(
+                    f"  region[{k}] expected={expected[k]:#x} actual={actual[k]:#x}")
+    else:
+        if indexed:
+            instr = VIndexedLoad(vd=data_reg, rs1=rs1_reg, vs2=index_reg, vm=1,
+                                 index_width=index_ew, ordered=False, nf=nf)
+        else:
+            instr = VlsegV(vd=data_reg, rs1=rs1_reg, vm=1, element_width=ew, nf=nf,
+                           rs2=rs2)
+        await instr.update_state(lamlet)
+
+        for f in range(nf):
+            addr = fields_base + f * vlmax * element_bytes
+            await lamlet.vstore(
+                vs=data_reg + f, addr=addr, ordering=ordering,
+                n_elements=vl, start_index=0, mask_reg=None,
+                parent_span_id=span_id, emul=1)
+            actual = await _read_elements(lamlet, addr, vl, ew)
+            for i in range(vl):
+                want = region[slot(i, f)]
+                if actual[i] != want:
+                    errors.append(
+                        f"  field {f} [{i}] expected={want:#x} actual={actual[i]:#x}")
+
+    lamlet.monitor.finalize_children(span_id)
+
+    if errors:
+        logger.error(f"FAIL: {len(errors)} mismatches")
+        for e in errors[:16]:
+            logger.error(e)
+        if len(errors) > 16:
+            logger.error(f"  ... and {len(errors) - 16} more")
+        return 1
+
+    logger.info(f"PASS: {vl} segments of {nf} fields correct")
+    return 0
+
+
+async def main(clock, ew, nf, vl, stride_elements, is_store, params, seed,
+               indexed=False, dump_spans=False):
+    clock.register_main()
+    clock.create_task(clock.clock_driver())
+    exit_code = await run_segment_test(
+        clock, ew=ew, nf=nf, vl=vl, stride_elements=stride_elements,
+        is_store=is_store, params=params, seed=seed, indexed=indexed,
+        dump_spans=dump_spans)
+    clock.running = False
+    return exit_code
+
+
+def run_test(ew: int, nf: int, vl: int, stride_elements: int | None, is_store: bool,
+             params: ZamletParams, seed: int, indexed: bool = False,
+             dump_spans: bool = False):
+    clock = Clock(max_cycles=100000)
+    exit_code = asyncio.run(main(
+        clock, ew=ew, nf=nf, vl=vl, stride_elements=stride_elements,
+        is_store=is_store, params=params, seed=seed, indexed=indexed,
+        dump_spans=dump_spans))
+    assert exit_code == 0, f"Test failed with exit_code={exit_code}"
+
+
+def generate_test_params(n_tests: int = 32, seed: int = 42):
+    """Random (geometry, ew, nf, vl, addressing, direction) combos.
+
+    A third of the cases each are unit-stride, strided and indexed.
+    """
+    rnd = Random(seed)
+    test_params = []
+    for i in range(n_tests):
+        geom_name = rnd.choice(list(SMALL_GEOMETRIES.keys()))
+        geom_params = SMALL_GEOMETRIES[geom_name]
+        ew = rnd.choice([8, 16, 32, 64])
+        nf = rnd.randint(2, 8)
+        vlmax = geom_params.vline_bytes * 8 // ew
+        vl = rnd.randint(1, vlmax)
+        mode = rnd.choice(['unit', 'strided', 'indexed'])
+        stride_elements = nf + rnd.randint(0, 5) if mode == 'strided' else None
+        indexed = mode == 'indexed'
+        is_store = rnd.random() < 0.5
+        kind = 'st' if is_store else 'ld'
+        stride_str = f's{stride_elements}' if mode == 'strided' else mode
+        id_str = f"{i}_{geom_name}_ew{ew}_nf{nf}_vl{vl}_{stride_str}_{kind}"
+        test_params.append(pytest.param(
+            geom_params, ew, nf, vl, stride_elements, is_store, indexed, i, id=id_str))
+    return test_params
+
+
+@pytest.mark.parametrize("params,ew,nf,vl,stride_elements,is_store,indexed,seed",
+                         generate_test_params(n_tests=scale_n_tests(32)))
+def test_segment(params, ew, nf, vl, stride_elements, is_store, indexed, seed):
+    """Test segment loads and stores with random configurations."""
+    run_test(ew=ew, nf=nf, vl=vl, stride_elements=stride_elements,
+             is_store=is_store, params=params, seed=seed, indexed=indexed)
+
+
+if __name__ == '__main__':
+    import sys
+    import argparse
+
+    from zamlet.geometries import get_geometry, list_geometries
+
+    parser = argparse.ArgumentParser(description='Test segment loads and stores')
+    parser.add_argument('--ew', type=int, default=32, help='Element width in bits')
+    parser.add_argument('--nf', type=int, default=2, help='Fields per segment')
+    parser.add_argument('--vl', type=int, default=8, help='Vector length')
+    parser.add_argument('--stride-elements', type=int, default=None,
+                        help='Segment stride in elements (default: unit-stride form)')
+    parser.add_argument('--indexed', action='store_true',
+                        help='Test vluxseg/vsuxseg with permuted segments')
+    parser.add_argument('--store', action='store_true', help='Test vsseg instead of vlseg')
+    parser.add_argument('--seed', type=int, default=0, help='Random seed')
+    parser.add_argument('--geometry', '-g', default='k2x2_j1x2',
+                        help='Geometry name (default: k2x2_j1x2)')
+    parser.add_argument('--list-geometries', action='store_true',
+                        help='List available geometries and exit')
+    parser.add_argument('--dump-spans', action='store_true',
+                        help='Dump span trees to span_trees.txt')
+    args = parser.parse_args()
+
+    if args.list_geometries:
+        print("Available geometries:")
+        print(list_geometries())
+        sys.exit(0)
+
+    logging.basicConfig(level=logging.DEBUG, stream=sys.stdout,
+                        format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+
+    params = get_geometry(args.geometry)
+    run_test(ew=args.ew, nf=args.nf, vl=args.vl, stride_elements=args.stride_elements,
+             is_store=args.store, params=params, seed=args.seed, indexed=args.indexed,
+             dump_spans=args.dump_spans)
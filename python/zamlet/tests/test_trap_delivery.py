@@ -6,7 +6,7 @@ from zamlet.addresses import GlobalAddress, MemoryType, Ordering
 from zamlet.geometries import SMALL_GEOMETRIES
 from zamlet.instructions.memory import Lw, Sw
 from zamlet.instructions.system import Mret
-from zamlet.instructions.vector import VIndexedLoad, VleV, VlseV
+from zamlet.instructions.vector import VIndexedLoad, VleV, VlseV, VssegV
 from zamlet.monitor import CompletionType, SpanType
 from zamlet.params import ZamletParams
 from zamlet.runner import Clock
@@ -290,6 +290,61 @@ def test_vector_strided_load_fault_reports_faulting_element_address(params):
     run_model_test(params, body)
 
 
+def test_strided_segment_store_fault_is_precise(params):
+    async def body(clock, lamlet):
+        page_bytes = lamlet.params.page_bytes
+        ew = 32
+        element_bytes = ew // 8
+        nf = 4
+        fault_index = 1
+        vl = 4
+        # Segment i starts two fields before the end of page i, so its last two fields
+        # are in page i + 1. Page fault_index + 1 is left unallocated: segment
+        # fault_index faults in its third field and the next segment in its first, and
+        # the segments after those are writable again. None of them may be written.
+        seg_addrs = [BASE + (i + 1) * page_bytes - 2 * element_bytes for i in range(vl)]
+        fields = [[0x11110000 * (f + 1) + i for i in range(vl)] for f in range(nf)]
+        marker = [0xaaaa0000 + f for f in range(nf)]
+        ordering = Ordering(lamlet.word_order, ew)
+
+        _install_handler(lamlet)
+        lamlet.pc = PC
+        lamlet.vl = vl
+        lamlet.set_vtype(ew, 1)
+        for f in range(nf):
+            await _load_vector(lamlet, 2 + f, fields[f], ew, BASE + (16 + f) * page_bytes)
+        for page in range(vl + 1):
+            if page != fault_index + 1:
+                _alloc(lamlet, BASE + page * page_bytes, memory_type=MemoryType.VPU)
+        for i, seg_addr in enumerate(seg_addrs):
+            if i != fault_index + 1:
+                lamlet.directly_set_memory(seg_addr, pack_elements(marker[:2], ew), ordering)
+            if i != fault_index:
+                lamlet.directly_set_memory(
+                    seg_addr + 2 * element_bytes, pack_elements(marker[2:], ew), ordering)
+        _write_x(lamlet, 1, seg_addrs[0])
+        _write_x(lamlet, 2, page_bytes)
+
+        await VssegV(
+            vs3=2, rs1=1, vm=1, element_width=ew, nf=nf, rs2=2,
+        ).update_state(lamlet)
+
+        await _assert_trap(
+            lamlet, CAUSE_STORE_PAGE_FAULT, BASE + (fault_index + 1) * page_bytes,
+            vstart=fault_index)
+        for i, seg_addr in enumerate(seg_addrs):
+            want = [fields[f][i] for f in range(nf)] if i < fault_index else marker
+            if i != fault_index + 1:
+                head = await lamlet.get_memory_blocking(seg_addr, 2 * element_bytes)
+                assert unpack_elements(head, ew) == want[:2], f"segment {i} fields 0-1"
+            if i != fault_index:
+                tail = await lamlet.get_memory_blocking(
+                    seg_addr + 2 * element_bytes, 2 * element_bytes)
+                assert unpack_elements(tail, ew) == want[2:], f"segment {i} fields 2-3"
+
+    run_model_test(params, body)
+
+
 def test_indexed_load_fault_reports_effective_element_address(params):
     async def body(clock, lamlet):
         page_bytes = lamlet.params.page_bytes
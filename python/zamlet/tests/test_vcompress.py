@@ -0,0 +1,221 @@
+"""
+Test vcompress.vm: vd[j] = vs2[i] where i is the position of the j-th set bit of vs1
+within [0, vl). Elements of vd from the number of set bits up to vlmax must be left
+unchanged. vd and vs2 are register groups of LMUL 1 or 2; vs1 is always one register.
+
+The lamlet reads the vs1 mask words, packs the set-bit positions and issues RegCompress
+kinstrs carrying them, one chunk of j_in_l destinations at a time.
+"""
+
+import asyncio
+import logging
+from random import Random
+
+import pytest
+
+from zamlet.runner import Clock
+from zamlet.params import ZamletParams
+from zamlet.addresses import GlobalAddress, MemoryType, Ordering
+from zamlet.geometries import SMALL_GEOMETRIES, scale_n_tests
+from zamlet.monitor import CompletionType, SpanType
+from zamlet.instructions.vector import VcompressVm
+from zamlet.tests.test_utils import (
+    setup_lamlet, setup_mask_register, pack_elements, unpack_elements, dump_span_trees,
+)
+
+logger = logging.getLogger(__name__)
+
+
+async def run_vcompress_test(
+    clock: Clock,
+    data_ew: int,
+    vl: int,
+    lmul: int,
+    density: float,
+    params: ZamletParams,
+    seed: int,
+    dump_spans: bool = False,
+):
+    """Drive vcompress.vm and verify vd against the reference."""
+    lamlet = await setup_lamlet(clock, params)
+    try:
+        return await _run_inner(lamlet, data_ew, vl, lmul, density, params, seed)
+    finally:
+        if dump_spans:
+            dump_span_trees(lamlet.monitor)
+
+
+async def _run_inner(lamlet, data_ew, vl, lmul, density, params, seed):
+    rnd = Random(seed)
+    data_bytes = data_ew // 8
+    data_ordering = Ordering(lamlet.word_order, data_ew)
+
+    vlmax = params.vline_bytes * 8 * lmul // data_ew
+    mask_bits = [rnd.random() < density for _ in range(vlmax)]
+    kept = [i for i in range(vl) if mask_bits[i]]
+
+    logger.info(
+        f"Test params: data_ew={data_ew} lmul={lmul} vl={vl} vlmax={vlmax} "
+        f"n_kept={len(kept)} seed={seed}")
+
+    page_bytes = params.page_bytes
+    src_base = 0x90000000
+    old_base = src_base + max(page_bytes, 4096)
+    dst_base = old_base + max(page_bytes, 4096)
+    mask_base = dst_base + max(page_bytes, 4096)
+    for base in (src_base, old_base, dst_base):
+        lamlet.allocate_memory(
+            GlobalAddress(bit_addr=base * 8, params=params),
+            page_bytes, memory_type=MemoryType.VPU)
+
+    src_data = [rnd.getrandbits(data_ew) for _ in range(vlmax)]
+    old_data = [rnd.getrandbits(data_ew) for _ in range(vlmax)]
+    await lamlet.set_memory(src_base, pack_elements(src_data, data_ew),
+                            ordering=data_ordering)
+    await lamlet.set_memory(old_base, pack_elements(old_data, data_ew),
+                            ordering=data_ordering)
+
+    expected = [src_data[i] for i in kept] + old_data[len(kept):]
+
+    vs2_reg = 4
+    vd_reg = 8
+    mask_reg = 1
+
+    await setup_mask_register(lamlet, mask_reg, mask_bits, page_bytes, mask_base)
+
+    lamlet.vl = vl
+    lamlet.vtype = {8: 0x0, 16: 0x8, 32: 0x10, 64: 0x18}[data_ew] | {1: 0x0, 2: 0x1}[lmul]
+    lamlet.vstart = 0
+    lamlet.pc = 0
+
+    span_id = lamlet.monitor.create_span(
+        span_type=SpanType.RISCV_INSTR, component="test",
+        completion_type=CompletionType.FIRE_AND_FORGET,
+        mnemonic="test_vcompress")
+
+    await lamlet.vload(
+        vd=vs2_reg, addr=src_base, ordering=data_ordering,
+        n_elements=vlmax, mask_reg=None, start_index=0,
+        parent_span_id=span_id, emul=lmul)
+    await lamlet.vload(
+        vd=vd_reg, addr=old_base, ordering=data_ordering,
+        n_elements=vlmax, mask_reg=None, start_index=0,
+        parent_span_id=span_id, emul=lmul)
+
+    instr = VcompressVm(vd=vd_reg, vs2=vs2_reg, vs1=mask_reg)
+    await instr.update_state(lamlet)
+
+    await lamlet.vstore(
+        vs=vd_reg, addr=dst_base, ordering=data_ordering,
+        n_elements=vlmax, start_index=0, mask_reg=None,
+        parent_span_id=span_id, emul=lmul)
+
+    errors = []
+    for i in range(vlmax):
+        addr = dst_base + i * data_bytes
+        future = await lamlet.get_memory(addr, data_bytes)
+        await future
+        actual = unpack_elements(future.result(), data_ew)[0]
+        if actual != expected[i]:
+            errors.append(
+                f"  [{i}] expected={expected[i]:#x} actual={actual:#x}")
+
+    lamlet.monitor.finalize_children(span_id)
+
+    if errors:
+        logger.error(f"FAIL: {len(errors)} mismatches")
+        for e in errors[:16]:
+            logger.error(e)
+        if len(errors) > 16:
+            logger.error(f"  ... and {len(errors) - 16} more")
+        return 1
+
+    logger.info(f"PASS: {len(kept)} packed elements and {vlmax - len(kept)} tail correct")
+    return 0
+
+
+async def main(clock, data_ew, vl, lmul, density, params, seed, dump_spans=False):
+    clock.register_main()
+    clock.create_task(clock.clock_driver())
+    exit_code = await run_vcompress_test(
+        clock, data_ew=data_ew, vl=vl, lmul=lmul, density=density,
+        params=params, seed=seed, dump_spans=dump_spans)
+    clock.running = False
+    return exit_code
+
+
+def run_test(data_ew: int, vl: int, lmul: int, density: float,
+             params: ZamletParams, seed: int, dump_spans: bool = False):
+    clock = Clock(max_cycles=50000)
+    exit_code = asyncio.run(main(
+        clock, data_ew=data_ew, vl=vl, lmul=lmul, density=density,
+        params=params, seed=seed, dump_spans=dump_spans))
+    assert exit_code == 0, f"Test failed with exit_code={exit_code}"
+
+
+def generate_test_params(n_tests: int = 32, seed: int = 42):
+    """Random (geometry, data_ew, lmul, vl, density) combos, plus empty and full masks."""
+    rnd = Random(seed)
+    test_params = []
+    for i in range(n_tests):
+        geom_name = rnd.choice(list(SMALL_GEOMETRIES.keys()))
+        geom_params = SMALL_GEOMETRIES[geom_name]
+        data_ew = rnd.choice([8, 16, 32, 64])
+        lmul = rnd.choice([1, 2])
+        vlmax = geom_params.vline_bytes * 8 * lmul // data_ew
+        vl = rnd.randint(1, vlmax)
+        density = rnd.choice([0.1, 0.5, 0.9])
+        id_str = f"{i}_{geom_name}_dew{data_ew}_m{lmul}_vl{vl}_d{density}"
+        test_params.append(pytest.param(
+            geom_params, data_ew, vl, lmul, density, i, id=id_str))
+    for i, geom_name in enumerate(SMALL_GEOMETRIES):
+        geom_params = SMALL_GEOMETRIES[geom_name]
+        vlmax = geom_params.vline_bytes * 8 // 32
+        for density in (0.0, 1.0):
+            id_str = f"edge{i}_{geom_name}_dew32_m1_vl{vlmax}_d{density}"
+            test_params.append(pytest.param(
+                geom_params, 32, vlmax, 1, density, 1000 + i, id=id_str))
+    return test_params
+
+
+@pytest.mark.parametrize("params,data_ew,vl,lmul,density,seed",
+                         generate_test_params(n_tests=scale_n_tests(32)))
+def test_vcompress(params, data_ew, vl, lmul, density, seed):
+    """Test vcompress.vm with random configurations."""
+    run_test(data_ew=data_ew, vl=vl, lmul=lmul, density=density, params=params, seed=seed)
+
+
+if __name__ == '__main__':
+    import sys
+    import argparse
+
+    from zamlet.geometries import get_geometry, list_geometries
+
+    parser = argparse.ArgumentParser(description='Test vcompress.vm instruction')
+    parser.add_argument('--data-ew', type=int, default=32,
+                        help='Data element width in bits')
+    parser.add_argument('--vl', type=int, default=8, help='Vector length')
+    parser.add_argument('--lmul', type=int, default=1, choices=[1, 2],
+                        help='Register group size of vd and vs2')
+    parser.add_argument('--density', type=float, default=0.5,
+                        help='Probability that a mask bit is set')
+    parser.add_argument('--seed', type=int, default=0, help='Random seed')
+    parser.add_argument('--geometry', '-g', default='k2x2_j1x2',
+                        help='Geometry name (default: k2x2_j1x2)')
+    parser.add_argument('--list-geometries', action='store_true',
+                        help='List available geometries and exit')
+    parser.add_argument('--dump-spans', action='store_true',
+                        help='Dump span trees to span_trees.txt')
+    args = parser.parse_args()
+
+    if args.list_geometries:
+        print("Available geometries:")
+        print(list_geometries())
+        sys.exit(0)
+
+    logging.basicConfig(level=logging.DEBUG, stream=sys.stdout,
+                        format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+
+    params = get_geometry(args.geometry)
+    run_test(data_ew=args.data_ew, vl=args.vl, lmul=args.lmul, density=args.density,
+             params=params, seed=args.seed, dump_spans=args.dump_spans)
@@ -0,0 +1,46 @@
+"""
+Vector register compress (vcompress.vm): vd[j] = vs2[i] where i is the position of
+the j-th set bit of the vs1 mask within [0, vl).
+
+RF-to-RF like RegGather, but the source element index of each destination element
+comes with the kinstr. The lamlet reads the mask, packs the positions of its set
+bits and hands each chunk of j_in_l destinations its slice of them, so the jamlets
+never need mask bits owned by other jamlets. Routing/sync machinery is shared via
+the RegPermute base; this file only supplies the index lookup.
+"""
+
+from typing import TYPE_CHECKING
+from dataclasses import dataclass
+import logging
+
+from zamlet.transactions.reg_permute import RegPermute, WaitingRegPermute
+
+if TYPE_CHECKING:
+    from zamlet.jamlet.jamlet import Jamlet
+
+logger = logging.getLogger(__name__)
+
+
+class WaitingRegCompress(WaitingRegPermute):
+    """Waiting item for vector register compress."""
+
+    def _compute_src_index(self, jamlet: 'Jamlet', dst_e: int) -> int:
+        instr = self.item
+        return instr.src_indices[dst_e - instr.start_index]
+
+
+@dataclass
+class RegCompress(RegPermute):
+    """Vector register compress instruction.
+
+    vd[start_index + k] = vs2[src_indices[k]] for k < n_elements.
+    """
+    src_indices: tuple[int, ...]
+
+    def _create_waiting_item(self, kamlet, rf_ident: int, renamed) -> WaitingRegCompress:
+        return WaitingRegCompress(
+            params=kamlet.params, instr=self, rf_ident=rf_ident,
+            dst_pregs=renamed.dst_pregs,
+            vs2_pregs=renamed.src2_pregs,
+            mask_preg=renamed.mask_preg,
+        )
@@ -28,6 +28,8 @@ class Store(KInstr):
     A store from a vector register to VPU memory.
 
     stride_bytes: byte stride between elements. None = unit stride (ew/8 bytes).
+    nontemporal: issued in a begin_nontemporal scope; the kamlet writes the line back and
+        frees its slot once the stream has moved past it.
     """
     src: int
     k_maddr: KMAddr  # An address in the kamlet address space
@@ -37,6 +39,7 @@ class Store(KInstr):
     mask_reg: int
     writeset_ident: int
     instr_ident: int
+    nontemporal: bool = False
 
     async def admit(self, kamlet: 'Kamlet') -> 'Store | None':
         ew_match = self.src_ordering.ew == self.k_maddr.ordering.ew
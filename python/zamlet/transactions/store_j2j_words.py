@@ -40,6 +40,7 @@ class WaitingStoreJ2JWords(WaitingItemRequiresCache):
         super().__init__(
             item=instr, instr_ident=instr.instr_ident,
             writeset_ident=instr.writeset_ident, rf_ident=rf_ident)
+        self.nontemporal = instr.nontemporal
         n_tags = params.word_bytes * params.j_in_k
         self.protocol_states: List[StoreProtocolState] = [
             StoreProtocolState() for _ in range(n_tags)]
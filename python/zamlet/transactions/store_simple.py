@@ -36,6 +36,7 @@ class WaitingStoreSimple(WaitingItemRequiresCache):
         super().__init__(
             item=instr, instr_ident=instr.instr_ident,
             writeset_ident=instr.writeset_ident, rf_ident=rf_ident)
+        self.nontemporal = instr.nontemporal
         # Phys regs locked at start time, indexed by vline_offset (the offset
         # from the start_vline of the operation). The kamlet's rename table
         # may rotate the src arch by the time finalize runs.
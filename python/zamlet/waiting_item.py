@@ -8,6 +8,8 @@ class WaitingItem:
     reads_all_memory = False
     writes_all_memory = False
     use_source_to_match = False
+    # A write witem from a non-temporal store; see CacheTable.queue_write_through.
+    nontemporal = False
 
     def __init__(self, item: Any, instr_ident: int, rf_ident: int|None=None,
                  source: Tuple[int, int]|None=None):